@@ -27,6 +27,7 @@
 #include "./tensor/test/Test.h"
 #include "./sample/fnnlm/FNNLM.h"
 #include "./sample/transformer/Transformer.h"
+#include "./sample/transformer/test/T2TTest.h"
 
 //#define CRTDBG_MAP_ALLOC
 //#include <stdlib.h>
@@ -38,8 +39,10 @@ using namespace transformer;
 
 int main( int argc, const char ** argv )
 {
-    if(argc > 1 && !strcmp(argv[1], "-test"))
+    if(argc > 1 && !strcmp(argv[1], "-test")){
         Test();
+        TestTransformer();
+    }
     else if(argc > 1 && !strcmp(argv[1], "-fnnlm"))
         FNNLMMain(argc - 1, argv + 1);
     else if(argc > 1 && !strcmp(argv[1], "-t2t"))
@@ -0,0 +1,92 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <cstring>
+
+#include "Bench.h"
+#include "../tensor/XCall.h"
+#include "../tensor/XPRunner.h"
+#include "../sample/transformer/module/T2TUtility.h"
+
+using namespace transformer;
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/*
+entrance of the benchmarks, e.g.,
+NiuTensorBench -batch 16 -len 32 -hsize 512 -filter MatrixMul -json result.json
+>> argc - number of the arguments
+>> argv - the arguments
+*/
+int BenchMain(int argc, const char ** argv)
+{
+    char ** args = new char*[argc];
+    for (int i = 0; i < argc; i++) {
+        args[i] = new char[strlen(argv[i]) + 1];
+        strcpy(args[i], argv[i]);
+    }
+
+    BenchShape shape;
+    LoadParamInt(argc, args, "batch", &shape.batchSize, 16);
+    LoadParamInt(argc, args, "len", &shape.seqLen, 32);
+    LoadParamInt(argc, args, "hsize", &shape.hSize, 512);
+    LoadParamInt(argc, args, "nhead", &shape.headNum, 8);
+    LoadParamInt(argc, args, "fnnhidden", &shape.fnnSize, shape.hSize * 4);
+    LoadParamInt(argc, args, "vsize", &shape.vocabSize, 10000);
+    LoadParamInt(argc, args, "beamsize", &shape.beamSize, 4);
+    LoadParamInt(argc, args, "nlayer", &shape.layerNum, 6);
+    LoadParamInt(argc, args, "nstep", &shape.stepNum, 32);
+
+    XBench bench;
+    int nthread = 0;
+    char filter[1024];
+    char jsonFN[1024];
+    LoadParamInt(argc, args, "warmup", &bench.warmupNum, 3);
+    LoadParamInt(argc, args, "run", &bench.runNum, 20);
+    LoadParamInt(argc, args, "nthread", &nthread, 0);
+    LoadParamString(argc, args, "filter", filter, "");
+    LoadParamString(argc, args, "json", jsonFN, "");
+    bench.filter = filter;
+
+    CheckNTErrors(shape.hSize % shape.headNum == 0, "The hidden size must be a multiple of the head number!");
+    CheckNTErrors(bench.runNum > 0, "We need at least one timed run!");
+
+    SetThreadNum(nthread);
+
+    DISABLE_GRAD;
+
+    BenchKernels(bench, shape);
+    BenchModel(bench, shape);
+
+    bench.Show(stdout);
+
+    if (strcmp(jsonFN, "") != 0)
+        bench.Dump(jsonFN);
+
+    for (int i = 0; i < argc; i++)
+        delete[] args[i];
+    delete[] args;
+
+    return 0;
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
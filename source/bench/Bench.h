@@ -0,0 +1,72 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include "XBench.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* shapes of the benchmarks (those of a transformer model) */
+struct BenchShape
+{
+    /* number of sentences in a batch */
+    int batchSize;
+
+    /* length of the sentences */
+    int seqLen;
+
+    /* the dimension of the hidden layers */
+    int hSize;
+
+    /* number of heads in attention */
+    int headNum;
+
+    /* the dimension of the fnn hidden layer */
+    int fnnSize;
+
+    /* size of the vocabulary */
+    int vocabSize;
+
+    /* beam size (of the top-k) */
+    int beamSize;
+
+    /* number of encoder (and decoder) layers */
+    int layerNum;
+
+    /* number of the decoding steps */
+    int stepNum;
+};
+
+/* benchmark the tensor operations */
+void BenchKernels(XBench &bench, BenchShape &shape);
+
+/* benchmark the encoder and the decoder of a transformer model */
+void BenchModel(XBench &bench, BenchShape &shape);
+
+/* entrance of the benchmarks */
+int BenchMain(int argc, const char ** argv);
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif /* __BENCH_H__ */
@@ -0,0 +1,357 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "Bench.h"
+#include "../tensor/XTensor.h"
+#include "../tensor/core/CHeader.h"
+#include "../tensor/function/FHeader.h"
+#include "../tensor/loss/CrossEntropy.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/*
+benchmark c = a * b (or b^T)
+>> bench - the benchmark runner
+>> role - where the multiplication is in the model
+>> m, k, n - a is m * k and c is m * n
+>> transposedB - indicates whether b is kept as n * k
+*/
+void BenchMatrixMul2D(XBench &bench, const char * role, int m, int k, int n,
+                      MATRIX_TRANS_TYPE transposedB)
+{
+    XTensor a;
+    XTensor b;
+    XTensor c;
+    InitTensor2D(&a, m, k);
+    if (transposedB == X_TRANS)
+        InitTensor2D(&b, n, k);
+    else
+        InitTensor2D(&b, k, n);
+    InitTensor2D(&c, m, n);
+    a.SetDataRand(-1.0F, 1.0F);
+    b.SetDataRand(-1.0F, 1.0F);
+
+    char shape[256];
+    sprintf(shape, "%s %dx%d*%dx%d%s", role, m, k, k, n, transposedB == X_TRANS ? "^T" : "");
+
+    bench.Run("MatrixMul2D", shape, 2.0 * m * n * k, 4.0 * (m * k + k * n + m * n), [&]() {
+        _MatrixMul2D(&a, X_NOTRANS, &b, transposedB, &c);
+    });
+}
+
+/*
+benchmark the batched multiplications of attention
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchMatrixMulBatched(XBench &bench, BenchShape &s)
+{
+    int num = s.batchSize * s.headNum;
+    int len = s.seqLen;
+    int dk = s.hSize / s.headNum;
+
+    XTensor q;
+    XTensor k;
+    XTensor v;
+    XTensor score;
+    XTensor att;
+    InitTensor3D(&q, num, len, dk);
+    InitTensor3D(&k, num, len, dk);
+    InitTensor3D(&v, num, len, dk);
+    InitTensor3D(&score, num, len, len);
+    InitTensor3D(&att, num, len, dk);
+    q.SetDataRand(-1.0F, 1.0F);
+    k.SetDataRand(-1.0F, 1.0F);
+    v.SetDataRand(-1.0F, 1.0F);
+    score.SetDataRand(0.0F, 1.0F);
+
+    char shape[256];
+
+    sprintf(shape, "q*k^T %dx(%dx%d*%dx%d)", num, len, dk, dk, len);
+    bench.Run("MatrixMulBatched", shape, 2.0 * num * len * len * dk,
+              4.0 * num * (2 * len * dk + len * len), [&]() {
+        _MatrixMulBatched(&q, X_NOTRANS, &k, X_TRANS, &score);
+    });
+
+    sprintf(shape, "score*v %dx(%dx%d*%dx%d)", num, len, len, len, dk);
+    bench.Run("MatrixMulBatched", shape, 2.0 * num * len * len * dk,
+              4.0 * num * (2 * len * dk + len * len), [&]() {
+        _MatrixMulBatched(&score, X_NOTRANS, &v, X_NOTRANS, &att);
+    });
+}
+
+/*
+benchmark the softmax functions (of attention and the output layer)
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchSoftmax(XBench &bench, BenchShape &s)
+{
+    int num = s.batchSize * s.headNum;
+    int len = s.seqLen;
+    int tokenNum = s.batchSize * s.seqLen;
+
+    XTensor score;
+    XTensor prob;
+    XTensor logit;
+    XTensor output;
+    InitTensor3D(&score, num, len, len);
+    InitTensor3D(&prob, num, len, len);
+    InitTensor2D(&logit, tokenNum, s.vocabSize);
+    InitTensor2D(&output, tokenNum, s.vocabSize);
+    score.SetDataRand(-1.0F, 1.0F);
+    logit.SetDataRand(-1.0F, 1.0F);
+
+    /* we count max, exp, sum and division for each item */
+    char shape[256];
+    double attNum = (double)num * len * len;
+    double outNum = (double)tokenNum * s.vocabSize;
+
+    sprintf(shape, "attention %dx%dx%d", num, len, len);
+    bench.Run("Softmax", shape, 4.0 * attNum, 8.0 * attNum, [&]() {
+        _Softmax(&score, &prob, 2);
+    });
+
+    sprintf(shape, "output %dx%d", tokenNum, s.vocabSize);
+    bench.Run("Softmax", shape, 4.0 * outNum, 8.0 * outNum, [&]() {
+        _Softmax(&logit, &output, 1);
+    });
+
+    bench.Run("LogSoftmax", shape, 4.0 * outNum, 8.0 * outNum, [&]() {
+        _LogSoftmax(&logit, &output, 1);
+    });
+}
+
+/*
+benchmark the reductions along the last dimension
+>> bench - the benchmark runner
+>> role - where the reduction is in the model
+>> m, n - the input is m * n
+*/
+void BenchReduce(XBench &bench, const char * role, int m, int n)
+{
+    XTensor a;
+    XTensor b;
+    InitTensor2D(&a, m, n);
+    InitTensor1D(&b, m);
+    a.SetDataRand(-1.0F, 1.0F);
+
+    char shape[256];
+    sprintf(shape, "%s %dx%d", role, m, n);
+
+    double num = (double)m * n;
+
+    bench.Run("ReduceSum", shape, num, 4.0 * (num + m), [&]() {
+        _ReduceSum(&a, &b, 1);
+    });
+
+    bench.Run("ReduceMax", shape, num, 4.0 * (num + m), [&]() {
+        _ReduceMax(&a, &b, 1);
+    });
+}
+
+/*
+benchmark the embedding lookup (gather) and its gradient (spread)
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchGather(XBench &bench, BenchShape &s)
+{
+    int tokenNum = s.batchSize * s.seqLen;
+
+    XTensor table;
+    XTensor embedding;
+    XTensor index;
+    InitTensor2D(&table, s.vocabSize, s.hSize);
+    InitTensor2D(&embedding, tokenNum, s.hSize);
+    InitTensor1D(&index, tokenNum, X_INT);
+    table.SetDataRand(-1.0F, 1.0F);
+    embedding.SetDataRand(-1.0F, 1.0F);
+
+    int * ids = new int[tokenNum];
+    for (int i = 0; i < tokenNum; i++)
+        ids[i] = rand() % s.vocabSize;
+    index.SetData(ids, tokenNum);
+    delete[] ids;
+
+    char shape[256];
+    sprintf(shape, "embedding %dx%d[%d]", s.vocabSize, s.hSize, tokenNum);
+
+    double num = (double)tokenNum * s.hSize;
+
+    bench.Run("Gather", shape, 0, 8.0 * num + 4.0 * tokenNum, [&]() {
+        _Gather(&table, &embedding, &index);
+    });
+
+    bench.Run("Spread", shape, num, 12.0 * num + 4.0 * tokenNum, [&]() {
+        _SpreadForGather(&table, &embedding, &index);
+    });
+}
+
+/*
+benchmark splitting the hidden states into heads and merging them back
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchSplitAndMerge(XBench &bench, BenchShape &s)
+{
+    int dk = s.hSize / s.headNum;
+
+    XTensor hidden;
+    XTensor heads;
+    InitTensor3D(&hidden, s.batchSize, s.seqLen, s.hSize);
+    InitTensor4D(&heads, s.headNum, s.batchSize, s.seqLen, dk);
+    hidden.SetDataRand(-1.0F, 1.0F);
+
+    char shape[256];
+    sprintf(shape, "heads %dx%dx%d<->%dx%dx%dx%d",
+            s.batchSize, s.seqLen, s.hSize, s.headNum, s.batchSize, s.seqLen, dk);
+
+    double num = (double)s.batchSize * s.seqLen * s.hSize;
+
+    bench.Run("Split", shape, 0, 8.0 * num, [&]() {
+        _Split(&hidden, &heads, 2, s.headNum);
+    });
+
+    bench.Run("Merge", shape, 0, 8.0 * num, [&]() {
+        _Merge(&heads, &hidden, 3, 0);
+    });
+}
+
+/*
+benchmark the top-k of beam search
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchTopK(XBench &bench, BenchShape &s)
+{
+    int num = s.batchSize * s.beamSize;
+
+    XTensor score;
+    XTensor best;
+    XTensor index;
+    InitTensor2D(&score, num, s.vocabSize);
+    InitTensor2D(&best, num, s.beamSize);
+    InitTensor2D(&index, num, s.beamSize, X_INT);
+    score.SetDataRand(-1.0F, 1.0F);
+
+    char shape[256];
+    sprintf(shape, "beam %dx%d k=%d", num, s.vocabSize, s.beamSize);
+
+    bench.Run("TopK", shape, (double)num * s.vocabSize, 4.0 * num * s.vocabSize, [&]() {
+        _TopK(&score, &best, &index, 1, s.beamSize);
+    });
+}
+
+/*
+benchmark the cross entropy loss of the output layer
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchCrossEntropy(XBench &bench, BenchShape &s)
+{
+    int tokenNum = s.batchSize * s.seqLen;
+
+    XTensor output;
+    XTensor gold;
+    XTensor loss;
+    InitTensor2D(&output, tokenNum, s.vocabSize);
+    InitTensor2D(&gold, tokenNum, s.vocabSize);
+    InitTensor1D(&loss, tokenNum);
+    output.SetDataRand(0.01F, 1.0F);
+    gold.SetDataRand(0.0F, 1.0F);
+
+    char shape[256];
+    sprintf(shape, "output %dx%d", tokenNum, s.vocabSize);
+
+    double num = (double)tokenNum * s.vocabSize;
+
+    bench.Run("CrossEntropy", shape, 3.0 * num, 8.0 * num, [&]() {
+        _CrossEntropy(&output, &gold, &loss);
+    });
+}
+
+/*
+benchmark the conversion between FP32 and FP16 (and the multiplication with FP16 weights)
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchConvertDataType(XBench &bench, BenchShape &s)
+{
+    XTensor a;
+    XTensor b;
+    InitTensor2D(&a, s.hSize, s.fnnSize);
+    InitTensor2D(&b, s.hSize, s.fnnSize, X_FLOAT16);
+    a.SetDataRand(-1.0F, 1.0F);
+
+    char shape[256];
+    double num = (double)s.hSize * s.fnnSize;
+
+    sprintf(shape, "weight %dx%d fp32->fp16", s.hSize, s.fnnSize);
+    bench.Run("ConvertDataType", shape, 0, 6.0 * num, [&]() {
+        _ConvertDataType(&a, &b);
+    });
+
+    sprintf(shape, "weight %dx%d fp16->fp32", s.hSize, s.fnnSize);
+    bench.Run("ConvertDataType", shape, 0, 6.0 * num, [&]() {
+        _ConvertDataType(&b, &a);
+    });
+
+    /* a step of decoding with the weight kept in fp16 */
+    XTensor x;
+    XTensor c;
+    InitTensor2D(&x, s.batchSize, s.hSize);
+    InitTensor2D(&c, s.batchSize, s.fnnSize);
+    x.SetDataRand(-1.0F, 1.0F);
+
+    sprintf(shape, "fnn1 %dx%d*%dx%d fp16", s.batchSize, s.hSize, s.hSize, s.fnnSize);
+    bench.Run("MatrixMulFP16", shape, 2.0 * s.batchSize * num,
+              2.0 * num + 4.0 * s.batchSize * (s.hSize + s.fnnSize), [&]() {
+        _MatrixMulFP16(&x, &b, X_NOTRANS, NULL, &c);
+    });
+}
+
+/*
+benchmark the tensor operations
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchKernels(XBench &bench, BenchShape &s)
+{
+    int tokenNum = s.batchSize * s.seqLen;
+
+    BenchMatrixMul2D(bench, "attention", tokenNum, s.hSize, s.hSize, X_NOTRANS);
+    BenchMatrixMul2D(bench, "fnn1", tokenNum, s.hSize, s.fnnSize, X_NOTRANS);
+    BenchMatrixMul2D(bench, "fnn2", tokenNum, s.fnnSize, s.hSize, X_NOTRANS);
+    BenchMatrixMul2D(bench, "output", tokenNum, s.hSize, s.vocabSize, X_TRANS);
+    BenchMatrixMulBatched(bench, s);
+    BenchSoftmax(bench, s);
+    BenchReduce(bench, "layernorm", tokenNum, s.hSize);
+    BenchReduce(bench, "output", tokenNum, s.vocabSize);
+    BenchGather(bench, s);
+    BenchSplitAndMerge(bench, s);
+    BenchTopK(bench, s);
+    BenchCrossEntropy(bench, s);
+    BenchConvertDataType(bench, s);
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
@@ -0,0 +1,174 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "../tensor/XTensor.h"
+#include "../sample/transformer/T2TModel.h"
+#include "../sample/transformer/translate/T2TDecodingState.h"
+
+using namespace transformer;
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/*
+create a model of random parameters
+>> model - the model
+>> s - the shapes
+*/
+void InitBenchModel(T2TModel &model, BenchShape &s)
+{
+    std::vector<std::string> options;
+    options.push_back("-dev");       options.push_back("-1");
+    options.push_back("-nhead");     options.push_back(std::to_string(s.headNum));
+    options.push_back("-enclayer");  options.push_back(std::to_string(s.layerNum));
+    options.push_back("-declayer");  options.push_back(std::to_string(s.layerNum));
+    options.push_back("-modelsize"); options.push_back(std::to_string(s.hSize));
+    options.push_back("-embsize");   options.push_back(std::to_string(s.hSize));
+    options.push_back("-fnnhidden"); options.push_back(std::to_string(s.fnnSize));
+    options.push_back("-vsize");     options.push_back(std::to_string(s.vocabSize));
+    options.push_back("-vsizetgt");  options.push_back(std::to_string(s.vocabSize));
+
+    std::vector<const char*> args;
+    for (size_t i = 0; i < options.size(); i++)
+        args.push_back(options[i].c_str());
+
+    T2TConfig config((int)args.size(), args.data());
+
+    /* the parameters are initialized randomly (rather than loaded) for training */
+    config.isTraining = true;
+    model.InitModel(config);
+}
+
+/*
+benchmark the encoder and the decoder of a transformer model. We time the
+encoder on a batch of source sentences, and each step of greedy decoding
+(the decoder and the output layer) with the caches of the self-attention.
+>> bench - the benchmark runner
+>> s - the shapes
+*/
+void BenchModel(XBench &bench, BenchShape &s)
+{
+    if (!bench.IsSelected("Encoder") && !bench.IsSelected("DecoderStep"))
+        return;
+
+    T2TModel model;
+    InitBenchModel(model, s);
+
+    int b = s.batchSize;
+    int len = s.seqLen;
+    int h = s.hSize;
+    int tokenNum = b * len;
+
+    XTensor input;
+    XTensor padding;
+    XTensor maskEnc;
+    InitTensor2D(&input, b, len, X_INT);
+    InitTensor2D(&padding, b, len);
+    padding.SetDataFixed(1);
+
+    int * ids = new int[tokenNum];
+    for (int i = 0; i < tokenNum; i++)
+        ids[i] = 4 + rand() % (s.vocabSize - 4);
+    input.SetData(ids, tokenNum);
+    delete[] ids;
+
+    model.MakeMTMaskEnc(padding, maskEnc);
+
+    /* weights of a layer of the encoder and the decoder */
+    double attWeight = 4.0 * h * h;
+    double fnnWeight = 2.0 * h * s.fnnSize;
+
+    char shape[256];
+
+    /* the encoder */
+    sprintf(shape, "%d layers %dx%d h=%d", s.layerNum, b, len, h);
+    double encFlops = s.layerNum * (2.0 * tokenNum * (attWeight + fnnWeight) +
+                                    4.0 * b * len * len * h);
+    double encBytes = s.layerNum * 4.0 * (attWeight + fnnWeight) +
+                      s.layerNum * 4.0 * 8 * tokenNum * h;
+
+    XTensor encoding;
+    bench.Run("Encoder", shape, encFlops, encBytes, [&]() {
+        encoding = model.encoder->Make(input, &maskEnc, false);
+    });
+
+    if (!bench.IsSelected("DecoderStep"))
+        return;
+
+    if (encoding.order == 0)
+        encoding = model.encoder->Make(input, &maskEnc, false);
+
+    /* the decoder (one step). The cost of attention grows with the step and
+       we count it for the middle step. */
+    T2TDecodingState state;
+    state.Init(&model);
+    state.SetCacheLength(s.stepNum);
+
+    sprintf(shape, "%d layers %dx1 h=%d v=%d", s.layerNum, b, h, s.vocabSize);
+    double decFlops = s.layerNum * (2.0 * b * (attWeight * 1.5 + fnnWeight) +
+                                    4.0 * b * (s.stepNum / 2 + len) * h) +
+                      2.0 * b * h * s.vocabSize;
+    double decBytes = s.layerNum * 4.0 * (attWeight * 2 + fnnWeight) +
+                      s.layerNum * 8.0 * (s.stepNum / 2 + len) * b * h +
+                      4.0 * h * s.vocabSize;
+
+    std::vector<double> times;
+    for (int run = 0; run < bench.warmupNum + bench.runNum; run++) {
+        state.Reset();
+
+        /* only the time matters so we feed the same word at each step */
+        XTensor inputDec;
+        InitTensor2D(&inputDec, b, 1, X_INT);
+        inputDec.SetDataFixed(2);
+
+        for (int l = 0; l < s.stepNum; l++) {
+            XTensor paddingDec;
+            XTensor maskDec;
+            XTensor maskEncDec;
+            XTensor decoding;
+            XTensor prob;
+
+            auto start = std::chrono::steady_clock::now();
+
+            InitTensor(&paddingDec, inputDec.order, inputDec.dimSize, X_INT);
+            paddingDec.SetDataFixed(1);
+            model.MakeMTMaskDec(padding, paddingDec, maskDec, maskEncDec);
+
+            decoding = model.decoder->Make(inputDec, encoding, NULL, &maskEncDec, l, false,
+                                           state.selfAttCache, state.enDeAttCache);
+            model.outputLayer->Make(decoding, prob, false, true, &state.shortlist);
+
+            auto end = std::chrono::steady_clock::now();
+
+            if (run >= bench.warmupNum)
+                times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+    }
+
+    bench.Add("DecoderStep", shape, decFlops, decBytes, times);
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
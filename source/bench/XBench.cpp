@@ -0,0 +1,159 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <chrono>
+#include <algorithm>
+
+#include "XBench.h"
+#include "../tensor/XGlobal.h"
+#include "../tensor/XSIMD.h"
+#include "../tensor/XPRunner.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* constructor */
+XBench::XBench()
+{
+    warmupNum = 3;
+    runNum = 20;
+}
+
+/*
+check if a benchmark is selected
+>> name - name of the benchmark
+*/
+bool XBench::IsSelected(const char * name)
+{
+    return filter.empty() || std::string(name).find(filter) != std::string::npos;
+}
+
+/*
+time a function
+>> name - name of the benchmark
+>> shape - the shapes of the benchmark
+>> flops - number of floating-point operations of a call
+>> bytes - number of bytes a call reads and writes
+>> func - the function
+*/
+void XBench::Run(const char * name, const char * shape, double flops, double bytes,
+                 const std::function<void()> &func)
+{
+    if (!IsSelected(name))
+        return;
+
+    for (int i = 0; i < warmupNum; i++)
+        func();
+
+    std::vector<double> times;
+    for (int i = 0; i < runNum; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    Add(name, shape, flops, bytes, times);
+}
+
+/*
+add the result of a benchmark that is timed outside
+>> name - name of the benchmark
+>> shape - the shapes of the benchmark
+>> flops - number of floating-point operations of a run
+>> bytes - number of bytes a run reads and writes
+>> times - latency of each run (in microseconds)
+*/
+void XBench::Add(const char * name, const char * shape, double flops, double bytes,
+                 std::vector<double> &times)
+{
+    CheckNTErrors(!times.empty(), "No timed run!");
+
+    int num = (int)times.size();
+    std::sort(times.begin(), times.end());
+
+    XBenchResult result;
+    result.name = name;
+    result.shape = shape;
+    result.flops = flops;
+    result.bytes = bytes;
+    result.runNum = num;
+    result.mean = 0;
+    for (int i = 0; i < num; i++)
+        result.mean += times[i] / num;
+    result.min = times[0];
+    result.p50 = times[MIN(num - 1, num * 50 / 100)];
+    result.p90 = times[MIN(num - 1, num * 90 / 100)];
+    result.p99 = times[MIN(num - 1, num * 99 / 100)];
+
+    results.push_back(result);
+
+    fprintf(stderr, "[INFO] %-18s %-40s p50=%10.1fus\n", name, shape, result.p50);
+}
+
+/*
+show the results
+>> file - where to show
+*/
+void XBench::Show(FILE * file)
+{
+    fprintf(file, "%-18s %-40s %9s %10s %10s %10s %10s\n",
+            "benchmark", "shape", "GFLOP/s", "GB/s", "p50(us)", "p90(us)", "p99(us)");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        XBenchResult &r = results[i];
+        double sec = MAX(r.p50, 1e-3) / 1e6;
+        fprintf(file, "%-18s %-40s %9.2f %10.2f %10.1f %10.1f %10.1f\n",
+                r.name.c_str(), r.shape.c_str(), r.flops / sec / 1e9, r.bytes / sec / 1e9,
+                r.p50, r.p90, r.p99);
+    }
+}
+
+/*
+dump the results into a json file
+>> fn - the file name
+*/
+void XBench::Dump(const char * fn)
+{
+    FILE * file = fopen(fn, "w");
+    CheckNTErrors(file, "Cannot open the result file!");
+
+    fprintf(file, "{\"simd\":\"%s\",\"threads\":%d,\"warmup\":%d,\"benchmarks\":[\n",
+            GetSIMDName(GetSIMDLevel()), GetThreadNum(), warmupNum);
+    for (size_t i = 0; i < results.size(); i++) {
+        XBenchResult &r = results[i];
+        double sec = MAX(r.p50, 1e-3) / 1e6;
+        fprintf(file, "{\"name\":\"%s\",\"shape\":\"%s\",\"runs\":%d,"
+                      "\"flops\":%.0f,\"bytes\":%.0f,\"gflops\":%.3f,\"gbps\":%.3f,"
+                      "\"latency_us\":{\"mean\":%.3f,\"min\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f}}%s\n",
+                r.name.c_str(), r.shape.c_str(), r.runNum,
+                r.flops, r.bytes, r.flops / sec / 1e9, r.bytes / sec / 1e9,
+                r.mean, r.min, r.p50, r.p90, r.p99,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "]}\n");
+
+    fclose(file);
+
+    fprintf(stderr, "[INFO] dumped %d results to %s\n", (int)results.size(), fn);
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
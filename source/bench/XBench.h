@@ -0,0 +1,103 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __XBENCH_H__
+#define __XBENCH_H__
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <functional>
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* result of a benchmark */
+struct XBenchResult
+{
+    /* name of the benchmark, e.g., "MatrixMul2D" */
+    std::string name;
+
+    /* the shapes (and the role in the model), e.g., "fnn1 512x512*512x2048" */
+    std::string shape;
+
+    /* number of floating-point operations of a run */
+    double flops;
+
+    /* number of bytes a run reads and writes (at least) */
+    double bytes;
+
+    /* number of the timed runs */
+    int runNum;
+
+    /* latency (in microseconds) */
+    double mean;
+    double min;
+    double p50;
+    double p90;
+    double p99;
+};
+
+/*
+The benchmark runner. Each benchmark is run a few times for warm-up and then
+"runNum" times with a timer. We report the latency percentiles of the timed
+runs, and the throughput (GFLOP/s and GB/s) of the median run.
+*/
+class XBench
+{
+public:
+    /* number of the runs for warm-up */
+    int warmupNum;
+
+    /* number of the timed runs */
+    int runNum;
+
+    /* only the benchmarks whose names contain this are run (all if it is empty) */
+    std::string filter;
+
+    /* results of the benchmarks */
+    std::vector<XBenchResult> results;
+
+public:
+    /* constructor */
+    XBench();
+
+    /* check if a benchmark is selected */
+    bool IsSelected(const char * name);
+
+    /* time a function */
+    void Run(const char * name, const char * shape, double flops, double bytes,
+             const std::function<void()> &func);
+
+    /* add the result of a benchmark that is timed outside */
+    void Add(const char * name, const char * shape, double flops, double bytes,
+             std::vector<double> &times);
+
+    /* show the results */
+    void Show(FILE * file);
+
+    /* dump the results into a json file */
+    void Dump(const char * fn);
+};
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif /* __XBENCH_H__ */
@@ -41,6 +41,12 @@ void XFuncGrad::MakeGrad(XTensor * node, bool isEfficient)
     XLink &income = node->income;
     int operID = income.typeID;
 
+    /* layer normalization has three inputs (x, w and b) */
+    if (operID == FUNC_LAYERNORM) {
+        GradLayerNorm(node, isEfficient);
+        return;
+    }
+
     CheckNTErrors(income.tailNum == 1, "Too many input tensors for the function!");
 
     XTensor * input = income.tails[0];
@@ -85,6 +91,49 @@ void XFuncGrad::MakeGrad(XTensor * node, bool isEfficient)
     node->visitMark = NODE_FINISHED;
 }
 
+/*
+gradient for layer normalization
+for
+y = (x - \mu) / \sqrt{\sigma^2 + eps} * w + b
+we compute dE/dx, dE/dw and dE/db in a single call (see _LayerNormBackward)
+>> node - the node (y) for backward computation
+>> isEfficient - indicates whether the computation is in
+                 an efficient manner
+*/
+void XFuncGrad::GradLayerNorm(XTensor * node, bool isEfficient)
+{
+    XLink &income = node->income;
+    CheckNTErrors(income.tailNum == 3, "Wrong input tensor number for LAYERNORM!");
+
+    XTensor * x = income.tails[0];
+    XTensor * w = income.tails[1];
+    XTensor * b = income.tails[2];
+    DTYPE eps = income.GetParam(0);
+
+    XTensor * dedx = NULL;
+    XTensor * dedw = NULL;
+    XTensor * dedb = NULL;
+
+    if (!isEfficient || x->isGrad) {
+        XNoder::MakeGrad(x);
+        dedx = x->grad;
+    }
+
+    if (!isEfficient || w->isGrad) {
+        XNoder::MakeGrad(w);
+        dedw = w->grad;
+    }
+
+    if (!isEfficient || b->isGrad) {
+        XNoder::MakeGrad(b);
+        dedb = b->grad;
+    }
+
+    _LayerNormBackward(x, w, node->grad, dedx, dedw, dedb, eps);
+
+    node->visitMark = NODE_FINISHED;
+}
+
 /* indicates whether the node is for an activation function */
 bool XFuncGrad::IsFunc(XTensor * node)
 {
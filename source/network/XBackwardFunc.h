@@ -40,6 +40,11 @@ public:
     /* indicates whether the node is for an activation function */
     static
     bool IsFunc(XTensor * node);
+
+private:
+    /* gradient for layer normalization */
+    static
+    void GradLayerNorm(XTensor * node, bool isEfficient);
 };
 
 }
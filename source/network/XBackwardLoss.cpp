@@ -51,6 +51,15 @@ void XLossGrad::MakeGrad(XTensor * node, bool isEfficient)
         XNoder::MakeGrad(output);
         XTensor * dedy = output->grad;
 
+        /* the gradient goes to the scores before the softmax directly */
+        if (operID == LOSS_SOFTMAXCROSSENTROPY) {
+            if (income.tailNum == 3)
+                padding = income.tails[2];
+            _SoftmaxCrossEntropyWithIndexBackward(output, income.tails[1], padding, dedy, income.GetParam(0));
+            node->visitMark = NODE_FINISHED;
+            return;
+        }
+
         if (income.tailNum == 1) {
             dedy->SetDataFixed(1);
             return;
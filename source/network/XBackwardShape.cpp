@@ -152,6 +152,7 @@ for
 b = gather(a) 
 we have
 dE/da = spreadforgather(b)
+or the rows of dE/db with their indices if a keeps a row-sparse gradient
 >> node - the node (c) for backward computation
 >> isEfficient - indicates whether the computation is in
                  an efficient manner
@@ -165,14 +166,22 @@ void XShapeGrad::GradGather(XTensor * node, bool isEfficient)
     XTensor * index = income.tails[1];
     
     if (!isEfficient || input->isGrad) {
-        XNoder::MakeGrad(input);
+        /* only the rows we looked up have gradients. We keep them as they
+           are rather than spreading them over a dense tensor */
+        if (input->isSparseGrad) {
+            XNoder::MakeSparseGrad(input);
+            input->sparseGrad->Add(index, node->grad);
+        }
+        else {
+            XNoder::MakeGrad(input);
 
-        XTensor * tmp = NewTensorBufV2(input, input->devID, input->mem);
-        tmp->SetZeroAll();
-        _SpreadForGather(tmp, node->grad, index);
-        _SumMe(input->grad, tmp);
+            XTensor * tmp = NewTensorBufV2(input, input->devID, input->mem);
+            tmp->SetZeroAll();
+            _SpreadForGather(tmp, node->grad, index);
+            _SumMe(input->grad, tmp);
 
-        DelTensorBuf(tmp);
+            DelTensorBuf(tmp);
+        }
     }
 
     node->visitMark = NODE_FINISHED;
@@ -0,0 +1,183 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2018, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * checkpoint regions (gradient checkpointing)
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "XNet.h"
+#include "XNoder.h"
+#include "XCheckpoint.h"
+#include "../tensor/XName.h"
+#include "../tensor/XDevice.h"
+
+namespace nts{
+
+/*
+make a checkpoint region. The sub-network is built as usual but we
+only keep its output. The intermediate nodes are released right after
+the forward computation and are re-computed in back-propagation.
+The output is linked to the inputs directly (by NETWORK_CHECKPOINT) so
+that XNet knows how to make the sub-network again. The random number
+generators are seeded before we make the sub-network. So the
+re-computation generates the same random numbers (e.g., dropout masks).
+Note that rand() is shared by the threads of the process. So no other
+thread should draw numbers from it while we train (e.g., the batch
+loader of the transformer has a generator of its own).
+
+>> func - the function that makes the sub-network
+>> inputs - the inputs of the region. Note that the function sees the
+            inputs in the same order in re-computation
+>> model - the model (or anything else) given to the function
+>> id - an integer given to the function, e.g., the index of the layer
+<< return - the output of the region
+*/
+XTensor Checkpoint(XRegionFunc func, TensorList &inputs, void * model, int id)
+{
+    CheckNTErrors(func != NULL, "No function is given!");
+    for (int i = 0; i < inputs.count; i++)
+        CheckNTErrors(inputs.GetItem(i) != NULL, "Empty input of the checkpoint region!");
+
+    int seed = rand();
+    GDevs.SetSeed(seed);
+
+    XTensor output = func(inputs, model, id);
+
+    if (!X_ENABLE_GRAD || !output.enableGrad)
+        return output;
+
+    /* cut the sub-network off. The intermediate nodes are temporary
+       ones and are deleted (as well as their data) when no one
+       refers to them */
+    XLink::ClearIncoming(&output);
+
+    XLink::MakeLink(&inputs, &output, NETWORK_CHECKPOINT);
+    XLink::AddParamToHeadPointer(&output, (void*)func);
+    XLink::AddParamToHeadPointer(&output, model);
+    XLink::AddParamToHeadInt(&output, id);
+    XLink::AddParamToHeadInt(&output, seed);
+
+    return output;
+}
+
+/*
+compute dE/dx of a node. We make the sub-network of the region again
+and run the back-propagation on it. The inputs of the sub-network share
+the data with the real inputs but hang on leaf nodes of their own. So
+the re-computation does not touch the rest of the network.
+>> node - the output of a checkpoint region
+>> isEfficient - indicates whether the computation is in
+                 an efficient manner
+*/
+void XCheckpointGrad::MakeGrad(XTensor * node, bool isEfficient)
+{
+    XLink &income = node->income;
+    CheckNTErrors(income.typeID == NETWORK_CHECKPOINT, "Not a checkpoint region!");
+
+    if (isEfficient && !node->isGrad) {
+        node->visitMark = NODE_FINISHED;
+        return;
+    }
+
+    CheckNTErrors(node->grad != NULL, "No gradient found!");
+
+    XRegionFunc func = (XRegionFunc)income.GetParamPointer(0);
+    void * model = income.GetParamPointer(1);
+    int id = income.GetParamInt(2);
+    int seed = income.GetParamInt(3);
+
+    TensorList leaves(income.tailNum);
+    TensorList inputs(income.tailNum);
+    for (int i = 0; i < income.tailNum; i++) {
+        XTensor * tail = income.tails[i];
+        int dims[MAX_TENSOR_DIM_NUM];
+        memcpy(dims, tail->dimSize, sizeof(int) * tail->order);
+        dims[0] = -dims[0];
+
+        /* the tensors do not allocate (or free) the data array */
+        XTensor * leaf = new XTensor(tail->order, dims, tail->dataType, tail->denseRatio,
+                                     tail->devID, tail->mem);
+        XTensor * input = new XTensor(tail->order, dims, tail->dataType, tail->denseRatio,
+                                      tail->devID, tail->mem);
+        leaf->data = tail->data;
+        leaf->isShared = true;
+        input->data = tail->data;
+        input->isShared = true;
+
+        /* we keep the gradient of the leaf as that of a parameter */
+        leaf->SetVarFlag(!isEfficient || tail->isGrad);
+
+        /* the input is not a leaf itself because a copy of a leaf
+           node (e.g., "y = x") is not connected to it */
+        XLink::MakeLink(leaf, NULL, input, FUNC_IDENTITY);
+
+        leaves.Add(leaf);
+        inputs.Add(input);
+    }
+
+    {
+        /* the same random numbers as in the forward computation */
+        int next = rand();
+        GDevs.SetSeed(seed);
+
+        XTensor output = func(inputs, model, id);
+
+        GDevs.SetSeed(next);
+
+        CheckNTErrors(_IsSameShaped(&output, node), "The re-computed output is of a different shape!");
+
+        output.grad = NewTensor(node->grad);
+        _CopyValues(node->grad, output.grad);
+
+        XNet net;
+        net.SetGradEfficientFlag(isEfficient);
+        net.SetDataReleaseFlag(true);
+        net.Backward(output);
+
+        for (int i = 0; i < income.tailNum; i++) {
+            XTensor * tail = income.tails[i];
+            XTensor * leaf = leaves.GetItem(i);
+
+            if (leaf->grad == NULL || (isEfficient && !tail->isGrad))
+                continue;
+
+            XNoder::MakeGrad(tail);
+            _SumMe(tail->grad, leaf->grad);
+        }
+
+        /* the sub-network is deleted with its output here */
+    }
+
+    for (int i = 0; i < inputs.count; i++) {
+        delete inputs.GetItem(i);
+        delete leaves.GetItem(i);
+    }
+
+    node->visitMark = NODE_FINISHED;
+}
+
+/* indicates whether the node is the output of a checkpoint region */
+bool XCheckpointGrad::IsCheckpoint(XTensor * node)
+{
+    XLink &income = node->income;
+    return income.typeID == NETWORK_CHECKPOINT;
+}
+
+}
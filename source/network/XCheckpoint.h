@@ -0,0 +1,59 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2018, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * checkpoint regions (gradient checkpointing)
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "../tensor/XTensor.h"
+
+#ifndef __XCHECKPOINT_H__
+#define __XCHECKPOINT_H__
+
+namespace nts{
+
+/*
+the function that makes the sub-network of a checkpoint region, i.e.,
+it computes the output from the inputs. "model" and "id" are passed
+through as they are, e.g., the module and the index of the layer.
+*/
+typedef XTensor (*XRegionFunc)(TensorList &inputs, void * model, int id);
+
+/*
+make a checkpoint region. The sub-network is built as usual but we
+only keep its output. The intermediate nodes are released right after
+the forward computation and are re-computed in back-propagation.
+*/
+XTensor Checkpoint(XRegionFunc func, TensorList &inputs, void * model, int id);
+
+/* this class computes the gradient for checkpoint regions given a node */
+class XCheckpointGrad
+{
+public:
+    /* compute dE/dx of a node */
+    static
+    void MakeGrad(XTensor * node, bool isEfficient);
+
+    /* indicates whether the node is the output of a checkpoint region */
+    static
+    bool IsCheckpoint(XTensor * node);
+};
+
+}
+
+#endif
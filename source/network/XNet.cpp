@@ -25,7 +25,9 @@
 #include "XBackwardMath.h"
 #include "XBackwardFunc.h"
 #include "XBackwardShape.h"
+#include "XCheckpoint.h"
 #include "../tensor/XName.h"
+#include "../tensor/XProfiler.h"
 
 namespace nts{
 
@@ -56,6 +58,7 @@ XNet::XNet()
 {
     nodes.Clear();
     isGradEfficient = true;
+    isDataReleased = false;
 }
 
 /* de-constructor */
@@ -124,6 +127,11 @@ void XNet::Backward(TensorList &roots)
             if(XNoder::IsLeaf(node))
                 ClearGrad(node);
         }
+
+        /* the activation is of no use once its consumers and itself
+           are processed. So we give the memory back to the pool */
+        if(isDataReleased)
+            ReleaseData(node, roots);
     }
 }
 
@@ -142,6 +150,8 @@ void XNet::BackwardNode(XTensor * node, bool isEfficent)
         /* post processing for parent nodes */
         BackwardNodePost(node, isEfficent);
 
+        double profStart = GProfiler.isEnabled ? GProfiler.BeginBackward(node) : -1;
+
         /* process the current node */
         if(XMathGrad::IsMathOP(node))
             XMathGrad::MakeGrad(node, isEfficent);
@@ -151,9 +161,14 @@ void XNet::BackwardNode(XTensor * node, bool isEfficent)
             XShapeGrad::MakeGrad(node, isEfficent);
         else if(XLossGrad::IsLossOP(node))
             XLossGrad::MakeGrad(node, isEfficent);
+        else if(XCheckpointGrad::IsCheckpoint(node))
+            XCheckpointGrad::MakeGrad(node, isEfficent);
         else{
             ShowNTErrors("Wrong node type!");
         }
+
+        if(profStart >= 0)
+            GProfiler.AddBackward(node, profStart);
     }
     else{
         node->visitMark = NODE_FINISHED;
@@ -321,6 +336,52 @@ void XNet::ClearGrad(XTensor * node)
     }
 }
 
+/* 
+set the flag of releasing node data in back-propagation. Note that
+the values and the gradients of intermediate nodes (except the roots)
+are not available after Backward() if the flag is set
+>> flag - the flag
+*/
+void XNet::SetDataReleaseFlag(bool flag)
+{
+    isDataReleased = flag;
+}
+
+/* 
+release the data of a node if no gradient function needs it. The
+value of a node is read by the backward functions of the node itself
+and of its parents (the nodes that take it as input). So it can be
+freed when all of them are finished. Its gradient is of no use then
+as well: the parents have accumulated into it and the node has passed
+it to its children. We keep the leaf nodes (e.g., inputs and model
+parameters) and the roots of the network.
+>> node - the node that we want to release
+>> roots - root nodes of the network
+*/
+void XNet::ReleaseData(XTensor * node, TensorList &roots)
+{
+    if(node->data == NULL || node->isVar || node->isShared)
+        return;
+    if(XNoder::IsLeaf(node))
+        return;
+    if(node->visitMark != NODE_FINISHED)
+        return;
+    if(roots.FindFirst(node) >= 0)
+        return;
+
+    XLink & outgo = node->outgo;
+    for(int i = 0; i < outgo.tailNum; i++){
+        XTensor * parent = outgo.tails[i];
+        if(parent->visitMark != NODE_FINISHED)
+            return;
+    }
+
+    node->DestroyData();
+
+    delete node->grad;
+    node->grad = NULL;
+}
+
 /* 
 show network topology 
 >> file - file to dump information
@@ -51,6 +51,10 @@ struct XNet
     /* indicates whether the network just keeps the gradient for parameter tensors */
     bool isGradEfficient;
 
+    /* indicates whether we free the data of an intermediate node once
+       no gradient function needs it any more */
+    bool isDataReleased;
+
     /* constructor */
     XNet();
 
@@ -96,6 +100,12 @@ struct XNet
     /* clear the graident information if the node is no use */
     void ClearGrad(XTensor * node);
 
+    /* set the flag of releasing node data in back-propagation */
+    void SetDataReleaseFlag(bool flag = true);
+
+    /* release the data of a node if no gradient function needs it */
+    void ReleaseData(XTensor * node, TensorList &roots);
+
     /* show network topology */
     void ShowNetwork(FILE * file, XTensor * node);
 
@@ -20,6 +20,7 @@
  */
 
 #include "XNoder.h"
+#include "../tensor/XRowSparse.h"
 
 namespace nts{
 
@@ -36,6 +37,18 @@ void XNoder::MakeGrad(XTensor * node)
     }
 }
 
+/* make row-sparse gradient for a node (see XRowSparse.h) */
+void XNoder::MakeSparseGrad(XTensor * node)
+{
+    if(node == NULL)
+        return;
+
+    CheckNTErrors(node->order == 2, "Row-sparse gradients are only for matrices!");
+
+    if(node->sparseGrad == NULL)
+        node->sparseGrad = new XRowSparse(node->dimSize[0], node->dimSize[1], node->devID);
+}
+
 /* the node is a leaf node (intput) or not */
 bool XNoder::IsLeaf(XTensor * node)
 {
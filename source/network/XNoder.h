@@ -39,6 +39,10 @@ public:
     static
     void MakeGrad(XTensor * node);
 
+    /* make row-sparse gradient for a node */
+    static
+    void MakeSparseGrad(XTensor * node);
+
     /* the node is a leaf node (intput) or not */
     static
     bool IsLeaf(XTensor * node);
@@ -30,8 +30,11 @@
 #include "../../tensor/XGlobal.h"
 #include "../../tensor/XUtility.h"
 #include "../../tensor/XDevice.h"
+#include "../../tensor/XShuffler.h"
+#include "../../tensor/XRowSparse.h"
 #include "../../tensor/function/FHeader.h"
 #include "../../network/XNet.h"
+#include "../../network/XNoder.h"
 
 namespace fnnlm
 {
@@ -66,10 +69,12 @@ float GetProb(XTensor &output, XTensor &gold, XTensor * wordProbs = NULL);
 void Dump(const char * fn, FNNModel &model);
 void Read(const char * fn, FNNModel &model);
 void Test(const char * test, const char * result, FNNModel &model);
-int  LoadNGrams(FILE * file, int n, NGram * ngrams, int sentNum, int wordNum);
+int  LoadNGrams(FILE * file, int n, NGram * ngrams, int sentNum, int wordNum,
+                XShuffler * shuffler = NULL);
 void InitZeroOneTensor2D(XTensor &tensor, int rowNum, int colNum, int * rows, int * cols, 
                          int itemNum, int devID);
 void MakeWordBatch(XTensor &batch, NGram * ngrams, int ngramNum, int n, int vSize, int devID);
+void MakeWordIndex(XTensor &index, NGram * ngrams, int ngramNum, int n, int devID);
 void Forward(XTensor inputs[], XTensor &output, FNNModel &model, FNNNet &net);
 void Backward(XTensor inputs[], XTensor &output, XTensor &gold, LOSS_FUNCTION_NAME loss, 
               FNNModel &model, FNNModel &grad, FNNNet &net);
@@ -129,7 +134,11 @@ int FNNLMMain(int argc, const char ** argv)
 
     /* learn model parameters */
     if(strcmp(trainFN, "")) {
-        ENABLE_GRAD;
+        /* the network is not needed if we compute the gradients ourselves */
+        if(autoDiff)
+            ENABLE_GRAD;
+        else
+            DISABLE_GRAD;
         Train(trainFN, shuffled, model);
     }
 
@@ -230,6 +239,11 @@ void LoadArgs(int argc, const char ** argv, FNNModel &model)
             model.devID = atoi(argv[i + 1]);
             fprintf(stderr, " -dev=%d\n", model.devID);
         }
+        if(!strcmp(argv[i], "-nthread") && i + 1 < argc){
+            int threadNum = atoi(argv[i + 1]);
+            SetThreadNum(threadNum);
+            fprintf(stderr, " -nthread=%d\n", threadNum);
+        }
     }
 }
 
@@ -244,7 +258,8 @@ void Check(FNNModel &model)
 /* make a hard copy of the fnn model */
 void Copy(FNNModel &tgt, FNNModel &src)
 {
-    InitTensor(&tgt.embeddingW, &src.embeddingW);
+    /* the embedding matrix is not copied because its gradient
+       is row-sparse and is kept with the parameter (see Backward) */
     for(int i = 0; i < MAX_HIDDEN_NUM; i++){
         InitTensor(&tgt.hiddenW[i], &src.hiddenW[i]);
         InitTensor(&tgt.hiddenB[i], &src.hiddenB[i]);
@@ -284,7 +299,6 @@ void Clear(FNNModel &model, bool isNodeGrad)
             model.outputB.grad->SetZeroAll();
     }
     else {
-        model.embeddingW.SetZeroAll();
         for (int i = 0; i < MAX_HIDDEN_NUM; i++) {
             model.hiddenW[i].SetZeroAll();
             model.hiddenB[i].SetZeroAll();
@@ -324,6 +338,9 @@ void Init(FNNModel &model)
     /* create embedding parameter matrix: vSize * eSize */
     InitModelTensor2D(model.embeddingW, model.vSize, model.eSize, model);
     model.embeddingW.SetVarFlag();
+
+    /* only the rows of the words in a batch have gradients */
+    model.embeddingW.SetSparseGradFlag();
     
     /* create hidden layer parameter matrics */
     for(int i = 0; i < model.hDepth; i++){
@@ -360,24 +377,6 @@ void Init(FNNModel &model)
         model.hiddenB[i].SetZeroAll();
 }
     
-/*
- shuffle lines of the file
- >> srcFile - the source file to shuffle
- >> tgtFile - the resulting file
- */
-void Shuffle(const char * srcFile, const char * tgtFile)
-{
-    char * line = new char[MAX_LINE_LENGTH_HERE];
-#ifndef WIN32
-    sprintf(line, "shuf %s > %s", srcFile, tgtFile);
-    system(line);
-#else
-    ShowErrors("Cannot shuffle the file on WINDOWS systems!");
-#endif
-    delete[] line;
-    
-}
-    
 char lineBuf[MAX_LINE_LENGTH_HERE];
 int wordBuf[MAX_LINE_LENGTH_HERE];
 
@@ -389,15 +388,10 @@ train the model with the standard SGD method
 */
 void Train(const char * train, bool isShuffled, FNNModel &model)
 {
-    char name[MAX_NAME_LENGTH];
-    
-    /* shuffle the data */
-    if(isShuffled){
-        sprintf(name, "%s-tmp", train);
-        Shuffle(train, name);
-    }
-    else
-        strcpy(name, train);
+    /* the lines are shuffled in every epoch (without rewriting the file) */
+    XShuffler shuffler;
+    if(isShuffled)
+        shuffler.Init(train);
     
     int epoch = 0;
     int step = 0;
@@ -422,8 +416,13 @@ void Train(const char * train, bool isShuffled, FNNModel &model)
     for(epoch = 0; epoch < nEpoch; epoch++){
 
         /* data file */
-        FILE * file = fopen(name, "rb");
-        CheckErrors(file, "Cannot open the training file");
+        FILE * file = NULL;
+        if(isShuffled)
+            shuffler.Start(epoch);
+        else{
+            file = fopen(train, "rb");
+            CheckErrors(file, "Cannot open the training file");
+        }
 
         wordCount = 0;
         loss = 0;
@@ -432,7 +431,7 @@ void Train(const char * train, bool isShuffled, FNNModel &model)
         while(ngramNum > 0){
             
             /* load a minibatch of ngrams */
-            ngramNum = LoadNGrams(file, model.n, ngrams, sentBatch, wordBatch);
+            ngramNum = LoadNGrams(file, model.n, ngrams, sentBatch, wordBatch, &shuffler);
 
             if (ngramNum <= 0)
                 break;
@@ -449,9 +448,9 @@ void Train(const char * train, bool isShuffled, FNNModel &model)
             /* the loss tensor */
             XTensor lossTensor;
 
-            /* make the input tensor for position i */
+            /* make the input tensor (word indices) for position i */
             for(int i = 0; i < model.n - 1; i++)
-                MakeWordBatch(inputs[i], ngrams, ngramNum, i, model.vSize, model.devID);
+                MakeWordIndex(inputs[i], ngrams, ngramNum, i, model.devID);
 
             /* make the gold tensor */
             MakeWordBatch(gold, ngrams, ngramNum, model.n - 1, model.vSize, model.devID);
@@ -515,7 +514,8 @@ void Train(const char * train, bool isShuffled, FNNModel &model)
             }
         }
 
-        fclose(file);
+        if(file != NULL)
+            fclose(file);
         
         if(isEnd)
             break;
@@ -553,8 +553,6 @@ void Update(FNNModel &model, FNNModel &grad, float epsilon, bool isNodeGrad)
         paraList.Add(&model.hiddenB[i]);
     }
 
-    paraList.Add(&model.embeddingW);
-
     if(!isNodeGrad){
         gradList.Add(&grad.outputW);
         gradList.Add(&grad.outputB);
@@ -563,8 +561,6 @@ void Update(FNNModel &model, FNNModel &grad, float epsilon, bool isNodeGrad)
             gradList.Add(&grad.hiddenW[i]);
             gradList.Add(&grad.hiddenB[i]);
         }
-;
-        gradList.Add(&grad.embeddingW);
     }
     else{
         gradList.Add(model.outputW.grad);
@@ -574,8 +570,6 @@ void Update(FNNModel &model, FNNModel &grad, float epsilon, bool isNodeGrad)
             gradList.Add(model.hiddenW[i].grad);
             gradList.Add(model.hiddenB[i].grad);
         }
-
-        gradList.Add(model.embeddingW.grad);
     }
 
     for (int i = 0; i < paraList.count; i++) {
@@ -585,6 +579,14 @@ void Update(FNNModel &model, FNNModel &grad, float epsilon, bool isNodeGrad)
         /* the delta rule */
         _Sum(para, paraGrad, para, -epsilon);
     }
+
+    /* the gradient of the embedding matrix is row-sparse (in both cases),
+       and we update the rows of the words in the batch only */
+    XRowSparse * embeddingGrad = model.embeddingW.sparseGrad;
+    if (embeddingGrad != NULL) {
+        embeddingGrad->ApplyTo(&model.embeddingW, -epsilon);
+        embeddingGrad->Clear();
+    }
 }
   
 /*
@@ -634,12 +636,15 @@ load a minibatch of ngrams
 >> ngrams - the loaded ngrams
 >> sentNum - maximum sentences kept in the minibatch
 >> wordNum - maximum words kept in the minibatch
+>> shuffler - where to load the lines if the file is NULL
 */
-int LoadNGrams(FILE * file, int n, NGram * ngrams, int sentNum, int wordNum)
+int LoadNGrams(FILE * file, int n, NGram * ngrams, int sentNum, int wordNum,
+               XShuffler * shuffler)
 {
     int num = 0;
     int lineNum = 0;
-    while(pin > 0 || fgets(lineBuf, MAX_LINE_LENGTH_HERE - 1, file)){
+    while(pin > 0 || (file != NULL ? fgets(lineBuf, MAX_LINE_LENGTH_HERE - 1, file) != NULL :
+                                     shuffler->GetLine(lineBuf, MAX_LINE_LENGTH_HERE - 1) != NULL)){
         if(pin <= 0){
             int len = (int)strlen(lineBuf);
 
@@ -753,9 +758,30 @@ void MakeWordBatch(XTensor &batch, NGram * ngrams, int ngramNum, int n, int vSiz
     delete[] cols;
 }
 
+/*
+make a tensor that keeps the indices of a batch of words
+>> index - the tensor (ngramNum) that keeps the word indices
+>> ngrams - the ngram batch
+>> ngramNum - batch size
+>> n - indicate which word is encode for each ngram
+>> devID - device id
+*/
+void MakeWordIndex(XTensor &index, NGram * ngrams, int ngramNum, int n, int devID)
+{
+    int * words = new int[ngramNum];
+
+    for(int i = 0; i < ngramNum; i++)
+        words[i] = ngrams[i].words[n];
+
+    InitTensor1D(&index, ngramNum, X_INT, devID);
+    index.SetData(words, ngramNum);
+
+    delete[] words;
+}
+
 /*
 forward procedure
->> inputs - input word representations
+>> inputs - input words (indices)
 >> output - output probability
 >> model - the fnn model
 >> net - the network that keeps the internal tensors generated in the process
@@ -782,9 +808,10 @@ void Forward(XTensor inputs[], XTensor &output, FNNModel &model, FNNNet &net)
         /* embedding output tensor of position i */
         InitModelTensor2D(embedding, batchSize, model.eSize, model);
 
-        /* generate word embedding of position i:
-           embedding = input * w   */
-        MatrixMul(input, X_NOTRANS, w, X_NOTRANS, embedding);
+        /* generate word embedding of position i, i.e., the rows
+           of w that are indexed by the input words. It is the same as
+           embedding = input * w if the words are in the one-hot form */
+        _Gather(&w, &embedding, &input);
 
         eList.Add(&net.embeddings[i]);
     }
@@ -855,7 +882,7 @@ void Forward(XTensor inputs[], XTensor &output, FNNModel &model, FNNNet &net)
 
 /*
 backward procedure
->> inputs - input word representations
+>> inputs - input words (indices)
 >> output - output probability
 >> gold - gold standard
 >> loss - loss function name
@@ -957,16 +984,21 @@ void Backward(XTensor inputs[], XTensor &output, XTensor &gold, LOSS_FUNCTION_NA
     /* split the concatenation of gradients of the embeddings */
     Split(dedyCat, eList, 1, n - 1);
 
+    /* the gradient of the embedding weight is row-sparse. It is kept
+       with the parameter rather than in the gradient model */
+    XNoder::MakeSparseGrad(&model.embeddingW);
+    XRowSparse * dedEmb = model.embeddingW.sparseGrad;
+
     /* go over for each word */
     for (int i = 0; i < n - 1; i++) {
         XTensor * dedy = (XTensor*)eList.GetItem(i);
         XTensor &x = inputs[i];
-        XTensor &dedw = grad.embeddingW;
 
-        /* gradient of the embedding weight: dE/dw += x^T * dE/dy 
+        /* gradient of the embedding weight: dE/dw += x^T * dE/dy,
+           i.e., row x_k of dE/dw is added by row k of dE/dy.
            NOTE that we accumulate dE/dw here because the matrix w
            is shared by several layers (or words) */
-        MatrixMul(x, X_TRANS, *dedy, X_NOTRANS, dedw, 1.0F, 1.0F);
+        dedEmb->Add(&x, dedy);
 
         delete dedy;
     }
@@ -1023,7 +1055,7 @@ void ForwardAutoDiff(NGram * ngrams, int batch, XTensor &output, FNNModel &model
 
 /*
 forward process (with tensor connections) (this is implemented by multiply function)
->> inputs - input word representations
+>> inputs - input word representations (in the one-hot form)
 >> output - output probability
 >> model - the fnn model
 */
@@ -1154,9 +1186,9 @@ void Test(const char * test, const char * result, FNNModel &model)
         /* the gold standard */
         XTensor gold;
         
-        /* make the input tensor for position i */
+        /* make the input tensor (word indices) for position i */
         for (int i = 0; i < model.n - 1; i++)
-            MakeWordBatch(inputs[i], ngrams, ngramNum, i, model.vSize, model.devID);
+            MakeWordIndex(inputs[i], ngrams, ngramNum, i, model.devID);
 
         /* make the gold tensor */
         MakeWordBatch(gold, ngrams, ngramNum, model.n - 1, model.vSize, model.devID);
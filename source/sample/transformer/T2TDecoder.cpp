@@ -27,6 +27,7 @@
 #include "module/T2TLayerNormal.h"
 #include "module/T2TCommonModules.h"
 #include "../../tensor/core/CHeader.h"
+#include "../../network/XCheckpoint.h"
 
 namespace transformer
 {
@@ -41,15 +42,12 @@ AttDecoder::AttDecoder()
     enDeAtt = NULL;
     enDeAttLayerNorms = NULL;
     decoderLayerNorm = NULL;
-    selfAttCache = NULL;
-    enDeAttCache = NULL;
+    useGradCheckpoint = false;
 }
 
 /* de-constructor */
 AttDecoder::~AttDecoder()
 {
-    delete[] selfAttCache;
-    delete[] enDeAttCache;
     delete[] selfAtt;
     delete[] fnns;
     delete[] selfAttLayerNorms;
@@ -73,6 +71,7 @@ void AttDecoder::InitModel(T2TConfig& config)
     vSize = config.tgtVocabSize;
     dropoutP = config.dropout;
     preNorm = config.preNorm;
+    useGradCheckpoint = config.useGradCheckpoint;
 
     CheckNTErrors(nlayer >= 1, "We have one encoding layer at least!");
     CheckNTErrors(vSize > 1, "set vocabulary size by \"-vsizetgt\"");
@@ -86,8 +85,6 @@ void AttDecoder::InitModel(T2TConfig& config)
     enDeAtt = new T2TAttention[nlayer];
     enDeAttLayerNorms = new T2TLN[nlayer];
     fnnLayerNorms = new T2TLN[nlayer];
-    selfAttCache = new Cache[nlayer];
-    enDeAttCache = new Cache[nlayer];
     if (preNorm)
         decoderLayerNorm = new T2TLN;
 
@@ -104,6 +101,21 @@ void AttDecoder::InitModel(T2TConfig& config)
         decoderLayerNorm->InitModel(config);
 }
 
+/*
+make a decoding layer in a checkpoint region (see Checkpoint())
+>> inputs - the input of the layer, the output of the encoder and the masks
+>> model - the decoder
+>> id - index of the layer
+<< return - the output of the layer
+*/
+static XTensor MakeDecoderLayer(TensorList &inputs, void * model, int id)
+{
+    AttDecoder * decoder = (AttDecoder*)model;
+
+    return decoder->MakeLayer(id, *inputs.GetItem(0), *inputs.GetItem(1),
+                              inputs.GetItem(2), inputs.GetItem(3), true);
+}
+
 /*
 make the decoding network
 >> inputDec - the input tensor of the decoder
@@ -112,10 +124,13 @@ make the decoding network
 >> maskEncDec - mask for the encoder-decoder attention
 >> nstep - the current length of the decoder input
 >> isTraining - indicates whether the model is used for training
+>> selfAttCache - the self-attention cache of each layer (for inference)
+>> enDeAttCache - the encoder-decoder attention cache of each layer (for inference)
 << return - the output tensor of the decoder
 */
 XTensor AttDecoder::Make(XTensor& inputDec, XTensor& outputEnc, XTensor* mask,
-    XTensor* maskEncDec, int nstep, bool isTraining)
+    XTensor* maskEncDec, int nstep, bool isTraining,
+    Cache* selfAttCache, Cache* enDeAttCache)
 {
     XTensor x;
     x = embedder.Make(inputDec, true, isTraining, nstep);
@@ -125,71 +140,104 @@ XTensor AttDecoder::Make(XTensor& inputDec, XTensor& outputEnc, XTensor* mask,
         x = Dropout(x, dropoutP);
 
     for (int i = 0; i < nlayer; i++) {
-        XTensor att;
-        XTensor ende;
-        XTensor fnn;
-        XTensor res;
-        XTensor selfAttnBefore;
-        XTensor selfAttnAfter;
-        XTensor endeAttnBefore;
-        XTensor endeAttnAfter;
-        XTensor fnnBefore;
-
-        /* layer normalization with pre-norm for self-attn */
-        selfAttnBefore = LayerNorm(x, selfAttLayerNorms[i], preNorm, true, false);
+        if (useGradCheckpoint && isTraining && mask != NULL && maskEncDec != NULL) {
+            TensorList inputs(4);
+            inputs.Add(&x);
+            inputs.Add(&outputEnc);
+            inputs.Add(mask);
+            inputs.Add(maskEncDec);
+
+            /* only the output of the layer is kept in the network */
+            x = Checkpoint(MakeDecoderLayer, inputs, this, i);
+        }
+        else
+            x = MakeLayer(i, x, outputEnc, mask, maskEncDec, isTraining,
+                          selfAttCache != NULL ? &selfAttCache[i] : NULL,
+                          enDeAttCache != NULL ? &enDeAttCache[i] : NULL);
+    }
 
-        /******************/
-        /* self attention */
-        att = selfAtt[i].Make(selfAttnBefore, selfAttnBefore, selfAttnBefore, 
-                              mask, isTraining, &selfAttCache[i], SELF_ATT);
+    if (preNorm)
+        x = decoderLayerNorm->Make(x);
 
-        /* dropout */
-        if (isTraining && dropoutP > 0)
-            att = Dropout(att, dropoutP);
+    return x;
+}
 
-        /* residual connection */
-        res = Sum(att, x);
+/*
+make a decoding layer
+>> i - index of the layer
+>> x - the input of the layer
+>> outputEnc - the output tensor of the encoder
+>> mask - mask that indicates which position is valid
+>> maskEncDec - mask for the encoder-decoder attention
+>> isTraining - indicates whether the model is used for training
+>> selfAttCache - the self-attention cache of the layer (for inference)
+>> enDeAttCache - the encoder-decoder attention cache of the layer (for inference)
+<< return - the output of the layer
+*/
+XTensor AttDecoder::MakeLayer(int i, XTensor& x, XTensor& outputEnc, XTensor* mask,
+                              XTensor* maskEncDec, bool isTraining,
+                              Cache* selfAttCache, Cache* enDeAttCache)
+{
+    XTensor att;
+    XTensor ende;
+    XTensor fnn;
+    XTensor res;
+    XTensor selfAttnBefore;
+    XTensor selfAttnAfter;
+    XTensor endeAttnBefore;
+    XTensor endeAttnAfter;
+    XTensor fnnBefore;
+
+    /* layer normalization with pre-norm for self-attn */
+    selfAttnBefore = LayerNorm(x, selfAttLayerNorms[i], preNorm, true, false);
+
+    /******************/
+    /* self attention */
+    att = selfAtt[i].Make(selfAttnBefore, selfAttnBefore, selfAttnBefore, 
+                          mask, isTraining, selfAttCache, SELF_ATT);
 
-        /* layer normalization with post-norm for self-attention */
-        selfAttnAfter = LayerNorm(res, selfAttLayerNorms[i], preNorm, false, true);
+    /* dropout */
+    if (isTraining && dropoutP > 0)
+        att = Dropout(att, dropoutP);
 
-        /* layer normalization with pre-norm for encoder-decoder attention */
-        endeAttnBefore = LayerNorm(selfAttnAfter, enDeAttLayerNorms[i], preNorm, true, false);
+    /* residual connection */
+    res = Sum(att, x);
 
-        /* encoder-decoder attention */
-        ende = enDeAtt[i].Make(outputEnc, endeAttnBefore, outputEnc, maskEncDec, 
-                               isTraining, &enDeAttCache[i], EN_DE_ATT);
+    /* layer normalization with post-norm for self-attention */
+    selfAttnAfter = LayerNorm(res, selfAttLayerNorms[i], preNorm, false, true);
 
-        /* dropout */
-        if (isTraining && dropoutP > 0)
-            ende = Dropout(ende, dropoutP);
+    /* layer normalization with pre-norm for encoder-decoder attention */
+    endeAttnBefore = LayerNorm(selfAttnAfter, enDeAttLayerNorms[i], preNorm, true, false);
 
-        /* residual connection */
-        res = Sum(ende, selfAttnAfter);
+    /* encoder-decoder attention */
+    ende = enDeAtt[i].Make(outputEnc, endeAttnBefore, outputEnc, maskEncDec, 
+                           isTraining, enDeAttCache, EN_DE_ATT);
 
-        /* layer normalization with post-norm for encoder-decoder attention */
-        endeAttnAfter = LayerNorm(res, enDeAttLayerNorms[i], preNorm, false, true);
+    /* dropout */
+    if (isTraining && dropoutP > 0)
+        ende = Dropout(ende, dropoutP);
 
-        /* layer normalization with pre-norm for fnn */
-        fnnBefore = LayerNorm(endeAttnAfter, fnnLayerNorms[i], preNorm, true, false);
+    /* residual connection */
+    res = Sum(ende, selfAttnAfter);
 
-        /* fnn */
-        fnn = fnns[i].Make(fnnBefore, isTraining);
+    /* layer normalization with post-norm for encoder-decoder attention */
+    endeAttnAfter = LayerNorm(res, enDeAttLayerNorms[i], preNorm, false, true);
 
-        /* dropout */
-        if (isTraining && dropoutP > 0)
-            fnn = Dropout(fnn, dropoutP);
+    /* layer normalization with pre-norm for fnn */
+    fnnBefore = LayerNorm(endeAttnAfter, fnnLayerNorms[i], preNorm, true, false);
 
-        /* residual connection */
-        res = Sum(fnn, endeAttnAfter);
+    /* fnn */
+    fnn = fnns[i].Make(fnnBefore, isTraining);
 
-        /* layer normalization with post-norm for fnn */
-        x = LayerNorm(res, fnnLayerNorms[i], preNorm, false, true);
-    }
+    /* dropout */
+    if (isTraining && dropoutP > 0)
+        fnn = Dropout(fnn, dropoutP);
 
-    if (preNorm)
-        x = decoderLayerNorm->Make(x);
+    /* residual connection */
+    res = Sum(fnn, endeAttnAfter);
 
-    return x;
+    /* layer normalization with post-norm for fnn */
+    return LayerNorm(res, fnnLayerNorms[i], preNorm, false, true);
 }
+
 }
\ No newline at end of file
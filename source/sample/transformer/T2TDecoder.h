@@ -75,15 +75,13 @@ public:
     /* layer normalization for encoder-decoder attention */
     T2TLN* enDeAttLayerNorms;
 
-    /* layer cache list */
-    Cache* selfAttCache;
-
-    /* layer cache list */
-    Cache* enDeAttCache;
-
     /* the location of layer normalization */
     bool preNorm;
 
+    /* indicates whether the layers are re-computed in back-propagation
+       rather than keeping their intermediate results (for training) */
+    bool useGradCheckpoint;
+
 public:
     /* constructor */
     AttDecoder();
@@ -96,7 +94,13 @@ public:
 
     /* make the decoding network */
     XTensor Make(XTensor& inputDec, XTensor& outputEnc, XTensor* mask,
-                 XTensor* maskEncDec, int nstep, bool isTraining);
+                 XTensor* maskEncDec, int nstep, bool isTraining,
+                 Cache* selfAttCache = NULL, Cache* enDeAttCache = NULL);
+
+    /* make a decoding layer */
+    XTensor MakeLayer(int i, XTensor& x, XTensor& outputEnc, XTensor* mask,
+                      XTensor* maskEncDec, bool isTraining,
+                      Cache* selfAttCache = NULL, Cache* enDeAttCache = NULL);
 };
 
 }
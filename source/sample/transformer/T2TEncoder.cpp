@@ -27,6 +27,7 @@
 #include "module/T2TLayerNormal.h"
 #include "module/T2TCommonModules.h"
 #include "../../tensor/core/CHeader.h"
+#include "../../network/XCheckpoint.h"
 
 namespace transformer
 {
@@ -39,6 +40,7 @@ AttEncoder::AttEncoder()
     attLayerNorms = NULL;
     fnnLayerNorms = NULL;
     encoderLayerNorm = NULL;
+    useGradCheckpoint = false;
 }
 
 /* de-constructor */
@@ -66,6 +68,7 @@ void AttEncoder::InitModel(T2TConfig& config)
     vSize = config.srcVocabSize;
     preNorm = config.preNorm;
     dropoutP = config.dropout;
+    useGradCheckpoint = config.useGradCheckpoint;
 
     CheckNTErrors(nlayer >= 1, "We have one encoding layer at least!");
     CheckNTErrors(vSize > 1, "set vocabulary size by \"-vsize\"");
@@ -92,6 +95,21 @@ void AttEncoder::InitModel(T2TConfig& config)
         encoderLayerNorm->InitModel(config);
 }
 
+/*
+make an encoding layer in a checkpoint region (see Checkpoint())
+>> inputs - the input of the layer and the mask (if there is one)
+>> model - the encoder
+>> id - index of the layer
+<< return - the output of the layer
+*/
+static XTensor MakeEncoderLayer(TensorList &inputs, void * model, int id)
+{
+    AttEncoder * encoder = (AttEncoder*)model;
+    XTensor * mask = inputs.count > 1 ? inputs.GetItem(1) : NULL;
+
+    return encoder->MakeLayer(id, *inputs.GetItem(0), mask, true);
+}
+
 /*
 make the encoding network
 >> input - the input tensor of the encoder
@@ -111,49 +129,72 @@ XTensor AttEncoder::Make(XTensor& input, XTensor* mask, XTensor& maskEncDec, boo
         x = Dropout(x, dropoutP);
 
     for (int i = 0; i < nlayer; i++) {
-        XTensor att;
-        XTensor fnn;
-        XTensor res;
-        XTensor attnBefore;
-        XTensor attnAfter;
-        XTensor fnnBefore;
+        if (useGradCheckpoint && isTraining) {
+            TensorList inputs(2);
+            inputs.Add(&x);
+            if (mask != NULL)
+                inputs.Add(mask);
+
+            /* only the output of the layer is kept in the network */
+            x = Checkpoint(MakeEncoderLayer, inputs, this, i);
+        }
+        else
+            x = MakeLayer(i, x, mask, isTraining);
+    }
+    if (preNorm)
+        x = encoderLayerNorm->Make(x);
 
-        /* layer normalization with pre-norm for self-attn */
-        attnBefore = LayerNorm(x, attLayerNorms[i], preNorm, true, false);
+    return x;
+}
 
-        /* self attention */
-        att = selfAtt[i].Make(attnBefore, attnBefore, attnBefore, mask, isTraining, NULL, 0);
+/*
+make an encoding layer
+>> i - index of the layer
+>> x - the input of the layer
+>> mask - the mask that indicate each position is valid
+>> isTraining - indicates whether the model is used for training
+<< return - the output of the layer
+*/
+XTensor AttEncoder::MakeLayer(int i, XTensor& x, XTensor* mask, bool isTraining)
+{
+    XTensor att;
+    XTensor fnn;
+    XTensor res;
+    XTensor attnBefore;
+    XTensor attnAfter;
+    XTensor fnnBefore;
 
-        /* dropout */
-        if (isTraining && dropoutP > 0)
-            att = Dropout(att, dropoutP);
+    /* layer normalization with pre-norm for self-attn */
+    attnBefore = LayerNorm(x, attLayerNorms[i], preNorm, true, false);
 
-        /* residual connection */
-        res = Sum(att, x);
+    /* self attention */
+    att = selfAtt[i].Make(attnBefore, attnBefore, attnBefore, mask, isTraining, NULL, 0);
 
-        /* layer normalization with post-norm for self-attn */
-        attnAfter = LayerNorm(res, attLayerNorms[i], preNorm, false, true);
+    /* dropout */
+    if (isTraining && dropoutP > 0)
+        att = Dropout(att, dropoutP);
 
-        /* layer normalization with pre-norm for fnn */
-        fnnBefore = LayerNorm(attnAfter, fnnLayerNorms[i], preNorm, true, false);
+    /* residual connection */
+    res = Sum(att, x);
 
-        /* fnn */
-        fnn = fnns[i].Make(fnnBefore, isTraining);
+    /* layer normalization with post-norm for self-attn */
+    attnAfter = LayerNorm(res, attLayerNorms[i], preNorm, false, true);
 
-        /* dropout */
-        if (isTraining && dropoutP > 0)
-            fnn = Dropout(fnn, dropoutP);
+    /* layer normalization with pre-norm for fnn */
+    fnnBefore = LayerNorm(attnAfter, fnnLayerNorms[i], preNorm, true, false);
 
-        /* residual connection */
-        res = Sum(fnn, attnAfter);
+    /* fnn */
+    fnn = fnns[i].Make(fnnBefore, isTraining);
 
-        /* layer normalization with post-norm for fnn */
-        x = LayerNorm(res, fnnLayerNorms[i], preNorm, false, true);
-    }
-    if (preNorm)
-        x = encoderLayerNorm->Make(x);
+    /* dropout */
+    if (isTraining && dropoutP > 0)
+        fnn = Dropout(fnn, dropoutP);
 
-    return x;
+    /* residual connection */
+    res = Sum(fnn, attnAfter);
+
+    /* layer normalization with post-norm for fnn */
+    return LayerNorm(res, fnnLayerNorms[i], preNorm, false, true);
 }
 
 /*
@@ -93,6 +93,10 @@ public:
     /* the location of layer normalization */
     bool preNorm;
 
+    /* indicates whether the layers are re-computed in back-propagation
+       rather than keeping their intermediate results (for training) */
+    bool useGradCheckpoint;
+
 public:
     /* constructor */
     AttEncoder();
@@ -108,6 +112,9 @@ public:
 
     /* make the encoding network (wrapper) */
     XTensor Make(XTensor& input, XTensor* mask, bool isTraining);
+
+    /* make an encoding layer */
+    XTensor MakeLayer(int i, XTensor& x, XTensor* mask, bool isTraining);
 };
 
 }
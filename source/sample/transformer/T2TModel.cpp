@@ -37,6 +37,8 @@ T2TModel::T2TModel()
     isLM = false;
     isMT = false;
     useFP16 = false;
+    useInt8 = false;
+    useFP16Weight = false;
     shareAllEmbeddings = false;
     shareDecInputOutputWeight = false;
     nhead = 1;
@@ -44,6 +46,7 @@ T2TModel::T2TModel()
     encoder = new AttEncoder();
     decoder = new AttDecoder();
     outputLayer = new T2TOutput();
+    mappedFile = NULL;
 }
 
 /* de-constructor */
@@ -52,6 +55,9 @@ T2TModel::~T2TModel()
     delete encoder;
     delete decoder;
     delete outputLayer;
+
+    /* the parameters may point to the mapped file, so we close it at last */
+    delete mappedFile;
 }
 
 /*
@@ -64,6 +70,8 @@ void T2TModel::InitModel(T2TConfig& config)
     isMT = config.isMT;
     isLM = !isMT;
     useFP16 = config.useFP16;
+    useInt8 = config.useInt8 && !config.isTraining;
+    useFP16Weight = config.useFP16Weight && !config.isTraining;
 
     /* configurations for the model */
     int* metaInfo[] = {
@@ -80,9 +88,22 @@ void T2TModel::InitModel(T2TConfig& config)
 
     /* read model configurations */
     if (!config.isTraining) {
-        modelFile = fopen(config.modelFN, "rb");
-        for (auto& meta : metaInfo)
-            fread(meta, sizeof(int), 1, modelFile);
+        if (XModelFile::IsModelFile(config.modelFN)) {
+            /* the model file is mapped into memory (see Read()) */
+            mappedFile = new XModelFile();
+            mappedFile->Open(config.modelFN);
+            CheckNTErrors(mappedFile->header.metaNum == sizeof(metaInfo) / sizeof(int*),
+                          "Unmatched model configurations!");
+            for (int i = 0; i < mappedFile->header.metaNum; i++)
+                *metaInfo[i] = mappedFile->meta[i];
+        }
+        else {
+            /* the old format (without the tensor index) */
+            modelFile = fopen(config.modelFN, "rb");
+            CheckNTErrors(modelFile, "Cannot open the model file");
+            for (auto& meta : metaInfo)
+                fread(meta, sizeof(int), 1, modelFile);
+        }
     }
     nhead = config.nhead;
 
@@ -96,7 +117,9 @@ void T2TModel::InitModel(T2TConfig& config)
     GetParams(params);
 
     /* load parameters */
-    if (!config.isTraining)
+    if (!config.isTraining && mappedFile != NULL)
+        Read(mappedFile);
+    else if (!config.isTraining)
         Read(modelFile);
     else {
         for (int i = 0; i < params.Size(); i++)
@@ -144,8 +167,11 @@ make the network for language modeling (with the output softmax layer)
 >> output - output tensor (distribution)
 >> padding - padding of the sequences
 >> isTraining - indicates whether the model is for training
+>> isNormalized - indicates whether the output is normalized by softmax
+                  (or we output the scores for a loss with softmax inside)
 */
-void T2TModel::MakeLM(XTensor& input, XTensor& output, XTensor& padding, bool isTraining)
+void T2TModel::MakeLM(XTensor& input, XTensor& output, XTensor& padding, bool isTraining,
+                      bool isNormalized)
 {
     int len = padding.GetDim(padding.order - 1);
     int* dims = new int[padding.order + 2];
@@ -168,7 +194,7 @@ void T2TModel::MakeLM(XTensor& input, XTensor& output, XTensor& padding, bool is
     XTensor encoding;
 
     encoding = MakeEncoder(input, &mask, isTraining);
-    outputLayer->Make(encoding, output, true, true);
+    outputLayer->Make(encoding, output, true, isNormalized);
 }
 
 /*
@@ -179,10 +205,12 @@ make the network for machine translation (with the output softmax layer)
 >> paddingEnc - padding of the sequences (on the encoder side)
 >> paddingDec - padding of the sequences (on the decoder side)
 >> isTraining - indicates whether the model is for training
+>> isNormalized - indicates whether the output is normalized by softmax
+                  (or we output the scores for a loss with softmax inside)
 */
 void T2TModel::MakeMT(XTensor& inputEnc, XTensor& inputDec, XTensor& output,
     XTensor& paddingEnc, XTensor& paddingDec,
-    bool isTraining)
+    bool isTraining, bool isNormalized)
 {
     XTensor encoding;
     XTensor decoding;
@@ -200,7 +228,7 @@ void T2TModel::MakeMT(XTensor& inputEnc, XTensor& inputDec, XTensor& output,
 
     decoding = MakeDecoder(inputDec, encoding, &maskDec, maskEncDec, isTraining);
 
-    outputLayer->Make(decoding, output, true, true);
+    outputLayer->Make(decoding, output, true, isNormalized);
 }
 
 /*
@@ -340,6 +368,21 @@ void T2TModel::MakeMTMaskDec(XTensor& paddingEnc, XTensor& paddingDec,
 
     delete[] dims;
 }
+/*
+add a parameter to the list and name it (the name is used in the model file)
+>> list - the list of parameters
+>> param - the parameter
+>> format - format of the name
+>> layer - the layer index (if the format needs it)
+*/
+void AddParam(TensorList& list, XTensor* param, const char* format, int layer = 0)
+{
+    char name[MAX_TENSOR_NAME_SIZE];
+    snprintf(name, MAX_TENSOR_NAME_SIZE, format, layer);
+    param->SetName(name);
+    list.Add(param);
+}
+
 /*
 get parameter matrices
 >> list - the list that keeps the parameter matrics
@@ -350,76 +393,76 @@ void T2TModel::GetParams(TensorList& list)
 
     /* encoder parameters */
     for (int i = 0; i < encoder->nlayer; i++) {
-        list.Add(&encoder->selfAtt[i].wq);
-        list.Add(&encoder->selfAtt[i].wk);
-        list.Add(&encoder->selfAtt[i].wv);
-        list.Add(&encoder->selfAtt[i].bq);
-        list.Add(&encoder->selfAtt[i].bk);
-        list.Add(&encoder->selfAtt[i].bv);
+        AddParam(list, &encoder->selfAtt[i].wq, "enc.%d.selfatt.wq", i);
+        AddParam(list, &encoder->selfAtt[i].wk, "enc.%d.selfatt.wk", i);
+        AddParam(list, &encoder->selfAtt[i].wv, "enc.%d.selfatt.wv", i);
+        AddParam(list, &encoder->selfAtt[i].bq, "enc.%d.selfatt.bq", i);
+        AddParam(list, &encoder->selfAtt[i].bk, "enc.%d.selfatt.bk", i);
+        AddParam(list, &encoder->selfAtt[i].bv, "enc.%d.selfatt.bv", i);
         if (encoder->selfAtt[i].useRPR)
-            list.Add(&encoder->selfAtt[i].RPEmbK);
-        list.Add(&encoder->selfAtt[i].wo);
-        list.Add(&encoder->selfAtt[i].bo);
-        list.Add(&encoder->fnns[i].w1);
-        list.Add(&encoder->fnns[i].b1);
-        list.Add(&encoder->fnns[i].w2);
-        list.Add(&encoder->fnns[i].b2);
-        list.Add(&encoder->attLayerNorms[i].w);
-        list.Add(&encoder->attLayerNorms[i].b);
-        list.Add(&encoder->fnnLayerNorms[i].w);
-        list.Add(&encoder->fnnLayerNorms[i].b);
+            AddParam(list, &encoder->selfAtt[i].RPEmbK, "enc.%d.selfatt.rpembk", i);
+        AddParam(list, &encoder->selfAtt[i].wo, "enc.%d.selfatt.wo", i);
+        AddParam(list, &encoder->selfAtt[i].bo, "enc.%d.selfatt.bo", i);
+        AddParam(list, &encoder->fnns[i].w1, "enc.%d.fnn.w1", i);
+        AddParam(list, &encoder->fnns[i].b1, "enc.%d.fnn.b1", i);
+        AddParam(list, &encoder->fnns[i].w2, "enc.%d.fnn.w2", i);
+        AddParam(list, &encoder->fnns[i].b2, "enc.%d.fnn.b2", i);
+        AddParam(list, &encoder->attLayerNorms[i].w, "enc.%d.attln.w", i);
+        AddParam(list, &encoder->attLayerNorms[i].b, "enc.%d.attln.b", i);
+        AddParam(list, &encoder->fnnLayerNorms[i].w, "enc.%d.fnnln.w", i);
+        AddParam(list, &encoder->fnnLayerNorms[i].b, "enc.%d.fnnln.b", i);
     }
     if (encoder->preNorm) {
-        list.Add(&encoder->encoderLayerNorm->w);
-        list.Add(&encoder->encoderLayerNorm->b);
+        AddParam(list, &encoder->encoderLayerNorm->w, "enc.ln.w");
+        AddParam(list, &encoder->encoderLayerNorm->b, "enc.ln.b");
     }
 
     if (isMT) {
         /* decoder parameters */
         for (int i = 0; i < decoder->nlayer; i++) {
-            list.Add(&decoder->selfAtt[i].wq);
-            list.Add(&decoder->selfAtt[i].wk);
-            list.Add(&decoder->selfAtt[i].wv);
-            list.Add(&decoder->selfAtt[i].bq);
-            list.Add(&decoder->selfAtt[i].bk);
-            list.Add(&decoder->selfAtt[i].bv);
+            AddParam(list, &decoder->selfAtt[i].wq, "dec.%d.selfatt.wq", i);
+            AddParam(list, &decoder->selfAtt[i].wk, "dec.%d.selfatt.wk", i);
+            AddParam(list, &decoder->selfAtt[i].wv, "dec.%d.selfatt.wv", i);
+            AddParam(list, &decoder->selfAtt[i].bq, "dec.%d.selfatt.bq", i);
+            AddParam(list, &decoder->selfAtt[i].bk, "dec.%d.selfatt.bk", i);
+            AddParam(list, &decoder->selfAtt[i].bv, "dec.%d.selfatt.bv", i);
             if (decoder->selfAtt[i].useRPR)
-                list.Add(&decoder->selfAtt[i].RPEmbK);
-            list.Add(&decoder->selfAtt[i].wo);
-            list.Add(&decoder->selfAtt[i].bo);
-            list.Add(&decoder->selfAttLayerNorms[i].w);
-            list.Add(&decoder->selfAttLayerNorms[i].b);
-            list.Add(&decoder->enDeAtt[i].wq);
-            list.Add(&decoder->enDeAtt[i].wk);
-            list.Add(&decoder->enDeAtt[i].wv);
-            list.Add(&decoder->enDeAtt[i].bq);
-            list.Add(&decoder->enDeAtt[i].bk);
-            list.Add(&decoder->enDeAtt[i].bv);
-            list.Add(&decoder->enDeAtt[i].wo);
-            list.Add(&decoder->enDeAtt[i].bo);
-            list.Add(&decoder->enDeAttLayerNorms[i].w);
-            list.Add(&decoder->enDeAttLayerNorms[i].b);
-            list.Add(&decoder->fnns[i].w1);
-            list.Add(&decoder->fnns[i].b1);
-            list.Add(&decoder->fnns[i].w2);
-            list.Add(&decoder->fnns[i].b2);
-            list.Add(&decoder->fnnLayerNorms[i].w);
-            list.Add(&decoder->fnnLayerNorms[i].b);
+                AddParam(list, &decoder->selfAtt[i].RPEmbK, "dec.%d.selfatt.rpembk", i);
+            AddParam(list, &decoder->selfAtt[i].wo, "dec.%d.selfatt.wo", i);
+            AddParam(list, &decoder->selfAtt[i].bo, "dec.%d.selfatt.bo", i);
+            AddParam(list, &decoder->selfAttLayerNorms[i].w, "dec.%d.selfattln.w", i);
+            AddParam(list, &decoder->selfAttLayerNorms[i].b, "dec.%d.selfattln.b", i);
+            AddParam(list, &decoder->enDeAtt[i].wq, "dec.%d.endeatt.wq", i);
+            AddParam(list, &decoder->enDeAtt[i].wk, "dec.%d.endeatt.wk", i);
+            AddParam(list, &decoder->enDeAtt[i].wv, "dec.%d.endeatt.wv", i);
+            AddParam(list, &decoder->enDeAtt[i].bq, "dec.%d.endeatt.bq", i);
+            AddParam(list, &decoder->enDeAtt[i].bk, "dec.%d.endeatt.bk", i);
+            AddParam(list, &decoder->enDeAtt[i].bv, "dec.%d.endeatt.bv", i);
+            AddParam(list, &decoder->enDeAtt[i].wo, "dec.%d.endeatt.wo", i);
+            AddParam(list, &decoder->enDeAtt[i].bo, "dec.%d.endeatt.bo", i);
+            AddParam(list, &decoder->enDeAttLayerNorms[i].w, "dec.%d.endeattln.w", i);
+            AddParam(list, &decoder->enDeAttLayerNorms[i].b, "dec.%d.endeattln.b", i);
+            AddParam(list, &decoder->fnns[i].w1, "dec.%d.fnn.w1", i);
+            AddParam(list, &decoder->fnns[i].b1, "dec.%d.fnn.b1", i);
+            AddParam(list, &decoder->fnns[i].w2, "dec.%d.fnn.w2", i);
+            AddParam(list, &decoder->fnns[i].b2, "dec.%d.fnn.b2", i);
+            AddParam(list, &decoder->fnnLayerNorms[i].w, "dec.%d.fnnln.w", i);
+            AddParam(list, &decoder->fnnLayerNorms[i].b, "dec.%d.fnnln.b", i);
         }
         if (decoder->preNorm) {
-            list.Add(&decoder->decoderLayerNorm->w);
-            list.Add(&decoder->decoderLayerNorm->b);
+            AddParam(list, &decoder->decoderLayerNorm->w, "dec.ln.w");
+            AddParam(list, &decoder->decoderLayerNorm->b, "dec.ln.b");
         }
     }
 
-    list.Add(&encoder->embedder.w);
+    AddParam(list, &encoder->embedder.w, "enc.emb.w");
 
     if (isMT && (shareAllEmbeddings == 0)) {
-        list.Add(&decoder->embedder.w);
+        AddParam(list, &decoder->embedder.w, "dec.emb.w");
     }
 
     if (shareDecInputOutputWeight == 0)
-        list.Add(&outputLayer->w);
+        AddParam(list, &outputLayer->w, "output.w");
 }
 
 /*
@@ -431,9 +474,6 @@ void T2TModel::Dump(const char* fn)
 {
     double startT = GetClockSec();
 
-    FILE* file = fopen(fn, "wb");
-    CheckNTErrors(file, "Cannot open the model file");
-
     TensorList params(100);
 
     GetParams(params);
@@ -447,23 +487,32 @@ void T2TModel::Dump(const char* fn)
         shareDecInputOutputWeight, encoder->embedder.maxLength - 1 - 1,
     };
 
-    /* part 1: hyper-parameters */
-    fwrite(metaInfo, sizeof(int), sizeof(metaInfo) / sizeof(int), file);
-
-    /* part 2: model parameters */
-    for (int i = 0; i < params.Size(); i++) {
-        params[i]->BinaryDump(file);
-    }
-
-    fclose(file);
+    /* hyper-parameters as the meta info and then the named parameters */
+    XModelFile::Dump(fn, metaInfo, sizeof(metaInfo) / sizeof(int), &params);
 
     double elapsed = GetClockSec() - startT;
 
     XPRINT1(0, stderr, "[INFO] model saved (took %.1fs)\n", elapsed);
 }
 
-/* read the parameters */
+/* read the parameters (in the old format) */
 void T2TModel::Read(FILE* file)
+{
+    ReadParams(file, NULL);
+}
+
+/* read the parameters from a mapped model file */
+void T2TModel::Read(XModelFile* file)
+{
+    ReadParams(NULL, file);
+}
+
+/*
+read the parameters
+>> file - the model file in the old format (a list of data arrays)
+>> mapped - the model file mapped into memory (used if it is not NULL)
+*/
+void T2TModel::ReadParams(FILE* file, XModelFile* mapped)
 {
     double startT = GetClockSec();
 
@@ -483,8 +532,12 @@ void T2TModel::Read(FILE* file)
         decEmb = ConvertDataType(decEmb, X_FLOAT16);
     }
 
-    for (int i = 0; i < params.Size(); i++)
-        params[i]->BinaryRead(file);
+    for (int i = 0; i < params.Size(); i++) {
+        if (mapped != NULL)
+            mapped->Load(params[i]);
+        else
+            params[i]->BinaryRead(file);
+    }
 
     /* share all embeddings */
     if (shareAllEmbeddings == 1) {
@@ -498,8 +551,122 @@ void T2TModel::Read(FILE* file)
         XPRINT(0, stderr, "[INFO] sharing decoder embeddings with output weights\n");
     }
 
+    if (useInt8)
+        QuantizeInt8();
+    else if (useFP16Weight)
+        ConvertWeightsToFP16();
+
     double elapsed = GetClockSec() - startT;
     XPRINT1(0, stderr, "[INFO] model loaded (took %.1fs)\n", elapsed);
 }
 
-}
\ No newline at end of file
+/*
+quantize the weight matrices of the attention, fnn and output layers into
+8-bit integers. The FP32 matrices are freed after that, so the model can
+only be used for inference.
+*/
+void T2TModel::QuantizeInt8()
+{
+    CheckNTErrors(devID < 0, "INT8 inference is only supported on CPUs!");
+    CheckNTErrors(!useFP16, "INT8 inference cannot be used with FP16!");
+
+    for (int i = 0; i < encoder->nlayer; i++) {
+        encoder->selfAtt[i].QuantizeInt8();
+        encoder->fnns[i].QuantizeInt8();
+    }
+
+    if (isMT) {
+        for (int i = 0; i < decoder->nlayer; i++) {
+            decoder->selfAtt[i].QuantizeInt8();
+            decoder->enDeAtt[i].QuantizeInt8();
+            decoder->fnns[i].QuantizeInt8();
+        }
+    }
+
+    outputLayer->QuantizeInt8();
+
+    XPRINT(0, stderr, "[INFO] weight matrices are quantized into 8-bit integers\n");
+}
+
+/*
+keep the weight matrices of the attention, fnn and output layers in FP16.
+The computation is still in FP32 and the matrices are converted on the fly,
+so we save half of the memory bandwidth for inference on CPUs.
+*/
+void T2TModel::ConvertWeightsToFP16()
+{
+    CheckNTErrors(devID < 0, "FP16 weights are only supported on CPUs (please use -fp16 on GPUs)!");
+    CheckNTErrors(!useFP16, "FP16 weights cannot be used with FP16!");
+
+    for (int i = 0; i < encoder->nlayer; i++) {
+        encoder->selfAtt[i].ConvertWeightsToFP16();
+        encoder->fnns[i].ConvertWeightsToFP16();
+    }
+
+    if (isMT) {
+        for (int i = 0; i < decoder->nlayer; i++) {
+            decoder->selfAtt[i].ConvertWeightsToFP16();
+            decoder->enDeAtt[i].ConvertWeightsToFP16();
+            decoder->fnns[i].ConvertWeightsToFP16();
+        }
+    }
+
+    outputLayer->ConvertWeightsToFP16();
+
+    XPRINT(0, stderr, "[INFO] weight matrices are kept in FP16\n");
+}
+
+/* move an 8-bit weight matrix out of the memory pool */
+static void DetachInt8Weight(T2TInt8Weight& w)
+{
+    w.data.DetachFromMem();
+    w.scale.DetachFromMem();
+}
+
+/*
+move the parameters (and the other tensors of the model) out of the memory
+pool. The tensors computed from the parameters are then not created in the
+global pool either, and a number of threads can decode with the model at the
+same time, each of which has a pool of its own (see T2TDecodingState).
+*/
+void T2TModel::DetachFromMem()
+{
+    TensorList params(10);
+    GetParams(params);
+
+    for (int i = 0; i < params.Size(); i++)
+        params[i]->DetachFromMem();
+
+    encoder->embedder.posEmbeddingBase.DetachFromMem();
+    if (isMT)
+        decoder->embedder.posEmbeddingBase.DetachFromMem();
+
+    /* the 8-bit weight matrices */
+    for (int i = 0; i < encoder->nlayer; i++) {
+        DetachInt8Weight(encoder->selfAtt[i].wqInt8);
+        DetachInt8Weight(encoder->selfAtt[i].wkInt8);
+        DetachInt8Weight(encoder->selfAtt[i].wvInt8);
+        DetachInt8Weight(encoder->selfAtt[i].woInt8);
+        DetachInt8Weight(encoder->fnns[i].w1Int8);
+        DetachInt8Weight(encoder->fnns[i].w2Int8);
+    }
+
+    if (isMT) {
+        for (int i = 0; i < decoder->nlayer; i++) {
+            DetachInt8Weight(decoder->selfAtt[i].wqInt8);
+            DetachInt8Weight(decoder->selfAtt[i].wkInt8);
+            DetachInt8Weight(decoder->selfAtt[i].wvInt8);
+            DetachInt8Weight(decoder->selfAtt[i].woInt8);
+            DetachInt8Weight(decoder->enDeAtt[i].wqInt8);
+            DetachInt8Weight(decoder->enDeAtt[i].wkInt8);
+            DetachInt8Weight(decoder->enDeAtt[i].wvInt8);
+            DetachInt8Weight(decoder->enDeAtt[i].woInt8);
+            DetachInt8Weight(decoder->fnns[i].w1Int8);
+            DetachInt8Weight(decoder->fnns[i].w2Int8);
+        }
+    }
+
+    DetachInt8Weight(outputLayer->wInt8);
+}
+
+}
@@ -29,6 +29,7 @@
 #include "module/T2TOutput.h"
 #include "module/T2TUtility.h"
 #include "module/T2TAttention.h"
+#include "../../tensor/XModelFile.h"
 
 namespace transformer
 {
@@ -60,6 +61,12 @@ public:
     /* indicates whether the model is running with FP16 data type */
     bool useFP16;
 
+    /* indicates whether the weight matrices are quantized into 8-bit integers */
+    bool useInt8;
+
+    /* indicates whether the weight matrices are kept in FP16 (and computed in FP32) */
+    bool useFP16Weight;
+
     /* number of heads in the attention model */
     int nhead;
 
@@ -69,6 +76,9 @@ public:
     /* indicates whether share decoder embeddings with output weights */
     int shareDecInputOutputWeight;
 
+    /* the model file mapped into memory (the parameters on the CPU point to it) */
+    XModelFile* mappedFile;
+
 public:
     /* constructor */
     T2TModel();
@@ -87,11 +97,13 @@ public:
         XTensor& MaskEncDec, bool isTraining);
 
     /* make the network for language modeling (with the output softmax layer) */
-    void MakeLM(XTensor& input, XTensor& output, XTensor& padding, bool isTraining);
+    void MakeLM(XTensor& input, XTensor& output, XTensor& padding, bool isTraining,
+                bool isNormalized = true);
 
     /* make the network for machine translation (with the output softmax layer) */
     void MakeMT(XTensor& inputEnc, XTensor& inputDec, XTensor& output,
-        XTensor& paddingEnc, XTensor& paddingDec, bool isTraining);
+        XTensor& paddingEnc, XTensor& paddingDec, bool isTraining,
+        bool isNormalized = true);
 
     /* make the mask for training MT models */
     void MakeMTMask(XTensor& inputEnc, XTensor& inputDec,
@@ -111,8 +123,24 @@ public:
     /* dump the model to a file */
     void Dump(const char* fn);
 
-    /* read the parameters */
+    /* read the parameters (in the old format) */
     void Read(FILE* file);
+
+    /* read the parameters from a mapped model file */
+    void Read(XModelFile* file);
+
+    /* quantize the weight matrices into 8-bit integers (for inference) */
+    void QuantizeInt8();
+
+    /* keep the weight matrices in FP16 (for inference) */
+    void ConvertWeightsToFP16();
+
+    /* move the parameters out of the memory pool (for sharing the model by threads) */
+    void DetachFromMem();
+
+protected:
+    /* read the parameters */
+    void ReadParams(FILE* file, XModelFile* mapped);
 };
 
 }
@@ -27,9 +27,11 @@
 #include "train/T2TTrainer.h"
 #include "module/T2TUtility.h"
 #include "translate/T2TTranslator.h"
+#include "translate/T2TServer.h"
 #include "../../tensor/XDevice.h"
 #include "../../tensor/XGlobal.h"
 #include "../../tensor/XUtility.h"
+#include "../../tensor/XProfiler.h"
 
 namespace transformer
 {
@@ -42,8 +44,14 @@ int TransformerMain(int argc, const char** argv)
     /* load configurations */
     T2TConfig config(argc, argv);
 
+    SetThreadNum(config.nthread);
+
     srand((unsigned int)time(NULL));
 
+    /* time the ops (see XProfiler) */
+    if (strcmp(config.profileFN, "") != 0)
+        GProfiler.Start();
+
     /* train the model */
     if (strcmp(config.trainFN, "") != 0) {
         ENABLE_GRAD;
@@ -65,6 +73,22 @@ int TransformerMain(int argc, const char** argv)
                              config.tgtVocabFN, config.outputFN, &model);
     }
 
+    /* translate the sentences from the standard input (as a service) */
+    if (config.isServer) {
+        DISABLE_GRAD;
+        T2TModel model;
+        model.InitModel(config);
+        T2TServer server;
+        server.Init(config);
+        server.Run(&model);
+    }
+
+    if (GProfiler.isEnabled) {
+        GProfiler.Stop();
+        GProfiler.ShowStats(stderr);
+        GProfiler.DumpTrace(config.profileFN);
+    }
+
     return 0;
 }
 
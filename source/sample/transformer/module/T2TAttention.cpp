@@ -25,6 +25,7 @@
 #include "T2TUtility.h"
 #include "T2TAttention.h"
 #include "T2TEmbedding.h"
+#include "../../../tensor/XUtility.h"
 #include "../../../tensor/core/CHeader.h"
 
 namespace transformer
@@ -99,17 +100,17 @@ make the network
 XTensor T2TAttention::Make(XTensor& k, XTensor& q, XTensor& v, XTensor* mask,
                            bool isTraining, Cache* cache, int cacheType)
 {
-    const bool isEnc = (!cache) ? true : false;
+    const bool isEnc = (cacheType == NONE) ? true : false;
 
     /* linear transformation before self-attention */
     XTensor q2, k2, v2;
 
-    q2 = MulAndShift(q, wq, bq);
+    q2 = LinearTransform(q, wq, &bq, wqInt8);
 
     if (!cache || isTraining) {
         /* self attention for encoder layers */
-        k2 = MulAndShift(k, wk, bk);
-        v2 = MulAndShift(v, wv, bv);
+        k2 = LinearTransform(k, wk, &bk, wkInt8);
+        v2 = LinearTransform(v, wv, &bv, wvInt8);
 
         if (useRPR)
             return MakeRPRAttention(k2, q2, v2, mask, isTraining, isEnc);
@@ -118,8 +119,15 @@ XTensor T2TAttention::Make(XTensor& k, XTensor& q, XTensor& v, XTensor* mask,
 
     else {
         if (cacheType == SELF_ATT) {
-            k2 = MulAndShift(k, wk, bk);
-            v2 = MulAndShift(v, wv, bv);
+            k2 = LinearTransform(k, wk, &bk, wkInt8);
+            v2 = LinearTransform(v, wv, &bv, wvInt8);
+
+            /* write the new token into the preallocated buffers and attend
+               to the valid steps of them without copying the history */
+            if (cache->maxLength > 0 && !useRPR && k2.dataType == X_FLOAT) {
+                cache->Append(k2, v2, nhead);
+                return MakeCachedAttention(q2, cache, mask);
+            }
 
             /* if hit, we only concat the cache with the new token */
             if (!cache->miss) {
@@ -129,6 +137,7 @@ XTensor T2TAttention::Make(XTensor& k, XTensor& q, XTensor& v, XTensor* mask,
             cache->key = k2;
             cache->value = v2;
             cache->miss = false;
+            cache->useBuf = false;
 
             if (useRPR)
                 return MakeRPRAttention(cache->key, q2, cache->value, mask, isTraining, isEnc);
@@ -136,8 +145,8 @@ XTensor T2TAttention::Make(XTensor& k, XTensor& q, XTensor& v, XTensor* mask,
         }
         else if (cacheType == EN_DE_ATT) {
             if (cache->miss) {
-                cache->key = MulAndShift(k, wk, bk);
-                cache->value = MulAndShift(v, wv, bv);
+                cache->key = LinearTransform(k, wk, &bk, wkInt8);
+                cache->value = LinearTransform(v, wv, &bv, wvInt8);
                 cache->miss = false;
             }
 
@@ -164,10 +173,23 @@ XTensor T2TAttention::MakeAttention(XTensor& k, XTensor& q, XTensor& v,
 
     const auto dataType = k.dataType;
 
+    /* for inference on CPUs, the heads are views of the inputs and the
+       output, and the heads are split and merged without moving the data
+       (see View.h) */
+    bool useView = !isTraining && k.devID < 0 && dataType == X_FLOAT &&
+                   q.dataType == X_FLOAT && v.dataType == X_FLOAT;
+
     /* multi head */
-    kheads = Split(k, k.order - 1, nhead);
-    qheads = Split(q, q.order - 1, nhead);
-    vheads = Split(v, v.order - 1, nhead);
+    if (useView) {
+        kheads = SplitView(k, k.order - 1, nhead);
+        qheads = SplitView(q, q.order - 1, nhead);
+        vheads = SplitView(v, v.order - 1, nhead);
+    }
+    else {
+        kheads = Split(k, k.order - 1, nhead);
+        qheads = Split(q, q.order - 1, nhead);
+        vheads = Split(v, v.order - 1, nhead);
+    }
 
     XTensor att;
     XTensor dot;
@@ -194,6 +216,20 @@ XTensor T2TAttention::MakeAttention(XTensor& k, XTensor& q, XTensor& v,
     if (isTraining && dropoutP > 0)
         scalar = Dropout(scalar, dropoutP);
 
+    if (useView) {
+        /* each head of the output is written into its place in the
+           concatenated output */
+        int dims[MAX_TENSOR_DIM_NUM];
+        memcpy(dims, q.dimSize, sizeof(int) * q.order);
+        dims[q.order - 1] = v.dimSize[v.order - 1];
+        InitTensor(&att, q.order, dims, X_FLOAT, q.devID);
+
+        XTensor attHeads = SplitView(att, att.order - 1, nhead);
+        _MatrixMulBatched(&scalar, X_NOTRANS, &vheads, X_NOTRANS, &attHeads);
+
+        return LinearTransform(att, wo, &bo, woInt8);
+    }
+
     if (vheads.dataType != scalar.dataType)
         vheads = ConvertDataType(vheads, scalar.dataType);
 
@@ -203,7 +239,116 @@ XTensor T2TAttention::MakeAttention(XTensor& k, XTensor& q, XTensor& v,
         att = ConvertDataType(att, dataType);
 
     /* concatenate the heads */
-    return MulAndShift(Merge(att, att.order - 1), wo, bo);
+    return LinearTransform(Merge(att, att.order - 1), wo, &bo, woInt8);
+}
+
+/*
+batched matrix multiplication c_i = trans(a_i) * trans(b_i) * alpha where the i-th
+matrix of an array starts at i * stride (in units) rather than right after the
+(i-1)-th matrix. So we can multiply the leading rows of each block in the cache
+buffers without copying them.
+>> a - the data array of a
+>> aRow - number of rows of each matrix in a
+>> aCol - number of columns of each matrix in a
+>> aStride - distance between two neighbouring matrices in a
+>> transposedA - indicates whether the matrices in a are transposed
+>> b - the data array of b
+>> bRow - number of rows of each matrix in b
+>> bCol - number of columns of each matrix in b
+>> bStride - distance between two neighbouring matrices in b
+>> transposedB - indicates whether the matrices in b are transposed
+>> c - the data array of c
+>> cRow - number of rows of each matrix in c
+>> cCol - number of columns of each matrix in c
+>> count - number of matrices
+>> alpha - a coefficient
+>> devID - the device where the data is kept
+*/
+void StridedBMMul(const float* a, int aRow, int aCol, int aStride, MATRIX_TRANS_TYPE transposedA,
+                  const float* b, int bRow, int bCol, int bStride, MATRIX_TRANS_TYPE transposedB,
+                  float* c, int cRow, int cCol, int count, float alpha, int devID)
+{
+    int inner = transposedA == X_TRANS ? aRow : aCol;
+
+    CheckNTErrors(inner == (transposedB == X_TRANS ? bCol : bRow), "Unmatched matrices!");
+
+    if (devID >= 0) {
+#ifdef USE_CUDA
+        int devIDBackup = 0;
+        ProtectCudaDev(devID, devIDBackup);
+
+        cublasHandle_t* handle = GDevs.GetCudaHandle(devID);
+        _CudaBLASMatrixMULBatchedStrided(handle,
+                                         a, transposedA, X_FLOAT, aStride,
+                                         b, transposedB, X_FLOAT, bStride,
+                                         c, X_FLOAT, cRow * cCol, count,
+                                         aRow, aCol, bRow, bCol, cRow, cCol, alpha, 0);
+
+        BacktoCudaDev(devID, devIDBackup);
+#else
+        ShowNTErrors("Plesae specify USE_CUDA and recompile the code!");
+#endif
+        return;
+    }
+
+    int grain = MAX(1, PFOR_ELEMENT_GRAIN / MAX(cRow * cCol * inner, 1));
+    ParallelFor(0, count, grain, [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            NativeSGEMM(transposedA == X_TRANS, transposedB == X_TRANS, cRow, cCol, inner,
+                        alpha, a + (long long)i * aStride, aCol, b + (long long)i * bStride, bCol,
+                        0, c + (long long)i * cRow * cCol, cCol);
+        }
+    });
+}
+
+/*
+make the attention network with the keys and values kept in the preallocated
+cache (see Cache::Append). Unlike MakeAttention(), the keys and values are not
+split into heads on the fly but are read from the buffers in place.
+>> q - queries (after linear transformation), B * L * H
+>> cache - the cache that keeps the keys and values of the previous steps
+>> mask - as it is
+*/
+XTensor T2TAttention::MakeCachedAttention(XTensor& q, Cache* cache, XTensor* mask)
+{
+    CheckNTErrors(cache->useBuf, "The cache is not preallocated!");
+    CheckNTErrors(q.order == 3 && q.dimSize[0] == cache->batchSize, "Illegal query!");
+
+    const int lenQ = q.dimSize[1];
+    const int lenKV = cache->length;
+    const int headSize = cache->headSize;
+    const int blockNum = nhead * cache->batchSize;
+    const int bufStride = cache->maxLength * headSize;
+
+    XTensor qheads;
+    XTensor att;
+    XTensor dot;
+    XTensor scalar;
+
+    /* multi head, (K, B, L_q, H/K) */
+    qheads = Split(q, q.order - 1, nhead);
+
+    /* dot = Q * K^T, (K, B, L_q, L_kv) */
+    InitTensor4D(&dot, nhead, cache->batchSize, lenQ, lenKV, X_FLOAT, q.devID);
+    StridedBMMul((float*)qheads.data, lenQ, headSize, lenQ * headSize, X_NOTRANS,
+                 (float*)cache->keyBuf[cache->bufIndex].data, lenKV, headSize, bufStride, X_TRANS,
+                 (float*)dot.data, lenQ, lenKV, blockNum, 1.0F, q.devID);
+
+    if (mask)
+        dot = dot + (*mask);
+
+    dot = Linear(dot, 1.0F / (float)sqrt((float)dk / nhead));
+
+    scalar = Softmax(dot, -1);
+
+    /* att = scalar * V, (K, B, L_q, H/K) */
+    InitTensor4D(&att, nhead, cache->batchSize, lenQ, headSize, X_FLOAT, q.devID);
+    StridedBMMul((float*)scalar.data, lenQ, lenKV, lenQ * lenKV, X_NOTRANS,
+                 (float*)cache->valueBuf[cache->bufIndex].data, lenKV, headSize, bufStride, X_NOTRANS,
+                 (float*)att.data, lenQ, headSize, blockNum, 1.0F, q.devID);
+
+    /* concatenate the heads */
+    return LinearTransform(Merge(att, att.order - 1), wo, &bo, woInt8);
 }
 
 /*
@@ -275,7 +420,7 @@ XTensor T2TAttention::MakeRPRAttention(XTensor& k, XTensor& q, XTensor& v,
         att = ConvertDataType(att, dataType);
 
     /* concatenate the heads */
-    return MulAndShift(Merge(att, att.order - 1), wo, bo);
+    return LinearTransform(Merge(att, att.order - 1), wo, &bo, woInt8);
 }
 
 /*
@@ -356,10 +501,35 @@ XTensor T2TAttention::RPDotProduct(XTensor& x, XTensor& y, XTensor& z, const boo
     return Sum(context, relativeTrans);
 }
 
+/* quantize the weights into 8-bit integers (for inference on CPUs) */
+void T2TAttention::QuantizeInt8()
+{
+    wqInt8.Quantize(wq, X_NOTRANS);
+    wkInt8.Quantize(wk, X_NOTRANS);
+    wvInt8.Quantize(wv, X_NOTRANS);
+    woInt8.Quantize(wo, X_NOTRANS);
+}
+
+/* keep the weights in FP16 (for inference on CPUs) */
+void T2TAttention::ConvertWeightsToFP16()
+{
+    ConvertWeightToFP16(wq);
+    ConvertWeightToFP16(wk);
+    ConvertWeightToFP16(wv);
+    ConvertWeightToFP16(wo);
+}
+
 /* constructor */
 Cache::Cache()
 {
     miss = true;
+    useBuf = false;
+    bufIndex = 0;
+    maxLength = 0;
+    length = 0;
+    batchSize = 0;
+    nhead = 0;
+    headSize = 0;
 }
 
 /* update the states cache */
@@ -370,10 +540,160 @@ void Cache::Update(XTensor&& k, XTensor&& v)
     miss = false;
 }
 
+/*
+set the maximum length for the preallocated buffers. The buffers are
+(re-)allocated when we see the first step of the next batch.
+>> myMaxLength - the maximum number of steps (0 means no preallocation)
+*/
+void Cache::SetMaxLength(int myMaxLength)
+{
+    maxLength = myMaxLength > 0 ? myMaxLength : 0;
+}
+
+/*
+append the keys and values of a new step to the preallocated buffers. The
+buffers are allocated on cache miss and then filled in place step by step.
+>> k - keys of the new step, B * 1 * H
+>> v - values of the new step, B * 1 * H
+>> myHeadNum - number of heads
+*/
+void Cache::Append(XTensor& k, XTensor& v, int myHeadNum)
+{
+    CheckNTErrors(maxLength > 0, "No maximum length is specified for the cache!");
+    CheckNTErrors(k.order == 3 && k.dimSize[1] == 1, "Only one step is allowed!");
+    CheckNTErrors(_IsSameShaped(&k, &v), "Unmatched keys and values!");
+
+    if (miss) {
+        nhead = myHeadNum;
+        headSize = k.dimSize[2] / nhead;
+        batchSize = k.dimSize[0];
+        length = 0;
+        bufIndex = 0;
+
+        for (int i = 0; i < 2; i++) {
+            InitTensor4D(&keyBuf[i], nhead, batchSize, maxLength, headSize, k.dataType, k.devID);
+            InitTensor4D(&valueBuf[i], nhead, batchSize, maxLength, headSize, v.dataType, v.devID);
+        }
+
+        useBuf = true;
+        miss = false;
+    }
+
+    CheckNTErrors(k.dimSize[0] == batchSize, "Unmatched batch size!");
+
+    /* enlarge the buffers if they are full (this should rarely happen) */
+    if (length == maxLength) {
+        int newMaxLength = maxLength * 2;
+        int other = 1 - bufIndex;
+
+        InitTensor4D(&keyBuf[other], nhead, batchSize, newMaxLength, headSize, k.dataType, k.devID);
+        InitTensor4D(&valueBuf[other], nhead, batchSize, newMaxLength, headSize, v.dataType, v.devID);
+        CopyStates(keyBuf[bufIndex], keyBuf[other], NULL, batchSize, maxLength, newMaxLength);
+        CopyStates(valueBuf[bufIndex], valueBuf[other], NULL, batchSize, maxLength, newMaxLength);
+        InitTensor4D(&keyBuf[bufIndex], nhead, batchSize, newMaxLength, headSize, k.dataType, k.devID);
+        InitTensor4D(&valueBuf[bufIndex], nhead, batchSize, newMaxLength, headSize, v.dataType, v.devID);
+
+        bufIndex = other;
+        maxLength = newMaxLength;
+    }
+
+    /* (K, B, 1, H/K) */
+    XTensor kheads;
+    XTensor vheads;
+    kheads = Split(k, k.order - 1, nhead);
+    vheads = Split(v, v.order - 1, nhead);
+
+    /* the new step goes to row "length" of each block */
+    int blockNum = nhead * batchSize;
+    int* targetBlocks = new int[blockNum];
+    for (int i = 0; i < blockNum; i++)
+        targetBlocks[i] = i * maxLength + length;
+
+    int blockSize = headSize * k.unitSize;
+    _CopyBlocks(kheads.data, k.unitSize, blockSize, blockNum,
+                keyBuf[bufIndex].data, targetBlocks, NULL, k.devID);
+    _CopyBlocks(vheads.data, v.unitSize, blockSize, blockNum,
+                valueBuf[bufIndex].data, targetBlocks, NULL, v.devID);
+
+    delete[] targetBlocks;
+
+    length++;
+}
+
+/*
+copy the valid steps of some states from one buffer to another
+>> s - the source buffer
+>> t - the target buffer
+>> srcIndex - the source state of each target state (NULL means i -> i)
+>> num - number of target states
+>> sMaxLength - maximum length of the source buffer
+>> tMaxLength - maximum length of the target buffer
+*/
+void Cache::CopyStates(XTensor& s, XTensor& t, int* srcIndex, int num,
+                       int sMaxLength, int tMaxLength)
+{
+    if (length == 0 || num == 0)
+        return;
+
+    int blockNum = nhead * num * length;
+    int* sourceBlocks = new int[blockNum];
+    int* targetBlocks = new int[blockNum];
+
+    int n = 0;
+    for (int h = 0; h < nhead; h++) {
+        for (int b = 0; b < num; b++) {
+            int sb = h * batchSize + (srcIndex != NULL ? srcIndex[b] : b);
+            int tb = h * num + b;
+            for (int j = 0; j < length; j++) {
+                sourceBlocks[n] = sb * sMaxLength + j;
+                targetBlocks[n] = tb * tMaxLength + j;
+                n++;
+            }
+        }
+    }
+
+    _CopyBlocks(s.data, s.unitSize, headSize * s.unitSize, sourceBlocks, blockNum,
+                t.data, targetBlocks, NULL, s.devID);
+
+    delete[] sourceBlocks;
+    delete[] targetBlocks;
+}
+
+/*
+gather the states of the given indices into the other buffers and switch to them
+>> index - indices of the states we want (along the batch dimension)
+*/
+void Cache::GatherStates(XTensor& index)
+{
+    int num = index.unitNum;
+
+    CheckNTErrors(index.dataType == X_INT, "The index must be integers!");
+    CheckNTErrors(num <= keyBuf[bufIndex].dimSize[1], "Too many states for the cache!");
+
+    int* srcIndex = new int[num];
+    XMemCopy(srcIndex, -1, index.data, index.devID, num * sizeof(int));
+
+    for (int i = 0; i < num; i++)
+        CheckNTErrors(srcIndex[i] >= 0 && srcIndex[i] < batchSize, "Wrong index!");
+
+    int other = 1 - bufIndex;
+    CopyStates(keyBuf[bufIndex], keyBuf[other], srcIndex, num, maxLength, maxLength);
+    CopyStates(valueBuf[bufIndex], valueBuf[other], srcIndex, num, maxLength, maxLength);
+
+    delete[] srcIndex;
+
+    bufIndex = other;
+    batchSize = num;
+}
+
 /* keep alive states */
 void Cache::KeepAlive(XTensor& aliveIdx)
 {
     if (!miss) {
+        if (useBuf) {
+            GatherStates(aliveIdx);
+            return;
+        }
         key = AutoGather(key, aliveIdx);
         value = AutoGather(value, aliveIdx);
     }
@@ -383,8 +703,12 @@ void Cache::KeepAlive(XTensor& aliveIdx)
 void Cache::Reorder(XTensor& reorder)
 {
     if (!miss) {
+        if (useBuf) {
+            GatherStates(reorder);
+            return;
+        }
         key = AutoGather(key, reorder);
         value = AutoGather(value, reorder);
     }
 }
-}
\ No newline at end of file
+}
@@ -45,6 +45,36 @@ public:
     /* cache for values, (B, L, H) */
     XTensor value;
 
+    /* preallocated buffers of keys for incremental decoding, (K, B, M, H/K)
+       where K is the number of heads and M is the maximum length. We keep two
+       of them and switch to the other one when the states are reordered. */
+    XTensor keyBuf[2];
+
+    /* preallocated buffers of values, (K, B, M, H/K) */
+    XTensor valueBuf[2];
+
+    /* index of the buffer in use */
+    int bufIndex;
+
+    /* maximum number of steps we allocate the buffers for (0 means
+       we do not preallocate and the cache grows by concatenation) */
+    int maxLength;
+
+    /* number of steps kept in the buffers */
+    int length;
+
+    /* number of states (i.e., batch size) kept in the buffers */
+    int batchSize;
+
+    /* number of heads */
+    int nhead;
+
+    /* size of the vector of each head */
+    int headSize;
+
+    /* indicates whether the states are kept in the preallocated buffers */
+    bool useBuf;
+
 public:
 
     /* indicates cache miss if 'true' */
@@ -56,11 +86,25 @@ public:
     /* update the states cache */
     void Update(XTensor&& k, XTensor&& v);
 
+    /* set the maximum length for the preallocated buffers */
+    void SetMaxLength(int myMaxLength);
+
+    /* append the keys and values of a new step to the preallocated buffers */
+    void Append(XTensor& k, XTensor& v, int myHeadNum);
+
     /* keep alive states */
     void KeepAlive(XTensor& aliveIdx);
 
     /* reorder alive states */
     void Reorder(XTensor& reorder);
+
+protected:
+    /* gather the states of the given indices into the other buffers */
+    void GatherStates(XTensor& index);
+
+    /* copy the states from one buffer to another */
+    void CopyStates(XTensor& s, XTensor& t, int* srcIndex, int num,
+                    int sMaxLength, int tMaxLength);
 };
 
 /* multi-head attention */
@@ -104,6 +148,12 @@ public:
     /* bias after dot-product attention */
     XTensor bo;
 
+    /* 8-bit transformation matrices (for inference) */
+    T2TInt8Weight wqInt8;
+    T2TInt8Weight wkInt8;
+    T2TInt8Weight wvInt8;
+    T2TInt8Weight woInt8;
+
     /* size of transformed Q and K */
     int dk;
 
@@ -141,6 +191,9 @@ public:
     XTensor MakeAttention(XTensor& k, XTensor& q, XTensor& v,
                           XTensor* mask, bool isTraining);
 
+    /* make the attention network with the keys and values kept in the preallocated cache */
+    XTensor MakeCachedAttention(XTensor& q, Cache* cache, XTensor* mask);
+
     /* make the attention network given keys, queries and values (after linear transformation) */
     XTensor MakeRPRAttention(XTensor& k, XTensor& q, XTensor& v,
                              XTensor* mask, bool isTraining, bool isEnc);
@@ -148,6 +201,12 @@ public:
     XTensor GetRPEmbedding(const int lenQ, const int lenKV, const int maxRelativeLen, const bool isEnc);
 
     XTensor RPDotProduct(XTensor& x, XTensor& y, XTensor& z, const bool is_key);
+
+    /* quantize the weights into 8-bit integers */
+    void QuantizeInt8();
+
+    /* keep the weights in FP16 */
+    void ConvertWeightsToFP16();
 };
 }
 
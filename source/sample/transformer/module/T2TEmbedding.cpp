@@ -62,6 +62,10 @@ void T2TEmbedder::InitModel(T2TConfig& config, bool isEnc)
     DTYPE v = 1.0F / (float)sqrt((float)eSize);
     w.SetDataRandn(0, v);
 
+    /* only the rows of the words in a batch have gradients */
+    if (config.isTraining && config.useSparseGrad)
+        w.SetSparseGradFlag();
+
     /* create the positional embedding matrix */
     MakePosEmbedding(maxLength);
 }
@@ -84,13 +84,27 @@ XTensor T2TFNN::Make(XTensor& input, bool isTraining)
     XTensor t1;
 
     /* t1 = max(0, x * w1 + b1) */
-    t1 = Rectify(MulAndShift(input, w1, b1));
+    t1 = Rectify(LinearTransform(input, w1, &b1, w1Int8));
 
     if (isTraining && dropoutP > 0)
         t1 = Dropout(t1, dropoutP);
 
     /* result = t1 * w2 + b2 */
-    return MulAndShift(t1, w2, b2);
+    return LinearTransform(t1, w2, &b2, w2Int8);
+}
+
+/* quantize the weights into 8-bit integers (for inference on CPUs) */
+void T2TFNN::QuantizeInt8()
+{
+    w1Int8.Quantize(w1, X_NOTRANS);
+    w2Int8.Quantize(w2, X_NOTRANS);
+}
+
+/* keep the weights in FP16 (for inference on CPUs) */
+void T2TFNN::ConvertWeightsToFP16()
+{
+    ConvertWeightToFP16(w1);
+    ConvertWeightToFP16(w2);
 }
 
 }
\ No newline at end of file
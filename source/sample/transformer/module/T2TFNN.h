@@ -25,6 +25,7 @@
 
 #include "T2TUtility.h"
 #include "T2TLayerNormal.h"
+#include "T2TNNUtil.h"
 #include "../../../tensor/XTensor.h"
 
 using namespace nts;
@@ -60,6 +61,10 @@ public:
     /* bias of transformation 2 */
     XTensor b2;
 
+    /* 8-bit matrices of the transformations (for inference) */
+    T2TInt8Weight w1Int8;
+    T2TInt8Weight w2Int8;
+
     /* dropout probability */
     DTYPE dropoutP;
 
@@ -76,6 +81,12 @@ public:
 
     /* make the network */
     XTensor Make(XTensor& input, bool isTraining);
+
+    /* quantize the weights into 8-bit integers */
+    void QuantizeInt8();
+
+    /* keep the weights in FP16 */
+    void ConvertWeightsToFP16();
 };
 
 }
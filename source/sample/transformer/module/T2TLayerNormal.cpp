@@ -25,6 +25,7 @@
 #include "T2TEmbedding.h"
 #include "T2TLayerNormal.h"
 #include "../../../tensor/core/CHeader.h"
+#include "../../../tensor/function/FHeader.h"
 
 namespace transformer
 {
@@ -34,6 +35,7 @@ T2TLN::T2TLN()
 {
     devID = -1;
     d = 0;
+    eps = 1e-6F;
 }
 
 /* de-constructor */
@@ -66,45 +68,19 @@ make the network
 */
 XTensor T2TLN::Make(XTensor& input)
 {
-    XTensor& x = input;
-    XTensor xn;
-    XTensor mean;
-    XTensor variance;
-    XTensor standard;
-    XTensor meanFilled;
-    XTensor standardFilled;
-
     TENSOR_DATA_TYPE dataType = input.dataType;
 
     if (dataType == X_FLOAT16) {
-        /* reduce functions can only run with FP32 */
-        x = ConvertDataType(input, X_FLOAT);
-    }
-
-    /* \mu = (sum_i x_i)/m */
-    mean = ReduceMean(x, x.order - 1);
-
-    /* \sigma = (sum_i (x_i - \mu)^2)/m */
-    variance = ReduceVariance(x, x.order - 1, mean);
+        /* layer normalization can only run with FP32 */
+        XTensor x = ConvertDataType(input, X_FLOAT);
+        XTensor w32 = ConvertDataType(w, X_FLOAT);
+        XTensor b32 = ConvertDataType(b, X_FLOAT);
 
-    /* standard = sqrt(variance) */
-    standard = Power(variance, 0.5F);
-
-    /* unsqueeze mean and standard deviation to fit them into
-       the same shape of x */
-    meanFilled = Unsqueeze(mean, x.order - 1, x.GetDim(-1));
-    standardFilled = Unsqueeze(standard, x.order - 1, x.GetDim(-1));
-
-    /* x' = (x - \mu)/standard */
-    xn = (x - meanFilled) / standardFilled;
-
-    if (dataType != mean.dataType) {
-        x = ConvertDataType(x, dataType);
-        xn = ConvertDataType(xn, dataType);
+        return ConvertDataType(LayerNorm(x, w32, b32, eps), dataType);
     }
 
-    /* result = x' * w + b   */
-    return xn * w + b;
+    /* result = (x - \mu)/\sqrt{\sigma^2 + eps} * w + b */
+    return LayerNorm(input, w, b, eps);
 }
 
-}
\ No newline at end of file
+}
@@ -32,7 +32,7 @@ namespace transformer
 {
 
 /* layer normalization: y = norm(x) * w + b
-   where norm(x) = (x - mean)/standardDeviation */
+   where norm(x) = (x - mean)/sqrt(variance + eps) */
 class T2TLN
 {
 public:
@@ -48,6 +48,9 @@ public:
     /* dimension size of the model */
     int d;
 
+    /* a small number to avoid dividing by zero */
+    DTYPE eps;
+
 public:
     /* constructor */
     T2TLN();
@@ -57,4 +57,83 @@ XTensor AutoGather(XTensor& src, XTensor& index)
     }
 }
 
-}
\ No newline at end of file
+/* constructor */
+T2TInt8Weight::T2TInt8Weight()
+{
+    isQuantized = false;
+}
+
+/*
+quantize a weight matrix (symmetric, one scale for each output channel).
+The original matrix is not used any more and we free it to save memory.
+>> w - the weight matrix
+>> transposedW - indicates whether w is used in the transposed form
+*/
+void T2TInt8Weight::Quantize(XTensor& w, MATRIX_TRANS_TYPE transposedW)
+{
+    CheckNTErrors(w.devID < 0, "INT8 inference is only supported on CPUs!");
+
+    int k = transposedW == X_TRANS ? w.dimSize[1] : w.dimSize[0];
+    int n = transposedW == X_TRANS ? w.dimSize[0] : w.dimSize[1];
+
+    InitTensor2D(&data, n, k, X_INT8, w.devID);
+    InitTensor1D(&scale, n, X_FLOAT, w.devID);
+
+    _QuantizeInt8(&w, transposedW, &data, &scale);
+
+    w.DestroyData();
+    isQuantized = true;
+}
+
+/*
+keep a weight matrix in FP16. It halves the memory (and the memory bandwidth)
+of the weight, and the multiplication is still in FP32 (see MatrixMulFP16).
+>> w - the weight matrix
+*/
+void ConvertWeightToFP16(XTensor& w)
+{
+    CheckNTErrors(w.devID < 0, "FP16 weights are only supported on CPUs!");
+    CheckNTErrors(w.dataType == X_FLOAT, "The weight must be in FP32!");
+
+    int dims[MAX_TENSOR_DIM_NUM];
+    memcpy(dims, w.dimSize, sizeof(int) * w.order);
+
+    XTensor h;
+    InitTensorV2(&h, w.order, dims, X_FLOAT16, 1.0F, w.devID);
+    _ConvertDataType(&w, &h);
+
+    InitTensorV2(&w, w.order, dims, X_FLOAT16, 1.0F, w.devID);
+    _CopyValues(&h, &w);
+}
+
+/*
+y = x * w + b. We run the 8-bit multiplication if the weight is quantized,
+and convert the weight into FP32 on the fly if it is kept in FP16 on CPUs.
+>> x - the input tensor
+>> w - the weight matrix
+>> b - the bias (NULL means no bias)
+>> wInt8 - the quantized weight
+>> transposedW - indicates whether w is transposed
+<< return - the output tensor
+*/
+XTensor LinearTransform(const XTensor& x, const XTensor& w, const XTensor* b,
+                        const T2TInt8Weight& wInt8, MATRIX_TRANS_TYPE transposedW)
+{
+    if (wInt8.isQuantized)
+        return MatrixMulInt8(x, wInt8.data, wInt8.scale, b);
+
+    if (w.dataType == X_FLOAT16 && x.dataType == X_FLOAT && w.devID < 0)
+        return MatrixMulFP16(x, w, transposedW, b);
+
+    if (b != NULL && transposedW == X_NOTRANS)
+        return MulAndShift(x, w, *b);
+
+    XTensor y = MMul(x, X_NOTRANS, w, transposedW);
+
+    if (b != NULL)
+        y = y + *b;
+
+    return y;
+}
+
+}
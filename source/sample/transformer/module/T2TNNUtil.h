@@ -34,6 +34,34 @@ namespace transformer
 /* the gather function for tensor with any dimension */
 XTensor AutoGather(XTensor& src, XTensor& index);
 
+/* a weight matrix that is quantized into 8-bit integers (for inference on CPUs) */
+class T2TInt8Weight
+{
+public:
+    /* the quantized matrix (one row for each output channel) */
+    XTensor data;
+
+    /* the scale of each output channel */
+    XTensor scale;
+
+    /* indicates whether the weight is quantized */
+    bool isQuantized;
+
+public:
+    /* constructor */
+    T2TInt8Weight();
+
+    /* quantize a weight matrix and free the original one */
+    void Quantize(XTensor& w, MATRIX_TRANS_TYPE transposedW);
+};
+
+/* keep a weight matrix in FP16 (the computation is still in FP32, for inference on CPUs) */
+void ConvertWeightToFP16(XTensor& w);
+
+/* y = x * w + b (with the 8-bit weight if it is quantized, or the FP16 weight) */
+XTensor LinearTransform(const XTensor& x, const XTensor& w, const XTensor* b,
+                        const T2TInt8Weight& wInt8, MATRIX_TRANS_TYPE transposedW = X_NOTRANS);
+
 }
 
 #endif
\ No newline at end of file
@@ -21,6 +21,7 @@
  */
 
 #include <cmath>
+#include <cstring>
 
 #include "T2TOutput.h"
 #include "T2TUtility.h"
@@ -64,17 +65,25 @@ make the network (redefined output tensor)
 >> input - input tensor
 >> output - output tensor
 >> isTraining - whether it is used for training
->> normalized - whether ignore the log-softmax
+>> normalized - whether ignore the log-softmax (or the softmax in training)
+>> shortlist - the target words we score in inference (NULL means the whole vocabulary)
 */
-void T2TOutput::Make(XTensor& input, XTensor& output, bool isTraining, bool normalized)
+void T2TOutput::Make(XTensor& input, XTensor& output, bool isTraining, bool normalized,
+                     const T2TOutputShortlist* shortlist)
 {
     XTensor& x = input;
 
-    output = MMul(x, X_NOTRANS, w, X_TRANS);
+    /* only the words in the shortlist are scored in inference. So the
+       log-softmax (and top-k in search) runs over the shortlist, too */
+    if (!isTraining && shortlist != NULL && shortlist->words.count > 0)
+        output = LinearTransform(x, shortlist->w, NULL, shortlist->wInt8, X_TRANS);
+    else
+        output = LinearTransform(x, w, NULL, wInt8, X_TRANS);
 
-    /* use softmax for training */
+    /* use softmax for training (unless it is fused into the loss) */
     if (isTraining) {
-        output = Softmax(output, -1);
+        if (normalized)
+            output = Softmax(output, -1);
         return;
     }
 
@@ -91,4 +100,72 @@ void T2TOutput::Make(XTensor& input, XTensor& output, bool isTraining, bool norm
     }
 }
 
-}
\ No newline at end of file
+/* quantize the weights into 8-bit integers (for inference on CPUs) */
+void T2TOutput::QuantizeInt8()
+{
+    wInt8.Quantize(w, X_TRANS);
+}
+
+/* keep the weights in FP16 (for inference on CPUs) */
+void T2TOutput::ConvertWeightsToFP16()
+{
+    ConvertWeightToFP16(w);
+}
+
+/*
+restrict the output to a list of target words (for inference). We gather
+the rows of the transformation matrix once here and the output of Make()
+is then a distribution over the list, i.e., the i-th column of the output
+is for the word words[i]. The model itself is not changed, so a number of
+decoders can restrict it in different ways at the same time.
+>> words - the target words (ids)
+>> shortlist - the restricted output layer
+*/
+void T2TOutput::SetShortlist(const IntList& words, T2TOutputShortlist& shortlist) const
+{
+    int n = words.count;
+    CheckNTErrors(n > 0, "Empty shortlist!");
+
+    shortlist.words.Clear();
+    shortlist.words.Add(words.items, n);
+
+    if (wInt8.isQuantized) {
+        int k = wInt8.data.dimSize[1];
+
+        InitTensor2D(&shortlist.wInt8.data, n, k, X_INT8, devID);
+        InitTensor1D(&shortlist.wInt8.scale, n, X_FLOAT, devID);
+
+        char* src = (char*)wInt8.data.data;
+        char* tgt = (char*)shortlist.wInt8.data.data;
+        float* srcScale = (float*)wInt8.scale.data;
+        float* tgtScale = (float*)shortlist.wInt8.scale.data;
+
+        for (int i = 0; i < n; i++) {
+            CheckNTErrors(words[i] >= 0 && words[i] < vSize, "Illegal word in the shortlist!");
+            memcpy(tgt + (size_t)i * k, src + (size_t)words[i] * k, k);
+            tgtScale[i] = srcScale[words[i]];
+        }
+
+        shortlist.wInt8.isQuantized = true;
+    }
+    else {
+        XTensor index;
+        InitTensor1D(&index, n, X_INT, devID);
+        index.SetData(words.items, n);
+
+        InitTensor2D(&shortlist.w, n, hSize, w.dataType, devID);
+        _Gather(&w, &shortlist.w, &index);
+    }
+}
+
+/* go back to the whole vocabulary */
+void T2TOutputShortlist::Clear()
+{
+    words.Clear();
+    w.DestroyData();
+    wInt8.data.DestroyData();
+    wInt8.scale.DestroyData();
+    wInt8.isQuantized = false;
+}
+
+}
@@ -24,6 +24,7 @@
 #define __T2TOUTPUT_H__
 
 #include "T2TUtility.h"
+#include "T2TNNUtil.h"
 #include "../../../tensor/function/FHeader.h"
 
 using namespace nts;
@@ -31,6 +32,26 @@ using namespace nts;
 namespace transformer
 {
 
+/* the output layer restricted to a list of target words. It is a state of
+   decoding (one for each batch) and is made by T2TOutput::SetShortlist(). */
+class T2TOutputShortlist
+{
+public:
+    /* target words that the output layer covers. It is empty if we
+       use the whole vocabulary. */
+    IntList words;
+
+    /* rows of the transformation matrix for the words */
+    XTensor w;
+
+    /* rows of the 8-bit transformation matrix for the words */
+    T2TInt8Weight wInt8;
+
+public:
+    /* go back to the whole vocabulary */
+    void Clear();
+};
+
 /* output layer */
 class T2TOutput
 {
@@ -47,6 +68,9 @@ public:
     /* transformation matrix */
     XTensor w;
 
+    /* 8-bit transformation matrix (for inference) */
+    T2TInt8Weight wInt8;
+
 public:
     /* constructor */
     T2TOutput();
@@ -58,7 +82,17 @@ public:
     void InitModel(T2TConfig& config);
 
     /* make the network (redefined output tensor) */
-    void Make(XTensor& input, XTensor& output, bool isTraining, bool normalized);
+    void Make(XTensor& input, XTensor& output, bool isTraining, bool normalized,
+              const T2TOutputShortlist* shortlist = NULL);
+
+    /* quantize the weights into 8-bit integers */
+    void QuantizeInt8();
+
+    /* keep the weights in FP16 */
+    void ConvertWeightsToFP16();
+
+    /* restrict the output to a list of target words */
+    void SetShortlist(const IntList& words, T2TOutputShortlist& shortlist) const;
 };
 
 }
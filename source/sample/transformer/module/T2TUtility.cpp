@@ -84,6 +84,8 @@ T2TConfig::T2TConfig(int argc, const char** argv)
     LoadParamString(argsNum, args, "train", trainFN, "");
     LoadParamString(argsNum, args, "valid", validFN, "");
     LoadParamInt(argsNum, args, "dev", &devID, 0);
+    LoadParamInt(argsNum, args, "nthread", &nthread, 0);
+    LoadParamString(argsNum, args, "profile", profileFN, "");
     LoadParamInt(argsNum, args, "wbatch", &wBatchSize, 2048);
     LoadParamInt(argsNum, args, "sbatch", &sBatchSize, 1);
     isTraining = (strcmp(trainFN, "") == 0) ? false : true;
@@ -101,11 +103,17 @@ T2TConfig::T2TConfig(int argc, const char** argv)
     LoadParamFloat(argc, args, "adambeta1", &adamBeta1, 0.9F);
     LoadParamFloat(argc, args, "adambeta2", &adamBeta2, 0.98F);
     LoadParamFloat(argc, args, "adamdelta", &adamDelta, 1e-9F);
+    LoadParamFloat(argc, args, "weightdecay", &weightDecay, 0.0F);
+    LoadParamBool(argc, args, "flatparam", &useFlatParams, false);
+    LoadParamBool(argc, args, "sparsegrad", &useSparseGrad, false);
     LoadParamBool(argc, args, "shuffled", &isShuffled, true);
+    LoadParamInt(argc, args, "shuffleseed", &shuffleSeed, 1);
     LoadParamFloat(argc, args, "labelsmoothing", &labelSmoothingP, 0.1);
     LoadParamInt(argc, args, "nstepcheckpoint", &nStepCheckpoint, -1);
     LoadParamBool(argc, args, "epochcheckpoint", &useEpochCheckpoint, false);
     LoadParamInt(argc, args, "updatestep", &updateStep, 1);
+    LoadParamBool(argc, args, "checkpoint", &useGradCheckpoint, false);
+    LoadParamBool(argc, args, "releasedata", &releaseData, false);
     LoadParamBool(argc, args, "debug", &isDebugged, false);
     LoadParamBool(argc, args, "sorted", &isLenSorted, false);
 
@@ -115,14 +123,27 @@ T2TConfig::T2TConfig(int argc, const char** argv)
     LoadParamBool(argc, args, "bigbatch", &isBigBatch, false);
     LoadParamBool(argc, args, "randbatch", &isRandomBatch, false);
     LoadParamInt(argc, args, "bucketsize", &bucketSize, 0);
+    LoadParamString(argc, args, "buckets", bucketBounds, "");
+    LoadParamString(argc, args, "bucketwbatch", bucketWBatch, "");
+    LoadParamFloat(argc, args, "maxpadding", &maxPaddingRatio, 0.1F);
+    LoadParamInt(argc, args, "prefetch", &prefetchNum, 0);
 
     /* options for translating */
     LoadParamString(argsNum, args, "test", testFN, "");
     LoadParamString(argsNum, args, "output", outputFN, "");
     LoadParamInt(argsNum, args, "beamsize", &beamSize, 1);
     LoadParamBool(argsNum, args, "fp16", &useFP16, false);
+    LoadParamBool(argsNum, args, "int8", &useInt8, false);
+    LoadParamBool(argsNum, args, "fp16weight", &useFP16Weight, false);
     LoadParamFloat(argsNum, args, "lenalpha", &lenAlpha, 0.6);
     LoadParamFloat(argsNum, args, "maxlenalpha", &maxLenAlpha, 2.0);
+    LoadParamString(argsNum, args, "shortlist", shortlistFN, "");
+    LoadParamInt(argsNum, args, "shortlisttop", &shortlistTopN, 50);
+    LoadParamInt(argsNum, args, "shortlistfreq", &shortlistFreqN, 100);
+    LoadParamBool(argsNum, args, "server", &isServer, false);
+    LoadParamInt(argsNum, args, "serverworker", &serverWorkerNum, 1);
+    LoadParamFloat(argsNum, args, "serverdelay", &serverMaxDelay, 10.0F);
+    LoadParamBool(argsNum, args, "serverslab", &serverSlabMem, false);
 
     for (int i = 0; i < argc; i++)
         delete[] args[i];
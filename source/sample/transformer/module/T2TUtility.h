@@ -74,9 +74,15 @@ public:
     /* path to the validation file */
     char validFN[1024];
 
+    /* path to the timeline of the profiler (the profiler is off if it is empty) */
+    char profileFN[1024];
+
     /* device id */
     int devID;
 
+    /* number of CPU threads (0 means using all the cores) */
+    int nthread;
+
     /* beam size */
     int beamSize;
 
@@ -134,6 +140,12 @@ public:
     /* indicates whether the model is running with FP16 data type */
     bool useFP16;
 
+    /* indicates whether the weight matrices are quantized into 8-bit integers */
+    bool useInt8;
+
+    /* indicates whether the weight matrices are kept in FP16 (and computed in FP32) on CPUs */
+    bool useFP16Weight;
+
     /* indicates whether we use the RPR attention */
     bool useRPR;
 
@@ -152,6 +164,30 @@ public:
     /* the alpha parameter controls the length preference */
     float lenAlpha;
 
+    /* path to the lexical shortlist (for inference) */
+    char shortlistFN[1024];
+
+    /* number of candidates we take for each source word in the shortlist */
+    int shortlistTopN;
+
+    /* number of the most frequent target words that are always in the shortlist */
+    int shortlistFreqN;
+
+    /* indicates whether we translate the sentences from the standard input
+       as a service (see T2TServer) */
+    bool isServer;
+
+    /* number of the decoding workers of the service (only one on GPUs
+       because the workers would share the cuBLAS handle of the device) */
+    int serverWorkerNum;
+
+    /* the maximum time (in milliseconds) a sentence waits before it is batched */
+    float serverMaxDelay;
+
+    /* indicates whether the workers of the service share a memory pool
+       of slabs (SLAB_FREE) instead of having pools of their own */
+    bool serverSlabMem;
+
     /* scalar of the input sequence (for max number of search steps) */
     float maxLenAlpha;
 
@@ -175,12 +211,28 @@ public:
     float adamBeta2;
     float adamDelta;
 
+    /* the (decoupled) weight decay, i.e., AdamW if it is larger than 0 */
+    float weightDecay;
+
+    /* indicates whether we keep all the parameters, gradients and moments
+       in flat buffers (and update them in one sweep) */
+    bool useFlatParams;
+
+    /* indicates whether the gradients of the embedding matrices are kept
+       as the rows of the words in the batch (row-sparse gradients). Note
+       that the weight decay of these matrices is then applied to the rows
+       of the batch only (with Adam and SGD), rather than the whole matrix */
+    bool useSparseGrad;
+
     /* step number of warm-up for training */
     int nwarmup;
 
     /* indicates whether the data file is shuffled for training */
     bool isShuffled;
 
+    /* the seed for shuffling the training data */
+    int shuffleSeed;
+
     /* the factor of label smoothing */
     float labelSmoothingP;
 
@@ -193,6 +245,15 @@ public:
     /* number of batches on which we do model update */
     int updateStep;
 
+    /* indicates whether we re-compute each encoder/decoder layer in
+       back-propagation instead of keeping its intermediate results
+       (gradient checkpointing) */
+    bool useGradCheckpoint;
+
+    /* indicates whether the activations (and the gradients) of the
+       intermediate nodes are freed in back-propagation once they are of no use */
+    bool releaseData;
+
     /* indicates whether we intend to debug the net */
     bool isDebugged;
 
@@ -219,6 +280,22 @@ public:
     /* bucket size */
     int bucketSize;
 
+    /* upper bounds of the sentence lengths of the buckets, e.g., "16,32,64".
+       A batch is then made of the sentences in the same bucket (see
+       T2TBatchLoader::MakeBatchMT). It is empty if we do not use buckets. */
+    char bucketBounds[1024];
+
+    /* maximum number of words (including paddings) in a batch of each bucket,
+       e.g., "4096,4096,2048" (it is the word batch size if it is not given) */
+    char bucketWBatch[1024];
+
+    /* the maximum ratio of paddings in a batch of a bucket */
+    float maxPaddingRatio;
+
+    /* number of batches that are prepared in the background
+       (0 means that batches are loaded on the training thread) */
+    int prefetchNum;
+
 public:
 
     /* load configurations from the command */
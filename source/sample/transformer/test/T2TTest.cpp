@@ -0,0 +1,53 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "T2TTest.h"
+
+namespace transformer
+{
+
+/* test for the modules of the transformer sample */
+bool TestTransformer()
+{
+    bool wrong = false;
+    XPRINT(0, stdout, "Testing the transformer sample ... \n\n");
+
+    wrong = !TestAttention() || wrong;
+    wrong = !TestShortlist() || wrong;
+    wrong = !TestServer() || wrong;
+    wrong = !TestBatchLoader() || wrong;
+
+    /* other test */
+    /*
+    TODO!!
+    */
+
+    if (wrong) {
+        XPRINT(0, stdout, "Something goes wrong in the transformer sample! Please check the code!\n");
+        return false;
+    }
+    else {
+        XPRINT(0, stdout, "OK! Everything is good in the transformer sample!\n");
+        return true;
+    }
+}
+
+}
@@ -0,0 +1,133 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "../../../tensor/XUtility.h"
+#include "TAttention.h"
+
+namespace transformer
+{
+
+/*
+case 1: decode step by step with the preallocated cache (Cache::Append() and
+MakeCachedAttention()) and with the cache that grows by concatenation
+(Concatenate() and MakeAttention()). The outputs are the same at every step,
+also after the states are reordered (with a repeated state), after some
+states are removed (KeepAlive()) and when the buffers are full and doubled.
+*/
+bool TestAttention1()
+{
+    bool ok = true;
+    int batchSize = 3;
+    int modelSize = 16;
+    int stepNum = 7;
+
+    const char * args[] = {"-dev", "-1", "-nhead", "4", "-modelsize", "16"};
+    T2TConfig config(6, args);
+
+    T2TAttention att;
+    att.InitModel(config);
+
+    /* the buffers are for 2 steps, so they are doubled at step 2 and 4 */
+    Cache bufCache;
+    Cache catCache;
+    bufCache.SetMaxLength(2);
+
+    int reorderIDs[3] = {2, 0, 2};
+    int aliveIDs[2] = {0, 2};
+
+    for (int step = 0; step < stepNum && ok; step++) {
+
+        /* reorder the states (e.g., for beam search) */
+        if (step == 2) {
+            XTensor reorder;
+            InitTensor1D(&reorder, 3, X_INT);
+            reorder.SetData(reorderIDs, 3);
+            bufCache.Reorder(reorder);
+            catCache.Reorder(reorder);
+        }
+
+        /* remove a finished state */
+        if (step == 4) {
+            XTensor alive;
+            InitTensor1D(&alive, 2, X_INT);
+            alive.SetData(aliveIDs, 2);
+            bufCache.KeepAlive(alive);
+            catCache.KeepAlive(alive);
+            batchSize = 2;
+        }
+
+        XTensor x;
+        XTensor y1;
+        XTensor y2;
+        InitTensor3D(&x, batchSize, 1, modelSize);
+        x.SetDataRand(-1.0F, 1.0F);
+
+        y1 = att.Make(x, x, x, NULL, false, &bufCache, SELF_ATT);
+        y2 = att.Make(x, x, x, NULL, false, &catCache, SELF_ATT);
+
+        ok = ok && bufCache.useBuf && !catCache.useBuf;
+        ok = ok && _IsSameShaped(&y1, &y2);
+        ok = ok && _CheckData(&y1, y2.data, y1.unitNum, 1e-4F);
+    }
+
+    ok = ok && bufCache.length == stepNum && bufCache.maxLength == 8;
+    ok = ok && bufCache.batchSize == 2;
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the attention with the decoder cache */
+bool TestAttention()
+{
+    XPRINT(0, stdout, "[TEST Attention] the decoder self-attention with the preallocated cache \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestAttention1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+}
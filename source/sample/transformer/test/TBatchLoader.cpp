@@ -0,0 +1,232 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <stdio.h>
+#include "../../../tensor/XUtility.h"
+#include "TBatchLoader.h"
+
+namespace transformer
+{
+
+/* the corpus we make batches from in the test */
+#define TEST_CORPUS_FILE "batchloader.test.tmp"
+
+/* number of sentence pairs in the corpus */
+#define TEST_PAIR_NUM 60
+
+/* length of the source sentence of pair i (every length pair occurs three times) */
+static int SrcLength(int i)
+{
+    return 1 + (i % 20 * 7) % 13;
+}
+
+/* length of the target sentence of pair i (with the start and end symbols) */
+static int TgtLength(int i)
+{
+    return 2 + (i % 20 * 5) % 11;
+}
+
+/*
+write the corpus. Every word of pair i is i + 10, so that we know which
+pair a row of a batch comes from.
+*/
+static void WriteCorpus()
+{
+    FILE * file = fopen(TEST_CORPUS_FILE, "wb");
+    CheckNTErrors(file, "Cannot create the test file!");
+
+    for (int i = 0; i < TEST_PAIR_NUM; i++) {
+        for (int j = 0; j < SrcLength(i); j++)
+            fprintf(file, "%d ", i + 10);
+        fprintf(file, "|||");
+        for (int j = 0; j < TgtLength(i); j++)
+            fprintf(file, " %d", i + 10);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+}
+
+/*
+make batches by the length buckets and check them. Every pair is in exactly
+one batch, the pairs of a batch are in the same bucket, and a batch of more
+than one pair is within the word budget of its bucket and the maximum ratio
+of paddings.
+>> maxPadding - the maximum ratio of paddings (-maxpadding)
+>> batchNum - number of the batches
+<< return - whether the batches are right
+*/
+static bool CheckBucketBatches(const char * maxPadding, int &batchNum)
+{
+    bool ok = true;
+    int wBatch = 4096;
+    int seen[TEST_PAIR_NUM] = {0};
+
+    const char * args[] = {"-buckets", "4,8", "-bucketwbatch", "16,24,48",
+                           "-maxpadding", maxPadding};
+    T2TConfig config(6, args);
+
+    T2TBatchLoader loader;
+    loader.Init(config);
+
+    FILE * file = fopen(TEST_CORPUS_FILE, "rb");
+    CheckNTErrors(file, "Cannot open the test file!");
+
+    batchNum = 0;
+    T2TBatchData * data = &loader.hostBatch;
+
+    while (ok && loader.MakeBatchMT(file, data, NULL, 1, wBatch, false) > 0) {
+        int sCount = data->sCount;
+        int bucket = -1;
+        int words = 0;
+        int maxEnc = 0;
+        int maxDec = 0;
+
+        for (int s = 0; s < sCount && ok; s++) {
+            int i = data->batchEnc[s * data->maxEnc] - 10;
+            ok = ok && i >= 0 && i < TEST_PAIR_NUM;
+            if (!ok)
+                break;
+
+            int b = loader.GetBucket(MAX(SrcLength(i), TgtLength(i)));
+            ok = ok && (bucket < 0 || b == bucket);
+            bucket = b;
+
+            seen[i]++;
+            words += SrcLength(i) + TgtLength(i) - 1;
+            maxEnc = MAX(maxEnc, SrcLength(i));
+            maxDec = MAX(maxDec, TgtLength(i) - 1);
+        }
+
+        ok = ok && data->maxEnc == maxEnc && data->maxDec == maxDec;
+
+        if (ok && sCount > 1) {
+            int budget = loader.bucketWBatch[bucket];
+            float padding = 1.0F - (float)words / (sCount * (maxEnc + maxDec));
+
+            ok = ok && sCount * maxEnc <= budget && sCount * maxDec <= budget;
+            ok = ok && padding <= loader.maxPaddingRatio + 1e-6F;
+        }
+
+        batchNum++;
+    }
+
+    fclose(file);
+
+    for (int i = 0; i < TEST_PAIR_NUM; i++)
+        ok = ok && seen[i] == 1;
+
+    return ok;
+}
+
+/*
+case 1: the bucket of a sentence pair is the first one whose upper bound is
+not smaller than the length, or the last one (for the longer sentences).
+*/
+bool TestBatchLoader1()
+{
+    bool ok = true;
+
+    const char * args[] = {"-buckets", "4,8"};
+    T2TConfig config(2, args);
+
+    T2TBatchLoader loader;
+    loader.Init(config);
+
+    ok = ok && loader.bucketBounds.count == 2;
+    ok = ok && loader.GetBucket(1) == 0 && loader.GetBucket(4) == 0;
+    ok = ok && loader.GetBucket(5) == 1 && loader.GetBucket(8) == 1;
+    ok = ok && loader.GetBucket(9) == 2 && loader.GetBucket(1000) == 2;
+
+    return ok;
+}
+
+/*
+case 2: make batches of a small corpus by the length buckets (-buckets 4,8
+-bucketwbatch 16,24,48). The batches respect the buckets, the word budget
+of each bucket and the ratio of paddings (-maxpadding 0.5), and most of them
+have more than one pair. With -maxpadding 0 the pairs of a batch have the
+same lengths on both sides.
+*/
+bool TestBatchLoader2()
+{
+    bool ok = true;
+    int batchNum = 0;
+
+    WriteCorpus();
+
+    ok = ok && CheckBucketBatches("0.5", batchNum);
+    ok = ok && batchNum > 0 && batchNum < TEST_PAIR_NUM / 2;
+
+    ok = ok && CheckBucketBatches("0", batchNum);
+    ok = ok && batchNum > 0 && batchNum < TEST_PAIR_NUM;
+
+    remove(TEST_CORPUS_FILE);
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the batches made by the length buckets */
+bool TestBatchLoader()
+{
+    XPRINT(0, stdout, "[TEST BatchLoader] the batches made by the length buckets \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestBatchLoader1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestBatchLoader2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+}
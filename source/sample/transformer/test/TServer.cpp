@@ -0,0 +1,225 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <math.h>
+#include <algorithm>
+#include "../../../tensor/XUtility.h"
+#include "TServer.h"
+
+namespace transformer
+{
+
+/* the service with the batching and the statistics open to the test */
+class TestableServer : public T2TServer
+{
+public:
+    using T2TServer::TakeBatch;
+    using T2TServer::AddLatency;
+    using T2TServer::GetLatency;
+};
+
+/*
+add a request to the pending queue of a service
+>> server - the service
+>> id - id of the request
+>> len - number of words in the request
+<< return - the request
+*/
+static T2TRequest* AddRequest(T2TServer& server, int id, int len)
+{
+    T2TRequest* request = new T2TRequest;
+    request->id = id;
+    request->arrivalTime = GetClockSec();
+    request->finishTime = 0;
+    request->isDone = false;
+    for (int i = 0; i < len; i++)
+        request->words.Add(4 + i);
+
+    server.pending.push_back(request);
+    server.pendingWordNum += len;
+
+    return request;
+}
+
+/*
+check the ids of the requests in a batch
+>> batch - the batch
+>> ids - the ids we expect (in order)
+>> num - number of the ids
+<< return - whether the batch has the requests
+*/
+static bool CheckBatch(vector<T2TRequest*>& batch, const int* ids, int num)
+{
+    if ((int)batch.size() != num)
+        return false;
+    for (int i = 0; i < num; i++) {
+        if (batch[i]->id != ids[i])
+            return false;
+    }
+    return true;
+}
+
+/*
+case 1: take batches from the pending requests. A batch is taken as soon as
+the pending words reach the word budget (-wbatch). It starts with the oldest
+request and takes the requests of the closest lengths as long as the padded
+batch is within the budget. A request longer than the budget makes a batch of
+its own, a request waits until its deadline when there are not enough words,
+and nothing is left to take once the input is closed.
+*/
+bool TestServer1()
+{
+    bool ok = true;
+    vector<T2TRequest*> all;
+    vector<T2TRequest*> batch;
+
+    TestableServer server;
+    server.wordBatch = 12;
+    server.maxDelay = 100.0;
+
+    /* lengths 4, 9, 3, 5 and 4. With the oldest one (4), the closest are
+       4 (id 4), 3 (id 2) and 5 (id 3), and 4 * 3 = 12 words fit the budget
+       while 5 * 4 = 20 words do not */
+    int lens[5] = {4, 9, 3, 5, 4};
+    for (int i = 0; i < 5; i++)
+        all.push_back(AddRequest(server, i, lens[i]));
+
+    int batch1[3] = {0, 4, 2};
+    ok = ok && server.TakeBatch(batch) && CheckBatch(batch, batch1, 3);
+    ok = ok && server.pending.size() == 2 && server.pendingWordNum == 14;
+
+    /* the next oldest (9) cannot be batched with 5 in 12 words */
+    int batch2[1] = {1};
+    ok = ok && server.TakeBatch(batch) && CheckBatch(batch, batch2, 1);
+    ok = ok && server.pending.size() == 1 && server.pendingWordNum == 5;
+
+    /* a sentence of 20 words is over the budget but still translated */
+    all.push_back(AddRequest(server, 5, 20));
+    int batch3[1] = {3};
+    int batch4[1] = {5};
+    ok = ok && server.TakeBatch(batch) && CheckBatch(batch, batch3, 1);
+    ok = ok && server.TakeBatch(batch) && CheckBatch(batch, batch4, 1);
+    ok = ok && server.pending.empty() && server.pendingWordNum == 0;
+
+    /* 3 words are fewer than the budget, so we wait for the deadline */
+    server.maxDelay = 0.05;
+    all.push_back(AddRequest(server, 6, 3));
+    double startT = GetClockSec();
+    int batch5[1] = {6};
+    ok = ok && server.TakeBatch(batch) && CheckBatch(batch, batch5, 1);
+    ok = ok && GetClockSec() - startT >= 0.04;
+
+    /* nothing to take after the input is closed */
+    server.isClosed = true;
+    ok = ok && !server.TakeBatch(batch) && batch.empty();
+
+    for (size_t i = 0; i < all.size(); i++)
+        delete all[i];
+
+    return ok;
+}
+
+/*
+case 2: compute the percentiles of a known set of latencies (1ms, 2ms, ...,
+100ms, in a random order) from the histogram. Each of them is no smaller than
+the real percentile and at most SERVER_LATENCY_GROWTH times of it, and it is
+never bigger than the maximum latency.
+*/
+bool TestServer2()
+{
+    bool ok = true;
+    int num = 100;
+    double* latencies = new double[num];
+
+    TestableServer server;
+
+    for (int i = 0; i < num; i++)
+        latencies[i] = (i + 1) * 0.001;
+
+    /* add them in a shuffled order */
+    for (int i = 0; i < num; i++)
+        server.AddLatency(latencies[(i * 37) % num]);
+    server.outputNum = num;
+
+    ok = ok && fabs(server.maxLatency - 0.1) < 1e-12;
+
+    int percents[5] = {0, 50, 90, 99, 100};
+    for (int i = 0; i < 5; i++) {
+        int rank = MIN(num - 1, num * percents[i] / 100);
+        double answer = latencies[rank];
+        double latency = server.GetLatency(percents[i]);
+
+        ok = ok && latency >= answer * (1 - 1e-9);
+        ok = ok && latency <= answer * SERVER_LATENCY_GROWTH * (1 + 1e-9);
+        ok = ok && latency <= server.maxLatency;
+    }
+
+    delete[] latencies;
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the batching and the latency statistics of the translation service */
+bool TestServer()
+{
+    XPRINT(0, stdout, "[TEST Server] the batching and the latency statistics of the translation service \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestServer1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestServer2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+}
@@ -0,0 +1,207 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "../../../tensor/XUtility.h"
+#include "TShortlist.h"
+
+namespace transformer
+{
+
+/* the shortlist table we load in the test */
+#define TEST_SHORTLIST_FILE "shortlist.test.tmp"
+
+/*
+compare the output of the shortlist with the full output layer
+>> full - the output over the whole vocabulary (rowNum * vSize)
+>> part - the output over the shortlist (rowNum * n)
+>> words - the target words of the shortlist
+>> normalized - indicates whether the outputs are log-softmax scores
+<< return - whether column i of "part" matches column words[i] of "full"
+*/
+static bool CheckShortlistOutput(XTensor &full, XTensor &part, IntList &words, bool normalized)
+{
+    int rowNum = full.GetDim(0);
+    int vSize = full.GetDim(1);
+    int n = words.count;
+
+    if (part.GetDim(0) != rowNum || part.GetDim(1) != n)
+        return false;
+
+    DTYPE * f = (DTYPE*)full.data;
+    DTYPE * p = (DTYPE*)part.data;
+
+    for (int i = 0; i < rowNum; i++) {
+        /* log of the probability mass of the shortlist (in the full softmax) */
+        double logZ = 0;
+        if (normalized) {
+            double z = 0;
+            for (int j = 0; j < n; j++)
+                z += exp((double)f[i * vSize + words[j]]);
+            logZ = log(z);
+        }
+
+        /* the best word in the shortlist */
+        int best = 0;
+        int bestFull = words[0];
+
+        for (int j = 0; j < n; j++) {
+            double answer = f[i * vSize + words[j]] - logZ;
+            if (fabs(answer - p[i * n + j]) > 1e-4)
+                return false;
+
+            if (p[i * n + j] > p[i * n + best])
+                best = j;
+            if (f[i * vSize + words[j]] > f[i * vSize + bestFull])
+                bestFull = words[j];
+        }
+
+        /* an offset in the shortlist maps back to the word in the vocabulary */
+        if (words[best] != bestFull)
+            return false;
+    }
+
+    return true;
+}
+
+/*
+case 1: make a shortlist from a table and a batch of source sentences.
+The list has the frequent words, the start and end symbols and the top-N
+candidates of the words in the batch (except the paddings). The output
+layer restricted to the list gives the matching columns of the full output
+(and the log-softmax over the list is the full softmax renormalized over
+the list), both with the FP32 weight and with the 8-bit weight.
+*/
+bool TestShortlist1()
+{
+    bool ok = true;
+    int srcVocabSize = 8;
+    int tgtVocabSize = 12;
+    int hSize = 6;
+    int rowNum = 3;
+
+    /* the table: src-id tgt-id1 tgt-id2 ... */
+    FILE * file = fopen(TEST_SHORTLIST_FILE, "wb");
+    CheckNTErrors(file, "Cannot create the test file!");
+    fprintf(file, "3 7 9 5\n");
+    fprintf(file, "4 6\n");
+    fprintf(file, "1 11 10\n");
+    fprintf(file, "6 8 11\n");
+    fclose(file);
+
+    T2TShortlist table;
+    table.srcVocabSize = srcVocabSize;
+    table.tgtVocabSize = tgtVocabSize;
+    table.topN = 2;
+    table.freqN = 2;
+    table.padID = 1;
+    table.startID = 2;
+    table.endID = 2;
+    table.Load(TEST_SHORTLIST_FILE);
+    remove(TEST_SHORTLIST_FILE);
+
+    /* a batch of source words (1 is the padding) */
+    int src[6] = {3, 4, 0, 4, 1, 1};
+    XTensor batchEnc;
+    InitTensor2D(&batchEnc, 2, 3, X_INT);
+    batchEnc.SetData(src, 6);
+
+    IntList words;
+    table.Make(batchEnc, words);
+
+    int answer[6] = {0, 1, 2, 6, 7, 9};
+    ok = ok && words.count == 6;
+    for (int i = 0; i < words.count && ok; i++)
+        ok = ok && words[i] == answer[i];
+
+    /* the output layer */
+    T2TOutput output;
+    output.devID = -1;
+    output.vSize = tgtVocabSize;
+    output.hSize = hSize;
+    InitTensor2D(&output.w, tgtVocabSize, hSize);
+    output.w.SetDataRand(-1.0F, 1.0F);
+
+    XTensor x;
+    InitTensor2D(&x, rowNum, hSize);
+    x.SetDataRand(-1.0F, 1.0F);
+
+    for (int q = 0; q < 2 && ok; q++) {
+        /* the 8-bit weight in the second round */
+        if (q == 1)
+            output.QuantizeInt8();
+
+        T2TOutputShortlist shortlist;
+        output.SetShortlist(words, shortlist);
+
+        for (int k = 0; k < 2 && ok; k++) {
+            bool normalized = k == 1;
+            XTensor full;
+            XTensor part;
+
+            output.Make(x, full, false, normalized);
+            output.Make(x, part, false, normalized, &shortlist);
+
+            ok = ok && CheckShortlistOutput(full, part, shortlist.words, normalized);
+        }
+    }
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the lexical shortlist of the transformer output layer */
+bool TestShortlist()
+{
+    XPRINT(0, stdout, "[TEST Shortlist] the output layer restricted to a lexical shortlist \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestShortlist1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+}
@@ -28,6 +28,73 @@
 namespace transformer
 {
 
+/* allocate a host buffer (page-locked if we copy it to GPUs) */
+static void* AllocHostBuffer(size_t size)
+{
+#ifdef USE_CUDA
+    void* p = NULL;
+    if (cudaMallocHost(&p, size) == cudaSuccess)
+        return p;
+#endif
+    return malloc(size);
+}
+
+/* free a host buffer */
+static void FreeHostBuffer(void* p)
+{
+    if (p == NULL)
+        return;
+#ifdef USE_CUDA
+    if (cudaFreeHost(p) == cudaSuccess)
+        return;
+#endif
+    free(p);
+}
+
+/* initialize a host batch */
+static void InitBatchData(T2TBatchData* data)
+{
+    memset(data, 0, sizeof(T2TBatchData));
+}
+
+/* release the buffers of a host batch */
+static void FreeBatchData(T2TBatchData* data)
+{
+    FreeHostBuffer(data->batchEnc);
+    FreeHostBuffer(data->paddingEnc);
+    FreeHostBuffer(data->batchDec);
+    FreeHostBuffer(data->paddingDec);
+    FreeHostBuffer(data->label);
+    InitBatchData(data);
+}
+
+/*
+make sure that a host batch can keep the given number of items
+>> data - the host batch
+>> sizeEnc - number of items on the encoder side
+>> sizeDec - number of items on the decoder side
+*/
+static void ResizeBatchData(T2TBatchData* data, int sizeEnc, int sizeDec)
+{
+    if (sizeEnc > data->capacityEnc) {
+        FreeHostBuffer(data->batchEnc);
+        FreeHostBuffer(data->paddingEnc);
+        data->batchEnc = (int*)AllocHostBuffer(sizeof(int) * sizeEnc);
+        data->paddingEnc = (float*)AllocHostBuffer(sizeof(float) * sizeEnc);
+        data->capacityEnc = sizeEnc;
+    }
+
+    if (sizeDec > data->capacityDec) {
+        FreeHostBuffer(data->batchDec);
+        FreeHostBuffer(data->paddingDec);
+        FreeHostBuffer(data->label);
+        data->batchDec = (int*)AllocHostBuffer(sizeof(int) * sizeDec);
+        data->paddingDec = (float*)AllocHostBuffer(sizeof(float) * sizeDec);
+        data->label = (int*)AllocHostBuffer(sizeof(int) * sizeDec);
+        data->capacityDec = sizeDec;
+    }
+}
+
 /* constructor */
 T2TBatchLoader::T2TBatchLoader()
 {
@@ -42,6 +109,20 @@ T2TBatchLoader::T2TBatchLoader()
     bufSize = 0;
     bufBatchSize = 0;
     seqOffset = NULL;
+    line = NULL;
+    prefetchNum = 0;
+    isPrefetching = false;
+    slots = NULL;
+    readyHead = 0;
+    readyNum = 0;
+    isPrefetchDone = false;
+    toStopPrefetch = false;
+    prefetchFile = NULL;
+    prefetchSBatch = 0;
+    prefetchWBatch = 0;
+    prefetchIsSorted = false;
+    randState = 1;
+    InitBatchData(&hostBatch);
 }
 
 /* de-constructor */
@@ -53,6 +134,16 @@ T2TBatchLoader::~T2TBatchLoader()
     delete[] seqLen;
     delete[] seqLen2;
     delete[] seqOffset;
+    delete[] line;
+
+    StopPrefetch();
+
+    FreeBatchData(&hostBatch);
+    if (slots != NULL) {
+        for (int i = 0; i < prefetchNum + 1; i++)
+            FreeBatchData(slots + i);
+        delete[] slots;
+    }
 }
 
 /*
@@ -68,6 +159,25 @@ void T2TBatchLoader::Init(T2TConfig& config)
     isBigBatch = config.isBigBatch;
     isRandomBatch = config.isRandomBatch;
     bucketSize = config.bucketSize;
+    prefetchNum = MAX(config.prefetchNum, 0);
+    maxPaddingRatio = config.maxPaddingRatio;
+    randState = (unsigned long long)config.shuffleSeed;
+
+    bucketBounds.Clear();
+    bucketWBatch.Clear();
+    if (strcmp(config.bucketBounds, "") != 0) {
+        IntList bounds = SplitInt(config.bucketBounds, ",");
+        for (int i = 0; i < bounds.count; i++)
+            bucketBounds.Add(bounds[i]);
+    }
+    if (strcmp(config.bucketWBatch, "") != 0) {
+        IntList sizes = SplitInt(config.bucketWBatch, ",");
+        for (int i = 0; i < sizes.count; i++)
+            bucketWBatch.Add(sizes[i]);
+    }
+
+    for (int i = 1; i < bucketBounds.count; i++)
+        CheckNTErrors(bucketBounds[i] > bucketBounds[i - 1], "The bucket bounds must be in ascending order!");
 
     buf = new int[bufSize];
     buf2 = new int[bufSize];
@@ -75,9 +185,14 @@ void T2TBatchLoader::Init(T2TConfig& config)
     seqLen = new int[bufSize];
     seqLen2 = new int[bufSize];
     seqOffset = new int[bufSize];
-}
+    line = new char[MAX_SEQUENCE_LENGTH];
 
-char line[MAX_SEQUENCE_LENGTH];
+    if (prefetchNum > 0) {
+        slots = new T2TBatchData[prefetchNum + 1];
+        for (int i = 0; i < prefetchNum + 1; i++)
+            InitBatchData(slots + i);
+    }
+}
 
 struct SampleNode
 {
@@ -101,7 +216,7 @@ int CompareSampleNodeV2(const void* a, const void* b)
 
 /*
 load data to buffer
->> file - where to load data
+>> file - where to load data (NULL means that we load the lines from the shuffler)
 >> isSorted - indicates whether the samples are sorted by length
 >> step - the number of sequences we go over when move to the next sample
 */
@@ -110,7 +225,8 @@ int T2TBatchLoader::LoadBuf(FILE* file, bool isSorted, int step)
     int lineCount = 0;
     int seqCount = 0;
     int wordCount = 0;
-    while (fgets(line, MAX_SEQUENCE_LENGTH - 1, file)) {
+    while (file != NULL ? fgets(line, MAX_SEQUENCE_LENGTH - 1, file) != NULL :
+                          shuffler.GetLine(line, MAX_SEQUENCE_LENGTH - 1) != NULL) {
         int len = (int)strlen(line);
 
         while (line[len - 1] == '\r' || line[len - 1] == '\n') {
@@ -191,7 +307,7 @@ int T2TBatchLoader::LoadBuf(FILE* file, bool isSorted, int step)
                 max = MAX(max, seqLen[i + j]);
             }
             node.value = max;
-            node.key = rand();
+            node.key = NextRandom();
             count++;
             offset += node.size;
         }
@@ -199,8 +315,9 @@ int T2TBatchLoader::LoadBuf(FILE* file, bool isSorted, int step)
         qsort(nodes, count, sizeof(SampleNode), CompareSampleNode);
 
         /* distribute samples into buckets. In each bucket, sequences have
-           similar a length */
-        if (bucketSize > 0) {
+           similar a length. We keep the order if the batches are made
+           by the length buckets (see MakeBatchMT). */
+        if (bucketSize > 0 && bucketBounds.count == 0) {
             int low = 0;
             int high = low + bucketSize;
             int n = count - 1;
@@ -263,6 +380,31 @@ void T2TBatchLoader::SetRandomBatch(bool flag)
     isRandomBatch = flag;
 }
 
+/* a random number in [0, INT_MAX] (splitmix64) */
+int T2TBatchLoader::NextRandom()
+{
+    unsigned long long z = (randState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return (int)(z >> 33);
+}
+
+/*
+get the bucket of a sentence (pair)
+>> len - length of the sentence (the longer one of the pair)
+<< return - index of the bucket
+*/
+int T2TBatchLoader::GetBucket(int len)
+{
+    for (int i = 0; i < bucketBounds.count; i++) {
+        if (len <= bucketBounds[i])
+            return i;
+    }
+
+    return bucketBounds.count;
+}
+
 /*
 load a batch of sequences
 >> file - the handle to the data file
@@ -291,6 +433,10 @@ int T2TBatchLoader::LoadBatch(FILE* file, bool isLM,
     bool isSorted, int& ws, int& wCount,
     int devID, bool isTraining)
 {
+    if (isPrefetching && !isLM)
+        return LoadPrefetchedBatch(batchEnc, paddingEnc, batchDec, paddingDec, label,
+            ws, wCount, devID);
+
     if (isLM) {
         return LoadBatchLM(file, batchEnc, paddingEnc, batchDec, paddingDec, gold, label,
             seqs, vsEnc, sBatch, wBatch,
@@ -484,8 +630,41 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
     bool isSorted, int& ws, int& wCount,
     int devID, bool isTraining)
 {
+    int sc = MakeBatchMT(file, &hostBatch, seqs, sBatch, wBatch, isSorted);
+
+    if (sc <= 0)
+        return 0;
+
+    CopyBatch(&hostBatch, batchEnc, paddingEnc, batchDec, paddingDec, label, devID);
+
+    ws = hostBatch.ws;
+    wCount = hostBatch.wCount;
+
+    return sc;
+}
+
+/*
+make a batch of sequences on the host (for MT). It does not touch any
+tensor, so we can run it on another thread.
+If the length buckets are given, the buffer is sorted by length and a batch
+is made of the sentences in the same bucket. It takes the sentences as long
+as the padded batch is within the word budget of the bucket and the paddings
+are no more than "maxPaddingRatio" of it.
+>> file - the handle to the data file
+>> data - the batch (on the host)
+>> seqs - keep the sequences in an array
+>> sBatch - batch size of sequences
+>> wBatch - batch size of words
+>> isSorted - indicates whether the sequences are sorted by length
+<< return - number of the sequences (two for each sentence pair)
+*/
+int T2TBatchLoader::MakeBatchMT(FILE* file, T2TBatchData* data, int* seqs,
+    int sBatch, int wBatch, bool isSorted)
+{
+    bool useBucket = bucketBounds.count > 0;
+
     if (nextBatch < 0 || nextBatch >= bufBatchSize) {
-        LoadBuf(file, isSorted, 2);
+        LoadBuf(file, isSorted || useBucket, 2);
 
         int seq = 0;
 
@@ -501,6 +680,8 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
             int maxEnc = 0;
             int maxDec = 0;
             int sc = 0;
+            int bucket = 0;
+            int bucketBatch = wBatch;
 
             while (seq + sc < nseqBuf) {
                 /* source-side sequence */
@@ -512,7 +693,26 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
                 int tcEnc = isBigBatch ? (wcEnc + wnEnc) : MAX(maxEnc, wnEnc) * (sc + 2) / 2;
                 int tcDec = isBigBatch ? (wcDec + wnDec) : MAX(maxDec, wnDec) * (sc + 2) / 2;
 
-                if (sc != 0 && sc > sBatch * 2 && (tcEnc > wBatch || tcDec > wBatch))
+                if (useBucket) {
+                    int b = GetBucket(MAX(seqLen[seq + sc], seqLen[seq + sc + 1]));
+
+                    if (sc == 0) {
+                        bucket = b;
+                        if (bucket < bucketWBatch.count)
+                            bucketBatch = bucketWBatch[bucket];
+                    }
+                    else {
+                        int padEnc = MAX(maxEnc, wnEnc) * (sc + 2) / 2;
+                        int padDec = MAX(maxDec, wnDec) * (sc + 2) / 2;
+                        int words = wcEnc + wnEnc + wcDec + wnDec;
+                        float padding = 1.0F - (float)words / (padEnc + padDec);
+
+                        if (b != bucket || padEnc > bucketBatch || padDec > bucketBatch ||
+                            padding > maxPaddingRatio)
+                            break;
+                    }
+                }
+                else if (sc != 0 && sc > sBatch * 2 && (tcEnc > wBatch || tcDec > wBatch))
                     break;
 
                 wcEnc += wnEnc;
@@ -533,7 +733,7 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
             batch.end = seq + sc;
             batch.maxEnc = maxEnc;
             batch.maxDec = maxDec;
-            batch.key = rand();
+            batch.key = NextRandom();
 
             bufBatchSize++;
             seq = seq + sc;
@@ -557,38 +757,26 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
     int sCount = sc / 2;
     int seqSize = 0;
 
-    InitTensor2D(batchEnc, sCount, maxEnc, X_INT, devID);
-    InitTensor2D(paddingEnc, sCount, maxEnc, X_FLOAT, devID);
-    InitTensor2D(batchDec, sCount, maxDec, X_INT, devID);
-    InitTensor2D(paddingDec, sCount, maxDec, X_FLOAT, devID);
-    InitTensor2D(label, sCount, maxDec, X_INT, devID);
+    ResizeBatchData(data, sCount * maxEnc, sCount * maxDec);
 
-    //InitTensor(gold, 3, dimsDec, X_FLOAT, devID);
+    data->sCount = sCount;
+    data->maxEnc = maxEnc;
+    data->maxDec = maxDec;
 
-    batchEnc->SetZeroAll();
-    paddingEnc->SetZeroAll();
-    batchDec->SetZeroAll();
-    paddingDec->SetZeroAll();
-    label->SetZeroAll();
+    int* batchEncValues = data->batchEnc;
+    int* batchDecValues = data->batchDec;
+    int* labelValues = data->label;
+    float* paddingEncValues = data->paddingEnc;
+    float* paddingDecValues = data->paddingDec;
 
-    //gold->SetZeroAll();
+    memset(batchEncValues, 0, sizeof(int) * sCount * maxEnc);
+    memset(batchDecValues, 0, sizeof(int) * sCount * maxDec);
+    memset(labelValues, 0, sizeof(int) * sCount * maxDec);
+    memset(paddingEncValues, 0, sizeof(float) * sCount * maxEnc);
+    memset(paddingDecValues, 0, sizeof(float) * sCount * maxDec);
 
     int wCountEnc = 0;
-    int wCountDec = 0;
-    int wCountPad = 0;
-    wCount = 0;
-
-    int* batchEncValues = new int[batchEnc->unitNum];
-    int* batchDecValues = new int[batchDec->unitNum];
-    int* labelValues = new int[label->unitNum];
-    MTYPE* paddingEncOffsets = new MTYPE[sc * maxEnc / 2];
-    MTYPE* paddingDecOffsets = new MTYPE[sc * maxDec / 2];
-
-    //MTYPE * goldOffsets = new MTYPE[sc * maxDec / 2];
-
-    memset(batchEncValues, 0, sizeof(int) * batchEnc->unitNum);
-    memset(batchDecValues, 0, sizeof(int) * batchDec->unitNum);
-    memset(labelValues, 0, sizeof(int) * batchDec->unitNum);
+    int wCount = 0;
 
     /* batch of the source-side sequences */
     for (int s = seq; s < seq + sc; s += 2) {
@@ -596,20 +784,11 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
         int sent = (s - seq) / 2;
         for (int w = 0; w < len; w++) {
             int num = buf[seqOffset[s] + w];
-            batchEncValues[batchEnc->GetOffset2D(sent, w)] = num;
-            paddingEncOffsets[wCountEnc] = paddingEnc->GetOffset2D(sent, w);
+            batchEncValues[sent * maxEnc + w] = num;
+            paddingEncValues[sent * maxEnc + w] = 1.0F;
             wCountEnc++;
         }
     }
-    ws = wCountEnc;
-    batchEnc->SetData(batchEncValues, batchEnc->unitNum);
-    paddingEnc->SetDataBatched(paddingEncOffsets, 1.0F, wCountEnc);
-
-    //XTensor * tmp = NewTensorBuf(paddingEnc, devID);
-    //_ConvertDataType(batchEnc, tmp);
-    //tmp->Dump(stderr, "tmp:");
-    //_NotEqual(tmp, paddingEnc, 0);
-    //DelTensorBuf(tmp);
 
     /* batch of the target-side sequences */
     for (int s = seq + 1; s < seq + sc; s += 2) {
@@ -618,33 +797,21 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
         int sent = (s - seq - 1) / 2;
         for (int w = 0; w < len; w++) {
             int num = buf[seqOffset[s] + w];
-            batchDecValues[batchDec->GetOffset2D(sent, w)] = num;
+            batchDecValues[sent * maxDec + w] = num;
 
-            //paddingDecOffsets[wCountDec] = paddingDec->GetOffset2D(sent, w);
             if (w < len - 1) {
-                paddingDecOffsets[wCountPad++] = paddingDec->GetOffset2D(sent, w);
+                paddingDecValues[sent * maxDec + w] = 1.0F;
                 wCount++;
             }
-            if (w > 0) {
-
-                //goldOffsets[wGold++] = gold->GetOffset3D(sent, w - 1, buf[seqOffset[s] + w]);
-                labelValues[label->GetOffset2D(sent, w - 1)] = buf[seqOffset[s] + w];
-            }
+            if (w > 0)
+                labelValues[sent * maxDec + w - 1] = buf[seqOffset[s] + w];
             if (w == len - 1) {
-                if (isDoubledEnd) {
-
-                    //goldOffsets[wGold++] = gold->GetOffset3D(sent, w, buf[seqOffset[s] + w]);
-                    labelValues[label->GetOffset2D(sent, w)] = buf[seqOffset[s] + w];
-                }
-                else {
-
-                    //goldOffsets[wGold++] = gold->GetOffset3D(sent, w, buf[seqOffset[s] + w + 1]);
-                    labelValues[label->GetOffset2D(sent, w)] = buf[seqOffset[s] + w + 1];
-                }
+                if (isDoubledEnd)
+                    labelValues[sent * maxDec + w] = buf[seqOffset[s] + w];
+                else
+                    labelValues[sent * maxDec + w] = buf[seqOffset[s] + w + 1];
             }
 
-            //wCount++;
-            wCountDec++;
             if (seqs != NULL)
                 seqs[seqSize++] = buf[seqOffset[s] + w];
         }
@@ -655,43 +822,156 @@ int T2TBatchLoader::LoadBatchMT(FILE* file,
         }
     }
 
-    batchDec->SetData(batchDecValues, batchDec->unitNum);
-    label->SetData(labelValues, label->unitNum);
-    paddingDec->SetDataBatched(paddingDecOffsets, 1.0F, wCountPad);
+    data->ws = wCountEnc;
+    data->wCount = wCount;
 
-    //XTensor * tmp2 = NewTensorBuf(paddingDec, devID);
-    //_ConvertDataType(batchDec, tmp2);
-    //_NotEqual(tmp2, paddingDec, 0);
-    //DelTensorBuf(tmp2);
+    return sc;
+}
+
+/*
+copy a batch from the host to the tensors
+>> data - the batch (on the host)
+>> batchEnc - the batch of the input sequences
+>> paddingEnc - padding of the input sequences
+>> batchDec - the batch of the output sequences
+>> paddingDec - padding of the output sequences
+>> label - (gold standard) label index of every position
+>> devID - device id
+*/
+void T2TBatchLoader::CopyBatch(T2TBatchData* data,
+    XTensor* batchEnc, XTensor* paddingEnc,
+    XTensor* batchDec, XTensor* paddingDec,
+    XTensor* label, int devID)
+{
+    int sCount = data->sCount;
+
+    InitTensor2D(batchEnc, sCount, data->maxEnc, X_INT, devID);
+    InitTensor2D(paddingEnc, sCount, data->maxEnc, X_FLOAT, devID);
+    InitTensor2D(batchDec, sCount, data->maxDec, X_INT, devID);
+    InitTensor2D(paddingDec, sCount, data->maxDec, X_FLOAT, devID);
+    InitTensor2D(label, sCount, data->maxDec, X_INT, devID);
+
+    batchEnc->SetData(data->batchEnc, batchEnc->unitNum);
+    paddingEnc->SetData(data->paddingEnc, paddingEnc->unitNum);
+    batchDec->SetData(data->batchDec, batchDec->unitNum);
+    paddingDec->SetData(data->paddingDec, paddingDec->unitNum);
+    label->SetData(data->label, label->unitNum);
+}
 
-    //gold->SetDataBatched(goldOffsets, 1.0F, wGold);
+/*
+start making batches (for MT) in the background. The batches are kept in
+a ring of host buffers and LoadBatch takes them one by one, so the next
+batch is ready while we are working on the current one. Note that we
+cannot make the tensors on the background thread because the memory pool
+is not thread-safe.
+>> file - the handle to the data file (NULL means the shuffler)
+>> sBatch - batch size of sequences
+>> wBatch - batch size of words
+>> isSorted - indicates whether the sequences are sorted by length
+*/
+void T2TBatchLoader::StartPrefetch(FILE* file, int sBatch, int wBatch, bool isSorted)
+{
+    CheckNTErrors(prefetchNum > 0, "No buffer for prefetching!");
 
-    delete[] batchEncValues;
-    delete[] batchDecValues;
-    delete[] labelValues;
-    delete[] paddingEncOffsets;
-    delete[] paddingDecOffsets;
+    StopPrefetch();
 
-    //delete[] goldOffsets;
+    prefetchFile = file;
+    prefetchSBatch = sBatch;
+    prefetchWBatch = wBatch;
+    prefetchIsSorted = isSorted;
+    readyHead = 0;
+    readyNum = 0;
+    isPrefetchDone = false;
+    toStopPrefetch = false;
+    isPrefetching = true;
 
-    return sc;
+    prefetcher = std::thread(&T2TBatchLoader::Prefetch, this);
+}
+
+/* stop the background thread (the batches that are not used are discarded) */
+void T2TBatchLoader::StopPrefetch()
+{
+    if (!isPrefetching)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        toStopPrefetch = true;
+    }
+    prefetchCond.notify_all();
+
+    prefetcher.join();
+
+    isPrefetching = false;
+    prefetchFile = NULL;
+    readyNum = 0;
 }
 
 /*
-shuffle lines of the file
->> srcFile - the source file to shuffle
->> tgtFile - the resulting file
+take a batch that is made in the background
+>> batchEnc - the batch of the input sequences
+>> paddingEnc - padding of the input sequences
+>> batchDec - the batch of the output sequences
+>> paddingDec - padding of the output sequences
+>> label - (gold standard) label index of every position
+>> ws - number of words on the encoder side
+>> wCount - word count
+>> devID - device id
+<< return - number of the sequences (0 means the end of the data)
 */
-void T2TBatchLoader::Shuffle(const char* srcFile, const char* tgtFile)
+int T2TBatchLoader::LoadPrefetchedBatch(
+    XTensor* batchEnc, XTensor* paddingEnc,
+    XTensor* batchDec, XTensor* paddingDec,
+    XTensor* label, int& ws, int& wCount, int devID)
 {
-    char* line = new char[MAX_LINE_LENGTH];
-#ifndef WIN32
-    sprintf(line, "shuf %s > %s", srcFile, tgtFile);
-    system(line);
-#else
-    ShowNTErrors("Cannot shuffle the file on WINDOWS systems!");
-#endif
-    delete[] line;
+    std::unique_lock<std::mutex> lock(prefetchMutex);
+    prefetchCond.wait(lock, [this] { return readyNum > 0 || isPrefetchDone; });
+
+    if (readyNum == 0)
+        return 0;
+
+    /* the producer does not write this slot until we take the next one */
+    T2TBatchData* data = slots + readyHead;
+    readyHead = (readyHead + 1) % (prefetchNum + 1);
+    readyNum--;
+
+    lock.unlock();
+    prefetchCond.notify_all();
+
+    CopyBatch(data, batchEnc, paddingEnc, batchDec, paddingDec, label, devID);
+
+    ws = data->ws;
+    wCount = data->wCount;
+
+    return data->sCount * 2;
+}
+
+/* the loop of the background thread */
+void T2TBatchLoader::Prefetch()
+{
+    std::unique_lock<std::mutex> lock(prefetchMutex);
+
+    while (true) {
+        prefetchCond.wait(lock, [this] { return toStopPrefetch || readyNum < prefetchNum; });
+
+        if (toStopPrefetch)
+            break;
+
+        T2TBatchData* data = slots + (readyHead + readyNum) % (prefetchNum + 1);
+
+        lock.unlock();
+        int sc = MakeBatchMT(prefetchFile, data, NULL, prefetchSBatch, prefetchWBatch, prefetchIsSorted);
+        lock.lock();
+
+        if (sc <= 0) {
+            isPrefetchDone = true;
+            prefetchCond.notify_all();
+            break;
+        }
+
+        readyNum++;
+        prefetchCond.notify_all();
+    }
 }
 
-}
\ No newline at end of file
+}
@@ -23,8 +23,12 @@
 #ifndef __T2TBATCHLOADER_H__
 #define __T2TBATCHLOADER_H__
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "../module/T2TUtility.h"
 #include "../../../network/XNet.h"
+#include "../../../tensor/XShuffler.h"
 
 using namespace nts;
 
@@ -52,6 +56,45 @@ struct BatchNode
     int key;
 };
 
+/* a batch of sequences kept on the host (see T2TBatchLoader::MakeBatchMT) */
+struct T2TBatchData
+{
+    /* number of sentence pairs */
+    int sCount;
+
+    /* maximum word number on the encoder side */
+    int maxEnc;
+
+    /* maximum word number on the decoder side */
+    int maxDec;
+
+    /* number of words on the encoder side */
+    int ws;
+
+    /* number of words that count in the loss */
+    int wCount;
+
+    /* word ids of the input sequences */
+    int* batchEnc;
+
+    /* padding of the input sequences */
+    float* paddingEnc;
+
+    /* word ids of the output sequences */
+    int* batchDec;
+
+    /* padding of the output sequences */
+    float* paddingDec;
+
+    /* label index of every position */
+    int* label;
+
+    /* number of the items that the buffers can keep
+       (on the encoder and decoder sides) */
+    int capacityEnc;
+    int capacityDec;
+};
+
 class T2TBatchLoader
 {
 public:
@@ -105,6 +148,67 @@ public:
     /* bucket size */
     int bucketSize;
 
+    /* upper bounds of the sentence lengths of the buckets (in ascending order).
+       The sentences longer than the last one are in the last bucket. */
+    IntList bucketBounds;
+
+    /* maximum number of words (including paddings) in a batch of each bucket */
+    IntList bucketWBatch;
+
+    /* the maximum ratio of paddings in a batch of a bucket */
+    float maxPaddingRatio;
+
+    /* the shuffler of the training data (used when we load data from a NULL file) */
+    XShuffler shuffler;
+
+    /* state of the random number generator for the sorting keys. The loader
+       does not use rand() because the batches might be made in the background
+       while the training thread seeds rand() for dropout (see XCheckpoint.cpp) */
+    unsigned long long randState;
+
+    /* buffer of the line we read */
+    char* line;
+
+    /* the batch made on the host (when we load batches on the calling thread) */
+    T2TBatchData hostBatch;
+
+    /* number of batches that are prepared in the background */
+    int prefetchNum;
+
+    /* indicates whether the background thread is working */
+    bool isPrefetching;
+
+    /* the batches made in the background (a ring of prefetchNum + 1 slots,
+       one of which is being copied into the tensors) */
+    T2TBatchData* slots;
+
+    /* the first ready batch in the ring */
+    int readyHead;
+
+    /* number of the ready batches */
+    int readyNum;
+
+    /* indicates whether the background thread reaches the end of the data */
+    bool isPrefetchDone;
+
+    /* indicates whether the background thread should quit */
+    bool toStopPrefetch;
+
+    /* the data file and settings for the background thread */
+    FILE* prefetchFile;
+    int prefetchSBatch;
+    int prefetchWBatch;
+    bool prefetchIsSorted;
+
+    /* the thread that makes batches */
+    std::thread prefetcher;
+
+    /* a lock to protect the ring */
+    std::mutex prefetchMutex;
+
+    /* to inform the producer and the consumer */
+    std::condition_variable prefetchCond;
+
 public:
     /* constructor */
     T2TBatchLoader();
@@ -124,6 +228,12 @@ public:
     /* set the random batch flag */
     void SetRandomBatch(bool flag = true);
 
+    /* get the bucket of a sentence (pair) */
+    int GetBucket(int len);
+
+    /* a random number in [0, INT_MAX] */
+    int NextRandom();
+
     /* load a batch of sequences */
     int LoadBatch(FILE* file, bool isLM,
         XTensor* batchEnc, XTensor* paddingEnc,
@@ -152,8 +262,31 @@ public:
         bool isSorted, int& ws, int& wCount,
         int devID, bool isTraining);
 
-    /* shuffle the data file */
-    void Shuffle(const char* srcFile, const char* tgtFile);
+    /* make a batch of sequences on the host (for machine translation) */
+    int MakeBatchMT(FILE* file, T2TBatchData* data, int* seqs,
+        int sBatch, int wBatch, bool isSorted);
+
+    /* copy a batch from the host to the tensors */
+    void CopyBatch(T2TBatchData* data,
+        XTensor* batchEnc, XTensor* paddingEnc,
+        XTensor* batchDec, XTensor* paddingDec,
+        XTensor* label, int devID);
+
+    /* start making batches (for machine translation) in the background */
+    void StartPrefetch(FILE* file, int sBatch, int wBatch, bool isSorted);
+
+    /* stop the background thread */
+    void StopPrefetch();
+
+    /* take a batch that is made in the background */
+    int LoadPrefetchedBatch(
+        XTensor* batchEnc, XTensor* paddingEnc,
+        XTensor* batchDec, XTensor* paddingDec,
+        XTensor* label, int& ws, int& wCount, int devID);
+
+    /* the loop of the background thread */
+    void Prefetch();
+
 };
 
 }
@@ -23,6 +23,7 @@
 #include "T2TTrainer.h"
 #include "../module/T2TUtility.h"
 #include "../../../tensor/XUtility.h"
+#include "../../../tensor/XProfiler.h"
 #include "../../../tensor/core/CHeader.h"
 #include "../../../tensor/loss/LHeader.h"
 #include "../../../network/XNoder.h"
@@ -39,6 +40,10 @@ namespace transformer
 T2TTrainer::T2TTrainer()
 {
     cfg = NULL;
+    flatParams = NULL;
+    flatGrads = NULL;
+    flatMoments = NULL;
+    flatMoments2nd = NULL;
 }
 
 /* de-constructor */
@@ -53,6 +58,11 @@ T2TTrainer::~T2TTrainer()
         XTensor* m = (XTensor*)moments2nd.Get(i);
         delete m;
     }
+
+    delete flatParams;
+    delete flatGrads;
+    delete flatMoments;
+    delete flatMoments2nd;
 }
 
 /*
@@ -76,11 +86,15 @@ void T2TTrainer::Init(T2TConfig& config)
     adamBeta1 = config.adamBeta1;
     adamBeta2 = config.adamBeta2;
     adamDelta = config.adamDelta;
+    weightDecay = config.weightDecay;
+    useFlatParams = config.useFlatParams;
     isShuffled = config.isShuffled;
+    shuffleSeed = config.shuffleSeed;
     labelSmoothingP = config.labelSmoothingP;
     nStepCheckpoint = config.nStepCheckpoint;
     useEpochCheckpoint = config.useEpochCheckpoint;
     updateStep = config.updateStep;
+    isDataReleased = config.releaseData;
     isDebugged = config.isDebugged;
     isLenSorted = config.isLenSorted;
 
@@ -117,35 +131,44 @@ void T2TTrainer::Train(const char* fn, const char* validFN, const char* modelFN,
     int validStep = 0;
     int epoch = 0;
 
-    char* trainFN = new char[(int)strlen(fn) + 10];
-    strcpy(trainFN, fn);
-
-#ifndef WIN32
-    if (isShuffled)
-        sprintf(trainFN, "%s.random", fn);
-#endif
-
     int devID = model->devID;
     XNet net;
 
+    /* activations are freed in back-propagation as soon as they are of no use */
+    net.SetDataReleaseFlag(isDataReleased);
+
     PrepareModel(model);
 
+    /* index the training file for shuffling */
+    if (isShuffled)
+        batchLoader.shuffler.Init(fn, (unsigned long long)shuffleSeed);
+
     double startT = GetClockSec();
 
     for (epoch = 1; epoch <= nepoch; epoch++) {
-#ifndef WIN32
-        if (isShuffled) {
-            fprintf(stderr, "shuffle the file\n");
-            batchLoader.Shuffle(fn, trainFN);
+        FILE* file = NULL;
+
+        /* the lines are read from the shuffler (see T2TBatchLoader::LoadBuf) */
+        if (isShuffled)
+            batchLoader.shuffler.Start(epoch);
+        else {
+            file = fopen(fn, "r");
+            CheckNTErrors(file, "cannot open training file!");
         }
-#endif
 
-        FILE* file = fopen(trainFN, "r");
-        CheckNTErrors(file, "cannot open training file!");
+        /* the batches are made on another thread while we train the model */
+        if (batchLoader.prefetchNum > 0 && model->isMT)
+            batchLoader.StartPrefetch(file, sBatchSize, wBatchSize, isLenSorted);
 
         wordCount = 0;
         loss = 0;
 
+        /* words and slots (words and paddings) of the batches of the epoch */
+        double epochStartT = GetClockSec();
+        int epochBatchNum = 0;
+        double epochWordNum = 0;
+        double epochSlotNum = 0;
+
         /* batch of sequences (on the encoder and decoder sides) */
         XTensor batchEnc;
         XTensor batchDec;
@@ -167,25 +190,35 @@ void T2TTrainer::Train(const char* fn, const char* validFN, const char* modelFN,
         {
             CheckNTErrors(batchEnc.order == 2, "wrong tensor order of the sequence batch");
 
-            /* output probabilities */
-            XTensor output;
-
-            /* make the network */
-            if (model->isLM)
-                model->MakeLM(batchEnc, output, paddingEnc, true);
-            else if (model->isMT)
-                model->MakeMT(batchEnc, batchDec, output, paddingEnc, paddingDec, true);
-            else {
-                ShowNTErrors("Illegal model type!");
+            /* each target sentence has a word more than those counted in the
+               loss (wc), i.e., the last one that is not fed to the loss */
+            if (model->isMT) {
+                epochBatchNum++;
+                epochWordNum += ws + wc + batchDec.GetDim(0);
+                epochSlotNum += batchEnc.unitNum + paddingDec.unitNum;
             }
 
-            /* get loss and probabilities */
-            XTensor labelOnehot;
+            /* output scores (before the softmax) */
+            XTensor output;
+
+            /* get loss. The softmax is computed inside the loss and the gold
+               standard is given by the labels (no one-hot tensor) */
             XTensor lossTensor;
 
-            labelOnehot = IndexToOnehot(label, vSizeTgt, labelSmoothingP);
+            {
+                XProfileRegion region("forward");
+
+                /* make the network */
+                if (model->isLM)
+                    model->MakeLM(batchEnc, output, paddingEnc, true, false);
+                else if (model->isMT)
+                    model->MakeMT(batchEnc, batchDec, output, paddingEnc, paddingDec, true, false);
+                else {
+                    ShowNTErrors("Illegal model type!");
+                }
 
-            lossTensor = CrossEntropy(output, labelOnehot, paddingDec);
+                lossTensor = SoftmaxCrossEntropyWithIndex(output, label, paddingDec, labelSmoothingP);
+            }
 
             float lossBatch = ReduceSumAllValue(lossTensor);
 
@@ -194,7 +227,10 @@ void T2TTrainer::Train(const char* fn, const char* validFN, const char* modelFN,
 
             if (doUpdate) {
                 /* back-propagation */
-                net.Backward(lossTensor);
+                {
+                    XProfileRegion region("backward");
+                    net.Backward(lossTensor);
+                }
 
                 gradStep += 1;
                 loss += lossBatch;
@@ -210,7 +246,10 @@ void T2TTrainer::Train(const char* fn, const char* validFN, const char* modelFN,
                         ((float)validStep + 1) * pow((float)nwarmup, -1.5F - lrbias));
 
                     /* model update */
-                    Update(model, lr);
+                    {
+                        XProfileRegion region("update");
+                        Update(model, lr);
+                    }
 
                     gradStep = 0;
                     validStep++;
@@ -242,7 +281,18 @@ void T2TTrainer::Train(const char* fn, const char* validFN, const char* modelFN,
             }
         }
 
-        fclose(file);
+        batchLoader.StopPrefetch();
+
+        if (file != NULL)
+            fclose(file);
+
+        /* the ratio of paddings and the words (of both sides) we go over per second */
+        if (epochSlotNum > 0) {
+            double epochT = GetClockSec() - epochStartT;
+            XPRINT4(0, stderr, "[INFO] epoch=%d, batch=%d, padding=%.1f%%, %.1f words/s\n",
+                    epoch, epochBatchNum, 100.0 * (1.0 - epochWordNum / epochSlotNum),
+                    epochWordNum / MAX(epochT, 1e-9));
+        }
 
         if (isEnd)
             break;
@@ -260,7 +310,13 @@ void T2TTrainer::Train(const char* fn, const char* validFN, const char* modelFN,
     XPRINT4(0, stderr, "[INFO] training finished (took %.1fs, step=%d, skipped=%d and epoch=%d)\n",
         elapsed, step, nSkipped, epoch);
 
-    delete[] trainFN;
+    batchLoader.shuffler.Close();
+
+    if (flatParams != NULL) {
+        TensorList ws(100);
+        model->GetParams(ws);
+        ReleaseFlatBuffers(ws);
+    }
 }
 
 /*
@@ -410,12 +466,69 @@ where
 */
 void T2TTrainer::Update(T2TModel* model, const float lr)
 {
+    DTYPE e = lr;
+    DTYPE d = adamDelta;
+    DTYPE decay = lr * weightDecay;
+
+    /* the bias correction of Adam (once for each step) */
+    if (useAdam) {
+        adamBeta1T *= adamBeta1;
+        adamBeta2T *= adamBeta2;
+        e = lr * (DTYPE)sqrt(1 - adamBeta2T) / (1 - adamBeta1T);
+        d = adamDelta * (DTYPE)sqrt(1 - adamBeta2T);
+    }
+
+    /* all the (dense) parameters are updated in one sweep */
+    if (flatParams != NULL) {
+        if (useAdam)
+            _Adam(flatParams, flatGrads, flatMoments, flatMoments2nd, adamBeta1, adamBeta2, e, d, decay);
+        else {
+            if (decay != 0)
+                _ScaleAndShiftMe(flatParams, 1.0F - decay, 0);
+            _Sum(flatParams, flatGrads, flatParams, -lr);
+        }
+
+        /* clear gradient */
+        flatGrads->SetZeroAll();
+    }
+
     TensorList ws(100);
 
     model->GetParams(ws);
 
     for (int i = 0; i < ws.Size(); i++) {
         XTensor* para = ws[i];
+
+        /* for a row-sparse gradient, we update the rows of the words
+           in the batch only. The weight decay is applied to these rows
+           as well (for both Adam and SGD), i.e., the other rows are
+           not decayed in this step */
+        if (para->isSparseGrad) {
+            XRowSparse* paraGrad = para->sparseGrad;
+
+            if (paraGrad == NULL)
+                continue;
+
+            if (useAdam) {
+                XTensor* m = (XTensor*)moments.Get(i);
+                XTensor* v = (XTensor*)moments2nd.Get(i);
+                _AdamSparse(para, paraGrad, m, v, adamBeta1, adamBeta2, e, d, decay);
+            }
+            else {
+                if (decay != 0)
+                    paraGrad->ScaleRowsOf(para, 1.0F - decay);
+                paraGrad->ApplyTo(para, -lr);
+            }
+
+            /* clear gradient */
+            paraGrad->Clear();
+
+            continue;
+        }
+
+        if (flatParams != NULL)
+            continue;
+
         XTensor* paraGrad = para->grad;
 
         if (paraGrad == NULL)
@@ -425,34 +538,38 @@ void T2TTrainer::Update(T2TModel* model, const float lr)
         CheckNTErrors(paraGrad != NULL, "NULL gradient tensor!");
 
         if (useAdam) {
-            adamBeta1T *= adamBeta1;
-            adamBeta2T *= adamBeta2;
-            DTYPE e = lr * (DTYPE)sqrt(1 - adamBeta2T) / (1 - adamBeta1T);
-            DTYPE d = adamDelta * (DTYPE)sqrt(1 - adamBeta2T);
-
-            /* m = beta_1 * m + (1-beta_1) * grad */
             XTensor* m = (XTensor*)moments.Get(i);
-            _ScaleAndShiftMe(m, adamBeta1, 0);
-            _Sum(m, paraGrad, m, (1.0F - adamBeta1));
-
-            /* v = beta_2 * v + (1-beta_2) * grad * grad*/
             XTensor* v = (XTensor*)moments2nd.Get(i);
-            _Multiply(paraGrad, paraGrad, v, adamBeta2 / (1.0F - adamBeta2));
-            _ScaleAndShiftMe(v, (1.0F - adamBeta2), 0);
-
-            /* v2 = m / (sqrt(v) + delta) */
-            XTensor* v2 = NewTensorBuf(v, v->devID);
-            _Power(v, v2, 0.5F);
-            _ScaleAndShiftMe(v2, 1.0F, d);
-            _Div(m, v2, v2);
-
-            /* the delta rule */
-            _Sum(para, v2, para, -e);
 
-            DelTensorBuf(v2);
+            if (para->dataType == X_FLOAT)
+                _Adam(para, paraGrad, m, v, adamBeta1, adamBeta2, e, d, decay);
+            else {
+                /* m = beta_1 * m + (1-beta_1) * grad */
+                _ScaleAndShiftMe(m, adamBeta1, 0);
+                _Sum(m, paraGrad, m, (1.0F - adamBeta1));
+
+                /* v = beta_2 * v + (1-beta_2) * grad * grad*/
+                _Multiply(paraGrad, paraGrad, v, adamBeta2 / (1.0F - adamBeta2));
+                _ScaleAndShiftMe(v, (1.0F - adamBeta2), 0);
+
+                /* v2 = m / (sqrt(v) + delta) */
+                XTensor* v2 = NewTensorBuf(v, v->devID);
+                _Power(v, v2, 0.5F);
+                _ScaleAndShiftMe(v2, 1.0F, d);
+                _Div(m, v2, v2);
+
+                /* the delta rule */
+                if (decay != 0)
+                    _ScaleAndShiftMe(para, 1.0F - decay, 0);
+                _Sum(para, v2, para, -e);
+
+                DelTensorBuf(v2);
+            }
         }
         else {
             /* the delta rule */
+            if (decay != 0)
+                _ScaleAndShiftMe(para, 1.0F - decay, 0);
             _Sum(para, paraGrad, para, -lr);
         }
 
@@ -476,9 +593,15 @@ void T2TTrainer::PrepareModel(T2TModel* model)
 
     for (int i = 0; i < ws.Size(); i++) {
         XTensor* para = ws[i];
-        XNoder::MakeGrad(para);
 
-        if (useAdam) {
+        if (para->isSparseGrad)
+            XNoder::MakeSparseGrad(para);
+        else
+            XNoder::MakeGrad(para);
+
+        /* the moments of the parameters with row-sparse gradients are
+           not in the flat buffers */
+        if (useAdam && (!useFlatParams || para->isSparseGrad)) {
             XTensor* m = new XTensor(para);
             XTensor* m2 = new XTensor(para);
             m->SetZeroAll();
@@ -486,10 +609,122 @@ void T2TTrainer::PrepareModel(T2TModel* model)
             moments.Add(m);
             moments2nd.Add(m2);
         }
+        else if (useAdam) {
+            moments.Add(NULL);
+            moments2nd.Add(NULL);
+        }
     }
 
+    if (useFlatParams)
+        MakeFlatBuffers(ws);
+
     adamBeta1T = 1.0F;
     adamBeta2T = 1.0F;
 }
 
+/* let a tensor use a piece of memory that it does not own */
+static void AttachData(XTensor* tensor, void* data)
+{
+    tensor->DestroyData();
+    tensor->data = data;
+    tensor->mem = NULL;
+    tensor->signature = 0;
+    tensor->isInGlobalMem = false;
+    tensor->isShared = true;
+}
+
+/* give a tensor its own copy of the data it points to */
+static void DetachData(XTensor* tensor)
+{
+    void* shared = tensor->data;
+    tensor->Resize(tensor);
+    XMemCopy(tensor->data, tensor->devID, shared, tensor->devID, tensor->GetDataSizeInChar());
+}
+
+/*
+put the parameters, the gradients and the moments into flat buffers.
+Each parameter (and its gradient) is copied into the buffer and then points
+to it, so that the update is a single sweep over contiguous memory. The
+pieces are aligned to 16 floats and the gaps stay zero. The parameters with
+row-sparse gradients are left out and updated on their own.
+>> params - the parameters (with gradients)
+*/
+void T2TTrainer::MakeFlatBuffers(TensorList& params)
+{
+    CheckNTErrors(flatParams == NULL, "The flat buffers have been made!");
+    CheckNTErrors(params.Size() > 0, "No parameters!");
+
+    int devID = params[0]->devID;
+    int total = 0;
+
+    for (int i = 0; i < params.Size(); i++) {
+        XTensor* para = params[i];
+        if (para->isSparseGrad)
+            continue;
+        CheckNTErrors(para->dataType == X_FLOAT, "Flat buffers only support float parameters!");
+        CheckNTErrors(para->devID == devID, "The parameters must be on the same device!");
+        CheckNTErrors(!para->isSparse && !para->isShared, "Illegal parameter tensor!");
+        CheckNTErrors(para->grad != NULL, "NULL gradient tensor!");
+        total += (para->unitNum + 15) / 16 * 16;
+    }
+
+    flatParams = NewTensor1DV2(total, X_FLOAT, devID);
+    flatGrads = NewTensor1DV2(total, X_FLOAT, devID);
+    flatParams->SetZeroAll();
+    flatGrads->SetZeroAll();
+
+    if (useAdam) {
+        flatMoments = NewTensor1DV2(total, X_FLOAT, devID);
+        flatMoments2nd = NewTensor1DV2(total, X_FLOAT, devID);
+        flatMoments->SetZeroAll();
+        flatMoments2nd->SetZeroAll();
+    }
+    else {
+        flatMoments = NULL;
+        flatMoments2nd = NULL;
+    }
+
+    int offset = 0;
+    for (int i = 0; i < params.Size(); i++) {
+        XTensor* para = params[i];
+        if (para->isSparseGrad)
+            continue;
+        float* p = (float*)flatParams->data + offset;
+        float* g = (float*)flatGrads->data + offset;
+
+        XMemCopy(p, devID, para->data, devID, sizeof(float) * para->unitNum);
+        XMemCopy(g, devID, para->grad->data, devID, sizeof(float) * para->unitNum);
+        AttachData(para, p);
+        AttachData(para->grad, g);
+
+        offset += (para->unitNum + 15) / 16 * 16;
+    }
+}
+
+/*
+let the parameters own their data again and free the flat buffers
+>> params - the parameters
+*/
+void T2TTrainer::ReleaseFlatBuffers(TensorList& params)
+{
+    for (int i = 0; i < params.Size(); i++) {
+        XTensor* para = params[i];
+        if (para->isSparseGrad)
+            continue;
+        DetachData(para);
+        if (para->grad != NULL)
+            DetachData(para->grad);
+    }
+
+    delete flatParams;
+    delete flatGrads;
+    delete flatMoments;
+    delete flatMoments2nd;
+
+    flatParams = NULL;
+    flatGrads = NULL;
+    flatMoments = NULL;
+    flatMoments2nd = NULL;
+}
+
 }
\ No newline at end of file
@@ -85,9 +85,25 @@ public:
     /* list of the 2nd order moment of the parameter matrices */
     TensorList moments2nd;
 
+    /* the (decoupled) weight decay */
+    float weightDecay;
+
+    /* indicates whether we keep the parameters in flat buffers */
+    bool useFlatParams;
+
+    /* flat buffers of the parameters, the gradients and the moments.
+       The parameter (and gradient) tensors point to pieces of them. */
+    XTensor* flatParams;
+    XTensor* flatGrads;
+    XTensor* flatMoments;
+    XTensor* flatMoments2nd;
+
     /* indicates whether the data file is shuffled for training */
     bool isShuffled;
 
+    /* the seed for shuffling the training data */
+    int shuffleSeed;
+
     /* the factor of label smoothing */
     DTYPE labelSmoothingP;
 
@@ -100,6 +116,9 @@ public:
     /* number of batches on which we do model update */
     int updateStep;
 
+    /* indicates whether we free the intermediate nodes in back-propagation */
+    bool isDataReleased;
+
     /* indicates whether we intend to debug the net */
     bool isDebugged;
 
@@ -133,6 +152,12 @@ public:
 
     /* prepare model for training */
     void PrepareModel(T2TModel* model);
+
+    /* put the parameters, the gradients and the moments into flat buffers */
+    void MakeFlatBuffers(TensorList& params);
+
+    /* let the parameters own their data again and free the flat buffers */
+    void ReleaseFlatBuffers(TensorList& params);
 };
 
 }
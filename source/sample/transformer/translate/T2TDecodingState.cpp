@@ -0,0 +1,103 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "T2TDecodingState.h"
+
+using namespace nts;
+
+namespace transformer
+{
+
+/* constructor */
+T2TDecodingState::T2TDecodingState()
+{
+    nlayer = 0;
+    selfAttCache = NULL;
+    enDeAttCache = NULL;
+    mem = NULL;
+}
+
+/* de-constructor */
+T2TDecodingState::~T2TDecodingState()
+{
+    /* the tensors go back to the pool before we free it */
+    delete[] selfAttCache;
+    delete[] enDeAttCache;
+    shortlist.Clear();
+    delete mem;
+}
+
+/*
+initialize the state
+>> model - the model we decode with
+>> usePrivateMem - indicates whether the state has a memory pool of its own.
+                   The pool is used by the thread that calls
+                   GMems.SetThreadMem(mem).
+*/
+void T2TDecodingState::Init(T2TModel* model, bool usePrivateMem)
+{
+    CheckNTErrors(model->isMT, "The decoding state is for MT models only!");
+
+    delete[] selfAttCache;
+    delete[] enDeAttCache;
+
+    nlayer = model->decoder->nlayer;
+    selfAttCache = new Cache[nlayer];
+    enDeAttCache = new Cache[nlayer];
+
+    if (usePrivateMem && mem == NULL) {
+        MTYPE bufSize = 0;
+        if (model->devID < 0)
+            GMems.GetBufferSize(GMems.GetAvailableMemory(), &bufSize);
+        else
+            GMems.GetBufferSize(GMems.GetAvailableGPUMemory(model->devID), &bufSize);
+
+        mem = new XMem(model->devID, FREE_ON_THE_FLY,
+                       MIN_BLOCK_SIZE_FOR_MEMPOOL,
+                       MIN_BLOCK_NUM_FOR_MEMPOOL,
+                       bufSize);
+    }
+}
+
+/* clear the state for a new batch */
+void T2TDecodingState::Reset()
+{
+    for (int i = 0; i < nlayer; i++) {
+        selfAttCache[i].miss = true;
+        enDeAttCache[i].miss = true;
+    }
+
+    shortlist.Clear();
+}
+
+/*
+set the maximum length of the self-attention caches. The caches then keep
+the keys and values in buffers preallocated for this length instead of
+concatenating them step by step.
+>> maxLength - the maximum number of decoding steps (0 disables preallocation)
+*/
+void T2TDecodingState::SetCacheLength(int maxLength)
+{
+    for (int i = 0; i < nlayer; i++)
+        selfAttCache[i].SetMaxLength(maxLength);
+}
+
+}
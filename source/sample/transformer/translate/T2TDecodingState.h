@@ -0,0 +1,80 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __T2TDECODINGSTATE_H__
+#define __T2TDECODINGSTATE_H__
+
+#include "../T2TModel.h"
+#include "../module/T2TOutput.h"
+#include "../module/T2TAttention.h"
+#include "../../../tensor/XMem.h"
+
+using namespace nts;
+
+namespace transformer
+{
+
+/*
+The state of decoding a batch of sentences, i.e., the attention caches of
+the decoder layers and the output layer restricted to a shortlist. The model
+is read-only in decoding and everything that changes is kept here. So a
+number of threads can decode with the same model at the same time, one
+state (and one memory pool) for each thread.
+*/
+class T2TDecodingState
+{
+public:
+    /* number of decoder layers */
+    int nlayer;
+
+    /* the self-attention cache of each layer */
+    Cache* selfAttCache;
+
+    /* the encoder-decoder attention cache of each layer */
+    Cache* enDeAttCache;
+
+    /* the output layer restricted to the shortlist of the batch */
+    T2TOutputShortlist shortlist;
+
+    /* the memory pool for the tensors of decoding (NULL means that
+       we use the global pool) */
+    XMem* mem;
+
+public:
+    /* constructor */
+    T2TDecodingState();
+
+    /* de-constructor */
+    ~T2TDecodingState();
+
+    /* initialize the state */
+    void Init(T2TModel* model, bool usePrivateMem = false);
+
+    /* clear the state for a new batch */
+    void Reset();
+
+    /* set the maximum length of the self-attention caches */
+    void SetCacheLength(int maxLength);
+};
+
+}
+
+#endif
@@ -76,6 +76,8 @@ void T2TStateBundle::MakeStates(int num)
 /* constructor */
 T2TPredictor::T2TPredictor()
 {
+    m = NULL;
+    ds = NULL;
     startSymbol = 2;
 }
 
@@ -122,14 +124,16 @@ void T2TPredictor::SetStartSymbol(int symbol)
 /*
 read a state
 >> model - the t2t model that keeps the network created so far
+>> decState - the decoding state, e.g., the attention caches
 >> state - a set of states. It keeps
 1) hypotheses (states)
 2) probabilities of hypotheses
 3) parts of the network for expanding toward the next state
 */
-void T2TPredictor::Read(T2TModel* model, T2TStateBundle* state)
+void T2TPredictor::Read(T2TModel* model, T2TDecodingState* decState, T2TStateBundle* state)
 {
     m = model;
+    ds = decState;
     s = state;
 }
 
@@ -177,16 +181,16 @@ void T2TPredictor::Predict(T2TStateBundle* next, XTensor& aliveState, XTensor& e
         inputDec = AutoGather(inputDec, aliveState);
 
         /* alive cache */
-        for (int i = 0; i < m->decoder->nlayer; i++) {
-            m->decoder->selfAttCache[i].KeepAlive(aliveState);
-            m->decoder->enDeAttCache[i].KeepAlive(aliveState);
+        for (int i = 0; i < ds->nlayer; i++) {
+            ds->selfAttCache[i].KeepAlive(aliveState);
+            ds->enDeAttCache[i].KeepAlive(aliveState);
         }
     }
 
     if (needReorder) {
-        for (int i = 0; i < m->decoder->nlayer; i++) {
-            m->decoder->selfAttCache[i].Reorder(reorderState);
-            m->decoder->enDeAttCache[i].Reorder(reorderState);
+        for (int i = 0; i < ds->nlayer; i++) {
+            ds->selfAttCache[i].Reorder(reorderState);
+            ds->enDeAttCache[i].Reorder(reorderState);
         }
     }
 
@@ -209,12 +213,13 @@ void T2TPredictor::Predict(T2TStateBundle* next, XTensor& aliveState, XTensor& e
     m->MakeMTMaskDec(paddingEnc, paddingDec, maskDec, maskEncDec);
 
     /* make the decoding network */
-    decoding = m->decoder->Make(inputDec, encoding, NULL, &maskEncDec, nstep, false);
+    decoding = m->decoder->Make(inputDec, encoding, NULL, &maskEncDec, nstep, false,
+                                ds->selfAttCache, ds->enDeAttCache);
 
     CheckNTErrors(decoding.order >= 2, "The tensor must be of order 2 or larger!");
 
     /* generate the output probabilities */
-    m->outputLayer->Make(decoding, output, false, true);
+    m->outputLayer->Make(decoding, output, false, true, &ds->shortlist);
 }
 
 /*
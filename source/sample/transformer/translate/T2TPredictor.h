@@ -26,6 +26,7 @@
 
 #include "../T2TModel.h"
 #include "T2TLengthPenalty.h"
+#include "T2TDecodingState.h"
 
 using namespace std;
 
@@ -128,6 +129,9 @@ private:
     /* pointer to the transformer model */
     T2TModel* m;
 
+    /* the decoding state (caches and etc.) */
+    T2TDecodingState* ds;
+
     /* current state */
     T2TStateBundle* s;
 
@@ -151,7 +155,7 @@ public:
     void SetStartSymbol(int symbol);
 
     /* read a state */
-    void Read(T2TModel* model, T2TStateBundle* state);
+    void Read(T2TModel* model, T2TDecodingState* decState, T2TStateBundle* state);
 
     /* predict the next state */
     void Predict(T2TStateBundle* next, XTensor& aliveIndices, XTensor& encoding,
@@ -22,6 +22,7 @@
 
 #include "T2TSearch.h"
 #include "../module/T2TUtility.h"
+#include "../../../tensor/XProfiler.h"
 #include "../../../tensor/core/CHeader.h"
 
 using namespace nts;
@@ -39,6 +40,7 @@ BeamSearch::BeamSearch()
     fullHypos = NULL;
     endSymbols = new int[32];
     startSymbol = -1;
+    shortlist = NULL;
 }
 
 /* de-constructor */
@@ -100,13 +102,14 @@ void BeamSearch::Prepare(int myBatchSize, int myBeamSize)
 /*
 search for the most promising states
 >> model - the transformer model
+>> decState - the decoding state (it is reset for the batch by the caller)
 >> input - input of the model
 >> padding - padding of the input
 >> output - output that represents the sequences as rows
 >> score - score of the sequences
 */
-void BeamSearch::Search(T2TModel* model, XTensor& input, XTensor& padding, 
-                        IntList* output, XTensor& score)
+void BeamSearch::Search(T2TModel* model, T2TDecodingState* decState, XTensor& input,
+                        XTensor& padding, IntList* output, XTensor& score)
 {
     T2TPredictor predictor;
     XTensor maskEnc;
@@ -120,11 +123,17 @@ void BeamSearch::Search(T2TModel* model, XTensor& input, XTensor& padding,
 
     Prepare(input.unitNum / input.dimSize[input.order - 1], beamSize);
 
+    /* the output layer might be restricted to a shortlist */
+    shortlist = decState->shortlist.words.Size() > 0 ? &decState->shortlist.words : NULL;
+
     /* encoder mask */
     model->MakeMTMaskEnc(padding, maskEnc);
 
     /* make the encoding network */
-    encoding = model->MakeEncoder(input, &maskEnc, false);
+    {
+        XProfileRegion region("encoder");
+        encoding = model->MakeEncoder(input, &maskEnc, false);
+    }
 
     encodingBeam = Unsqueeze(encoding, encoding.order - 2, beamSize);
     inputBeam = Unsqueeze(input, input.order - 1, beamSize);
@@ -140,6 +149,9 @@ void BeamSearch::Search(T2TModel* model, XTensor& input, XTensor& padding,
     CheckNTErrors(lengthLimit > 0, "no max length specified!");
     maxLength = lengthLimit;
 
+    /* preallocate the decoder states for all the steps */
+    decState->SetCacheLength(lengthLimit);
+
     T2TStateBundle* states = new T2TStateBundle[lengthLimit + 1];
     T2TStateBundle* first = states;
     T2TStateBundle* cur = NULL;
@@ -171,11 +183,14 @@ void BeamSearch::Search(T2TModel* model, XTensor& input, XTensor& padding,
         next = states + l + 1;
 
         /* read the current state */
-        predictor.Read(model, cur);
+        predictor.Read(model, decState, cur);
 
         /* predict the next state */
-        predictor.Predict(next, aliveState, encodingBeam, inputBeam,
-            paddingBeam, batchSize * beamSize, l == 0, reorderState, needReorder, l);
+        {
+            XProfileRegion region("decoder");
+            predictor.Predict(next, aliveState, encodingBeam, inputBeam,
+                paddingBeam, batchSize * beamSize, l == 0, reorderState, needReorder, l);
+        }
 
         /* compute the model score (given the prediction probability) */
         Score(cur, next);
@@ -320,32 +335,49 @@ void BeamSearch::Generate(T2TStateBundle* prev, T2TStateBundle* beam)
     score.Reshape(order, dimsBeam);
     prob.Reshape(order, dimsBeam);
 
-    /* keep the most promising candidates in the beam */
-    TopK(score, scoreTopK, index, -1, beamSize, true);
-
-    float lp = T2TLengthPenalizer::GNMT(beam->nstep, alpha);
+    if (score.devID < 0 && score.dataType == X_FLOAT) {
+        /* On CPUs, the top-k gives the previous states ("preID") and the words
+           ("index") of the most promising candidates in a single pass */
+        _TopKBeam(&score, &scoreTopK, &preID, &index, beamSize, sizeVocab);
+
+        /* we keep the top-k scores */
+        score = CopyValues(scoreTopK);
+
+        /* positions of the candidates in "prob" and "probPath" */
+        int* preIDData = (int*)preID.data;
+        int* indexData = (int*)index.data;
+        int* indexCPUData = (int*)indexCPU.data;
+        for (int i = 0; i < indexCPU.unitNum; i += beamSize) {
+            for (int j = 0; j < beamSize; j++)
+                indexCPUData[i + j] = i * stride + preIDData[i + j] * sizeVocab + indexData[i + j];
+        }
+    }
+    else {
+        /* keep the most promising candidates in the beam */
+        TopK(score, scoreTopK, index, -1, beamSize, true);
 
-    CopyValues(index, indexCPU);
-    CopyValues(index, preID);
+        CopyValues(index, indexCPU);
+        CopyValues(index, preID);
 
-    /* "preID" represents the id (or the offset) of the previous state used to make the current
-       hypotheses. Note that we reshape the "score" tensor into a matrix where each
-       row means a previous state. The column number is size-of-beam \times vocab-size. We,
-       therefore, divide entries of the top-k index by vocab-size to compute the id of the
-       previous state for each hypotheses in the top-k list. */
-    DescaleMe(preID, sizeVocab);
+        /* "preID" represents the id (or the offset) of the previous state used to make the current
+           hypotheses. Note that we reshape the "score" tensor into a matrix where each
+           row means a previous state. The column number is size-of-beam \times vocab-size. We,
+           therefore, divide entries of the top-k index by vocab-size to compute the id of the
+           previous state for each hypotheses in the top-k list. */
+        DescaleMe(preID, sizeVocab);
 
-    /* Then, we do something similar to "preID". For the top-k predictions, we need
-       to know their indices in the vocabulary. We compute the offset of each prediction
-       in the vocabulary by dividing it with vocab-size and computing the remainder. */
-    ModMe(index, sizeVocab);
+        /* Then, we do something similar to "preID". For the top-k predictions, we need
+           to know their indices in the vocabulary. We compute the offset of each prediction
+           in the vocabulary by dividing it with vocab-size and computing the remainder. */
+        ModMe(index, sizeVocab);
 
-    /* we keep the top-k scores */
-    score = CopyValues(scoreTopK);
+        /* we keep the top-k scores */
+        score = CopyValues(scoreTopK);
 
-    for (int i = 0; i < indexCPU.unitNum; i += beamSize) {
-        for (int j = 0; j < beamSize; j++) {
-            indexCPU.SetInt(i * stride + indexCPU.GetInt(i + j), i + j);
+        for (int i = 0; i < indexCPU.unitNum; i += beamSize) {
+            for (int j = 0; j < beamSize; j++) {
+                indexCPU.SetInt(i * stride + indexCPU.GetInt(i + j), i + j);
+            }
         }
     }
 
@@ -460,6 +492,8 @@ void BeamSearch::Expand(T2TStateBundle* prev, T2TStateBundle* beam, XTensor& reo
 
             /* prediction */
             state.prediction = prediction.GetInt(k);
+            if (shortlist != NULL)
+                state.prediction = (*shortlist)[state.prediction];
 
             CheckNTErrors(state.prediction >= 0, "Illegal prediction!");
 
@@ -794,11 +828,12 @@ void GreedySearch::SetEnd(const int* tokens, const int tokenNum)
 /*
 search for the most promising states
 >> model - the transformer model
+>> decState - the decoding state (it is reset for the batch by the caller)
 >> input - input of the model
 >> padding - padding of the input
 >> output - output that represents the sequences as rows
 */
-void GreedySearch::Search(T2TModel* model, XTensor& input, 
+void GreedySearch::Search(T2TModel* model, T2TDecodingState* decState, XTensor& input,
                           XTensor& padding, IntList* output)
 {
     XTensor maskEnc;
@@ -811,11 +846,17 @@ void GreedySearch::Search(T2TModel* model, XTensor& input,
     model->MakeMTMaskEnc(padding, maskEnc);
 
     /* make the encoding network */
-    encoding = model->encoder->Make(input, &maskEnc, false);
+    {
+        XProfileRegion region("encoder");
+        encoding = model->encoder->Make(input, &maskEnc, false);
+    }
 
     /* max output-length = scalar * source-length */
     maxLength = (int)(input.dimSize[input.order - 1] * scalarMaxLength);
 
+    /* preallocate the decoder states for all the steps */
+    decState->SetCacheLength(maxLength);
+
     /* the first token */
     XTensor inputDec;
     InitTensor2D(&inputDec, batchSize, 1, X_INT, input.devID);
@@ -843,11 +884,16 @@ void GreedySearch::Search(T2TModel* model, XTensor& input,
         /* decoder mask */
         model->MakeMTMaskDec(padding, paddingDec, maskDec, maskEncDec);
 
-        /* make the decoding network */
-        decoding = model->decoder->Make(inputDec, encoding, NULL, &maskEncDec, l, false);
+        {
+            XProfileRegion region("decoder");
 
-        /* generate the output probabilities */
-        model->outputLayer->Make(decoding, prob, false, false);
+            /* make the decoding network */
+            decoding = model->decoder->Make(inputDec, encoding, NULL, &maskEncDec, l, false,
+                                            decState->selfAttCache, decState->enDeAttCache);
+
+            /* generate the output probabilities */
+            model->outputLayer->Make(decoding, prob, false, false, &decState->shortlist);
+        }
 
         /* get the most promising prediction */
         prob.Reshape(prob.dimSize[0], prob.dimSize[prob.order - 1]);
@@ -858,6 +904,14 @@ void GreedySearch::Search(T2TModel* model, XTensor& input,
         InitTensorOnCPU(&indexCPU, &inputDec);
         CopyValues(inputDec, indexCPU);
 
+        /* map the offsets in the shortlist to the words */
+        if (decState->shortlist.words.Size() > 0) {
+            IntList& shortlist = decState->shortlist.words;
+            for (int i = 0; i < indexCPU.unitNum; i++)
+                indexCPU.SetInt(shortlist[indexCPU.GetInt(i)], i);
+            CopyValues(indexCPU, inputDec);
+        }
+
         for (int i = 0; i < batchSize; i++) {
             output[i].Add(indexCPU.GetInt(i));
             if (IsEnd(indexCPU.GetInt(i)))
@@ -80,6 +80,11 @@ private:
     /* whether we need to reorder the states */
     bool needReorder;
 
+    /* target words that the output layer covers (NULL means the whole
+       vocabulary). The predictions are offsets in this list before we
+       map them to the words. */
+    IntList* shortlist;
+
 public:
     /* constructor */
     BeamSearch();
@@ -91,7 +96,8 @@ public:
     void Init(T2TConfig& config);
 
     /* search for the most promising states */
-    void Search(T2TModel* model, XTensor& input, XTensor& padding, IntList* output, XTensor& score);
+    void Search(T2TModel* model, T2TDecodingState* decState, XTensor& input, XTensor& padding,
+                IntList* output, XTensor& score);
 
     /* preparation */
     void Prepare(int myBatchSize, int myBeamSize);
@@ -167,7 +173,8 @@ public:
     void Init(T2TConfig& config);
 
     /* search for the most promising states */
-    void Search(T2TModel* model, XTensor& input, XTensor& padding, IntList* output);
+    void Search(T2TModel* model, T2TDecodingState* decState, XTensor& input, XTensor& padding,
+                IntList* output);
 
     /* preparation */
     void Prepare(int myBatchSize);
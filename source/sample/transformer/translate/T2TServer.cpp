@@ -0,0 +1,463 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+#include "T2TServer.h"
+#include "T2TSearch.h"
+#include "T2TDataSet.h"
+#include "../../../tensor/XUtility.h"
+
+using namespace nts;
+
+namespace transformer
+{
+
+/* constructor */
+T2TServer::T2TServer()
+{
+    config = NULL;
+    model = NULL;
+    workerNum = 1;
+    sharedMem = NULL;
+    wordBatch = 0;
+    maxDelay = 0;
+    pendingWordNum = 0;
+    isClosed = false;
+    outputNum = 0;
+    maxLatency = 0;
+    memset(latencyCounts, 0, sizeof(latencyCounts));
+}
+
+/* de-constructor */
+T2TServer::~T2TServer()
+{
+    for (size_t i = 0; i < requests.size(); i++)
+        delete requests[i];
+}
+
+/*
+initialize the service
+>> myConfig - configurations of the model and the service
+*/
+void T2TServer::Init(T2TConfig& myConfig)
+{
+    config = &myConfig;
+    workerNum = MAX(myConfig.serverWorkerNum, 1);
+    wordBatch = myConfig.wBatchSize;
+    maxDelay = myConfig.serverMaxDelay / 1000.0;
+
+    /* the cuBLAS handle (and the stream) of a device is shared by all the
+       threads, so the workers cannot run matrix operations on a GPU at
+       the same time */
+    CheckNTErrors(workerNum == 1 || myConfig.devID < 0,
+                  "-serverworker > 1 is not supported on GPUs!");
+
+    CheckNTErrors(strcmp(myConfig.srcVocabFN, "") != 0, "missing source vocab file");
+    CheckNTErrors(strcmp(myConfig.tgtVocabFN, "") != 0, "missing target vocab file");
+
+    srcVocab.Load(myConfig.srcVocabFN);
+
+    /* share source and target vocabs */
+    if (strcmp(myConfig.srcVocabFN, myConfig.tgtVocabFN) == 0)
+        tgtVocab.CopyFrom(srcVocab);
+    else
+        tgtVocab.Load(myConfig.tgtVocabFN);
+
+    shortlist.Init(myConfig);
+}
+
+/*
+run the service until the input is closed
+>> myModel - the (trained) model
+*/
+void T2TServer::Run(T2TModel* myModel)
+{
+    model = myModel;
+
+    /* the parameters are not in the global memory pool so that
+       the workers can compute with them in their own pools */
+    model->DetachFromMem();
+
+    XPRINT3(0, stderr, "[INFO] translation service (workers=%d, wbatch=%d, delay=%.1fms)\n",
+            workerNum, wordBatch, maxDelay * 1000);
+
+    if (config->serverSlabMem) {
+        MTYPE bufSize = 0;
+        if (model->devID < 0)
+            GMems.GetBufferSize(GMems.GetAvailableMemory(), &bufSize);
+        else
+            GMems.GetBufferSize(GMems.GetAvailableGPUMemory(model->devID), &bufSize);
+
+        sharedMem = new XMem(model->devID, SLAB_FREE,
+                             MIN_BLOCK_SIZE_FOR_MEMPOOL,
+                             MIN_BLOCK_NUM_FOR_MEMPOOL,
+                             bufSize);
+    }
+
+    double startT = GetClockSec();
+
+    vector<thread> workers;
+    for (int i = 0; i < workerNum; i++)
+        workers.push_back(thread(&T2TServer::Work, this, i));
+
+    string line;
+    int id = 0;
+    while (getline(cin, line)) {
+        T2TRequest* request = new T2TRequest;
+        request->id = id++;
+        request->arrivalTime = GetClockSec();
+        request->finishTime = 0;
+        request->isDone = false;
+        Tokenize(line, request->words);
+
+        {
+            lock_guard<mutex> guard(outputMutex);
+            requests.push_back(request);
+        }
+
+        /* an empty line is translated into an empty line */
+        if (request->words.Size() == 0) {
+            vector<T2TRequest*> batch(1, request);
+            Finish(batch);
+            continue;
+        }
+
+        {
+            lock_guard<mutex> guard(queueMutex);
+            pending.push_back(request);
+            pendingWordNum += (int)request->words.Size();
+        }
+        queueCond.notify_one();
+    }
+
+    {
+        lock_guard<mutex> guard(queueMutex);
+        isClosed = true;
+    }
+    queueCond.notify_all();
+
+    for (int i = 0; i < workerNum; i++)
+        workers[i].join();
+
+    ShowStats(GetClockSec() - startT);
+
+    if (sharedMem != NULL) {
+        sharedMem->ShowMemUsage(stderr);
+        delete sharedMem;
+        sharedMem = NULL;
+    }
+}
+
+/*
+transform a line into word ids (in the same way as DataSet)
+>> line - the sentence
+>> words - the word ids
+*/
+void T2TServer::Tokenize(const string& line, IntList& words)
+{
+    istringstream stream(line);
+    string word;
+
+    /* reserve the first 120 words if the input is too long */
+    while (stream >> word && words.Size() < MAX_WORD_NUM) {
+        if (srcVocab.word2id.find(word) == srcVocab.word2id.end())
+            words.Add(3);
+        else
+            words.Add(srcVocab.word2id.at(word));
+    }
+
+    /* make sure that the sequence ends with EOS */
+    if (words.Size() != 0 && words[-1] != EOS)
+        words.Add(EOS);
+}
+
+/*
+the main loop of a worker
+>> id - id of the worker
+*/
+void T2TServer::Work(int id)
+{
+    /* the tensors of the worker are created in its own pool
+       or in the pool shared by all the workers */
+    T2TDecodingState* decState = new T2TDecodingState();
+    decState->Init(model, sharedMem == NULL);
+    GMems.SetThreadMem(sharedMem != NULL ? sharedMem : decState->mem);
+
+    void* searcher = NULL;
+    if (config->beamSize > 1) {
+        searcher = new BeamSearch();
+        ((BeamSearch*)searcher)->Init(*config);
+    }
+    else {
+        searcher = new GreedySearch();
+        ((GreedySearch*)searcher)->Init(*config);
+    }
+
+    vector<T2TRequest*> batch;
+    while (TakeBatch(batch)) {
+        Translate(batch, searcher, decState);
+        Finish(batch);
+    }
+
+    if (config->beamSize > 1)
+        delete (BeamSearch*)searcher;
+    else
+        delete (GreedySearch*)searcher;
+
+    GMems.SetThreadMem(NULL);
+    delete decState;
+}
+
+/*
+take a batch of pending requests. We wait until there are enough words for a
+batch or the oldest request has waited for too long. The batch starts with
+the oldest request and then takes the requests of the closest lengths as long
+as the padded batch is within the word budget.
+>> batch - the requests in the batch
+<< return - false if there is nothing to do any more
+*/
+bool T2TServer::TakeBatch(vector<T2TRequest*>& batch)
+{
+    batch.clear();
+
+    unique_lock<mutex> lock(queueMutex);
+
+    while (true) {
+        if (pending.empty()) {
+            if (isClosed)
+                return false;
+            queueCond.wait(lock);
+            continue;
+        }
+
+        double wait = pending[0]->arrivalTime + maxDelay - GetClockSec();
+        if (isClosed || wait <= 0 || pendingWordNum >= wordBatch)
+            break;
+
+        queueCond.wait_for(lock, chrono::duration<double>(wait));
+    }
+
+    T2TRequest* oldest = pending[0];
+    int len = (int)oldest->words.Size();
+
+    /* the other requests in the order of length difference (and arrival) */
+    vector<T2TRequest*> candidates(pending.begin() + 1, pending.end());
+    stable_sort(candidates.begin(), candidates.end(), [len](T2TRequest* a, T2TRequest* b) {
+        return abs((int)a->words.Size() - len) < abs((int)b->words.Size() - len);
+    });
+
+    int maxLen = len;
+    batch.push_back(oldest);
+    for (size_t i = 0; i < candidates.size(); i++) {
+        int newMaxLen = MAX(maxLen, (int)candidates[i]->words.Size());
+        if (newMaxLen * ((int)batch.size() + 1) > wordBatch)
+            continue;
+        maxLen = newMaxLen;
+        batch.push_back(candidates[i]);
+    }
+
+    /* remove the batch from the queue */
+    vector<T2TRequest*> rest;
+    for (size_t i = 0; i < pending.size(); i++) {
+        if (find(batch.begin(), batch.end(), pending[i]) == batch.end())
+            rest.push_back(pending[i]);
+        else
+            pendingWordNum -= (int)pending[i]->words.Size();
+    }
+    pending.swap(rest);
+
+    /* let another worker take the rest */
+    if (!pending.empty())
+        queueCond.notify_one();
+
+    return true;
+}
+
+/*
+translate a batch of requests
+>> batch - the requests
+>> searcher - the search of the worker
+>> decState - the decoding state of the worker
+*/
+void T2TServer::Translate(vector<T2TRequest*>& batch, void* searcher, T2TDecodingState* decState)
+{
+    int sentNum = (int)batch.size();
+    int maxLen = 0;
+    for (int i = 0; i < sentNum; i++)
+        maxLen = MAX(maxLen, (int)batch[i]->words.Size());
+
+    int* batchValues = new int[sentNum * maxLen];
+    float* paddingValues = new float[sentNum * maxLen];
+
+    for (int i = 0; i < sentNum * maxLen; i++) {
+        batchValues[i] = 1;
+        paddingValues[i] = 0.0F;
+    }
+
+    /* left padding */
+    for (int i = 0; i < sentNum; i++) {
+        IntList& words = batch[i]->words;
+        int cur = maxLen * (i + 1) - (int)words.Size();
+        for (int j = 0; j < words.Size(); j++) {
+            batchValues[cur] = words[j];
+            paddingValues[cur++] = 1.0F;
+        }
+    }
+
+    IntList* output = new IntList[sentNum];
+
+    {
+        XTensor batchEnc;
+        XTensor paddingEnc;
+        InitTensor2D(&batchEnc, sentNum, maxLen, X_INT, model->devID);
+        InitTensor2D(&paddingEnc, sentNum, maxLen, X_FLOAT, model->devID);
+        batchEnc.SetData(batchValues, batchEnc.unitNum);
+        paddingEnc.SetData(paddingValues, paddingEnc.unitNum);
+
+        decState->Reset();
+
+        /* restrict the output layer to the candidates of this batch */
+        if (shortlist.IsEnabled()) {
+            IntList words;
+            shortlist.Make(batchEnc, words);
+            model->outputLayer->SetShortlist(words, decState->shortlist);
+        }
+
+        if (config->beamSize > 1) {
+            XTensor score;
+            ((BeamSearch*)searcher)->Search(model, decState, batchEnc, paddingEnc, output, score);
+        }
+        else {
+            ((GreedySearch*)searcher)->Search(model, decState, batchEnc, paddingEnc, output);
+        }
+    }
+
+    for (int i = 0; i < sentNum; i++)
+        batch[i]->result = output[i];
+
+    delete[] output;
+    delete[] batchValues;
+    delete[] paddingValues;
+}
+
+/*
+mark requests as done and write the translations in order. A translation
+is written only when all the requests before it are written.
+>> batch - the requests
+*/
+void T2TServer::Finish(vector<T2TRequest*>& batch)
+{
+    lock_guard<mutex> guard(outputMutex);
+
+    double now = GetClockSec();
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch[i]->isDone = true;
+        batch[i]->finishTime = now;
+    }
+
+    bool written = false;
+    while (!requests.empty() && requests.front()->isDone) {
+        T2TRequest* request = requests.front();
+        IntList& result = request->result;
+
+        for (int i = 0; i < result.Size(); i++) {
+            if (result[i] < 4)
+                break;
+            fprintf(stdout, "%s ", tgtVocab.id2word[result[i]].c_str());
+        }
+        fprintf(stdout, "\n");
+
+        AddLatency(request->finishTime - request->arrivalTime);
+
+        requests.pop_front();
+        delete request;
+        outputNum++;
+        written = true;
+    }
+
+    if (written)
+        fflush(stdout);
+}
+
+/*
+add the latency of a request to the histogram
+>> latency - the latency (in seconds)
+*/
+void T2TServer::AddLatency(double latency)
+{
+    int bucket = 0;
+    if (latency > SERVER_LATENCY_MIN)
+        bucket = (int)ceil(log(latency / SERVER_LATENCY_MIN) / log(SERVER_LATENCY_GROWTH));
+
+    latencyCounts[MIN(bucket, SERVER_LATENCY_BUCKET_NUM - 1)]++;
+    maxLatency = MAX(maxLatency, latency);
+}
+
+/*
+get a percentile of the latencies. It is the upper bound of the bucket
+where the percentile falls, i.e., it is at most 5% bigger than the real one.
+>> percent - the percentile (e.g., 99)
+<< return - the latency (in seconds)
+*/
+double T2TServer::GetLatency(int percent)
+{
+    long long rank = MIN((long long)outputNum - 1, (long long)outputNum * percent / 100);
+    long long count = 0;
+
+    for (int i = 0; i < SERVER_LATENCY_BUCKET_NUM; i++) {
+        count += latencyCounts[i];
+        if (count > rank)
+            return MIN(SERVER_LATENCY_MIN * pow(SERVER_LATENCY_GROWTH, i), maxLatency);
+    }
+
+    return maxLatency;
+}
+
+/*
+show the latency and the throughput
+>> elapsed - the running time of the service
+*/
+void T2TServer::ShowStats(double elapsed)
+{
+    int num = outputNum;
+    if (num == 0) {
+        XPRINT(0, stderr, "[INFO] translation service stopped (sent=0)\n");
+        return;
+    }
+
+    double p50 = GetLatency(50);
+    double p90 = GetLatency(90);
+    double p99 = GetLatency(99);
+
+    XPRINT4(0, stderr, "[INFO] translation service stopped (sent=%d, elapsed=%.1fs, %.1f sent/s, max latency=%.1fms)\n",
+            num, elapsed, num / MAX(elapsed, 1e-9), maxLatency * 1000);
+    XPRINT3(0, stderr, "[INFO] latency p50=%.1fms, p90=%.1fms, p99=%.1fms\n",
+            p50 * 1000, p90 * 1000, p99 * 1000);
+}
+
+}
@@ -0,0 +1,185 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __T2TSERVER_H__
+#define __T2TSERVER_H__
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "T2TVocab.h"
+#include "T2TShortlist.h"
+#include "T2TDecodingState.h"
+#include "../T2TModel.h"
+#include "../module/T2TUtility.h"
+
+using namespace std;
+
+namespace transformer
+{
+
+/* the latencies are counted in buckets whose bounds grow by
+   SERVER_LATENCY_GROWTH from SERVER_LATENCY_MIN (in seconds) */
+#define SERVER_LATENCY_BUCKET_NUM 512
+#define SERVER_LATENCY_MIN 1e-5
+#define SERVER_LATENCY_GROWTH 1.05
+
+/* a sentence to translate in the service mode */
+struct T2TRequest
+{
+    /* the order of the request in the input */
+    int id;
+
+    /* the source sentence (word ids) */
+    IntList words;
+
+    /* the translation (word ids) */
+    IntList result;
+
+    /* the time when the request arrives */
+    double arrivalTime;
+
+    /* the time when the translation is done */
+    double finishTime;
+
+    /* indicates whether the translation is done */
+    bool isDone;
+};
+
+/*
+The translation service. It reads sentences from the standard input (one
+sentence per line) and writes the translations to the standard output in
+the same order. A number of workers decode the sentences in the background.
+A worker takes a batch when the pending sentences reach the word budget
+(-wbatch) or the oldest one has waited for "maxDelay" seconds. The batch is
+made of the oldest sentence and those of similar lengths so that we waste
+little on padding. The workers decode with the same (read-only) model at the
+same time. Each of them has its own decoding state and memory pool, or
+they share a memory pool in the slab mode (-serverslab). On a GPU there is
+a single worker since the device has one cuBLAS handle for all threads.
+*/
+class T2TServer
+{
+public:
+    /* configurations (for creating the search of each worker) */
+    T2TConfig* config;
+
+    /* the model shared by all the workers (read-only) */
+    T2TModel* model;
+
+    /* number of the workers */
+    int workerNum;
+
+    /* the memory pool shared by the workers (NULL if each has its own pool) */
+    XMem* sharedMem;
+
+    /* maximum number of words (including paddings) in a batch */
+    int wordBatch;
+
+    /* the maximum time (in seconds) a sentence waits before it is batched */
+    double maxDelay;
+
+    /* the source vocabulary */
+    Vocab srcVocab;
+
+    /* the target vocabulary */
+    Vocab tgtVocab;
+
+    /* the lexical shortlist that restricts the output layer */
+    T2TShortlist shortlist;
+
+    /* the requests that are not batched yet (in the order of arrival) */
+    vector<T2TRequest*> pending;
+
+    /* number of words of the pending requests */
+    int pendingWordNum;
+
+    /* indicates whether the input is closed */
+    bool isClosed;
+
+    /* a lock for the pending requests */
+    mutex queueMutex;
+
+    /* to wake up the workers when requests come */
+    condition_variable queueCond;
+
+    /* the requests that are not written yet (in the order of arrival) */
+    deque<T2TRequest*> requests;
+
+    /* number of the requests that are written */
+    int outputNum;
+
+    /* a histogram of the latencies (so that we keep a fixed amount of
+       memory however long the service runs) */
+    long long latencyCounts[SERVER_LATENCY_BUCKET_NUM];
+
+    /* the maximum latency (in seconds) */
+    double maxLatency;
+
+    /* a lock for the output */
+    mutex outputMutex;
+
+public:
+    /* constructor */
+    T2TServer();
+
+    /* de-constructor */
+    ~T2TServer();
+
+    /* initialize the service */
+    void Init(T2TConfig& myConfig);
+
+    /* run the service until the input is closed */
+    void Run(T2TModel* myModel);
+
+protected:
+    /* transform a line into word ids */
+    void Tokenize(const string& line, IntList& words);
+
+    /* the main loop of a worker */
+    void Work(int id);
+
+    /* take a batch of pending requests */
+    bool TakeBatch(vector<T2TRequest*>& batch);
+
+    /* translate a batch of requests */
+    void Translate(vector<T2TRequest*>& batch, void* searcher, T2TDecodingState* decState);
+
+    /* mark requests as done and write the translations in order */
+    void Finish(vector<T2TRequest*>& batch);
+
+    /* add the latency of a request to the histogram */
+    void AddLatency(double latency);
+
+    /* get a percentile of the latencies (from the histogram) */
+    double GetLatency(int percent);
+
+    /* show the latency and the throughput */
+    void ShowStats(double elapsed);
+};
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+
+#include "T2TShortlist.h"
+#include "../../../tensor/XUtility.h"
+
+using namespace nts;
+using namespace std;
+
+namespace transformer
+{
+
+/* constructor */
+T2TShortlist::T2TShortlist()
+{
+    srcVocabSize = 0;
+    tgtVocabSize = 0;
+    topN = 0;
+    freqN = 0;
+    padID = -1;
+    startID = -1;
+    endID = -1;
+    offsets = NULL;
+    candidates = NULL;
+}
+
+/* de-constructor */
+T2TShortlist::~T2TShortlist()
+{
+    delete[] offsets;
+    delete[] candidates;
+}
+
+/*
+initialize the table (and load it if a file is given)
+>> config - configurations of the model
+*/
+void T2TShortlist::Init(T2TConfig& config)
+{
+    srcVocabSize = config.srcVocabSize;
+    tgtVocabSize = config.tgtVocabSize;
+    topN = config.shortlistTopN;
+    freqN = config.shortlistFreqN;
+    padID = config.padID;
+    startID = config.startID;
+    endID = config.endID;
+
+    if (strcmp(config.shortlistFN, "") != 0)
+        Load(config.shortlistFN);
+}
+
+/*
+load the table from a file. We keep the first "topN" candidates
+for each source word.
+>> fn - the file name
+*/
+void T2TShortlist::Load(const char* fn)
+{
+    ifstream f(fn, ios::in);
+    CheckNTErrors(f.is_open(), "Cannot open the shortlist file!");
+
+    vector<vector<int>> table(srcVocabSize);
+    string line;
+    int total = 0;
+
+    while (getline(f, line)) {
+        IntList ids = SplitInt(line, " ");
+        if (ids.Size() == 0)
+            continue;
+
+        int src = ids[0];
+        CheckNTErrors(src >= 0 && src < srcVocabSize, "Illegal source word in the shortlist!");
+
+        vector<int>& row = table[src];
+        for (int i = 1; i < ids.Size() && (int)row.size() < topN; i++) {
+            CheckNTErrors(ids[i] >= 0 && ids[i] < tgtVocabSize, "Illegal target word in the shortlist!");
+            row.push_back(ids[i]);
+            total++;
+        }
+    }
+
+    delete[] offsets;
+    delete[] candidates;
+
+    offsets = new int[srcVocabSize + 1];
+    candidates = new int[MAX(total, 1)];
+
+    offsets[0] = 0;
+    for (int i = 0; i < srcVocabSize; i++) {
+        int offset = offsets[i];
+        for (size_t j = 0; j < table[i].size(); j++)
+            candidates[offset + j] = table[i][j];
+        offsets[i + 1] = offset + (int)table[i].size();
+    }
+
+    XPRINT2(0, stderr, "[INFO] loaded the shortlist (%d candidates, top %d for each word)\n",
+            total, topN);
+}
+
+/* indicates whether the table is loaded */
+bool T2TShortlist::IsEnabled()
+{
+    return offsets != NULL;
+}
+
+/*
+make the shortlist for a batch of source sentences, i.e., the union of the
+most frequent target words and the candidates of every word in the batch
+>> batchEnc - the source sentences (ids)
+>> list - the target words of the shortlist (in ascending order)
+*/
+void T2TShortlist::Make(XTensor& batchEnc, IntList& list)
+{
+    CheckNTErrors(IsEnabled(), "The shortlist is not loaded!");
+    CheckNTErrors(batchEnc.dataType == X_INT, "The input must be word ids!");
+
+    int* words = new int[batchEnc.unitNum];
+    XMemCopy(words, -1, batchEnc.data, batchEnc.devID, sizeof(int) * batchEnc.unitNum);
+
+    bool* hit = new bool[tgtVocabSize];
+    memset(hit, 0, sizeof(bool) * tgtVocabSize);
+
+    for (int i = 0; i < MIN(freqN, tgtVocabSize); i++)
+        hit[i] = true;
+    if (startID >= 0 && startID < tgtVocabSize)
+        hit[startID] = true;
+    if (endID >= 0 && endID < tgtVocabSize)
+        hit[endID] = true;
+
+    for (int i = 0; i < batchEnc.unitNum; i++) {
+        int w = words[i];
+        if (w == padID || w < 0 || w >= srcVocabSize)
+            continue;
+        for (int j = offsets[w]; j < offsets[w + 1]; j++)
+            hit[candidates[j]] = true;
+    }
+
+    list.Clear();
+    for (int i = 0; i < tgtVocabSize; i++) {
+        if (hit[i])
+            list.Add(i);
+    }
+
+    delete[] words;
+    delete[] hit;
+}
+
+}
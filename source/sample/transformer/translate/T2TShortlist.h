@@ -0,0 +1,93 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __T2TSHORTLIST_H__
+#define __T2TSHORTLIST_H__
+
+#include "../module/T2TUtility.h"
+#include "../../../tensor/XTensor.h"
+
+using namespace nts;
+
+namespace transformer
+{
+
+/*
+The lexical shortlist restricts the output layer to a small set of target
+words for each batch, i.e., the most frequent words and the top-N translation
+candidates of each source word. The table is precomputed (e.g., from word
+alignments or co-occurrence counts) and is in the form of
+    src-id tgt-id1 tgt-id2 ...
+one line for each source word, where the candidates are sorted from the
+best to the worst. The ids are the same as in the vocabularies.
+*/
+class T2TShortlist
+{
+public:
+    /* size of the source vocabulary */
+    int srcVocabSize;
+
+    /* size of the target vocabulary */
+    int tgtVocabSize;
+
+    /* number of candidates we take for each source word */
+    int topN;
+
+    /* number of the most frequent target words (ids 0 ... freqN - 1)
+       that are always in the list */
+    int freqN;
+
+    /* the padding id of the source side */
+    int padID;
+
+    /* the start and end symbols of the target side (always in the list) */
+    int startID;
+    int endID;
+
+    /* offsets of the candidates of each source word (srcVocabSize + 1 items) */
+    int* offsets;
+
+    /* candidates of all source words */
+    int* candidates;
+
+public:
+    /* constructor */
+    T2TShortlist();
+
+    /* de-constructor */
+    ~T2TShortlist();
+
+    /* initialize the table */
+    void Init(T2TConfig& config);
+
+    /* load the table from a file */
+    void Load(const char* fn);
+
+    /* indicates whether the table is loaded */
+    bool IsEnabled();
+
+    /* make the shortlist for a batch of source sentences */
+    void Make(XTensor& batchEnc, IntList& list);
+};
+
+}
+
+#endif
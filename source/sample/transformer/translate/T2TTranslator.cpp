@@ -70,6 +70,8 @@ void T2TTranslator::Init(T2TConfig& config)
     else {
         CheckNTErrors(false, "invalid beam size\n");
     }
+
+    shortlist.Init(config);
 }
 
 /*
@@ -98,6 +100,8 @@ void T2TTranslator::Translate(const char* ifn, const char* sfn, const char* tfn,
     /* padding */
     XTensor paddingEnc;
 
+    decState.Init(model);
+
     batchLoader.Init(ifn, sfn, tfn);
     XPRINT1(0, stderr, "[INFO] loaded the input file, elapsed=%.1fs \n", 
             GetClockSec() - startT);
@@ -108,24 +112,28 @@ void T2TTranslator::Translate(const char* ifn, const char* sfn, const char* tfn,
     {
         count++;
 
-        for (int i = 0; i < model->decoder->nlayer; ++i) {
-            model->decoder->selfAttCache[i].miss = true;
-            model->decoder->enDeAttCache[i].miss = true;
-        }
+        decState.Reset();
 
         auto indices = batchLoader.LoadBatch(&batchEnc, &paddingEnc, 
                                              sentBatch, wordBatch, devID);
 
         IntList* output = new IntList[indices.Size() - 1];
 
+        /* restrict the output layer to the candidates of this batch */
+        if (shortlist.IsEnabled()) {
+            IntList words;
+            shortlist.Make(batchEnc, words);
+            model->outputLayer->SetShortlist(words, decState.shortlist);
+        }
+
         /* greedy search */
         if (beamSize == 1) {
-            ((GreedySearch*)seacher)->Search(model, batchEnc, paddingEnc, output);
+            ((GreedySearch*)seacher)->Search(model, &decState, batchEnc, paddingEnc, output);
         }
         /* beam search */
         else {
             XTensor score;
-            ((BeamSearch*)seacher)->Search(model, batchEnc, paddingEnc, output, score);
+            ((BeamSearch*)seacher)->Search(model, &decState, batchEnc, paddingEnc, output, score);
         }
 
         for (int i = 0; i < indices.Size() - 1; ++i) {
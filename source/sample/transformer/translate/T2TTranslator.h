@@ -26,6 +26,8 @@
 
 #include "T2TSearch.h"
 #include "T2TDataSet.h"
+#include "T2TShortlist.h"
+#include "T2TDecodingState.h"
 
 namespace transformer
 {
@@ -55,6 +57,12 @@ public:
     /* decoder for inference */
     void* seacher;
 
+    /* the lexical shortlist that restricts the output layer */
+    T2TShortlist shortlist;
+
+    /* the decoding state (the caches and etc.) */
+    T2TDecodingState decState;
+
 public:
     /* constructor */
     T2TTranslator();
@@ -206,6 +206,23 @@ void XDevice::Reset()
 #endif
 }
 
+/* 
+set the seed for random number generation. The generator of a GPU
+restarts from the beginning of the sequence.
+>> mySeed - the seed
+*/
+void XDevice::SetSeed(int mySeed)
+{
+    seed = mySeed;
+
+#ifdef USE_CUDA
+    if (isGenReady) {
+        curandSetPseudoRandomGeneratorSeed(gen, seed);
+        curandSetGeneratorOffset(gen, 0);
+    }
+#endif
+}
+
 #ifdef USE_CUDA
 
 /* get cublas handle */
@@ -382,6 +399,20 @@ void XDevManager::Clear()
     isInitialized = false;
 }
 
+/* 
+set the seed of all random number generators, i.e., rand() on the
+CPU side and the generator of each GPU. With the same seed we get
+the same random numbers (e.g., dropout masks) again.
+>> seed - the seed
+*/
+void XDevManager::SetSeed(int seed)
+{
+    srand((unsigned int)seed);
+
+    for(int i = 0; i < nGPU; i++)
+        GPUs[i].SetSeed(seed);
+}
+
 #ifdef USE_CUDA
 
 /* get the handle of a given GPU */
@@ -137,6 +137,9 @@ public:
     /* reset it */
     void Reset();
 
+    /* set the seed for random number generation */
+    void SetSeed(int mySeed);
+
 #ifdef USE_CUDA
     /* get cublas handle */
     cublasHandle_t * GetCublasHandle();
@@ -203,6 +206,9 @@ public:
     /* clear it */
     void Clear();
 
+    /* set the seed of all random number generators (CPUs and GPUs) */
+    void SetSeed(int seed);
+
 #ifdef USE_CUDA
     /* get the handle of GPU */
     cublasHandle_t * GetCudaHandle(const int devID);
@@ -27,6 +27,7 @@
 #include "XGlobal.h"
 #include "XUtility.h"
 #include "XMem.h"
+#include "XMemSlab.h"
 
 /* the nts (NiuTrans.Tensor) namespace */
 namespace nts{
@@ -41,6 +42,9 @@ XMemManager GMems;
 
 XMem * GMem;
 
+/* the memory pool of the current thread (see XMemManager::SetThreadMem) */
+static thread_local XMem * threadMem = NULL;
+
 /* constructor */
 XMem::XMem()
 {
@@ -64,6 +68,7 @@ constructor
 >> myMode - mode of running the memory pool
             UNI_FREE: free all the space at the end of using the memory pool
             FREE_ON_THE_FLY: normal "malloc" and "free" mode
+            SLAB_FREE: "malloc" and "free" on size-class slabs (thread-safe)
 >> myBlockSize - size of a memory block
 >> myBlockNum  - number of memory blocks
 >> myBufSize - size of buffer
@@ -109,6 +114,7 @@ initialize it
 >> myMode - mode of running the memory pool
             UNI_FREE: free all the space at the end of using the memory pool
             FREE_ON_THE_FLY: normal "malloc" and "free" mode
+            SLAB_FREE: "malloc" and "free" on size-class slabs (thread-safe)
 >> myBlockSize - size of a memory block
 >> myBlockNum  - number of memory blocks
 >> myBufSize - size of buffer
@@ -136,8 +142,11 @@ void XMem::Initialize(int myDevID, MEMPOOL_MODE myMode, MTYPE myBlockSize, int m
     curBlockID = 0;
     finalBlockID = 0;
 
+    /* in the slab mode each thread has a buffer of its own */
+    MTYPE myPoolBufSize = myMode == SLAB_FREE ? 0 : myBufSize;
+
     if(myDevID < 0){
-        buf = new char[(unsigned int)myBufSize];
+        buf = new char[(unsigned int)myPoolBufSize];
     }
     else{
 #ifdef USE_CUDA
@@ -145,8 +154,8 @@ void XMem::Initialize(int myDevID, MEMPOOL_MODE myMode, MTYPE myBlockSize, int m
         cudaGetDevice(&devIDBackup);
         SetDevice(myDevID);
 
-        CheckNTErrors(cudaMalloc((void **)&buf, myBufSize) == cudaSuccess, "Cannot allocate the memory.");
-        CheckNTErrors(cudaMemset(buf, 0, myBufSize) == cudaSuccess, "Cannot update the memory.");
+        CheckNTErrors(cudaMalloc((void **)&buf, myPoolBufSize) == cudaSuccess, "Cannot allocate the memory.");
+        CheckNTErrors(cudaMemset(buf, 0, myPoolBufSize) == cudaSuccess, "Cannot update the memory.");
         CheckNTErrors(curandCreateGenerator(&randGen, CURAND_RNG_PSEUDO_DEFAULT) == CURAND_STATUS_SUCCESS, "Cannot make the cuda random number generator!");
         CheckNTErrors(curandSetPseudoRandomGeneratorSeed(randGen, (unsigned)time(NULL)) == CURAND_STATUS_SUCCESS, "Cannot generate the seed!");
 
@@ -169,6 +178,9 @@ void XMem::Initialize(int myDevID, MEMPOOL_MODE myMode, MTYPE myBlockSize, int m
         SetIndex(MILLION);
 #endif
 
+    if (myMode == SLAB_FREE)
+        slab = new XMemSlab(myDevID, myBlockSize, myBufSize);
+
     signature++;
     isInitialized = true;
 }
@@ -188,6 +200,9 @@ void XMem::Free()
     bufSize = 0;
     bufUsed = 0;
 
+    delete slab;
+    slab = NULL;
+
     devID = -1;
 }
 
@@ -381,6 +396,8 @@ void * XMem::Alloc(int myDevID, MTYPE mySize)
 {
     if(mode == FREE_ON_THE_FLY)
         return AllocStandard(myDevID, mySize);
+    else if(mode == SLAB_FREE)
+        return slab->Alloc(mySize);
     else if(isStatic)
         return AllocStatic(myDevID, mySize);
     else
@@ -510,6 +527,24 @@ MTYPE XMem::GetAvailableSize(int myDevID)
     return curBlock->size - curBlock->used;
 }
 
+/*
+get the size of the memory taken from the pool, i.e., the used part of the
+blocks and the buffer. Note that a piece of memory that is released on the
+fly is kept in the pool (for the next allocation) and is still counted.
+In the slab mode it is the size of the slabs.
+<< return - the size in bytes
+*/
+MTYPE XMem::GetUsedSize()
+{
+    if (mode == SLAB_FREE)
+        return slab->GetReservedSize();
+
+    MTYPE size = bufUsed;
+    for (int i = 0; i <= curBlockID && i < blockNum; i++)
+        size += blocks[i].used;
+    return size;
+}
+
 /* 
 require a piece of memory in the buffer
 >> myDevID - device id(-1: CPU memory, >=0: GPU device ID)
@@ -519,6 +554,9 @@ require a piece of memory in the buffer
 */
 void * XMem::AllocBuf(int myDevID, MTYPE mySize, int pitch)
 {
+    if(mode == SLAB_FREE)
+        return slab->AllocBuf(mySize, pitch);
+
     MTYPE backOffset = 0;
 
     if(pitch > 1){
@@ -562,6 +600,8 @@ void XMem::Release(int myDevID, void * p, MTYPE size)
 {
     if(mode == FREE_ON_THE_FLY)
         ReleaseStandard(myDevID, p, size);
+    else if(mode == SLAB_FREE)
+        slab->Release(p, size);
 }
 
 /* 
@@ -572,6 +612,11 @@ release a piece of memory in the buffer
 */
 void XMem::ReleaseBuf(int myDevID, MTYPE mySize, int pitch)
 {
+    if(mode == SLAB_FREE){
+        slab->ReleaseBuf(mySize, pitch);
+        return;
+    }
+
     CheckNTErrors((bufUsed >= mySize), 
                   "Cannot allocate the memory. Please specify a larger buffer in XMem!");
 
@@ -1261,6 +1306,9 @@ void XMem::Clear()
         curBlock = blocks;
         curBlockID = 0;
     }
+    else if (mode == SLAB_FREE) {
+        slab->Clear();
+    }
     else {
         ShowNTErrors("Something is wrong!");
     }
@@ -1271,6 +1319,8 @@ void XMem::Clear()
 /* clear the buffer */
 void XMem::ClearBuf()
 {
+    if(mode == SLAB_FREE)
+        slab->ClearBuf();
     bufUsed = 0;
 }
 
@@ -1379,12 +1429,16 @@ void XMem::BackToPin()
 /* record the pin point for buffer */
 void XMem::SetPinBuf()
 {
+    if(mode == SLAB_FREE)
+        slab->SetPinBuf();
     bufUsedPin = bufUsed;
 }
 
 /* go back to the pin point */
 void XMem::BackToPinBuf()
 {
+    if(mode == SLAB_FREE)
+        slab->BackToPinBuf();
     bufUsed = bufUsedPin;
 }
 
@@ -1500,6 +1554,11 @@ void XMem::CreateBLASHandle()
 /* show profile of the memory pool */
 void XMem::ShowMemUsage(FILE * file)
 {
+    if(mode == SLAB_FREE){
+        slab->ShowMemUsage(file);
+        return;
+    }
+
     MTYPE blockUsed = 0;
     MTYPE blockTotal = 0;
 
@@ -1511,7 +1570,6 @@ void XMem::ShowMemUsage(FILE * file)
     }
 
     MTYPE bufTotal = bufSize;
-    MTYPE bufUsed = bufUsed;
 
     fprintf(file, "block mem:%.1fMB used:%.1fMB usage:%.3f\n",
            (DTYPE)blockTotal/MILLION, (DTYPE)blockUsed/MILLION, (DTYPE)blockUsed/blockTotal);
@@ -1640,6 +1698,10 @@ void XMemManager::Free()
 /* get global memory pool */
 XMem * XMemManager::GetMem(const int devID)
 {
+    /* the thread might have a pool of its own (see SetThreadMem) */
+    if (threadMem != NULL && threadMem->devID == devID)
+        return threadMem;
+
     XMem * mem = NULL;
     if (devID < 0){
         if(!CPUMems[0].isInitialized){
@@ -1675,6 +1737,17 @@ XMem * XMemManager::GetMem(const int devID)
     return mem;
 }
 
+/*
+set the memory pool of the current thread. GetMem() then returns this pool
+(for the same device) on the thread instead of the global one, and the
+tensors created on the thread do not touch the pool of the others.
+>> mem - the memory pool (NULL means that we go back to the global pool)
+*/
+void XMemManager::SetThreadMem(XMem * mem)
+{
+    threadMem = mem;
+}
+
 /* get global memory size */
 int XMemManager::GetMemSize(const int devID, MTYPE * myBlockSize, int * myBlockNum, MTYPE * myBufSize)
 {
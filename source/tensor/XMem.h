@@ -69,10 +69,13 @@ typedef long long          INT_64;
 mode of runnig a memory pool 
 - UNI_FREE: free all memory space when the memory allocation is no use
 - FREE_ON_THE_FLY: run in normal "malloc" and "free" ways
+- SLAB_FREE: run in "malloc" and "free" ways on slabs of power-of-two size
+             classes (see XMemSlab). The pool can be shared by threads.
 */
-enum MEMPOOL_MODE {UNI_FREE, FREE_ON_THE_FLY};
+enum MEMPOOL_MODE {UNI_FREE, FREE_ON_THE_FLY, SLAB_FREE};
     
 struct MPieceNode;
+class XMemSlab;
 
 /* header of a memory piece (FREE_ON_THE_FLY) */
 struct MHeader
@@ -149,7 +152,10 @@ when a small piece of memory is not used any more. Instead we call the "go back"
 function to the initial state when all memory space in the memory pool is not in use.
 Another way (free on-the-fly mode) is to allocate and free the memory space as in standard 
 "malloc" and "free" manners. Here we do it on a pre-allocated memory block. This mode is 
-more flexible but relatively slower than the uni-free mode.
+more flexible but relatively slower than the uni-free mode. The slab mode works in the 
+"malloc" and "free" manners as well, but the memory pieces are of power-of-two sizes and are 
+cached by threads. It is the only mode in which a number of threads can use the same pool 
+at the same time (each of the threads has its own buffer then).
 */
 class XMem
 {
@@ -249,6 +255,9 @@ public:
     /* indicates whether we merge free memory pieces on the fly */
     bool mergeFreeOTF;
 
+    /* the slab allocator (SLAB_FREE) */
+    XMemSlab * slab;
+
 public:
 
     /* constructor */
@@ -319,6 +328,9 @@ public:
     /* get the available size of the memory that can be used */
     MTYPE GetAvailableSize(int myDevID);
 
+    /* get the size of the memory taken from the pool */
+    MTYPE GetUsedSize();
+
     /* require a piece of memory in the buffer */
     void * AllocBuf(int myDevID, MTYPE mySize, int pitch = BUF_PITCH);
 
@@ -470,6 +482,9 @@ public:
     /* get global memory pool */
     XMem * GetMem(const int devID);
 
+    /* set the memory pool of the current thread */
+    void SetThreadMem(XMem * mem);
+
     /* get global memory size */
     int GetMemSize(const int devID, MTYPE * myBlockSize, int * myBlockNum, MTYPE * myBufSize);
 
@@ -0,0 +1,620 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <string.h>
+#include "XMemSlab.h"
+#include "XGlobal.h"
+#include "XUtility.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* the index that means "no batch" */
+#define SLAB_NO_BATCH 0xFFFFFFFF
+
+/* ids of the threads (for the caches). The id of a thread is used again
+   after the thread exits, and the new thread takes over its caches. */
+static std::mutex slabThreadMutex;
+static int slabFreeThreadIDs[SLAB_MAX_THREAD_NUM];
+static int slabFreeThreadIDNum = 0;
+static int slabThreadIDNum = 0;
+
+/* the id of a thread (-1 means that there are too many threads and the
+   thread has no cache) */
+struct XSlabThreadID
+{
+    int id;
+
+    XSlabThreadID()
+    {
+        std::lock_guard<std::mutex> guard(slabThreadMutex);
+        if (slabFreeThreadIDNum > 0)
+            id = slabFreeThreadIDs[--slabFreeThreadIDNum];
+        else if (slabThreadIDNum < SLAB_MAX_THREAD_NUM)
+            id = slabThreadIDNum++;
+        else
+            id = -1;
+    }
+
+    ~XSlabThreadID()
+    {
+        if (id < 0)
+            return;
+        std::lock_guard<std::mutex> guard(slabThreadMutex);
+        slabFreeThreadIDs[slabFreeThreadIDNum++] = id;
+    }
+};
+
+static thread_local XSlabThreadID slabThreadID;
+
+/* raise a high-water mark to the given value */
+static void UpdatePeak(std::atomic<MTYPE> &peak, MTYPE value)
+{
+    MTYPE old = peak.load(std::memory_order_relaxed);
+    while (old < value && !peak.compare_exchange_weak(old, value, std::memory_order_relaxed));
+}
+
+/*
+constructor
+>> myDevID - device id (<0: CPU memory, >=0: GPU device ID)
+>> mySlabSize - maximum size of a slab
+>> myBufSize - size of the buffer of each thread
+*/
+XMemSlab::XMemSlab(int myDevID, MTYPE mySlabSize, MTYPE myBufSize)
+{
+    devID = myDevID;
+    slabSize = MAX(MIN(mySlabSize, (MTYPE)SLAB_MAX_SLAB_SIZE), (MTYPE)1 << SLAB_MIN_CLASS_BITS);
+    bufSize = myBufSize;
+
+    slabs = NULL;
+    slabNum = 0;
+    largePieces = NULL;
+    largeNum = 0;
+    for (int i = 0; i < SLAB_CLASS_NUM; i++)
+        depots[i] = SLAB_NO_BATCH;
+    emptyBatches = SLAB_NO_BATCH;
+    for (int i = 0; i < SLAB_MAX_BATCH_CHUNK_NUM; i++)
+        batchChunks[i] = NULL;
+    batchNum = 0;
+    for (int i = 0; i < SLAB_MAX_THREAD_NUM; i++)
+        caches[i] = NULL;
+
+    requestedSize = 0;
+    usedSize = 0;
+    reservedSize = 0;
+    peakRequestedSize = 0;
+    peakUsedSize = 0;
+}
+
+/* de-constructor */
+XMemSlab::~XMemSlab()
+{
+    Clear();
+
+    for (int i = 0; i < SLAB_MAX_BATCH_CHUNK_NUM; i++)
+        delete[] batchChunks[i].load();
+
+    for (int i = 0; i < SLAB_MAX_THREAD_NUM; i++) {
+        if (caches[i] == NULL)
+            continue;
+        if (caches[i]->buf != NULL)
+            XMemFreeOnDev(devID, caches[i]->buf);
+        delete caches[i];
+    }
+}
+
+/*
+get the size class of a piece of memory, i.e., the piece is rounded
+up to 2^(SLAB_MIN_CLASS_BITS + class) bytes
+>> mySize - size of the memory
+<< return - the size class
+*/
+int XMemSlab::GetSizeClass(MTYPE mySize)
+{
+    int sizeClass = 0;
+    MTYPE classSize = (MTYPE)1 << SLAB_MIN_CLASS_BITS;
+    while (classSize < mySize) {
+        classSize <<= 1;
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+/* get the batch of a given index */
+XSlabBatch * XMemSlab::GetBatch(unsigned int index)
+{
+    return batchChunks[index / SLAB_BATCH_CHUNK_SIZE].load(std::memory_order_acquire) +
+           index % SLAB_BATCH_CHUNK_SIZE;
+}
+
+/*
+push a batch onto a stack
+>> stack - head of the stack
+>> index - index of the batch
+*/
+void XMemSlab::PushBatch(std::atomic<MTYPE> &stack, unsigned int index)
+{
+    XSlabBatch * batch = GetBatch(index);
+    MTYPE head = stack.load(std::memory_order_relaxed);
+    MTYPE newHead;
+    do {
+        batch->next.store((unsigned int)head, std::memory_order_relaxed);
+        newHead = (((head >> 32) + 1) << 32) | index;
+    } while (!stack.compare_exchange_weak(head, newHead, std::memory_order_release,
+                                          std::memory_order_relaxed));
+}
+
+/*
+pop a batch from a stack
+>> stack - head of the stack
+<< return - index of the batch (SLAB_NO_BATCH if the stack is empty)
+*/
+unsigned int XMemSlab::PopBatch(std::atomic<MTYPE> &stack)
+{
+    MTYPE head = stack.load(std::memory_order_acquire);
+    while (true) {
+        unsigned int index = (unsigned int)head;
+        if (index == SLAB_NO_BATCH)
+            return SLAB_NO_BATCH;
+
+        /* the batch might be taken by another thread in the meantime. The tag
+           makes sure that the head is not updated with a "next" that is out of date. */
+        unsigned int next = GetBatch(index)->next.load(std::memory_order_relaxed);
+        MTYPE newHead = (((head >> 32) + 1) << 32) | next;
+        if (stack.compare_exchange_weak(head, newHead, std::memory_order_acquire,
+                                        std::memory_order_acquire))
+            return index;
+    }
+}
+
+/*
+get a batch that is not in use
+<< return - index of the batch
+*/
+unsigned int XMemSlab::NewBatch()
+{
+    unsigned int index = PopBatch(emptyBatches);
+    if (index != SLAB_NO_BATCH)
+        return index;
+
+    index = batchNum.fetch_add(1);
+    unsigned int chunk = index / SLAB_BATCH_CHUNK_SIZE;
+    CheckNTErrors(chunk < SLAB_MAX_BATCH_CHUNK_NUM, "Too many batches in the memory pool!");
+
+    if (batchChunks[chunk].load(std::memory_order_acquire) == NULL) {
+        XSlabBatch * newChunk = new XSlabBatch[SLAB_BATCH_CHUNK_SIZE];
+        XSlabBatch * expected = NULL;
+        if (!batchChunks[chunk].compare_exchange_strong(expected, newChunk, std::memory_order_acq_rel))
+            delete[] newChunk;
+    }
+
+    return index;
+}
+
+/*
+get a batch of free pieces of a size class. We cut a new slab if the depot is empty.
+>> sizeClass - the size class
+<< return - index of the batch (with at least one piece)
+*/
+unsigned int XMemSlab::TakeBatch(int sizeClass)
+{
+    unsigned int index = PopBatch(depots[sizeClass]);
+    if (index == SLAB_NO_BATCH)
+        index = NewSlab(sizeClass);
+    return index;
+}
+
+/*
+cut a new slab into pieces of a size class. The pieces go to the
+depot except the first batch.
+>> sizeClass - the size class
+<< return - index of the first batch
+*/
+unsigned int XMemSlab::NewSlab(int sizeClass)
+{
+    MTYPE size = (MTYPE)1 << (sizeClass + SLAB_MIN_CLASS_BITS);
+    MTYPE mySlabSize = MIN(slabSize, MAX(size * SLAB_PIECE_NUM, (MTYPE)SLAB_MIN_SLAB_SIZE));
+    int pieceNum = (int)MAX(mySlabSize / size, (MTYPE)1);
+
+    XSlab * slab = new XSlab;
+    slab->size = size * pieceNum;
+    slab->mem = XMemAllocOnDev(devID, slab->size);
+    slab->next = slabs.load(std::memory_order_relaxed);
+    while (!slabs.compare_exchange_weak(slab->next, slab, std::memory_order_release,
+                                        std::memory_order_relaxed));
+
+    slabNum.fetch_add(1, std::memory_order_relaxed);
+    reservedSize.fetch_add(slab->size, std::memory_order_relaxed);
+
+    int batchSize = MAX(GetBatchSize(sizeClass), 1);
+    unsigned int first = SLAB_NO_BATCH;
+    for (int i = 0; i < pieceNum;) {
+        unsigned int index = NewBatch();
+        XSlabBatch * batch = GetBatch(index);
+        batch->count = 0;
+        while (batch->count < batchSize && i < pieceNum)
+            batch->pieces[batch->count++] = (char*)slab->mem + size * i++;
+
+        if (first == SLAB_NO_BATCH)
+            first = index;
+        else
+            PushBatch(depots[sizeClass], index);
+    }
+
+    return first;
+}
+
+/*
+get the cache of the current thread
+<< return - the cache (NULL if the thread has no cache)
+*/
+XSlabCache * XMemSlab::GetCache()
+{
+    int id = slabThreadID.id;
+    if (id < 0)
+        return NULL;
+
+    if (caches[id] == NULL) {
+        caches[id] = new XSlabCache;
+        memset(caches[id], 0, sizeof(XSlabCache));
+    }
+
+    return caches[id];
+}
+
+/*
+get the number of pieces moved between a cache and the depot at a time
+>> sizeClass - the size class
+<< return - the number of pieces (0 means that the pieces are not cached)
+*/
+int XMemSlab::GetBatchSize(int sizeClass)
+{
+    MTYPE size = (MTYPE)1 << (sizeClass + SLAB_MIN_CLASS_BITS);
+    if (size > SLAB_BATCH_BYTES)
+        return 0;
+    return (int)MIN((MTYPE)SLAB_BATCH_BYTES / size, (MTYPE)SLAB_BATCH_SIZE);
+}
+
+/*
+update the statistics for an allocation
+>> requested - size the user asks for
+>> used - size of the piece
+*/
+void XMemSlab::AddUsage(MTYPE requested, MTYPE used)
+{
+    UpdatePeak(peakRequestedSize, requestedSize.fetch_add(requested, std::memory_order_relaxed) + requested);
+    UpdatePeak(peakUsedSize, usedSize.fetch_add(used, std::memory_order_relaxed) + used);
+}
+
+/*
+check if a piece of memory is too big for the slabs, i.e., its size class is
+bigger than a slab. Such a piece would have a slab of its own, and it would
+waste up to a half of the memory in rounding up.
+>> mySize - size of the memory
+<< return - whether we allocate it from the device directly
+*/
+bool XMemSlab::IsLarge(MTYPE mySize)
+{
+    return ((MTYPE)1 << (GetSizeClass(mySize) + SLAB_MIN_CLASS_BITS)) > slabSize;
+}
+
+/*
+allocate a big piece of memory from the device. It is of the exact size and
+is not cached by the pool.
+>> mySize - size of the memory
+<< return - the pointer to the memory
+*/
+void * XMemSlab::AllocLarge(MTYPE mySize)
+{
+    XSlab * piece = new XSlab;
+    piece->size = mySize;
+    piece->mem = XMemAllocOnDev(devID, mySize);
+
+    {
+        std::lock_guard<std::mutex> guard(largeMutex);
+        piece->next = largePieces;
+        largePieces = piece;
+    }
+
+    largeNum.fetch_add(1, std::memory_order_relaxed);
+    reservedSize.fetch_add(mySize, std::memory_order_relaxed);
+    AddUsage(mySize, mySize);
+
+    return piece->mem;
+}
+
+/*
+give a big piece of memory back to the device
+>> p - the pointer to the memory
+>> mySize - size of the memory (the same as that in the allocation)
+*/
+void XMemSlab::ReleaseLarge(void * p, MTYPE mySize)
+{
+    XSlab * piece = NULL;
+
+    {
+        std::lock_guard<std::mutex> guard(largeMutex);
+        XSlab ** last = &largePieces;
+        while (*last != NULL && (*last)->mem != p)
+            last = &(*last)->next;
+        piece = *last;
+        if (piece != NULL)
+            *last = piece->next;
+    }
+
+    CheckNTErrors(piece != NULL && piece->size == mySize, "Illegal release of a big piece of memory!");
+
+    XMemFreeOnDev(devID, piece->mem);
+    delete piece;
+
+    largeNum.fetch_sub(1, std::memory_order_relaxed);
+    reservedSize.fetch_sub(mySize, std::memory_order_relaxed);
+    requestedSize.fetch_sub(mySize, std::memory_order_relaxed);
+    usedSize.fetch_sub(mySize, std::memory_order_relaxed);
+}
+
+/*
+allocate a piece of memory. It takes a free piece from the cache of the thread,
+or a batch of pieces from the depot when the cache is empty. A piece that is
+too big for the slabs is allocated from the device directly.
+>> mySize - size of the memory
+<< return - the pointer to the memory
+*/
+void * XMemSlab::Alloc(MTYPE mySize)
+{
+    if (IsLarge(mySize))
+        return AllocLarge(mySize);
+
+    int sizeClass = GetSizeClass(mySize);
+    CheckNTErrors(sizeClass < SLAB_CLASS_NUM, "The required memory is too big!");
+
+    int batchSize = GetBatchSize(sizeClass);
+    XSlabCache * cache = batchSize > 0 ? GetCache() : NULL;
+    void * p = NULL;
+
+    if (cache != NULL) {
+        int &count = cache->count[sizeClass];
+        if (count == 0) {
+            unsigned int index = TakeBatch(sizeClass);
+            XSlabBatch * batch = GetBatch(index);
+            memcpy(cache->pieces[sizeClass], batch->pieces, sizeof(void*) * batch->count);
+            count = batch->count;
+            PushBatch(emptyBatches, index);
+        }
+        p = cache->pieces[sizeClass][--count];
+    }
+    else {
+        unsigned int index = TakeBatch(sizeClass);
+        XSlabBatch * batch = GetBatch(index);
+        p = batch->pieces[--batch->count];
+        if (batch->count > 0)
+            PushBatch(depots[sizeClass], index);
+        else
+            PushBatch(emptyBatches, index);
+    }
+
+    AddUsage(mySize, (MTYPE)1 << (sizeClass + SLAB_MIN_CLASS_BITS));
+
+    return p;
+}
+
+/*
+release a piece of memory. The piece goes to the cache of the thread (it might
+be allocated by another thread), and half of the cache goes to the depot when
+the cache is full. A piece that is too big for the slabs goes back to the device.
+>> p - the pointer to the memory
+>> mySize - size of the memory (the same as that in the allocation)
+*/
+void XMemSlab::Release(void * p, MTYPE mySize)
+{
+    if (p == NULL)
+        return;
+
+    if (IsLarge(mySize)) {
+        ReleaseLarge(p, mySize);
+        return;
+    }
+
+    int sizeClass = GetSizeClass(mySize);
+    CheckNTErrors(sizeClass < SLAB_CLASS_NUM, "Illegal memory size!");
+
+    int batchSize = GetBatchSize(sizeClass);
+    XSlabCache * cache = batchSize > 0 ? GetCache() : NULL;
+
+    if (cache != NULL) {
+        int &count = cache->count[sizeClass];
+        if (count == batchSize * 2) {
+            unsigned int index = NewBatch();
+            XSlabBatch * batch = GetBatch(index);
+            count -= batchSize;
+            memcpy(batch->pieces, cache->pieces[sizeClass] + count, sizeof(void*) * batchSize);
+            batch->count = batchSize;
+            PushBatch(depots[sizeClass], index);
+        }
+        cache->pieces[sizeClass][count++] = p;
+    }
+    else {
+        unsigned int index = NewBatch();
+        XSlabBatch * batch = GetBatch(index);
+        batch->pieces[0] = p;
+        batch->count = 1;
+        PushBatch(depots[sizeClass], index);
+    }
+
+    requestedSize.fetch_sub(mySize, std::memory_order_relaxed);
+    usedSize.fetch_sub((MTYPE)1 << (sizeClass + SLAB_MIN_CLASS_BITS), std::memory_order_relaxed);
+}
+
+/*
+allocate a piece of memory in the buffer of the current thread
+>> mySize - size of the memory
+>> pitch - pitch for aligned memory
+<< return - the head pointer of the memory
+*/
+void * XMemSlab::AllocBuf(MTYPE mySize, int pitch)
+{
+    XSlabCache * cache = GetCache();
+    CheckNTErrors(cache != NULL, "Too many threads use the memory pool!");
+
+    if (cache->buf == NULL && bufSize > 0)
+        cache->buf = XMemAllocOnDev(devID, bufSize);
+
+    MTYPE backOffset = 0;
+    if (pitch > 1) {
+        MTYPE address = (MTYPE)((char*)cache->buf + cache->bufUsed);
+        int offset = address % pitch;
+        backOffset = offset > 0 ? pitch - offset : 0;
+    }
+
+    CheckNTErrors(bufSize >= cache->bufUsed + mySize + backOffset,
+                  "Cannot allocate the memory. Please specify a larger buffer in XMem!");
+
+    char * required = (char*)cache->buf + cache->bufUsed + backOffset;
+    cache->bufUsed += mySize + backOffset;
+
+    return required;
+}
+
+/*
+release a piece of memory in the buffer of the current thread
+>> mySize - size of the memory
+>> pitch - pitch for aligned memory
+*/
+void XMemSlab::ReleaseBuf(MTYPE mySize, int pitch)
+{
+    XSlabCache * cache = GetCache();
+    CheckNTErrors(cache != NULL && cache->bufUsed >= mySize, "Illegal release of the buffer!");
+
+    MTYPE backOffset = 0;
+    if (pitch > 1) {
+        MTYPE address = (MTYPE)((char*)cache->buf + (cache->bufUsed - mySize));
+        backOffset = address % pitch;
+    }
+
+    cache->bufUsed -= (mySize + backOffset);
+}
+
+/* record the pin point for the buffer of the current thread */
+void XMemSlab::SetPinBuf()
+{
+    XSlabCache * cache = GetCache();
+    CheckNTErrors(cache != NULL, "Too many threads use the memory pool!");
+    cache->bufUsedPin = cache->bufUsed;
+}
+
+/* go back to the pin point for the buffer of the current thread */
+void XMemSlab::BackToPinBuf()
+{
+    XSlabCache * cache = GetCache();
+    CheckNTErrors(cache != NULL, "Too many threads use the memory pool!");
+    cache->bufUsed = cache->bufUsedPin;
+}
+
+/* clear the buffer of the current thread */
+void XMemSlab::ClearBuf()
+{
+    XSlabCache * cache = GetCache();
+    if (cache != NULL)
+        cache->bufUsed = 0;
+}
+
+/*
+free all the memory pieces and give the slabs back to the device.
+No other thread can use the pool at the same time.
+*/
+void XMemSlab::Clear()
+{
+    XSlab * slab = slabs.load();
+    while (slab != NULL) {
+        XSlab * next = slab->next;
+        XMemFreeOnDev(devID, slab->mem);
+        delete slab;
+        slab = next;
+    }
+    slabs = NULL;
+    slabNum = 0;
+
+    XSlab * piece = largePieces;
+    while (piece != NULL) {
+        XSlab * next = piece->next;
+        XMemFreeOnDev(devID, piece->mem);
+        delete piece;
+        piece = next;
+    }
+    largePieces = NULL;
+    largeNum = 0;
+
+    for (int i = 0; i < SLAB_CLASS_NUM; i++)
+        depots[i] = SLAB_NO_BATCH;
+    emptyBatches = SLAB_NO_BATCH;
+    batchNum = 0;
+
+    for (int i = 0; i < SLAB_MAX_THREAD_NUM; i++) {
+        if (caches[i] == NULL)
+            continue;
+        memset(caches[i]->count, 0, sizeof(int) * SLAB_CLASS_NUM);
+        caches[i]->bufUsed = 0;
+        caches[i]->bufUsedPin = 0;
+    }
+
+    requestedSize = 0;
+    usedSize = 0;
+    reservedSize = 0;
+}
+
+/* get the size of the memory obtained from the device */
+MTYPE XMemSlab::GetReservedSize()
+{
+    return reservedSize.load(std::memory_order_relaxed);
+}
+
+/*
+show the usage of the memory. The internal fragmentation is the part of the
+pieces in use that is wasted in rounding up to the size classes, and the
+cached free memory is the part of the memory we obtain from the device that
+is free but kept by the pool (in the caches and the depot) for reuse.
+>> file - where to print
+*/
+void XMemSlab::ShowMemUsage(FILE * file)
+{
+    MTYPE reserved = reservedSize.load();
+    MTYPE used = usedSize.load();
+    MTYPE requested = requestedSize.load();
+
+    int threadNum = 0;
+    for (int i = 0; i < SLAB_MAX_THREAD_NUM; i++) {
+        if (caches[i] != NULL)
+            threadNum++;
+    }
+
+    DTYPE internalFrag = used > 0 ? 1.0F - (DTYPE)requested / used : 0;
+    DTYPE cachedFree = reserved > 0 ? 1.0F - (DTYPE)used / reserved : 0;
+
+    fprintf(file, "slab mem:%.1fMB used:%.1fMB requested:%.1fMB slabs:%d big pieces:%d threads:%d\n",
+            (DTYPE)reserved / 1024 / 1024, (DTYPE)used / 1024 / 1024, (DTYPE)requested / 1024 / 1024,
+            slabNum.load(), largeNum.load(), threadNum);
+    fprintf(file, "slab peak used:%.1fMB peak requested:%.1fMB\n",
+            (DTYPE)peakUsedSize.load() / 1024 / 1024, (DTYPE)peakRequestedSize.load() / 1024 / 1024);
+    fprintf(file, "slab internal fragmentation:%.3f cached free:%.3f\n", internalFrag, cachedFree);
+    fprintf(file, "buffer mem:%.1fMB (for each thread)\n", (DTYPE)bufSize / 1024 / 1024);
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
@@ -0,0 +1,261 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ *
+ * The slab allocator behind the SLAB_FREE mode of XMem. A request is rounded
+ * up to a power of two (a size class) and served by a piece of a slab, i.e.,
+ * a big piece of memory of the device that is cut into pieces of the same
+ * class. The free pieces are kept in the cache of each thread and in a shared
+ * depot of batches. The depot is a lock-free stack so that a number of threads
+ * (e.g., the decoding workers) can allocate and free memory with the same pool.
+ * Nothing is written into the pieces, so it works for GPU memory as well.
+ * A request that is bigger than a slab is not rounded up. It is allocated
+ * from the device directly and goes back to the device when it is released.
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ *
+ */
+
+#ifndef __XMEMSLAB_H__
+#define __XMEMSLAB_H__
+
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include "XMem.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* the smallest size class is 2^SLAB_MIN_CLASS_BITS bytes */
+#define SLAB_MIN_CLASS_BITS 8
+
+/* number of the size classes (2^8 bytes ... 2^39 bytes) */
+#define SLAB_CLASS_NUM 32
+
+/* maximum number of the free pieces in a batch */
+#define SLAB_BATCH_SIZE 32
+
+/* maximum size of a batch (in bytes). The bigger pieces are not cached by threads. */
+#define SLAB_BATCH_BYTES (1 << 20)
+
+/* minimum and maximum sizes of a slab. A piece that is bigger than a slab is
+   allocated from the device directly. */
+#define SLAB_MIN_SLAB_SIZE (1 << 20)
+#define SLAB_MAX_SLAB_SIZE (1 << 24)
+
+/* number of pieces we want to cut a slab into */
+#define SLAB_PIECE_NUM 16
+
+/* maximum number of threads that have caches */
+#define SLAB_MAX_THREAD_NUM 64
+
+/* number of batches we create at a time */
+#define SLAB_BATCH_CHUNK_SIZE 1024
+
+/* maximum number of the batch chunks */
+#define SLAB_MAX_BATCH_CHUNK_NUM 4096
+
+/* a batch of free pieces of the same size class */
+struct XSlabBatch
+{
+    /* the free pieces */
+    void * pieces[SLAB_BATCH_SIZE];
+
+    /* number of the pieces */
+    int count;
+
+    /* index of the next batch in the stack */
+    std::atomic<unsigned int> next;
+};
+
+/* a slab, i.e., a piece of memory we obtain from the device. It is also
+   used to keep a big piece that is allocated from the device directly. */
+struct XSlab
+{
+    /* where the memory starts */
+    void * mem;
+
+    /* size of the memory */
+    MTYPE size;
+
+    /* the next slab in the list */
+    XSlab * next;
+};
+
+/* the cache of a thread. Only the thread accesses it. */
+struct XSlabCache
+{
+    /* the free pieces of each size class */
+    void * pieces[SLAB_CLASS_NUM][SLAB_BATCH_SIZE * 2];
+
+    /* number of the free pieces of each size class */
+    int count[SLAB_CLASS_NUM];
+
+    /* the buffer of the thread */
+    void * buf;
+
+    /* size of the used buffer */
+    MTYPE bufUsed;
+
+    /* pin of the buffer */
+    MTYPE bufUsedPin;
+};
+
+/* the slab allocator */
+class XMemSlab
+{
+public:
+    /* device id (<0: CPU memory, >=0: GPU device ID) */
+    int devID;
+
+    /* maximum size of a slab */
+    MTYPE slabSize;
+
+    /* size of the buffer of each thread */
+    MTYPE bufSize;
+
+    /* the slabs we obtain from the device (a list that we only push to) */
+    std::atomic<XSlab*> slabs;
+
+    /* number of the slabs */
+    std::atomic<int> slabNum;
+
+    /* the big pieces we obtain from the device directly (see IsLarge()) */
+    XSlab * largePieces;
+
+    /* number of the big pieces */
+    std::atomic<int> largeNum;
+
+    /* the mutex for the list of the big pieces */
+    std::mutex largeMutex;
+
+    /* the depot, i.e., a stack of the batches of free pieces for each size class.
+       The low 32 bits of the head is the index of the top batch and the high 32 bits
+       is a tag that is changed in each update (against the ABA problem). */
+    std::atomic<MTYPE> depots[SLAB_CLASS_NUM];
+
+    /* the stack of the batches that are not in use */
+    std::atomic<MTYPE> emptyBatches;
+
+    /* the batches (in chunks that are never released before the pool is destroyed) */
+    std::atomic<XSlabBatch*> batchChunks[SLAB_MAX_BATCH_CHUNK_NUM];
+
+    /* number of the batches we have created */
+    std::atomic<unsigned int> batchNum;
+
+    /* the cache of each thread (indexed by the id of the thread) */
+    XSlabCache * caches[SLAB_MAX_THREAD_NUM];
+
+    /* size of the memory the user asks for and does not free yet */
+    std::atomic<MTYPE> requestedSize;
+
+    /* size of the pieces in use (after rounding up to the size classes) */
+    std::atomic<MTYPE> usedSize;
+
+    /* size of the memory obtained from the device */
+    std::atomic<MTYPE> reservedSize;
+
+    /* high-water mark of requestedSize */
+    std::atomic<MTYPE> peakRequestedSize;
+
+    /* high-water mark of usedSize */
+    std::atomic<MTYPE> peakUsedSize;
+
+public:
+    /* constructor */
+    XMemSlab(int myDevID, MTYPE mySlabSize, MTYPE myBufSize);
+
+    /* de-constructor */
+    ~XMemSlab();
+
+    /* allocate a piece of memory */
+    void * Alloc(MTYPE mySize);
+
+    /* release a piece of memory */
+    void Release(void * p, MTYPE mySize);
+
+    /* allocate a piece of memory in the buffer of the current thread */
+    void * AllocBuf(MTYPE mySize, int pitch);
+
+    /* release a piece of memory in the buffer of the current thread */
+    void ReleaseBuf(MTYPE mySize, int pitch);
+
+    /* record the pin point for the buffer of the current thread */
+    void SetPinBuf();
+
+    /* go back to the pin point for the buffer of the current thread */
+    void BackToPinBuf();
+
+    /* clear the buffer of the current thread */
+    void ClearBuf();
+
+    /* free all the memory pieces */
+    void Clear();
+
+    /* get the size of the memory obtained from the device */
+    MTYPE GetReservedSize();
+
+    /* show the usage and the fragmentation of the memory */
+    void ShowMemUsage(FILE * file);
+
+    /* check if a piece of memory is too big for the slabs */
+    bool IsLarge(MTYPE mySize);
+
+    /* get the size class of a piece of memory */
+    static
+    int GetSizeClass(MTYPE mySize);
+
+protected:
+    /* get the batch of a given index */
+    XSlabBatch * GetBatch(unsigned int index);
+
+    /* push a batch onto a stack */
+    void PushBatch(std::atomic<MTYPE> &stack, unsigned int index);
+
+    /* pop a batch from a stack */
+    unsigned int PopBatch(std::atomic<MTYPE> &stack);
+
+    /* get a batch that is not in use */
+    unsigned int NewBatch();
+
+    /* get a batch of free pieces of a size class */
+    unsigned int TakeBatch(int sizeClass);
+
+    /* cut a new slab into pieces of a size class */
+    unsigned int NewSlab(int sizeClass);
+
+    /* get the cache of the current thread */
+    XSlabCache * GetCache();
+
+    /* get the number of pieces moved between a cache and the depot at a time */
+    int GetBatchSize(int sizeClass);
+
+    /* update the statistics */
+    void AddUsage(MTYPE requested, MTYPE used);
+
+    /* allocate a big piece of memory from the device */
+    void * AllocLarge(MTYPE mySize);
+
+    /* give a big piece of memory back to the device */
+    void ReleaseLarge(void * p, MTYPE mySize);
+};
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
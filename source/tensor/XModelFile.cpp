@@ -0,0 +1,347 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "XModelFile.h"
+#include "XCall.h"
+#include "XUtility.h"
+#include "core/getandset/ConvertDataType.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* round up an offset to the alignment */
+static long long AlignOffset(long long offset)
+{
+    return (offset + MODEL_FILE_ALIGNMENT - 1) / MODEL_FILE_ALIGNMENT * MODEL_FILE_ALIGNMENT;
+}
+
+/*
+write items into a file
+>> p - the items
+>> itemSize - size of each item
+>> num - number of the items
+>> file - the file
+<< return - whether all the items are written
+*/
+static bool WriteItems(const void * p, size_t itemSize, size_t num, FILE * file)
+{
+    if (num == 0)
+        return true;
+    return fwrite(p, itemSize, num, file) == num;
+}
+
+/* constructor */
+XModelFile::XModelFile()
+{
+    memset(&header, 0, sizeof(header));
+    meta = NULL;
+    entries = NULL;
+    base = NULL;
+    size = 0;
+    isMapped = false;
+}
+
+/* de-constructor */
+XModelFile::~XModelFile()
+{
+    Close();
+}
+
+/*
+check whether a file is in this format
+>> fn - the file name
+<< return - true if the file starts with MODEL_FILE_MAGIC
+*/
+bool XModelFile::IsModelFile(const char * fn)
+{
+    FILE * file = fopen(fn, "rb");
+    if (file == NULL)
+        return false;
+
+    char magic[8];
+    memset(magic, 0, sizeof(magic));
+    size_t readNum = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+
+    return readNum == sizeof(magic) && !strcmp(magic, MODEL_FILE_MAGIC);
+}
+
+/*
+write a list of tensors (and the meta info) into a file. Each tensor is
+identified by its name (see XTensor::SetName) which should be unique.
+>> fn - the file name
+>> myMeta - the meta info, e.g., hyper-parameters of the model
+>> metaNum - number of the integers in the meta info
+>> tensors - the tensors
+*/
+void XModelFile::Dump(const char * fn, const int * myMeta, int metaNum, TensorList * tensors)
+{
+    int tensorNum = tensors->count;
+
+    XModelFileHeader myHeader;
+    memset(&myHeader, 0, sizeof(myHeader));
+    strcpy(myHeader.magic, MODEL_FILE_MAGIC);
+    myHeader.version = MODEL_FILE_VERSION;
+    myHeader.tensorNum = tensorNum;
+    myHeader.metaNum = metaNum;
+    myHeader.alignment = MODEL_FILE_ALIGNMENT;
+
+    /* the index has 64-bit fields, so it starts at a multiple of 8 bytes */
+    long long metaEnd = sizeof(XModelFileHeader) + sizeof(int) * metaNum;
+    myHeader.indexOffset = (metaEnd + sizeof(long long) - 1) / sizeof(long long) * sizeof(long long);
+
+    /* build the index */
+    XModelFileEntry * myEntries = new XModelFileEntry[tensorNum];
+    memset(myEntries, 0, sizeof(XModelFileEntry) * tensorNum);
+
+    long long offset = myHeader.indexOffset + sizeof(XModelFileEntry) * tensorNum;
+
+    for (int i = 0; i < tensorNum; i++) {
+        XTensor * tensor = tensors->GetItem(i);
+        XModelFileEntry &entry = myEntries[i];
+
+        CheckNTErrors(!tensor->isSparse, "Sparse tensors are not supported!");
+        CheckNTErrors(tensor->order <= MODEL_FILE_DIM_NUM, "Too many dimensions!");
+        CheckNTErrors(strlen(tensor->name) > 0, "Tensors must be named before we save them!");
+
+        for (int j = 0; j < i; j++)
+            CheckNTErrors(strcmp(myEntries[j].name, tensor->name), "Duplicated tensor name!");
+
+        strcpy(entry.name, tensor->name);
+        entry.dataType = tensor->dataType;
+        entry.order = tensor->order;
+        memcpy(entry.dimSize, tensor->dimSize, sizeof(int) * tensor->order);
+        entry.offset = AlignOffset(offset);
+        entry.size = (long long)tensor->unitNum * tensor->unitSize;
+
+        offset = entry.offset + entry.size;
+    }
+
+    myHeader.fileSize = offset;
+
+    FILE * file = fopen(fn, "wb");
+    CheckNTErrors(file, "Cannot open the model file");
+
+    char padding[MODEL_FILE_ALIGNMENT];
+    memset(padding, 0, sizeof(padding));
+
+    /* a write fails if the disk is full, and we must not leave a truncated model */
+    bool ok = true;
+    ok = ok && WriteItems(&myHeader, sizeof(XModelFileHeader), 1, file);
+    ok = ok && WriteItems(myMeta, sizeof(int), metaNum, file);
+    ok = ok && WriteItems(padding, 1, (size_t)(myHeader.indexOffset - metaEnd), file);
+    ok = ok && WriteItems(myEntries, sizeof(XModelFileEntry), tensorNum, file);
+
+    long long pos = myHeader.indexOffset + sizeof(XModelFileEntry) * tensorNum;
+
+    for (int i = 0; i < tensorNum && ok; i++) {
+        XTensor * tensor = tensors->GetItem(i);
+        XModelFileEntry &entry = myEntries[i];
+
+        ok = ok && WriteItems(padding, 1, (size_t)(entry.offset - pos), file);
+
+        if (tensor->devID < 0)
+            ok = ok && WriteItems(tensor->data, 1, (size_t)entry.size, file);
+        else {
+            char * d = new char[entry.size];
+            XMemCopy(d, -1, tensor->data, tensor->devID, (size_t)entry.size);
+            ok = ok && WriteItems(d, 1, (size_t)entry.size, file);
+            delete[] d;
+        }
+
+        pos = entry.offset + entry.size;
+    }
+
+    /* the buffered data is written when the file is closed */
+    ok = fclose(file) == 0 && ok;
+
+    delete[] myEntries;
+
+    if (!ok) {
+        remove(fn);
+        XPRINT1(0, stderr, "[ERROR] cannot write the model file \"%s\"\n", fn);
+        ShowNTErrors("Cannot write the model file (is the disk full?)");
+    }
+}
+
+/*
+open a file and map it into memory
+>> fn - the file name
+*/
+void XModelFile::Open(const char * fn)
+{
+    Close();
+
+#ifdef _WIN32
+    /* we simply read the whole file on Windows */
+    FILE * file = fopen(fn, "rb");
+    CheckNTErrors(file, "Cannot open the model file");
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    base = new char[size];
+    size_t readNum = fread(base, 1, (size_t)size, file);
+    fclose(file);
+
+    CheckNTErrors(readNum == (size_t)size, "Cannot read the model file");
+    isMapped = false;
+#else
+    int fd = open(fn, O_RDONLY);
+    CheckNTErrors(fd >= 0, "Cannot open the model file");
+
+    struct stat st;
+    CheckNTErrors(fstat(fd, &st) == 0, "Cannot get the size of the model file");
+    size = (long long)st.st_size;
+
+    /* a private mapping: the pages are shared with other processes until
+       someone writes them (copy-on-write) */
+    void * p = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    CheckNTErrors(p != MAP_FAILED, "Cannot map the model file into memory");
+    base = (char*)p;
+    isMapped = true;
+#endif
+
+    CheckNTErrors(size >= (long long)sizeof(XModelFileHeader), "Broken model file!");
+    memcpy(&header, base, sizeof(XModelFileHeader));
+
+    CheckNTErrors(!strcmp(header.magic, MODEL_FILE_MAGIC), "Not a model file!");
+    CheckNTErrors(header.version >= 1 && header.version <= MODEL_FILE_VERSION,
+                  "Unsupported version of the model file!");
+    CheckNTErrors(header.fileSize == size, "Broken model file!");
+    CheckNTErrors(header.indexOffset + (long long)sizeof(XModelFileEntry) * header.tensorNum <= size,
+                  "Broken model file!");
+
+    meta = (int*)(base + sizeof(XModelFileHeader));
+    entries = (XModelFileEntry*)(base + header.indexOffset);
+
+    for (int i = 0; i < header.tensorNum; i++) {
+        CheckNTErrors(entries[i].offset + entries[i].size <= size, "Broken model file!");
+        CheckNTErrors(entries[i].order <= MODEL_FILE_DIM_NUM, "Broken model file!");
+    }
+}
+
+/* unmap the file */
+void XModelFile::Close()
+{
+    if (base != NULL) {
+#ifdef _WIN32
+        delete[] base;
+#else
+        if (isMapped)
+            munmap(base, (size_t)size);
+#endif
+    }
+
+    memset(&header, 0, sizeof(header));
+    meta = NULL;
+    entries = NULL;
+    base = NULL;
+    size = 0;
+    isMapped = false;
+}
+
+/*
+find a tensor by its name
+>> name - name of the tensor
+<< return - the entry of the tensor (NULL if there is no such a tensor)
+*/
+const XModelFileEntry * XModelFile::Find(const char * name)
+{
+    for (int i = 0; i < header.tensorNum; i++) {
+        if (!strcmp(entries[i].name, name))
+            return entries + i;
+    }
+
+    return NULL;
+}
+
+/*
+get the data of a tensor in memory
+>> entry - the entry of the tensor
+*/
+void * XModelFile::GetData(const XModelFileEntry * entry)
+{
+    return base + entry->offset;
+}
+
+/*
+load a tensor (by its name) from the file. If the tensor is on the CPU and
+has the same data type as in the file, we do not copy the data but let the
+tensor point to the file in memory. Note that the file must be kept open
+as long as we use the tensor.
+>> tensor - the tensor (with a name)
+*/
+void XModelFile::Load(XTensor * tensor)
+{
+    CheckNTErrors(base != NULL, "The model file is not opened!");
+
+    const XModelFileEntry * entry = Find(tensor->name);
+
+    if (entry == NULL) {
+        XPRINT1(0, stderr, "[ERROR] cannot find tensor \"%s\" in the model file\n", tensor->name);
+        ShowNTErrors("Cannot find the tensor!");
+    }
+
+    CheckNTErrors(entry->order == tensor->order, "Unmatched tensor order!");
+    for (int i = 0; i < entry->order; i++)
+        CheckNTErrors(entry->dimSize[i] == tensor->dimSize[i], "Unmatched tensor size!");
+    CheckNTErrors(!tensor->isSparse, "Sparse tensors are not supported!");
+
+    void * d = GetData(entry);
+
+    if (entry->dataType == tensor->dataType) {
+        if (tensor->devID < 0) {
+            /* point to the file in memory (and the tensor does not free it) */
+            tensor->DestroyData();
+            tensor->data = d;
+            tensor->mem = NULL;
+            tensor->signature = 0;
+            tensor->isInGlobalMem = false;
+            tensor->isShared = true;
+        }
+        else {
+            XMemCopy(tensor->data, tensor->devID, d, -1, (size_t)entry->size);
+        }
+    }
+    else {
+        /* convert the data, e.g., FP32 in the file and FP16 in the model */
+        XTensor * tmp = NewTensorV2(entry->order, entry->dimSize, (TENSOR_DATA_TYPE)entry->dataType,
+                                    1.0F, tensor->devID, tensor->mem);
+        XMemCopy(tmp->data, tmp->devID, d, -1, (size_t)entry->size);
+        _ConvertDataType(tmp, tensor);
+        DelTensor(tmp);
+    }
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
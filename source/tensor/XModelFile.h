@@ -0,0 +1,160 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ *
+ * A container of model parameters. The file looks like
+ *
+ *   | header | meta info (int array) | tensor index | tensor data ... |
+ *
+ * where the index records the name, the data type, the shape and the
+ * offset of each tensor, and the data of each tensor is aligned. When we
+ * load a model, the file is mapped into memory and the tensors on the CPU
+ * point to the mapped pages directly. So there is no copy at all, and the
+ * pages are shared by all the processes that load the same model.
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ *
+ */
+
+#ifndef __XMODELFILE_H__
+#define __XMODELFILE_H__
+
+#include "XGlobal.h"
+#include "XTensor.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* the first bytes of the file */
+#define MODEL_FILE_MAGIC "NTMODEL"
+
+/* the current version of the file format */
+#define MODEL_FILE_VERSION 1
+
+/* the data of each tensor starts at a multiple of this number */
+#define MODEL_FILE_ALIGNMENT 64
+
+/* maximum length of tensor names */
+#define MODEL_FILE_NAME_SIZE 64
+
+/* maximum number of dimensions recorded in the file */
+#define MODEL_FILE_DIM_NUM 8
+
+/* header of the model file */
+struct XModelFileHeader
+{
+    /* MODEL_FILE_MAGIC */
+    char magic[8];
+
+    /* version of the format */
+    int version;
+
+    /* number of tensors */
+    int tensorNum;
+
+    /* number of the integers in the meta info */
+    int metaNum;
+
+    /* alignment of the tensor data */
+    int alignment;
+
+    /* where the index starts (a multiple of 8 bytes) */
+    long long indexOffset;
+
+    /* size of the whole file */
+    long long fileSize;
+};
+
+/* an entry of the tensor index */
+struct XModelFileEntry
+{
+    /* name of the tensor */
+    char name[MODEL_FILE_NAME_SIZE];
+
+    /* data type */
+    int dataType;
+
+    /* number of dimensions */
+    int order;
+
+    /* size of each dimension */
+    int dimSize[MODEL_FILE_DIM_NUM];
+
+    /* where the data starts (from the beginning of the file) */
+    long long offset;
+
+    /* size of the data in bytes */
+    long long size;
+};
+
+/* a model file that is mapped into memory */
+class XModelFile
+{
+public:
+    /* header of the file */
+    XModelFileHeader header;
+
+    /* the meta info (e.g., hyper-parameters of the model) */
+    int * meta;
+
+    /* the tensor index */
+    XModelFileEntry * entries;
+
+    /* the beginning of the file in memory */
+    char * base;
+
+    /* size of the file */
+    long long size;
+
+    /* indicates whether the file is mapped (or read into a buffer) */
+    bool isMapped;
+
+public:
+    /* constructor */
+    XModelFile();
+
+    /* de-constructor */
+    ~XModelFile();
+
+    /* check whether a file is in this format */
+    static
+    bool IsModelFile(const char * fn);
+
+    /* write a list of tensors (and the meta info) into a file */
+    static
+    void Dump(const char * fn, const int * myMeta, int metaNum, TensorList * tensors);
+
+    /* open a file and map it into memory */
+    void Open(const char * fn);
+
+    /* unmap the file */
+    void Close();
+
+    /* find a tensor by its name */
+    const XModelFileEntry * Find(const char * name);
+
+    /* get the data of a tensor in memory */
+    void * GetData(const XModelFileEntry * entry);
+
+    /* load a tensor from the file */
+    void Load(XTensor * tensor);
+};
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
@@ -96,7 +96,9 @@ const char * GetOPName(int type)
         else if (type == MATH_SHIFT)
             return "M_SHIFT";
         else if (type == MATH_MULANDSHIFT)
-            return "M_OPERATION";
+            return "M_MULANDSHIFT";
+        else if (type == MATH_MOD)
+            return "M_MOD";
         else if (type == MATH_SIGN)
             return "M_SIGN";
         else if (type == MATH_SUB)
@@ -169,6 +171,8 @@ const char * GetOPName(int type)
             return "F_HARDTANH";
         else if (type == FUNC_IDENTITY)
             return "F_IDENTITY";
+        else if (type == FUNC_LAYERNORM)
+            return "F_LAYERNORM";
         else if (type == FUNC_LOGSOFTMAX)
             return "F_LOGSOFTMAX";
         else if (type == FUNC_RECTIFY)
@@ -181,6 +185,12 @@ const char * GetOPName(int type)
     else if ((type & LOSS_BASE) != 0) {
         if (type == LOSS_CROSSENTROPY)
             return "L_CROSSENTROPY";
+        else if (type == LOSS_SOFTMAXCROSSENTROPY)
+            return "L_SOFTMAXCROSSENTROPY";
+    }
+    else if ((type & NETWORK_BASE) != 0) {
+        if (type == NETWORK_CHECKPOINT)
+            return "N_CHECKPOINT";
     }
     
     return "NULL";
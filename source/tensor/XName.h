@@ -118,13 +118,18 @@ namespace nts { // namespace nts(NiuTrans.Tensor)
 #define FUNC_DROPOUT            FUNCTION_BASE + 1
 #define FUNC_HARDTANH           FUNC_DROPOUT + 1
 #define FUNC_IDENTITY           FUNC_HARDTANH + 1
-#define FUNC_LOGSOFTMAX         FUNC_IDENTITY + 1
+#define FUNC_LAYERNORM          FUNC_IDENTITY + 1
+#define FUNC_LOGSOFTMAX         FUNC_LAYERNORM + 1
 #define FUNC_RECTIFY            FUNC_LOGSOFTMAX + 1
 #define FUNC_SIGMOID            FUNC_RECTIFY + 1
 #define FUNC_SOFTMAX            FUNC_SIGMOID + 1
 
 #define LOSS_BASE               FUNCTION_BASE * 2
 #define LOSS_CROSSENTROPY       LOSS_BASE + 1
+#define LOSS_SOFTMAXCROSSENTROPY LOSS_CROSSENTROPY + 1
+
+#define NETWORK_BASE            LOSS_BASE * 2
+#define NETWORK_CHECKPOINT      NETWORK_BASE + 1
 
 /* get operator name */
 const char * GetOPName(int type);
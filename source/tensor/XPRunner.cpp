@@ -24,6 +24,12 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <string.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <new>
 #include "XPRunner.h"
 #include "XGlobal.h"
 
@@ -37,7 +43,134 @@ that needs to do something parallel, e.g., speed-up matrix operation by
 multi-threading.
 */
 
-XPRunner * globalPRunner = NULL;
+/* the global runner. Each job holds a reference to it, so a runner replaced by
+   SetThreadNum is freed (and its threads are joined) when its last job is done.
+   The holder itself is never freed, i.e., the runner lives until the program exits. */
+static std::shared_ptr<XPRunner> * globalPRunner = new std::shared_ptr<XPRunner>();
+
+/* number of threads for the global runner (0 means all cores) */
+static std::atomic<int> globalThreadNum(0);
+
+/* a lock to create or replace the global runner */
+static std::mutex globalPRunnerMutex;
+
+/* indicates whether the current thread is running a ParallelFor job */
+static thread_local bool isInParallelJob = false;
+
+/* chunks owned by a thread (aligned to avoid false sharing). Note that "new"
+   does not respect the alignment before C++17, so see NewChunkRanges(). */
+struct alignas(64) XChunkRange
+{
+    /* the next chunk to process */
+    std::atomic<int> next;
+
+    /* the end of the chunks */
+    int last;
+};
+
+/* 
+create the chunk ranges of the threads on a 64-byte boundary
+>> num - number of the ranges
+>> buf - the memory we allocate (to free with delete[])
+<< return - the ranges
+*/
+static XChunkRange * NewChunkRanges(int num, char * &buf)
+{
+    buf = new char[sizeof(XChunkRange) * num + alignof(XChunkRange)];
+    size_t offset = (size_t)buf % alignof(XChunkRange);
+    XChunkRange * ranges = (XChunkRange*)(buf + (offset > 0 ? alignof(XChunkRange) - offset : 0));
+    for (int i = 0; i < num; i++)
+        new (ranges + i) XChunkRange();
+    return ranges;
+}
+
+/* a pool of persistent threads */
+struct XThreadPool
+{
+    /* the working threads (the calling thread is not included) */
+    std::vector<std::thread> workers;
+
+    /* a lock to protect the states below */
+    std::mutex mutex;
+
+    /* to wake up the workers */
+    std::condition_variable wakeCond;
+
+    /* to inform the caller that the job is done */
+    std::condition_variable doneCond;
+
+    /* id of the current job */
+    long long generation;
+
+    /* indicates whether the workers should quit */
+    bool toStop;
+
+    /* only one ParallelFor can use the pool at a time */
+    std::mutex busy;
+
+    /* the current job */
+    const PFORFunction * function;
+    int begin;
+    int end;
+    int chunkSize;
+    int activeNum;
+
+    /* chunks of each thread */
+    XChunkRange * ranges;
+
+    /* the memory of the chunks */
+    char * rangeBuf;
+
+    /* number of active workers that have not finished the job */
+    std::atomic<int> unfinished;
+
+    /* process a chunk */
+    void RunChunk(int c)
+    {
+        int b = begin + c * chunkSize;
+        int e = MIN(end, b + chunkSize);
+        (*function)(b, e);
+    }
+
+    /* process the chunks of a thread and then steal from the others */
+    void RunChunks(int id)
+    {
+        for (int s = 0; s < activeNum; s++) {
+            XChunkRange &range = ranges[(id + s) % activeNum];
+            while (true) {
+                int c = range.next.fetch_add(1);
+                if (c >= range.last)
+                    break;
+                RunChunk(c);
+            }
+        }
+    }
+
+    /* the main loop of a worker */
+    void Work(int id)
+    {
+        isInParallelJob = true;
+        long long seen = 0;
+
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCond.wait(lock, [&] {return toStop || generation != seen;});
+            if (toStop)
+                break;
+            seen = generation;
+            int active = activeNum;
+            lock.unlock();
+
+            if (id < active) {
+                RunChunks(id);
+                if (unfinished.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    doneCond.notify_one();
+                }
+            }
+        }
+    }
+};
 
 
 /****************************
@@ -50,19 +183,11 @@ XPRunner::XPRunner()
     method = PRUNNER_SINGLE;
 
     /* multi-threading */
-    threads = NULL;
+    pool = NULL;
     threadNum = 0;
     minimumOPNum = INT_MAX;
     MUTEX_INIT(mutex);
     isMultiThreaded = true;
-    availableThreadNum = 0;
-    runningThreadNum = 0;
-    runningThreads = new int[MAX_THREAD_NUM];
-    memset(runningThreads, 0 ,sizeof(int) * MAX_THREAD_NUM);
-    runningStates = new int[MAX_THREAD_NUM];
-    memset(runningStates, 0 ,sizeof(int) * MAX_THREAD_NUM);
-    availableThreads = new int[MAX_THREAD_NUM];
-    memset(availableThreads, 0 ,sizeof(int) * MAX_THREAD_NUM);
 }
 
 /* deconstructor */
@@ -70,9 +195,6 @@ XPRunner::~XPRunner()
 {
     KillThreads();
     MUTEX_DELE(mutex);
-    delete[] runningThreads;
-    delete[] runningStates;
-    delete[] availableThreads;
 }
 
 /* 
@@ -94,7 +216,7 @@ methods for multi-threading
 
 /* 
 initialization 
->> tNum - number of required threads
+>> tNum - number of required threads (including the calling thread)
 */
 void XPRunner::CreateThreads(int tNum)
 {
@@ -103,48 +225,50 @@ void XPRunner::CreateThreads(int tNum)
         exit(1);
     }
 
-    threads = new XThread[tNum];
-    for(int i = 0; i < tNum; i++){
-        if(!threads[i].Start()){
-            XPRINT1(0, stderr, "[XPRunner::CreateThreads] Error! cannot create thread %d\n", i);
-            exit(1);
-        }
-    }
+    KillThreads();
 
-#ifdef _WIN32
-    Sleep(300);
-#else
-    usleep(300 * 1000);
-#endif
+    pool = new XThreadPool();
+    pool->generation = 0;
+    pool->toStop = false;
+    pool->function = NULL;
+    pool->activeNum = 0;
+    pool->ranges = NewChunkRanges(MAX(tNum, 1), pool->rangeBuf);
+    pool->unfinished = 0;
+
+    for(int i = 1; i < tNum; i++)
+        pool->workers.push_back(std::thread(&XThreadPool::Work, pool, i));
 
     threadNum = tNum;
 
     minimumOPNum = MIN_OPERATION_NUM;
-
-
 }
 
 /* kill all threads */
 void XPRunner::KillThreads()
 {
-    for(int i = 0; i < threadNum; i++){
-        //threads[i].End();
+    if(pool == NULL)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        pool->toStop = true;
     }
-#ifdef    _WIN32
-    //Sleep(300);
-#else
-    //sleep(0.3);
-#endif
-    delete[] threads;
-    threads = NULL;
-}
+    pool->wakeCond.notify_all();
+
+    for(int i = 0; i < (int)pool->workers.size(); i++)
+        pool->workers[i].join();
 
+    delete[] pool->rangeBuf;
+    delete pool;
+    pool = NULL;
+    threadNum = 0;
+}
 
 /* 
 run a set of jobs in parallel 
 >> jobFunctions - the function for each job
 >> jobArgs - the list of arguments for each job
->> sleepTime - time to sleep (in ms) for each round
+>> sleepTime - time to sleep (in ms) for each round (not used any more)
 */
 void XPRunner::Run(TensorList * jobFunctions, TensorList * jobArgs, float sleepTime)
 {
@@ -153,98 +277,75 @@ void XPRunner::Run(TensorList * jobFunctions, TensorList * jobArgs, float sleepT
         exit(1);
     }
 
-    runningThreadNum = 0;
-    availableThreadNum = 0;
+    ParallelFor(0, jobFunctions->count, 1, [&](int beg, int end) {
+        for(int i = beg; i < end; i++){
+            TFunction function = (TFunction)jobFunctions->GetItem(i);
+            volatile TensorList * args = (TensorList*)jobArgs->GetItem(i);
+            function(args);
+        }
+    });
+}
 
-    memset(runningStates, 0, sizeof(int) * MAX_THREAD_NUM);
+/*
+run a function over the items in [begin, end) in parallel. The items are
+cut into chunks of at least "grain" items. We run the job in the current
+thread if it is too small, if the pool is used by another thread or if we
+are already in a parallel job (nested parallelism).
+>> begin - the first item
+>> end - the end of the items (not included)
+>> grain - the minimum number of items of a chunk
+>> function - the job. It is called as function(beg, end) for each chunk.
+*/
+void XPRunner::ParallelFor(int begin, int end, int grain, const PFORFunction &function)
+{
+    int num = end - begin;
+    if(num <= 0)
+        return;
 
-    int c = jobFunctions->count;
-    int unfinished = c;
+    if(grain < 1)
+        grain = 1;
 
-    MUTEX_LOCK(mutex);
+    /* rounding down makes sure that no chunk is smaller than the grain */
+    int maxChunkNum = MAX(num / grain, 1);
+    int workerNum = MIN(threadNum, maxChunkNum);
 
-    while(unfinished > 0){
+    if(workerNum <= 1 || pool == NULL || isInParallelJob || !pool->busy.try_lock()){
+        function(begin, end);
+        return;
+    }
 
-        /* get the list of threads that are ready to process the job */
-        for(int i = 0; i < threadNum; i++){
-            if(runningStates[i] == 2 && threads[i].jobCount == 0){
-                /* a job has been finished*/
-                unfinished--;
-                availableThreads[availableThreadNum++] = i;
-                runningStates[i] = 1;
-#ifdef _WIN32
-                MUTEX_LOCK(threads[i].workingMutex);
-                COND_RESET(threads[i].jobCond);
-                MUTEX_UNLOCK(threads[i].workingMutex);
-#endif
-            }
-            else if(runningStates[i] == 0 && threads[i].jobCount == 0){
-                availableThreads[availableThreadNum++] = i;
-                runningStates[i] = 1;
-#ifdef _WIN32
-                MUTEX_LOCK(threads[i].workingMutex);
-                COND_RESET(threads[i].jobCond);
-                MUTEX_UNLOCK(threads[i].workingMutex);
-#endif
-            }
-        }
+    int chunkNum = MIN(maxChunkNum, workerNum * PFOR_CHUNK_PER_THREAD);
+
+    pool->function = &function;
+    pool->begin = begin;
+    pool->end = end;
+    pool->chunkSize = (int)(((long long)num + chunkNum - 1) / chunkNum);
+    chunkNum = (int)(((long long)num + pool->chunkSize - 1) / pool->chunkSize);
+    pool->activeNum = workerNum;
+    for(int i = 0; i < workerNum; i++){
+        pool->ranges[i].next = (int)((long long)chunkNum * i / workerNum);
+        pool->ranges[i].last = (int)((long long)chunkNum * (i + 1) / workerNum);
+    }
+    pool->unfinished = workerNum - 1;
 
-        /* assign the jobs */
-        for(int i = availableThreadNum - 1; i >= 0 && c > 0; i--){
-            /* the function to run*/
-            TFunction function = (TFunction)jobFunctions->GetItem(jobArgs->count - c);
-
-            /* the arguments that are passed to the function */
-            volatile TensorList * args = (TensorList*)jobArgs->GetItem(jobArgs->count - c);
-
-            /* thread */
-            XThread * thread  = threads + availableThreads[i];
-
-            thread->argv = args;
-            thread->function = function;
-
-            MUTEX_LOCK(thread->workingMutex);
-            thread->working = 1;
-            MUTEX_UNLOCK(thread->workingMutex);
-
-#ifdef USE_PTHREAD
-            MUTEX_LOCK(thread->mutex);
-            thread->jobCount++;
-            MUTEX_UNLOCK(thread->mutex);
-            //COND_BROADCAST(thread->cond);
-            COND_SIGNAL(thread->cond);
-            //MUTEX_UNLOCK(thread->mutex);
-#else
-#ifdef _WIN32
-            /* reset various locks */
-            MUTEX_LOCK(thread->workingMutex);
-            thread->jobCount++;
-            COND_RESET(thread->jobCond);
-            //COND_RESET(thread->gCond);
-            MUTEX_UNLOCK(thread->workingMutex);
-
-            /* inform the job */
-            //ResumeThread(threads[i].hnd);
-            COND_SIGNAL(thread->jobCond);
-#endif
-#endif
-
-            /* a job is under processing */
-            c--;
-            availableThreadNum--;
-            runningStates[availableThreads[i]] = 2;
-        }
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        pool->generation++;
+    }
+    pool->wakeCond.notify_all();
 
-        if(sleepTime > 0){
-#ifdef _WIN32
-            Sleep((DWORD)sleepTime);
-#else
-            sleep(sleepTime/1000);
-#endif
-        }
+    /* the calling thread works as thread 0 */
+    isInParallelJob = true;
+    pool->RunChunks(0);
+    isInParallelJob = false;
+
+    {
+        std::unique_lock<std::mutex> lock(pool->mutex);
+        pool->doneCond.wait(lock, [&] {return pool->unfinished == 0;});
     }
 
-    MUTEX_UNLOCK(mutex);
+    pool->function = NULL;
+    pool->busy.unlock();
 }
 
 /* 
@@ -255,7 +356,82 @@ int XPRunner::GetJobNum(int size)
 {
     int jobNum = int((float)size/minimumOPNum);
 
-    return MIN(jobNum, threadNum);
+    return MAX(MIN(jobNum, threadNum), 1);
+}
+
+/*
+set the number of threads used by the CPU kernels
+>> myThreadNum - number of threads (0 means all cores)
+*/
+void SetThreadNum(int myThreadNum)
+{
+    std::lock_guard<std::mutex> guard(globalPRunnerMutex);
+
+    globalThreadNum.store(myThreadNum);
+
+    std::shared_ptr<XPRunner> runner = std::atomic_load(globalPRunner);
+    int tNum = GetThreadNum();
+
+    if(runner == NULL || runner->threadNum == tNum)
+        return;
+
+    /* other threads might be running jobs with the current runner. They keep
+       it alive until they are done, and then it is freed. */
+    std::shared_ptr<XPRunner> newRunner(new XPRunner());
+    newRunner->Init(tNum);
+
+    std::atomic_store(globalPRunner, newRunner);
+}
+
+/* get the number of threads used by the CPU kernels */
+int GetThreadNum()
+{
+    int num = globalThreadNum;
+
+    if(num <= 0)
+        num = (int)std::thread::hardware_concurrency();
+
+    return MAX(MIN(num, MAX_THREAD_NUM), 1);
+}
+
+/* 
+get the global parallel runner (it is created the first time we need it).
+Please keep the returned reference while using the runner.
+*/
+std::shared_ptr<XPRunner> GetGlobalPRunner()
+{
+    std::shared_ptr<XPRunner> runner = std::atomic_load(globalPRunner);
+
+    if(runner == NULL){
+        std::lock_guard<std::mutex> guard(globalPRunnerMutex);
+        runner = std::atomic_load(globalPRunner);
+        if(runner == NULL){
+            runner.reset(new XPRunner());
+            runner->Init(GetThreadNum());
+            std::atomic_store(globalPRunner, runner);
+        }
+    }
+
+    return runner;
+}
+
+/*
+run a function over the items in [begin, end) with the global parallel runner
+>> begin - the first item
+>> end - the end of the items (not included)
+>> grain - the minimum number of items of a chunk
+>> function - the job. It is called as function(beg, end) for each chunk.
+*/
+void ParallelFor(int begin, int end, int grain, const PFORFunction &function)
+{
+    /* small jobs do not need the pool at all */
+    if(end - begin <= grain){
+        if(end > begin)
+            function(begin, end);
+        return;
+    }
+
+    GetGlobalPRunner()->ParallelFor(begin, end, grain, function);
 }
 
 } /* end of the nts (NiuTrans.Tensor) namespace */
@@ -24,6 +24,8 @@
 #ifndef __XPRUNNER_H__
 #define __XPRUNNER_H__
 
+#include <functional>
+#include <memory>
 #include "XThread.h"
 #include "XList.h"
 
@@ -32,17 +34,34 @@ namespace nts{
 
 #define MIN_OPERATION_NUM 1024 * 4
 #define MAX_JOB_NUM 32
-#define MAX_THREAD_NUM 32
+#define MAX_THREAD_NUM 256
+
+/* number of chunks a thread gets in ParallelFor (more chunks = better load balance) */
+#define PFOR_CHUNK_PER_THREAD 4
+
+/* minimum number of items of a chunk in simple element-wise operations */
+#define PFOR_ELEMENT_GRAIN (1024 * 16)
 
 #define PRUNNER_SINGLE 0
 #define PRUNNER_MULTIPLE 1
 #define PRUNNER_GPU 2
 
+/* a job of ParallelFor. It processes the items in [beg, end). */
+typedef std::function<void(int, int)> PFORFunction;
+
+/* the thread pool (see XPRunner.cpp) */
+struct XThreadPool;
+
 /*
 The XPRunner maintains a the parallel processing resources, e.g., a pool
 of threads. It can provide the parallel computation interface for someone
 that needs to do something parallel, e.g., speed-up matrix operation by
 multi-threading.
+
+The threads are created once and then sleep until a job comes. A job is
+cut into chunks and each thread has its own list of chunks. A thread that
+runs out of chunks steals chunks from the others. The calling thread always
+works as one of the threads, so "threadNum" threads run in total.
 */
 class XPRunner
 {
@@ -53,10 +72,10 @@ public:
     */
     int method;
 public:
-    /* a set of threads */
-    XThread * threads;
+    /* the pool of (persistent) threads */
+    XThreadPool * pool;
 
-    /* max number of threads */
+    /* number of threads (including the calling thread) */
     int threadNum;
 
     /* a mutex lock */
@@ -71,21 +90,6 @@ public:
     /* if multi-threading is activated */
     bool isMultiThreaded;
 
-    /* list of running threads */
-    int * runningThreads;
-
-     /* list of threads states */
-    int * runningStates;
-
-    /* number of running threads */
-    int runningThreadNum;
-
-    /* list of available threads */
-    int * availableThreads;
-
-    /* number of available threads */
-    int availableThreadNum;
-
 /* general methods */
 public:
     /* constructor */
@@ -108,12 +112,25 @@ public:
     /* run a set of jobs in parallel */
     void Run(TensorList * jobFunctions, TensorList * jobArgs, float sleepTime = 0);
 
+    /* run a function over the items in [begin, end) in parallel */
+    void ParallelFor(int begin, int end, int grain, const PFORFunction &function);
+
     /* get the number of parallel jobs to run */
     int GetJobNum(int size);
 };
 
-extern XPRunner * globalPRunner;
+/* set the number of threads used by the CPU kernels (0 means all cores) */
+void SetThreadNum(int myThreadNum);
+
+/* get the number of threads used by the CPU kernels */
+int GetThreadNum();
+
+/* get the global parallel runner (it is created the first time we need it) */
+std::shared_ptr<XPRunner> GetGlobalPRunner();
+
+/* run a function over the items in [begin, end) with the global parallel runner */
+void ParallelFor(int begin, int end, int grain, const PFORFunction &function);
 
 } /* end of the nts (NiuTrans.Tensor) namespace */
 
-#endif
\ No newline at end of file
+#endif
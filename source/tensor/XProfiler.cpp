@@ -0,0 +1,427 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University. 
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+
+#include "XProfiler.h"
+#include "XTensor.h"
+#include "XName.h"
+#include "XDevice.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* the global profiler */
+XProfiler GProfiler;
+
+/* depth of the ops (and the backward steps) that are running on the thread */
+static thread_local int opDepth = 0;
+
+/* id of the thread on the timeline */
+static thread_local int threadID = -1;
+static std::atomic<int> threadCount(0);
+
+/* get the clock time (in microseconds) */
+static double GetClock()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() / 1000.0;
+}
+
+/*
+estimate the cost of an op. The number of floating-point operations is
+2 * M * N * K for the matrix products and the number of the elements of the
+largest tensor for the others. The number of bytes is the size of the input
+and output tensors.
+>> typeID - type of the op
+>> h - the output of the op
+>> tails - the inputs of the op
+>> tailNum - number of the inputs
+>> flops - the number of floating-point operations
+>> bytes - the number of bytes
+*/
+static void EstimateCost(int typeID, const XTensor * h, const XTensor * const * tails, int tailNum,
+                         double &flops, double &bytes)
+{
+    flops = 0;
+    bytes = 0;
+
+    if (h == NULL)
+        return;
+
+    double maxNum = h->unitNum;
+    bytes = (double)h->unitNum * h->unitSize;
+
+    for (int i = 0; i < tailNum; i++) {
+        const XTensor * t = tails[i];
+        if (t == NULL)
+            continue;
+        bytes += (double)t->unitNum * t->unitSize;
+        maxNum = MAX(maxNum, (double)t->unitNum);
+    }
+
+    if ((typeID == MATH_MATRIXMUL || typeID == MATH_MATRIXMULBATCHED ||
+         typeID == MATH_MULANDSHIFT) && tailNum >= 2 &&
+         tails[0] != NULL && tails[1] != NULL && h->unitNum > 0) {
+        const XTensor * a = tails[0];
+        const XTensor * b = tails[1];
+
+        /* a = (batch, m, k), b = (batch, k, n) or (k, n) and h = (batch, m, n) */
+        double batch = 1;
+        for (int i = 0; i < b->order - 2; i++)
+            batch *= b->dimSize[i];
+
+        double k = sqrt((double)a->unitNum * b->unitNum / ((double)h->unitNum * batch));
+        flops = 2.0 * h->unitNum * k;
+    }
+    else
+        flops = maxNum;
+}
+
+/*
+wait until the jobs on the device of a tensor are done (for GPUs). The
+kernels run asynchronously and would not be timed otherwise.
+>> t - the tensor
+*/
+static void SyncDevice(const XTensor * t)
+{
+#ifdef USE_CUDA
+    if (t == NULL || t->devID < 0)
+        return;
+
+    int devIDBackup = XDevice::GetGPUDevice();
+    if (t->devID != devIDBackup)
+        XDevice::SetGPUDevice(t->devID);
+    cudaDeviceSynchronize();
+    if (t->devID != devIDBackup)
+        XDevice::SetGPUDevice(devIDBackup);
+#endif
+}
+
+/* get the size of the memory taken from the pool of a tensor */
+static double GetMemUsed(const XTensor * h)
+{
+    return (h != NULL && h->mem != NULL) ? (double)h->mem->GetUsedSize() : 0;
+}
+
+/* constructor */
+XProfiler::XProfiler()
+{
+    isEnabled = false;
+    startTime = 0;
+    droppedEventNum = 0;
+}
+
+/* de-constructor */
+XProfiler::~XProfiler()
+{
+}
+
+/* clear all the records and start profiling */
+void XProfiler::Start()
+{
+    std::lock_guard<std::mutex> guard(statMutex);
+
+    events.clear();
+    stats.clear();
+    droppedEventNum = 0;
+    startTime = GetClock();
+    opDepth = 0;
+    isEnabled = true;
+}
+
+/* stop profiling */
+void XProfiler::Stop()
+{
+    isEnabled = false;
+}
+
+/* get the time (in microseconds) since the profiler started */
+double XProfiler::GetTime()
+{
+    return GetClock() - startTime;
+}
+
+/*
+mark the beginning of an op. Only the outermost op on the thread is timed.
+>> c - the output of the op
+<< return - the start time (<0 if the op is called in another op)
+*/
+double XProfiler::BeginOp(const XTensor * c)
+{
+    if (opDepth++ > 0)
+        return -1;
+
+    /* the previous jobs on the device are not counted in this op */
+    SyncDevice(c);
+
+    return GetClock();
+}
+
+/*
+record an op
+>> typeID - type of the op (see XName.h)
+>> a - the first input
+>> b - the second input (it can be NULL)
+>> c - the output
+>> start - the start time (see BeginOp())
+*/
+void XProfiler::AddOp(int typeID, const XTensor * a, const XTensor * b, const XTensor * c, double start)
+{
+    opDepth--;
+
+    if (start < 0)
+        return;
+
+    SyncDevice(c);
+
+    double end = GetClock();
+    double flops = 0;
+    double bytes = 0;
+    const XTensor * tails[2] = {a, b};
+    EstimateCost(typeID, c, tails, 2, flops, bytes);
+
+    AddEvent(GetOPName(typeID), "forward", start, end, flops, bytes, GetMemUsed(c));
+}
+
+/*
+mark the beginning of the backward computation of a node. The ops called
+in it are counted in the backward step.
+>> node - the node (i.e., the output of the op)
+<< return - the start time
+*/
+double XProfiler::BeginBackward(XTensor * node)
+{
+    opDepth++;
+    SyncDevice(node);
+    return GetClock();
+}
+
+/*
+record the backward computation of a node. We count twice the forward cost,
+i.e., the gradient of each input is about as costly as the op itself.
+>> node - the node (i.e., the output of the op)
+>> start - the start time (see BeginBackward())
+*/
+void XProfiler::AddBackward(XTensor * node, double start)
+{
+    opDepth--;
+    SyncDevice(node);
+
+    double end = GetClock();
+    double flops = 0;
+    double bytes = 0;
+    XLink &income = node->income;
+    EstimateCost(income.typeID, income.head, income.tails, income.tailNum, flops, bytes);
+
+    AddEvent(GetOPName(node->income.typeID), "backward", start, end,
+             flops * 2, bytes * 2, GetMemUsed(node));
+}
+
+/*
+mark the beginning of a region
+<< return - the start time
+*/
+double XProfiler::BeginRegion()
+{
+    return GetClock();
+}
+
+/*
+record a region
+>> name - name of the region (it must be kept until the profiler is done)
+>> start - the start time (see BeginRegion())
+*/
+void XProfiler::AddRegion(const char * name, double start)
+{
+    double end = GetClock();
+
+    AddEvent(name, "region", start, end, 0, 0, 0);
+}
+
+/*
+add an event
+>> name - name of the op or the region
+>> category - category of the event
+>> start - the start time (clock time in microseconds)
+>> end - the end time (clock time in microseconds)
+>> flops - number of floating-point operations
+>> bytes - number of bytes
+>> memUsed - size of the memory taken from the pool
+*/
+void XProfiler::AddEvent(const char * name, const char * category, double start, double end,
+                         double flops, double bytes, double memUsed)
+{
+    if (threadID < 0)
+        threadID = threadCount++;
+
+    std::lock_guard<std::mutex> guard(statMutex);
+
+    std::string key = std::string(category) + ":" + name;
+    auto iter = stats.find(key);
+    if (iter == stats.end()) {
+        XProfileStat stat;
+        stat.name = name;
+        stat.category = category;
+        stat.count = 0;
+        stat.time = 0;
+        stat.flops = 0;
+        stat.bytes = 0;
+        stat.maxMemUsed = 0;
+        iter = stats.insert(std::make_pair(key, stat)).first;
+    }
+
+    XProfileStat &stat = iter->second;
+    stat.count++;
+    stat.time += end - start;
+    stat.flops += flops;
+    stat.bytes += bytes;
+    stat.maxMemUsed = MAX(stat.maxMemUsed, memUsed);
+
+    if (events.size() >= MAX_PROFILE_EVENT_NUM) {
+        droppedEventNum++;
+        return;
+    }
+
+    XProfileEvent event;
+    event.name = name;
+    event.category = category;
+    event.thread = threadID;
+    event.start = start - startTime;
+    event.time = end - start;
+    event.flops = flops;
+    event.bytes = bytes;
+    event.memUsed = memUsed;
+    events.push_back(event);
+}
+
+/*
+show the statistics of each op (in the order of the running time)
+>> file - where to show
+*/
+void XProfiler::ShowStats(FILE * file)
+{
+    std::lock_guard<std::mutex> guard(statMutex);
+
+    std::vector<XProfileStat> list;
+    double opTime = 0;
+    for (auto iter = stats.begin(); iter != stats.end(); iter++) {
+        list.push_back(iter->second);
+        if (strcmp(iter->second.category, "region") != 0)
+            opTime += iter->second.time;
+    }
+
+    std::stable_sort(list.begin(), list.end(), [](const XProfileStat &a, const XProfileStat &b) {
+        return a.time > b.time;
+    });
+
+    fprintf(file, "[INFO] profile (elapsed=%.1fs, op time=%.1fs, events=%d, dropped=%d)\n",
+            GetTime() / 1e6, opTime / 1e6, (int)events.size(), droppedEventNum);
+    fprintf(file, "%-9s %-28s %9s %11s %6s %10s %9s %8s %10s\n",
+            "category", "name", "calls", "total(ms)", "%", "avg(us)", "GFLOP/s", "GB/s", "pool(MB)");
+
+    for (size_t i = 0; i < list.size(); i++) {
+        XProfileStat &stat = list[i];
+        bool isRegion = strcmp(stat.category, "region") == 0;
+        double seconds = MAX(stat.time, 1e-3) / 1e6;
+        fprintf(file, "%-9s %-28s %9d %11.3f %6.2f %10.2f %9.3f %8.3f %10.1f\n",
+                stat.category, stat.name, stat.count, stat.time / 1e3,
+                isRegion ? 0.0 : 100.0 * stat.time / MAX(opTime, 1e-3),
+                stat.time / stat.count,
+                stat.flops / seconds / 1e9, stat.bytes / seconds / 1e9,
+                stat.maxMemUsed / 1024 / 1024);
+    }
+}
+
+/*
+dump the timeline in the Chrome trace event format, i.e., a list of
+"complete" events with the time in microseconds
+>> fn - name of the file
+*/
+void XProfiler::DumpTrace(const char * fn)
+{
+    std::lock_guard<std::mutex> guard(statMutex);
+
+    FILE * file = fopen(fn, "w");
+    CheckNTErrors(file, "Cannot open the trace file!");
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < events.size(); i++) {
+        XProfileEvent &event = events[i];
+        fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+                      "\"ts\":%.3f,\"dur\":%.3f,"
+                      "\"args\":{\"flops\":%.0f,\"bytes\":%.0f,\"pool\":%.0f}}%s\n",
+                event.name, event.category, event.thread, event.start, event.time,
+                event.flops, event.bytes, event.memUsed,
+                i + 1 < events.size() ? "," : "");
+    }
+    fprintf(file, "]}\n");
+
+    fclose(file);
+
+    fprintf(stderr, "[INFO] dumped %d events to %s\n", (int)events.size(), fn);
+}
+
+/*
+constructor
+>> myName - name of the region (it must be kept until the profiler is done)
+*/
+XProfileRegion::XProfileRegion(const char * myName)
+{
+    name = myName;
+    start = GProfiler.isEnabled ? GProfiler.BeginRegion() : -1;
+}
+
+/* de-constructor */
+XProfileRegion::~XProfileRegion()
+{
+    if (start >= 0 && GProfiler.isEnabled)
+        GProfiler.AddRegion(name, start);
+}
+
+/*
+constructor
+>> myTypeID - type of the op (see XName.h)
+>> myA - the first input
+>> myB - the second input (it can be NULL)
+>> myC - the output
+*/
+XProfileOp::XProfileOp(int myTypeID, const XTensor * myA, const XTensor * myB, const XTensor * myC)
+{
+    typeID = myTypeID;
+    a = myA;
+    b = myB;
+    c = myC;
+    isSeen = GProfiler.isEnabled;
+    start = isSeen ? GProfiler.BeginOp(c) : -1;
+}
+
+/* de-constructor */
+XProfileOp::~XProfileOp()
+{
+    if (isSeen)
+        GProfiler.AddOp(typeID, a, b, c, start);
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
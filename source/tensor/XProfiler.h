@@ -0,0 +1,231 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2020, Natural Language Processing Lab, Northeastern University. 
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __XPROFILER_H__
+#define __XPROFILER_H__
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "XGlobal.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* cross reference */
+struct XTensor;
+
+/* maximum number of events we keep for the timeline. The events beyond
+   this are counted in the statistics but not written to the trace. */
+#define MAX_PROFILE_EVENT_NUM 1000000
+
+/* a timed op (or region) on the timeline */
+struct XProfileEvent
+{
+    /* name of the op (see XName.h) or the region */
+    const char * name;
+
+    /* category, i.e., "forward", "backward" or "region" */
+    const char * category;
+
+    /* id of the thread */
+    int thread;
+
+    /* start time (in microseconds since the profiler started) */
+    double start;
+
+    /* running time (in microseconds) */
+    double time;
+
+    /* number of floating-point operations (estimated) */
+    double flops;
+
+    /* number of bytes of the input and output tensors */
+    double bytes;
+
+    /* size of the memory taken from the memory pool (in bytes) */
+    double memUsed;
+};
+
+/* statistics of an op (or region) */
+struct XProfileStat
+{
+    /* name of the op or the region */
+    const char * name;
+
+    /* category, i.e., "forward", "backward" or "region" */
+    const char * category;
+
+    /* number of calls */
+    int count;
+
+    /* total running time (in microseconds) */
+    double time;
+
+    /* total number of floating-point operations */
+    double flops;
+
+    /* total number of bytes */
+    double bytes;
+
+    /* the maximum size of the memory taken from the pool */
+    double maxMemUsed;
+};
+
+/*
+The profiler times the tensor ops and the user-defined regions (e.g., the
+forward and backward passes of a training step). An op is timed by an
+XProfileOp guard at its entry (e.g., _MatrixMul()), i.e., it is seen in
+inference and in the calls of the "_" functions as well, whether or not it
+is linked into the network. The backward computation of an op is timed in
+XNet::BackwardNode. An op that is called in another op (or in a backward
+step) is counted in the outer one. For an op on a GPU the device is
+synchronized at both ends, so that the time covers the kernels rather than
+the launches. The profiler is off by default and then costs nothing but a
+flag check. It dumps the statistics of each op and a timeline in the Chrome
+trace event format (open it with chrome://tracing or Perfetto).
+*/
+class XProfiler
+{
+public:
+    /* indicates whether the profiler is running */
+    bool isEnabled;
+
+protected:
+    /* the time when the profiler starts */
+    double startTime;
+
+    /* events on the timeline */
+    std::vector<XProfileEvent> events;
+
+    /* number of the events that are not kept */
+    int droppedEventNum;
+
+    /* statistics of each op (indexed by category and name) */
+    std::map<std::string, XProfileStat> stats;
+
+    /* a lock for the events and the statistics */
+    std::mutex statMutex;
+
+public:
+    /* constructor */
+    XProfiler();
+
+    /* de-constructor */
+    ~XProfiler();
+
+    /* clear all the records and start profiling */
+    void Start();
+
+    /* stop profiling */
+    void Stop();
+
+    /* get the time (in microseconds) since the profiler started */
+    double GetTime();
+
+    /* mark the beginning of an op */
+    double BeginOp(const XTensor * c);
+
+    /* record an op */
+    void AddOp(int typeID, const XTensor * a, const XTensor * b, const XTensor * c, double start);
+
+    /* mark the beginning of the backward computation of a node */
+    double BeginBackward(XTensor * node);
+
+    /* record the backward computation of a node */
+    void AddBackward(XTensor * node, double start);
+
+    /* mark the beginning of a region */
+    double BeginRegion();
+
+    /* record a region */
+    void AddRegion(const char * name, double start);
+
+    /* show the statistics of each op */
+    void ShowStats(FILE * file);
+
+    /* dump the timeline in the Chrome trace event format */
+    void DumpTrace(const char * fn);
+
+protected:
+    /* add an event */
+    void AddEvent(const char * name, const char * category, double start, double end,
+                  double flops, double bytes, double memUsed);
+};
+
+/* a region that is timed from its construction to its destruction, e.g.,
+   { XProfileRegion region("forward"); ... } */
+class XProfileRegion
+{
+protected:
+    /* name of the region */
+    const char * name;
+
+    /* the start time (<0 means that the profiler is off) */
+    double start;
+
+public:
+    /* constructor */
+    XProfileRegion(const char * myName);
+
+    /* de-constructor */
+    ~XProfileRegion();
+};
+
+/* an op that is timed from its construction to its destruction. Put it
+   at the entry of the op, e.g., XProfileOp profile(MATH_SUM, a, b, c); */
+class XProfileOp
+{
+protected:
+    /* type of the op (see XName.h) */
+    int typeID;
+
+    /* the inputs (b might be NULL) */
+    const XTensor * a;
+    const XTensor * b;
+
+    /* the output */
+    const XTensor * c;
+
+    /* the start time (<0 means that the op is not timed, e.g., it is
+       called in another op) */
+    double start;
+
+    /* indicates whether the op is seen by the profiler */
+    bool isSeen;
+
+public:
+    /* constructor */
+    XProfileOp(int myTypeID, const XTensor * myA, const XTensor * myB, const XTensor * myC);
+
+    /* de-constructor */
+    ~XProfileOp();
+};
+
+/* the global profiler */
+extern XProfiler GProfiler;
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
@@ -0,0 +1,278 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <string.h>
+#include "XRowSparse.h"
+#include "XCall.h"
+#include "XUtility.h"
+#include "core/movement/Gather.h"
+#include "core/movement/Spread.h"
+#include "core/math/ScaleAndShift.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/*
+constructor
+>> myRowNum - number of rows of the matrix
+>> myColNum - number of columns of the matrix
+>> myDevID - id of the device where the rows are kept
+*/
+XRowSparse::XRowSparse(int myRowNum, int myColNum, int myDevID)
+{
+    CheckNTErrors(myRowNum > 0 && myColNum > 0, "Illegal matrix size!");
+
+    rowNum = myRowNum;
+    colNum = myColNum;
+    devID = myDevID;
+    count = 0;
+    capacity = 0;
+    index = NULL;
+    rows = NULL;
+    slots = NULL;
+}
+
+/* de-constructor */
+XRowSparse::~XRowSparse()
+{
+    delete[] index;
+    delete rows;
+    delete[] slots;
+}
+
+/* remove all the rows (the buffer is kept for reuse) */
+void XRowSparse::Clear()
+{
+    count = 0;
+}
+
+/*
+make sure that we can keep a given number of rows. The buffer is
+doubled when it is enlarged.
+>> num - number of the rows
+*/
+void XRowSparse::Reserve(int num)
+{
+    if (num <= capacity)
+        return;
+
+    int newCapacity = MAX(num, capacity * 2);
+    int * newIndex = new int[newCapacity];
+    XTensor * newRows = NewTensor2DV2(newCapacity, colNum, X_FLOAT, devID);
+
+    if (count > 0) {
+        memcpy(newIndex, index, sizeof(int) * count);
+        XMemCopy(newRows->data, devID, rows->data, devID, sizeof(DTYPE) * count * colNum);
+    }
+
+    delete[] index;
+    delete rows;
+
+    index = newIndex;
+    rows = newRows;
+    capacity = newCapacity;
+}
+
+/*
+add rows, i.e., row i of myRows is added to row myIndex[i] of the matrix.
+It is what we have in the backward computation of Gather.
+>> myIndex - the row indices (of any shape)
+>> myRows - the rows (of size myIndex->unitNum * colNum)
+*/
+void XRowSparse::Add(const XTensor * myIndex, const XTensor * myRows)
+{
+    CheckNTErrors(myIndex->dataType == X_INT, "The index must be integers!");
+    CheckNTErrors(myRows->dataType == X_FLOAT, "TODO!");
+    CheckNTErrors(myRows->IsContiguous(), "The rows must be contiguous!");
+    CheckNTErrors(myRows->unitNum == myIndex->unitNum * colNum, "Unmatched index and rows!");
+
+    int num = myIndex->unitNum;
+    if (num == 0)
+        return;
+
+    Reserve(count + num);
+
+    XMemCopy(index + count, -1, myIndex->data, myIndex->devID, sizeof(int) * num);
+    XMemCopy((DTYPE*)rows->data + (long long)count * colNum, devID,
+             myRows->data, myRows->devID, sizeof(DTYPE) * num * colNum);
+
+    for (int i = count; i < count + num; i++)
+        CheckNTErrors(index[i] >= 0 && index[i] < rowNum, "The index is out of range!");
+
+    count += num;
+}
+
+/*
+sum up the rows with the same index so that each index appears only once.
+The rows are kept in the order of their first appearance. It takes time
+linear in the number of rows (rather than the size of the matrix).
+*/
+void XRowSparse::Coalesce()
+{
+    if (count == 0)
+        return;
+
+    if (slots == NULL) {
+        slots = new int[rowNum];
+        for (int i = 0; i < rowNum; i++)
+            slots[i] = -1;
+    }
+
+    int * target = new int[count];
+    int * uniqueIndex = new int[count];
+    int uniqueNum = 0;
+
+    for (int i = 0; i < count; i++) {
+        int r = index[i];
+        if (slots[r] < 0) {
+            slots[r] = uniqueNum;
+            uniqueIndex[uniqueNum++] = r;
+        }
+        target[i] = slots[r];
+    }
+
+    for (int i = 0; i < uniqueNum; i++)
+        slots[uniqueIndex[i]] = -1;
+
+    /* row i goes to row target[i] of a new buffer */
+    if (uniqueNum < count) {
+        XTensor oldRows;
+        GetRows(&oldRows);
+
+        XTensor * newRows = NewTensor2DV2(capacity, colNum, X_FLOAT, devID);
+        XTensor sum;
+        InitTensor2DV2(&sum, -uniqueNum, colNum, X_FLOAT, devID);
+        sum.data = newRows->data;
+        sum.isShared = true;
+        sum.SetZeroAll();
+
+        XTensor targetIndex;
+        InitTensor1DV2(&targetIndex, count, X_INT, devID);
+        targetIndex.SetData(target, count);
+
+        _SpreadForGather(&sum, &oldRows, &targetIndex);
+
+        delete rows;
+        rows = newRows;
+        memcpy(index, uniqueIndex, sizeof(int) * uniqueNum);
+        count = uniqueNum;
+    }
+
+    delete[] target;
+    delete[] uniqueIndex;
+}
+
+/*
+make a tensor (count * colNum) that uses the rows we keep. There is
+no copy and the tensor is valid until the rows are changed.
+>> t - the tensor
+*/
+void XRowSparse::GetRows(XTensor * t)
+{
+    CheckNTErrors(count > 0, "No rows!");
+
+    InitTensor2DV2(t, -count, colNum, X_FLOAT, devID);
+    t->data = rows->data;
+    t->isShared = true;
+}
+
+/*
+make a tensor of the row indices on the device
+>> t - the tensor
+*/
+void XRowSparse::GetIndex(XTensor * t)
+{
+    CheckNTErrors(count > 0, "No rows!");
+
+    InitTensor1DV2(t, count, X_INT, devID);
+    t->SetData(index, count);
+}
+
+/*
+add the rows to a dense matrix, i.e., t = t + alpha * this
+>> t - the dense matrix (rowNum * colNum)
+>> alpha - the scalar
+*/
+void XRowSparse::ApplyTo(XTensor * t, DTYPE alpha)
+{
+    CheckNTErrors(t->order == 2 && t->dimSize[0] == rowNum && t->dimSize[1] == colNum,
+                  "Unmatched matrix!");
+    CheckNTErrors(t->devID == devID, "The matrix must be on the same device!");
+
+    if (count == 0)
+        return;
+
+    XTensor r;
+    XTensor idx;
+    GetRows(&r);
+    GetIndex(&idx);
+
+    if (alpha == 1.0F)
+        _SpreadForGather(t, &r, &idx);
+    else {
+        XTensor scaled;
+        InitTensor2DV2(&scaled, count, colNum, X_FLOAT, devID);
+        _ScaleAndShift(&r, &scaled, alpha, 0);
+        _SpreadForGather(t, &scaled, &idx);
+    }
+}
+
+/*
+scale the rows of a dense matrix that appear here, i.e.,
+t[index[i]] = scale * t[index[i]]. The other rows are not touched, so
+the cost depends on the number of the rows rather than the size of t.
+The rows are coalesced first so that each of them is scaled only once.
+>> t - the dense matrix (rowNum * colNum)
+>> scale - the scalar
+*/
+void XRowSparse::ScaleRowsOf(XTensor * t, DTYPE scale)
+{
+    CheckNTErrors(t->order == 2 && t->dimSize[0] == rowNum && t->dimSize[1] == colNum,
+                  "Unmatched matrix!");
+    CheckNTErrors(t->devID == devID, "The matrix must be on the same device!");
+
+    Coalesce();
+
+    if (count == 0 || scale == 1.0F)
+        return;
+
+    XTensor idx;
+    XTensor tRows;
+    GetIndex(&idx);
+    InitTensor2DV2(&tRows, count, colNum, X_FLOAT, devID);
+
+    /* t[index[i]] += (scale - 1) * t[index[i]] */
+    _Gather(t, &tRows, &idx);
+    _ScaleAndShiftMe(&tRows, scale - 1.0F, 0);
+    _SpreadForGather(t, &tRows, &idx);
+}
+
+/*
+get the dense matrix
+>> t - the dense matrix (rowNum * colNum)
+*/
+void XRowSparse::ToDense(XTensor * t)
+{
+    t->SetZeroAll();
+    ApplyTo(t);
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
@@ -0,0 +1,106 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ *
+ * A row-sparse matrix, i.e., a few rows of a big matrix together with their
+ * row indices. It is used to keep the gradient of a matrix that we only
+ * access by Gather, e.g., the word embedding matrix. In this case only the
+ * rows of the words in the batch have non-zero gradients, and we do not need
+ * to go over the whole vocabulary in back-propagation and in the update.
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ *
+ */
+
+#ifndef __XROWSPARSE_H__
+#define __XROWSPARSE_H__
+
+#include "XGlobal.h"
+#include "XTensor.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/*
+a row-sparse matrix of size rowNum * colNum. Item i is a row of colNum
+values (kept in "rows") that is added to row index[i] of the matrix. The
+same row may appear several times, and the values are summed up then.
+*/
+struct XRowSparse
+{
+    /* number of rows of the (dense) matrix */
+    int rowNum;
+
+    /* number of columns of the matrix, i.e., the size of a row */
+    int colNum;
+
+    /* id of the device where the rows are kept */
+    int devID;
+
+    /* number of the rows we keep */
+    int count;
+
+    /* number of the rows we can keep without enlarging the buffer */
+    int capacity;
+
+    /* row indices (on the host) */
+    int * index;
+
+    /* the rows, a buffer of capacity * colNum values on the device */
+    XTensor * rows;
+
+    /* the position of each row of the matrix in coalescing (-1 if it is not used) */
+    int * slots;
+
+    /* constructor */
+    XRowSparse(int myRowNum, int myColNum, int myDevID);
+
+    /* de-constructor */
+    ~XRowSparse();
+
+    /* remove all the rows (the buffer is kept for reuse) */
+    void Clear();
+
+    /* make sure that we can keep a given number of rows */
+    void Reserve(int num);
+
+    /* add rows */
+    void Add(const XTensor * myIndex, const XTensor * myRows);
+
+    /* sum up the rows with the same index so that each index appears only once */
+    void Coalesce();
+
+    /* make a tensor (count * colNum) that uses the rows we keep */
+    void GetRows(XTensor * t);
+
+    /* make a tensor of the row indices on the device */
+    void GetIndex(XTensor * t);
+
+    /* add the rows to a dense matrix, i.e., t = t + alpha * this */
+    void ApplyTo(XTensor * t, DTYPE alpha = (DTYPE)1.0);
+
+    /* scale the rows of a dense matrix that appear here, i.e., t[index[i]] = scale * t[index[i]] */
+    void ScaleRowsOf(XTensor * t, DTYPE scale);
+
+    /* get the dense matrix */
+    void ToDense(XTensor * t);
+};
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
@@ -0,0 +1,182 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "XSIMD.h"
+
+#ifdef X86_SIMD
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* what the hardware supports (-1 means we have not checked yet) */
+static int hardwareSIMDLevel = -1;
+static int hardwareF16C = -1;
+
+/* upper bound set by the user */
+static SIMD_LEVEL maxSIMDLevel = SIMD_AVX512;
+
+#ifdef X86_SIMD
+
+/* run the cpuid instruction */
+static void CPUID(int leaf, int subleaf, unsigned int * regs)
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, subleaf);
+    for (int i = 0; i < 4; i++)
+        regs[i] = (unsigned int)r[i];
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/* get the register states that the OS saves for us (XCR0) */
+static unsigned long long XGetBV()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+/* check the CPU and the OS */
+static void DetectSIMD()
+{
+    unsigned int regs[4];
+    int level = SIMD_SCALAR;
+    int f16c = 0;
+
+    CPUID(0, 0, regs);
+    unsigned int maxLeaf = regs[0];
+
+    CPUID(1, 0, regs);
+    bool sse42 = (regs[2] >> 20) & 1;
+    bool fma = (regs[2] >> 12) & 1;
+    bool osxsave = (regs[2] >> 27) & 1;
+    bool avx = (regs[2] >> 28) & 1;
+    bool hasF16C = (regs[2] >> 29) & 1;
+
+    if (sse42)
+        level = SIMD_SSE;
+
+    if (osxsave && avx) {
+        unsigned long long xcr0 = XGetBV();
+
+        /* the OS must save the ymm registers */
+        if ((xcr0 & 0x6) == 0x6) {
+            f16c = hasF16C ? 1 : 0;
+
+            if (maxLeaf >= 7) {
+                CPUID(7, 0, regs);
+                bool avx2 = (regs[1] >> 5) & 1;
+                bool avx512f = (regs[1] >> 16) & 1;
+
+                if (avx2 && fma)
+                    level = SIMD_AVX2;
+
+                /* and the zmm registers and the mask registers */
+                if (avx2 && fma && avx512f && (xcr0 & 0xE0) == 0xE0)
+                    level = SIMD_AVX512;
+            }
+        }
+    }
+
+    hardwareSIMDLevel = level;
+    hardwareF16C = f16c;
+}
+
+#elif defined(ARM_SIMD)
+
+/* NEON is known at compile time */
+static void DetectSIMD()
+{
+    hardwareSIMDLevel = SIMD_SSE;
+    hardwareF16C = 0;
+}
+
+#else
+
+static void DetectSIMD()
+{
+    hardwareSIMDLevel = SIMD_SCALAR;
+    hardwareF16C = 0;
+}
+
+#endif
+
+/* get the highest SIMD level that we can use on this machine */
+SIMD_LEVEL GetSIMDLevel()
+{
+    if (hardwareSIMDLevel < 0)
+        DetectSIMD();
+
+    return (SIMD_LEVEL)(hardwareSIMDLevel < (int)maxSIMDLevel ? hardwareSIMDLevel : (int)maxSIMDLevel);
+}
+
+/*
+set an upper bound of the SIMD level
+>> level - the max level we allow
+*/
+void SetMaxSIMDLevel(SIMD_LEVEL level)
+{
+    maxSIMDLevel = level;
+}
+
+/*
+get the name of a SIMD level
+>> level - the SIMD level
+*/
+const char * GetSIMDName(SIMD_LEVEL level)
+{
+    if (level == SIMD_AVX512)
+        return "avx512";
+    else if (level == SIMD_AVX2)
+        return "avx2";
+    else if (level == SIMD_SSE)
+#ifdef ARM_SIMD
+        return "neon";
+#else
+        return "sse";
+#endif
+    else
+        return "scalar";
+}
+
+/* check whether the CPU can convert between float16 and float32 in hardware */
+bool IsF16CSupported()
+{
+    if (hardwareF16C < 0)
+        DetectSIMD();
+
+    return hardwareF16C == 1 && GetSIMDLevel() >= SIMD_AVX2;
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
@@ -0,0 +1,85 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ *
+ * Detection of the SIMD instruction sets of the host CPU. The native CPU
+ * kernels (e.g., matrix multiplication without BLAS) are compiled for several
+ * instruction sets in the same binary and we choose one of them at runtime.
+ * So we do not need "-mavx2" and the like when compiling the code, and the
+ * same program can run on both old and new machines.
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ *
+ */
+
+#ifndef __XSIMD_H__
+#define __XSIMD_H__
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define X86_SIMD
+#endif
+
+/*
+NEON is chosen at compile time. It is always there on AArch64 (and on
+32-bit ARM when the compiler is asked for it), so no runtime check is needed.
+*/
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define ARM_SIMD
+#endif
+
+/*
+compile a function for a given instruction set. gcc and clang need the
+"target" attribute to accept the intrinsics, while msvc always accepts them.
+*/
+#if defined(X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE __attribute__((target("sse4.1,sse4.2")))
+#define TARGET_AVX2 __attribute__((target("avx,avx2,fma")))
+#define TARGET_AVX512 __attribute__((target("avx,avx2,fma,avx512f")))
+#define TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+#define TARGET_SSE
+#define TARGET_AVX2
+#define TARGET_AVX512
+#define TARGET_F16C
+#endif
+
+/* levels of SIMD support (a higher level includes the lower ones). On ARM,
+   NEON (128-bit registers) is at the level of SIMD_SSE. */
+enum SIMD_LEVEL {SIMD_SCALAR, SIMD_SSE, SIMD_AVX2, SIMD_AVX512};
+
+/* get the highest SIMD level that we can use on this machine */
+SIMD_LEVEL GetSIMDLevel();
+
+/*
+set an upper bound of the SIMD level, e.g., SIMD_SCALAR disables all the
+vectorized kernels (mainly for debugging and testing)
+*/
+void SetMaxSIMDLevel(SIMD_LEVEL level);
+
+/* get the name of a SIMD level */
+const char * GetSIMDName(SIMD_LEVEL level);
+
+/* check whether the CPU can convert between float16 and float32 in hardware */
+bool IsF16CSupported();
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
@@ -0,0 +1,263 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ *
+ * Math routines on SIMD registers that are shared by the native CPU kernels,
+ * i.e., e^x (a Cephes-style polynomial) and the horizontal sum/max/min of
+ * a register. They are inlined into the kernels of the same instruction set
+ * (SSE4, AVX2 and AVX-512 on x86, and NEON on ARM).
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ *
+ */
+
+#ifndef __XSIMDMATH_H__
+#define __XSIMDMATH_H__
+
+#include "XSIMD.h"
+
+#if defined(X86_SIMD) || defined(ARM_SIMD)
+
+#ifdef X86_SIMD
+/* the AVX-512 intrinsics without a mask pass _mm512_undefined_ps() as the
+   (unused) source of the masked builtins, and GCC 12 takes it for an
+   uninitialized variable (-Wmaybe-uninitialized) wherever they are inlined,
+   e.g., in ExpAVX512(). The warning is turned off for this header only, so
+   the kernels should include it through this file. */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#else
+#include <arm_neon.h>
+#endif
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* coefficients of the polynomial for e^r where |r| <= ln(2) / 2 */
+#define EXP_HI 88.3762626647949F
+#define EXP_LO -87.3365478515625F
+#define EXP_LOG2E 1.44269504088896341F
+#define EXP_C1 0.693359375F
+#define EXP_C2 -2.12194440e-4F
+#define EXP_P0 1.9875691500E-4F
+#define EXP_P1 1.3981999507E-3F
+#define EXP_P2 8.3334519073E-3F
+#define EXP_P3 4.1665795894E-2F
+#define EXP_P4 1.6666665459E-1F
+#define EXP_P5 5.0000001201E-1F
+
+#ifdef X86_SIMD
+
+/*
+e^x = 2^n * e^r where n = round(x / ln(2)) and r = x - n * ln(2).
+The input is clipped so that 2^n is a normal number. There is no fma
+in SSE4 and we use a multiplication and an addition instead.
+*/
+TARGET_SSE
+static inline __m128 ExpSSE(__m128 x)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(EXP_LO)), _mm_set1_ps(EXP_HI));
+
+    __m128 n = _mm_round_ps(_mm_mul_ps(x, _mm_set1_ps(EXP_LOG2E)),
+                            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(EXP_C1)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(EXP_C2)));
+
+    __m128 p = _mm_set1_ps(EXP_P0);
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P1));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P2));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P3));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P4));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P5));
+    p = _mm_add_ps(_mm_mul_ps(p, _mm_mul_ps(r, r)), _mm_add_ps(r, _mm_set1_ps(1.0F)));
+
+    __m128i e = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+    return _mm_mul_ps(p, _mm_castsi128_ps(_mm_slli_epi32(e, 23)));
+}
+
+/* sum of the 4 numbers in a xmm register */
+TARGET_SSE
+static inline float HorizontalSumSSE(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+/* max of the 4 numbers in a xmm register */
+TARGET_SSE
+static inline float HorizontalMaxSSE(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+/* min of the 4 numbers in a xmm register */
+TARGET_SSE
+static inline float HorizontalMinSSE(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_min_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+/* the same as ExpSSE() but on 8 numbers (with fma) */
+TARGET_AVX2
+static inline __m256 ExpAVX2(__m256 x)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_LO)), _mm256_set1_ps(EXP_HI));
+
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(EXP_LOG2E)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(EXP_C1), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(EXP_C2), r);
+
+    __m256 p = _mm256_set1_ps(EXP_P0);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P1));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P2));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P3));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P4));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P5));
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0F)));
+
+    __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(e, 23)));
+}
+
+/* sum of the 8 numbers in a ymm register */
+TARGET_AVX2
+static inline float HorizontalSumAVX2(__m256 v)
+{
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 1));
+    return _mm_cvtss_f32(h);
+}
+
+/* max of the 8 numbers in a ymm register */
+TARGET_AVX2
+static inline float HorizontalMaxAVX2(__m256 v)
+{
+    __m128 h = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_max_ss(h, _mm_shuffle_ps(h, h, 1));
+    return _mm_cvtss_f32(h);
+}
+
+/* min of the 8 numbers in a ymm register */
+TARGET_AVX2
+static inline float HorizontalMinAVX2(__m256 v)
+{
+    __m128 h = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    h = _mm_min_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_min_ss(h, _mm_shuffle_ps(h, h, 1));
+    return _mm_cvtss_f32(h);
+}
+
+/* the same as ExpAVX2() but on 16 numbers */
+TARGET_AVX512
+static inline __m512 ExpAVX512(__m512 x)
+{
+    x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(EXP_LO)), _mm512_set1_ps(EXP_HI));
+
+    __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(EXP_LOG2E)),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(EXP_C1), x);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(EXP_C2), r);
+
+    __m512 p = _mm512_set1_ps(EXP_P0);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P1));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P2));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P3));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P4));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P5));
+    p = _mm512_fmadd_ps(p, _mm512_mul_ps(r, r), _mm512_add_ps(r, _mm512_set1_ps(1.0F)));
+
+    __m512i e = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+    return _mm512_mul_ps(p, _mm512_castsi512_ps(_mm512_slli_epi32(e, 23)));
+}
+
+#else
+
+/*
+the same as ExpSSE() but on NEON registers. The rounding instructions are
+only there on ARMv8, so n = floor(x / ln(2) + 0.5) is computed by a
+conversion (towards zero) and a correction of the negative numbers.
+*/
+static inline float32x4_t ExpNEON(float32x4_t x)
+{
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(EXP_LO)), vdupq_n_f32(EXP_HI));
+
+    float32x4_t t = vmlaq_f32(vdupq_n_f32(0.5F), x, vdupq_n_f32(EXP_LOG2E));
+    float32x4_t n = vcvtq_f32_s32(vcvtq_s32_f32(t));
+    uint32x4_t isOver = vcgtq_f32(n, t);
+    n = vsubq_f32(n, vreinterpretq_f32_u32(vandq_u32(isOver, vreinterpretq_u32_f32(vdupq_n_f32(1.0F)))));
+
+    float32x4_t r = vmlsq_f32(x, n, vdupq_n_f32(EXP_C1));
+    r = vmlsq_f32(r, n, vdupq_n_f32(EXP_C2));
+
+    float32x4_t p = vdupq_n_f32(EXP_P0);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P1), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P2), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P3), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P4), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P5), p, r);
+    p = vmlaq_f32(vaddq_f32(r, vdupq_n_f32(1.0F)), p, vmulq_f32(r, r));
+
+    int32x4_t e = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+    return vmulq_f32(p, vreinterpretq_f32_s32(vshlq_n_s32(e, 23)));
+}
+
+/* sum of the 4 numbers in a NEON register */
+static inline float HorizontalSumNEON(float32x4_t v)
+{
+    float32x2_t h = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    h = vpadd_f32(h, h);
+    return vget_lane_f32(h, 0);
+}
+
+/* max of the 4 numbers in a NEON register */
+static inline float HorizontalMaxNEON(float32x4_t v)
+{
+    float32x2_t h = vmax_f32(vget_low_f32(v), vget_high_f32(v));
+    h = vpmax_f32(h, h);
+    return vget_lane_f32(h, 0);
+}
+
+/* min of the 4 numbers in a NEON register */
+static inline float HorizontalMinNEON(float32x4_t v)
+{
+    float32x2_t h = vmin_f32(vget_low_f32(v), vget_high_f32(v));
+    h = vpmin_f32(h, h);
+    return vget_lane_f32(h, 0);
+}
+
+#endif
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
+
+#endif
@@ -0,0 +1,304 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <string.h>
+#include "XShuffler.h"
+#include "XUtility.h"
+
+/* 64-bit seek and tell */
+#ifdef _WIN32
+#define XFSEEK _fseeki64
+#define XFTELL _ftelli64
+#else
+#define XFSEEK fseeko
+#define XFTELL ftello
+#endif
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* constructor */
+XShuffler::XShuffler()
+{
+    file = NULL;
+    shardSize = SHUFFLE_SHARD_SIZE;
+    bufShardNum = SHUFFLE_BUF_SHARD_NUM;
+    shardNum = 0;
+    shardOffsets = NULL;
+    shardOrder = NULL;
+    nextShard = 0;
+    data = NULL;
+    dataSize = 0;
+    lines = NULL;
+    lineNum = 0;
+    lineSize = 0;
+    nextLine = 0;
+    seed = 1;
+    state = 1;
+}
+
+/* de-constructor */
+XShuffler::~XShuffler()
+{
+    Close();
+}
+
+/*
+open a file and index its shards. We go over the file once and record
+where every shardSize lines start.
+>> fn - the file name
+>> mySeed - the seed of the random number generator
+>> myShardSize - number of lines in a shard
+>> myBufShardNum - number of shards that are loaded (and shuffled) together
+*/
+void XShuffler::Init(const char * fn, unsigned long long mySeed, int myShardSize, int myBufShardNum)
+{
+    Close();
+
+    CheckNTErrors(myShardSize > 0 && myBufShardNum > 0, "Illegal shard size!");
+
+    file = fopen(fn, "rb");
+    CheckNTErrors(file, "Cannot open the file to shuffle!");
+
+    seed = mySeed;
+    shardSize = myShardSize;
+    bufShardNum = myBufShardNum;
+
+    int offsetSize = 1024;
+    shardOffsets = new long long[offsetSize];
+    shardNum = 0;
+
+    const int chunkSize = 1 << 20;
+    char * chunk = new char[chunkSize];
+    long long pos = 0;
+    int lineCount = 0;
+    bool lineStart = true;
+    size_t readNum = 0;
+
+    while ((readNum = fread(chunk, 1, chunkSize, file)) > 0) {
+        for (size_t i = 0; i < readNum; i++, pos++) {
+            if (lineStart && lineCount % shardSize == 0) {
+                if (shardNum + 1 >= offsetSize) {
+                    long long * newOffsets = new long long[offsetSize * 2];
+                    memcpy(newOffsets, shardOffsets, sizeof(long long) * offsetSize);
+                    delete[] shardOffsets;
+                    shardOffsets = newOffsets;
+                    offsetSize *= 2;
+                }
+                shardOffsets[shardNum++] = pos;
+            }
+            lineStart = false;
+
+            if (chunk[i] == '\n') {
+                lineCount++;
+                lineStart = true;
+            }
+        }
+    }
+
+    /* the end of the last shard */
+    shardOffsets[shardNum] = pos;
+
+    delete[] chunk;
+
+    shardOrder = new int[MAX(shardNum, 1)];
+    for (int i = 0; i < shardNum; i++)
+        shardOrder[i] = i;
+
+    nextShard = shardNum;
+    lineNum = 0;
+    nextLine = 0;
+}
+
+/* close the file */
+void XShuffler::Close()
+{
+    if (file != NULL)
+        fclose(file);
+
+    delete[] shardOffsets;
+    delete[] shardOrder;
+    delete[] data;
+    delete[] lines;
+
+    file = NULL;
+    shardNum = 0;
+    shardOffsets = NULL;
+    shardOrder = NULL;
+    nextShard = 0;
+    data = NULL;
+    dataSize = 0;
+    lines = NULL;
+    lineNum = 0;
+    lineSize = 0;
+    nextLine = 0;
+}
+
+/* indicates whether the shuffler has a file */
+bool XShuffler::IsOpen()
+{
+    return file != NULL;
+}
+
+/*
+start an epoch. The shards are permuted with a generator seeded
+by the seed and the epoch, so that an epoch can be reproduced.
+>> epoch - the epoch id
+*/
+void XShuffler::Start(int epoch)
+{
+    CheckNTErrors(file != NULL, "No file to shuffle!");
+
+    state = seed * 0x9E3779B97F4A7C15ULL + (unsigned long long)epoch;
+
+    for (int i = 0; i < shardNum; i++)
+        shardOrder[i] = i;
+
+    /* Fisher-Yates shuffle */
+    for (int i = shardNum - 1; i > 0; i--) {
+        int j = NextRandom(i + 1);
+        int tmp = shardOrder[i];
+        shardOrder[i] = shardOrder[j];
+        shardOrder[j] = tmp;
+    }
+
+    nextShard = 0;
+    lineNum = 0;
+    nextLine = 0;
+}
+
+/*
+get the next line. It is the same as fgets(), i.e., the line ends with '\n'
+and it is cut if it is longer than size - 1 characters.
+>> line - where to put the line
+>> size - size of the line buffer
+<< return - the line (NULL if we have reached the end of the epoch)
+*/
+char * XShuffler::GetLine(char * line, int size)
+{
+    if (nextLine >= lineNum && !LoadShards())
+        return NULL;
+
+    const char * p = data + lines[nextLine++];
+    int len = (int)strlen(p);
+
+    if (len > size - 2)
+        len = size - 2;
+
+    memcpy(line, p, len);
+    line[len] = '\n';
+    line[len + 1] = 0;
+
+    return line;
+}
+
+/* a random number in [0, n) (splitmix64) */
+int XShuffler::NextRandom(int n)
+{
+    unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return (int)(z % (unsigned long long)n);
+}
+
+/*
+load the next group of shards into the buffer and permute the lines
+<< return - false if there is no shard left in this epoch
+*/
+bool XShuffler::LoadShards()
+{
+    while (nextShard < shardNum) {
+        int last = MIN(nextShard + bufShardNum, shardNum);
+
+        /* size of the data */
+        long long size = 0;
+        for (int i = nextShard; i < last; i++) {
+            int s = shardOrder[i];
+            size += shardOffsets[s + 1] - shardOffsets[s];
+        }
+
+        /* one more byte for the last line that has no '\n' */
+        if (size + 1 > dataSize) {
+            delete[] data;
+            dataSize = size + 1;
+            data = new char[dataSize];
+        }
+
+        long long pos = 0;
+        for (int i = nextShard; i < last; i++) {
+            int s = shardOrder[i];
+            long long shardBytes = shardOffsets[s + 1] - shardOffsets[s];
+
+            XFSEEK(file, shardOffsets[s], SEEK_SET);
+            size_t readNum = fread(data + pos, 1, (size_t)shardBytes, file);
+            CheckNTErrors(readNum == (size_t)shardBytes, "Cannot read the file to shuffle!");
+
+            pos += shardBytes;
+
+            /* the last line of the file may have no '\n' */
+            if (shardBytes > 0 && data[pos - 1] != '\n')
+                data[pos++] = '\n';
+        }
+
+        nextShard = last;
+
+        /* cut the data into lines */
+        int num = 0;
+        for (long long i = 0; i < pos; i++) {
+            if (data[i] == '\n')
+                num++;
+        }
+
+        if (num > lineSize) {
+            delete[] lines;
+            lineSize = num;
+            lines = new long long[lineSize];
+        }
+
+        lineNum = 0;
+        long long start = 0;
+        for (long long i = 0; i < pos; i++) {
+            if (data[i] == '\n') {
+                data[i] = 0;
+                lines[lineNum++] = start;
+                start = i + 1;
+            }
+        }
+
+        /* permute the lines in the buffer */
+        for (int i = lineNum - 1; i > 0; i--) {
+            int j = NextRandom(i + 1);
+            long long tmp = lines[i];
+            lines[i] = lines[j];
+            lines[j] = tmp;
+        }
+
+        nextLine = 0;
+
+        if (lineNum > 0)
+            return true;
+    }
+
+    return false;
+}
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
@@ -0,0 +1,129 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ *
+ * A streaming shuffler of text files. It is used to go over the lines of
+ * a (large) training file in a random order without rewriting the file.
+ * The file is cut into shards of lines and we index the byte offset of
+ * each shard. In each epoch the shards are permuted, a group of shards is
+ * loaded into a buffer, and the lines in the buffer are permuted again.
+ * The random numbers are from a seeded generator so the order only depends
+ * on the seed and the epoch.
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ *
+ */
+
+#ifndef __XSHUFFLER_H__
+#define __XSHUFFLER_H__
+
+#include <stdio.h>
+#include "XGlobal.h"
+
+/* the nts (NiuTrans.Tensor) namespace */
+namespace nts{
+
+/* number of lines in a shard */
+#define SHUFFLE_SHARD_SIZE 1024
+
+/* number of shards that are loaded (and shuffled) together */
+#define SHUFFLE_BUF_SHARD_NUM 64
+
+/* a shuffler that generates the lines of a file in a random order */
+class XShuffler
+{
+protected:
+    /* the file */
+    FILE * file;
+
+    /* number of lines in a shard */
+    int shardSize;
+
+    /* number of shards in a buffer */
+    int bufShardNum;
+
+    /* number of shards */
+    int shardNum;
+
+    /* byte offset of each shard (and the end of the file) */
+    long long * shardOffsets;
+
+    /* the order of shards in the current epoch */
+    int * shardOrder;
+
+    /* the next shard (in shardOrder) to load */
+    int nextShard;
+
+    /* the loaded data */
+    char * data;
+
+    /* size of the data buffer */
+    long long dataSize;
+
+    /* start of each line in the buffer */
+    long long * lines;
+
+    /* number of lines in the buffer */
+    int lineNum;
+
+    /* size of the line array */
+    int lineSize;
+
+    /* the next line to return */
+    int nextLine;
+
+    /* the seed of the random number generator */
+    unsigned long long seed;
+
+    /* state of the random number generator */
+    unsigned long long state;
+
+public:
+    /* constructor */
+    XShuffler();
+
+    /* de-constructor */
+    ~XShuffler();
+
+    /* open a file and index its shards */
+    void Init(const char * fn, unsigned long long mySeed = 1,
+              int myShardSize = SHUFFLE_SHARD_SIZE, int myBufShardNum = SHUFFLE_BUF_SHARD_NUM);
+
+    /* close the file */
+    void Close();
+
+    /* indicates whether the shuffler has a file */
+    bool IsOpen();
+
+    /* start an epoch */
+    void Start(int epoch);
+
+    /* get the next line (as fgets does) */
+    char * GetLine(char * line, int size);
+
+protected:
+    /* a random number in [0, n) */
+    int NextRandom(int n);
+
+    /* load the next group of shards into the buffer */
+    bool LoadShards();
+};
+
+} /* end of the nts (NiuTrans.Tensor) namespace */
+
+#endif
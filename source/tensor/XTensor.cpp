@@ -40,6 +40,7 @@
 #include "XHeap.h"
 #include "XBLAS.h"
 #include "XName.h"
+#include "XRowSparse.h"
 #include "core/shape/MergeBlockLists.h"
 #include "core/movement/CopyValues.h"
 #include "core/arithmetic/Sum.h"
@@ -164,6 +165,8 @@ XTensor::XTensor(const XTensor& reference)
         mem = reference.mem;
         data = reference.data;
         signature = reference.signature;
+        isStrided = reference.isStrided;
+        memcpy(strides, reference.strides, sizeof(int) * MAX_TENSOR_DIM_NUM);
         
         /* what we really want to do is "reference.data = NULL;"
            As "reference" is constant, we cannot reset "reference.data"
@@ -175,6 +178,7 @@ XTensor::XTensor(const XTensor& reference)
     else{
         devID = reference.devID;
         mem = reference.mem;
+        isShared = false;
         InitTensorV2(this, &reference);
         _CopyValues(&reference, this);
     }
@@ -206,6 +210,8 @@ XTensor::XTensor(const XTensor&& reference)
     mem = reference.mem;
     data = reference.data;
     signature = reference.signature;
+    isStrided = reference.isStrided;
+    memcpy(strides, reference.strides, sizeof(int) * MAX_TENSOR_DIM_NUM);
         
     /* what we really want to do is "reference.data = NULL;"
        As "reference" is constant, we cannot reset "reference.data"
@@ -251,6 +257,9 @@ XTensor::~XTensor()
 
     if(grad != NULL)
         delete grad;
+
+    if(sparseGrad != NULL)
+        delete sparseGrad;
 }
 
 /* set the name of the tensor */
@@ -279,6 +288,8 @@ void XTensor::Init()
     unitNumNonZero = 0;
     denseRatio = 1.0F;
     isShared = false;
+    isStrided = false;
+    memset(strides, 0, sizeof(int) * MAX_TENSOR_DIM_NUM);
     isDefaultDType = true;
     isInGlobalMem = false;
     memset(isAllValued, 0, sizeof(bool) * MAX_TENSOR_DIM_NUM);
@@ -289,12 +300,17 @@ void XTensor::Init()
     enableGrad = X_ENABLE_GRAD;
     visitMark = 0;
     grad = NULL;
+    isSparseGrad = false;
+    sparseGrad = NULL;
 }
 
 /* delete data arrays */
 void XTensor::DestroyData()
 {
-    if(data != NULL && mem == NULL && !isShared)
+    /* a shared data array (e.g., a mapped model file) is freed by its owner */
+    if(data != NULL && isShared)
+        data = NULL;
+    else if(data != NULL && mem == NULL)
         XMemFree(devID, data);
     else if(data != NULL && isInGlobalMem)
         FreeData(this, mem);
@@ -302,6 +318,8 @@ void XTensor::DestroyData()
         mem->Release(data, GetDataSizeInChar(), signature);
     
     data = NULL;
+    isShared = false;
+    isStrided = false;
 
     if(dataHost != NULL)
         delete[] (char*)dataHost;
@@ -380,6 +398,7 @@ XTensor& XTensor::operator= (const XTensor& tensor)
         /* hard copy of the data array */
         int size = unitNum * unitSize;
         if(isInit && !isSparse && !tensor.isSparse &&
+           IsContiguous() && tensor.IsContiguous() &&
            size == tensor.unitNum * tensor.unitSize &&
            ((devID < 0 && tensor.devID < 0) && devID == tensor.devID) &&
             data != NULL)
@@ -399,8 +418,10 @@ XTensor& XTensor::operator= (const XTensor& tensor)
             _CopyValues(&tensor, this);
         }
 
-        /* copy member variables */
+        /* copy member variables (but we still own the data array or not as before) */
+        bool shared = isShared;
         ShallowCopy(tensor);
+        isShared = shared;
 
         isInit = true;
         isTmp = false;
@@ -452,6 +473,8 @@ XTensor& XTensor::operator= (const XTensor&& tensor)
     mem = tensor.mem;
     data = tensor.data;
     signature = tensor.signature;
+    isStrided = tensor.isStrided;
+    memcpy(strides, tensor.strides, sizeof(int) * MAX_TENSOR_DIM_NUM);
         
     /* what we really want to do is "reference.data = NULL;"
        As "reference" is constant, we cannot reset "reference.data"
@@ -602,6 +625,63 @@ int XTensor::GetDim(const int dim) const
     return dimSize[d];
 }
 
+/* check whether the items are kept in a contiguous data array (in the row-major order) */
+bool XTensor::IsContiguous() const
+{
+    if(!isStrided)
+        return true;
+
+    int stride = 1;
+    for(int i = order - 1; i >= 0; i--){
+        if(dimSize[i] != 1 && strides[i] != stride)
+            return false;
+        stride *= dimSize[i];
+    }
+
+    return true;
+}
+
+/* 
+get the distance (in units) between two neighbouring items along a given dimension
+>> dim - the given dim we are looking at
+*/
+int XTensor::GetStride(const int dim) const
+{
+    CheckNTErrors(dim < order && dim >= -order, "dimenision is out of range!");
+
+    int d = dim;
+    if(dim < 0)
+        d = order + dim;
+
+    if(isStrided)
+        return strides[d];
+
+    int stride = 1;
+    for(int i = order - 1; i > d; i--)
+        stride *= dimSize[i];
+
+    return stride;
+}
+
+/* 
+get the offset (in units) of the i-th item (in the row-major order) in the data array
+>> index - index of the item
+<< return - the offset
+*/
+int XTensor::GetStridedOffset(int index) const
+{
+    if(!isStrided)
+        return index;
+
+    int offset = 0;
+    for(int i = order - 1; i >= 0; i--){
+        offset += (index % dimSize[i]) * strides[i];
+        index /= dimSize[i];
+    }
+
+    return offset;
+}
+
 /* 
 reshape the tensor 
 >> myOrder - order of the tensor
@@ -618,9 +698,11 @@ void XTensor::Reshape(const int myOrder, const int* myDimSize)
     }
 
     CheckNTErrors(abs(num) == unitNum, "Wrong size found when we reshape the tensor!");
+    CheckNTErrors(IsContiguous(), "Cannot reshape a strided view. Please call Contiguous() first!");
 
     order = myOrder;
     memcpy(dimSize, dims, sizeof(int) * order);
+    isStrided = false;
 }
 
 /* 
@@ -940,7 +1022,7 @@ DTYPE XTensor::Get(int offset) const
     CheckNTErrors(data != NULL, "Cannot use an uninitialized tensor!");
     CheckNTErrors(denseRatio == 1.0F, "Only dense tensors are supported in Get(offset).");
 
-    DTYPE* address = (DTYPE*)data + offset;
+    DTYPE* address = (DTYPE*)data + GetStridedOffset(offset);
 
     return ToCPU(devID, address);
 }
@@ -960,6 +1042,12 @@ void* XTensor::GetCell(int index[], int size) const
         CheckNTErrors((index[i] < dimSize[i]), "Index is out of range!");
         offset = offset * dimSize[i] + index[i];
     }
+
+    if(isStrided){
+        offset = 0;
+        for(int i = 0; i < size; ++i)
+            offset += index[i] * strides[i];
+    }
     
     if(isSparse){
         DTYPE value;
@@ -1188,7 +1276,7 @@ bool XTensor::Set(DTYPE value, int offset)
     CheckNTErrors(offset >= 0 && offset < unitNum, "Invalid index!");
     CheckNTErrors(data != NULL, "Cannot use an uninitialized tensor!");
 
-    DTYPE* d = (DTYPE*)data + offset;
+    DTYPE* d = (DTYPE*)data + GetStridedOffset(offset);
 
     return SetToDevice(devID, d, value);
 }
@@ -1451,6 +1539,17 @@ void XTensor::SetVarFlag(bool myIsVar)
         SetGradFlag(true);
 }
 
+/* 
+set the tensor as "keep-row-sparse-gradient", i.e., the gradient is kept
+as the rows that are looked up by Gather (see XRowSparse.h)
+>> myIsSparseGrad - the flag
+*/
+void XTensor::SetSparseGradFlag(bool myIsSparseGrad)
+{
+    CheckNTErrors(!myIsSparseGrad || order == 2, "Row-sparse gradients are only for matrices!");
+    isSparseGrad = myIsSparseGrad;
+}
+
 /* 
 resize a tensor with a specified tensor size
 >> myOrder - order of the tensor
@@ -1463,12 +1562,14 @@ bool XTensor::Resize(const int myOrder, const int* myDimSize,
                      const TENSOR_DATA_TYPE myDataType, const float myDenseRatio)
 {
     /* free old mem */
-    if(data != NULL){
+    if(data != NULL && !isShared){
         if (mem == NULL)
             XMemFree(devID, data);
         else
             mem->Release(data, GetDataSizeInChar(), signature);
     }
+    isShared = false;
+    isStrided = false;
 
     signature = mem != NULL ? mem->GetSignature() : 0;
     
@@ -2009,6 +2110,34 @@ void XTensor::FlushToMem(XMem* targetMem)
     }
 }
 
+/*
+move the data out of the memory pool, i.e., the data array is then allocated
+on the device on its own. Note that the tensors computed from this tensor
+are usually created in its pool. So a tensor that is read by threads with
+their own pools (e.g., a model parameter shared by a number of decoders)
+should not be in any pool.
+*/
+void XTensor::DetachFromMem()
+{
+    if (mem == NULL)
+        return;
+
+    /* a shared data array is kept where it is */
+    if (data != NULL && !isShared) {
+        void* tmpData = XMemAlloc(devID, GetDataSizeInChar());
+        XMemCopy(tmpData, devID, data, devID, GetDataSizeInChar());
+        if (isInGlobalMem)
+            FreeData(this, mem);
+        else
+            mem->Release(data, GetDataSizeInChar(), signature);
+        data = tmpData;
+    }
+
+    mem = NULL;
+    isInGlobalMem = false;
+    signature = 0;
+}
+
 /*
 allocate the memory space of the tensor (in the global memory) 
 >> tensor - the tensor we intend to process
@@ -44,6 +44,7 @@ namespace nts{
 
 /* cross reference */
 struct XLink;
+struct XRowSparse;
 
 /* define the maximum number of dimensions in a tensor */
 #define MAX_TENSOR_DIM_NUM 8
@@ -131,6 +132,15 @@ public:
     /* indicates whether the data array is shared with other tensors */
     bool isShared;
 
+    /* indicates whether the tensor is a view of the data array of another tensor
+       (see core/shape/View.h). If so, the item (i_0, ..., i_{n-1}) is kept at
+       data + \sum_k i_k * strides[k]. Otherwise the data array is contiguous
+       and strides[] is not used. */
+    bool isStrided;
+
+    /* distance (in units) between two neighbouring items along each dimension */
+    int strides[MAX_TENSOR_DIM_NUM];
+
     /* indicates whether the date type used in this tensor is in default type (i.e., DTYPE) */
     bool isDefaultDType;
 
@@ -160,6 +170,14 @@ public:
 
     /* gradient (for back-propagation) */
     XTensor * grad;
+
+    /* indicates whether the gradient is kept as the rows that have been
+       looked up (by Gather) rather than a dense tensor, e.g., for the word
+       embedding matrix (see XRowSparse.h) */
+    bool isSparseGrad;
+
+    /* the row-sparse gradient (used if isSparseGrad = true) */
+    XRowSparse * sparseGrad;
     
     /*
     the link used to form networks. Note that when we compute on tensors, we actually create a
@@ -261,6 +279,15 @@ public:
     /* get the size of a given dimension */
     int GetDim(const int dim) const;
 
+    /* check whether the items are kept in a contiguous data array (in the row-major order) */
+    bool IsContiguous() const;
+
+    /* get the distance (in units) between two neighbouring items along a given dimension */
+    int GetStride(const int dim) const;
+
+    /* get the offset (in units) of the i-th item (in the row-major order) in the data array */
+    int GetStridedOffset(int index) const;
+
     /* reshape the tensor */
     void Reshape(const int order, const int * myDimSize);
 
@@ -427,6 +454,9 @@ public:
     /* set the tensor as "variable" */
     void SetVarFlag(bool myIsVar = true);
 
+    /* set the tensor as "keep-row-sparse-gradient" */
+    void SetSparseGradFlag(bool myIsSparseGrad = true);
+
     /* resize a tensor with a specified tensor size */
     bool Resize(const int myOrder, const int * myDimSize,
                 const TENSOR_DATA_TYPE myDataType = DEFAULT_DTYPE,
@@ -457,6 +487,9 @@ public:
     /* flush the data to the target device */
     void FlushToMem(XMem * targetMem);
 
+    /* move the data out of the memory pool */
+    void DetachFromMem();
+
     /* allocate the memory space of the tensor (in the global memory) */
     static
     void AllocateData(XTensor * tensor, XMem * myMem = NULL, bool useBuf = false);
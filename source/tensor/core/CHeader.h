@@ -32,6 +32,9 @@
 #include "arithmetic/MatrixMul.h"
 #include "arithmetic/MatrixMul2D.h"
 #include "arithmetic/MatrixMul2DMultiTheading.h"
+#include "arithmetic/MatrixMul2DNative.h"
+#include "arithmetic/MatrixMulInt8.h"
+#include "arithmetic/MatrixMulFP16.h"
 #include "arithmetic/MatrixMul2DParallel.h"
 #include "arithmetic/MatrixMulBatched.h"
 #include "arithmetic/Multiply.h"
@@ -47,6 +50,7 @@
 #include "getandset/Select.h"
 #include "getandset/SetData.h"
 
+#include "math/Adam.h"
 #include "math/Binary.h"
 #include "math/Clip.h"
 #include "math/Compare.h"
@@ -84,6 +88,7 @@
 #include "shape/Squeeze.h"
 #include "shape/Stack.h"
 #include "shape/Transpose.h"
+#include "shape/View.h"
 #include "shape/Unsqueeze.h"
 #include "shape/IsSameShaped.h"
 
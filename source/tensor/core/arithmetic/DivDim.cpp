@@ -54,6 +54,8 @@ void _DivDim(const XTensor * a, const XTensor * b, XTensor * c, int n, DTYPE alp
     CheckNTErrors(a->order == c->order, "The input tensors do not have the same order in division!");
     CheckNTErrors(!a->isSparse && !b->isSparse && !c->isSparse, "Dense tensors are required!");
     CheckNTErrors(a->dimSize[n] == b->unitNum, "Wrong tensor size!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && c->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     CheckDev(a->devID, b->devID);
 
@@ -23,6 +23,7 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "../shape/IsSameShaped.h"
 #include "Mask.h"
@@ -37,12 +38,16 @@ where i is the index of the element
 */
 void _Mask(const XTensor * a, const XTensor * mask, XTensor * c, DTYPE alpha)
 {
+    XProfileOp profile(MATH_MASK, a, mask, c);
+
     CheckNTErrors(a && mask && c, "Empty tensor input!");
     CheckNTErrors(a->unitNum == mask->unitNum && a->unitNum == c->unitNum,
         "Unmatched tensors in addition!");
     CheckNTErrors(mask->dataType == X_INT, "The mask tensor must be in X_INT!")
     //CheckNTErrors(a->dataType == mask->dataType && a->dataType == c->dataType,
     //    "Unmatched tensors in addition!");
+    CheckNTErrors(a->IsContiguous() && mask->IsContiguous() && c->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     if (a->devID >= 0 || mask->devID >= 0 || c->devID >= 0) {
 #ifdef USE_CUDA
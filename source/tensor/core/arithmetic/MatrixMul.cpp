@@ -22,6 +22,7 @@
 #include "../../XTensor.h"
 #include "../../XDevice.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "MatrixMul.h"
 #include "MatrixMul2D.h"
 #include "XTensorBLAS.h"
@@ -53,12 +54,16 @@ void _MatrixMul(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
                 const XTensor * b, MATRIX_TRANS_TYPE transposedB,
                 XTensor * c, DTYPE alpha, DTYPE beta, XPRunner * parallelRunner)
 {
+    XProfileOp profile(MATH_MATRIXMUL, a, b, c);
+
     CheckNTErrors(a && b && c, "Empty input tensors!");
     CheckNTErrors(a->dataType == b->dataType && a->dataType == c->dataType,
                   "Input tensors should have the same data type!");
     CheckNTErrors(a->order >= 2 && b->order >= 2 && c->order >= 2,
                   "Input tensors must have a order >= 2!");
     CheckNTErrors(c->order == a->order + b->order - 2, "wrong tensor order")
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && c->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
     
     /* we transform a higher order tensor to a matrix to kill the number
        of calls of matrix multiplication */
@@ -0,0 +1,405 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+* A GotoBLAS-style matrix multiplication. The matrices are cut into blocks
+* that fit in the caches, the blocks are packed into contiguous panels, and
+* a small register-tiled kernel (AVX-512, AVX2 or plain C++) runs on the panels.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "../../XTensor.h"
+#include "../../XSIMD.h"
+#include "MatrixMul2DNative.h"
+
+#ifdef X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* block sizes: KC * NR floats of b stay in L1, MC * KC floats of a stay in L2 */
+#define GEMM_KC 256
+#define GEMM_MC_TILE_NUM 16
+#define GEMM_NC 3072
+#define GEMM_MAX_MR 8
+#define GEMM_MAX_NR 32
+#define GEMM_ALIGN 64
+
+/*
+a micro-kernel computes c += alpha * a * b for a MR * NR tile of c
+where a is a packed MR * kc panel and b is a packed kc * NR panel
+*/
+typedef void (*GEMMKernel)(int kc, const float * a, const float * b, float * c, int ldc, float alpha);
+
+/* plain C++ kernel (4 * 8) */
+static void GEMMKernelScalar(int kc, const float * a, const float * b, float * c, int ldc, float alpha)
+{
+    float acc[4][8];
+    memset(acc, 0, sizeof(acc));
+
+    for (int p = 0; p < kc; p++) {
+        for (int r = 0; r < 4; r++) {
+            float ar = a[r];
+            for (int j = 0; j < 8; j++)
+                acc[r][j] += ar * b[j];
+        }
+        a += 4;
+        b += 8;
+    }
+
+    for (int r = 0; r < 4; r++) {
+        float * cr = c + r * ldc;
+        for (int j = 0; j < 8; j++)
+            cr[j] += alpha * acc[r][j];
+    }
+}
+
+#ifdef X86_SIMD
+
+#define AVX2_ROW_FMA(r) \
+{ \
+    __m256 ar = _mm256_broadcast_ss(a + r); \
+    c##r##0 = _mm256_fmadd_ps(ar, b0, c##r##0); \
+    c##r##1 = _mm256_fmadd_ps(ar, b1, c##r##1); \
+}
+
+#define AVX2_ROW_STORE(r) \
+{ \
+    float * cr = c + r * ldc; \
+    _mm256_storeu_ps(cr, _mm256_fmadd_ps(c##r##0, va, _mm256_loadu_ps(cr))); \
+    _mm256_storeu_ps(cr + 8, _mm256_fmadd_ps(c##r##1, va, _mm256_loadu_ps(cr + 8))); \
+}
+
+/* AVX2 kernel (6 * 16, i.e., 12 ymm accumulators) */
+TARGET_AVX2
+static void GEMMKernelAVX2(int kc, const float * a, const float * b, float * c, int ldc, float alpha)
+{
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (int p = 0; p < kc; p++) {
+        __m256 b0 = _mm256_load_ps(b);
+        __m256 b1 = _mm256_load_ps(b + 8);
+        AVX2_ROW_FMA(0);
+        AVX2_ROW_FMA(1);
+        AVX2_ROW_FMA(2);
+        AVX2_ROW_FMA(3);
+        AVX2_ROW_FMA(4);
+        AVX2_ROW_FMA(5);
+        a += 6;
+        b += 16;
+    }
+
+    __m256 va = _mm256_set1_ps(alpha);
+    AVX2_ROW_STORE(0);
+    AVX2_ROW_STORE(1);
+    AVX2_ROW_STORE(2);
+    AVX2_ROW_STORE(3);
+    AVX2_ROW_STORE(4);
+    AVX2_ROW_STORE(5);
+}
+
+#define AVX512_ROW_FMA(r) \
+{ \
+    __m512 ar = _mm512_set1_ps(a[r]); \
+    c##r##0 = _mm512_fmadd_ps(ar, b0, c##r##0); \
+    c##r##1 = _mm512_fmadd_ps(ar, b1, c##r##1); \
+}
+
+#define AVX512_ROW_STORE(r) \
+{ \
+    float * cr = c + r * ldc; \
+    _mm512_storeu_ps(cr, _mm512_fmadd_ps(c##r##0, va, _mm512_loadu_ps(cr))); \
+    _mm512_storeu_ps(cr + 16, _mm512_fmadd_ps(c##r##1, va, _mm512_loadu_ps(cr + 16))); \
+}
+
+/* AVX-512 kernel (6 * 32, i.e., 12 zmm accumulators) */
+TARGET_AVX512
+static void GEMMKernelAVX512(int kc, const float * a, const float * b, float * c, int ldc, float alpha)
+{
+    __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+    __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+    __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+    __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+    __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+    __m512 c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+
+    for (int p = 0; p < kc; p++) {
+        __m512 b0 = _mm512_load_ps(b);
+        __m512 b1 = _mm512_load_ps(b + 16);
+        AVX512_ROW_FMA(0);
+        AVX512_ROW_FMA(1);
+        AVX512_ROW_FMA(2);
+        AVX512_ROW_FMA(3);
+        AVX512_ROW_FMA(4);
+        AVX512_ROW_FMA(5);
+        a += 6;
+        b += 32;
+    }
+
+    __m512 va = _mm512_set1_ps(alpha);
+    AVX512_ROW_STORE(0);
+    AVX512_ROW_STORE(1);
+    AVX512_ROW_STORE(2);
+    AVX512_ROW_STORE(3);
+    AVX512_ROW_STORE(4);
+    AVX512_ROW_STORE(5);
+}
+
+#endif
+
+/*
+pack a mc * kc block of trans(a) into panels of MR rows. Each panel
+is stored column by column and the missing rows are filled with 0.
+*/
+static void PackA(bool transposed, const float * a, int lda, int mc, int kc, int mr, float * buf)
+{
+    for (int i = 0; i < mc; i += mr) {
+        int rows = MIN(mr, mc - i);
+        if (!transposed) {
+            for (int p = 0; p < kc; p++) {
+                for (int r = 0; r < rows; r++)
+                    buf[r] = a[(i + r) * lda + p];
+                for (int r = rows; r < mr; r++)
+                    buf[r] = 0;
+                buf += mr;
+            }
+        }
+        else {
+            for (int p = 0; p < kc; p++) {
+                const float * ap = a + p * lda + i;
+                for (int r = 0; r < rows; r++)
+                    buf[r] = ap[r];
+                for (int r = rows; r < mr; r++)
+                    buf[r] = 0;
+                buf += mr;
+            }
+        }
+    }
+}
+
+/*
+pack a kc * nc block of trans(b) into panels of NR columns. Each panel
+is stored row by row and the missing columns are filled with 0.
+*/
+static void PackB(bool transposed, const float * b, int ldb, int kc, int nc, int nr, float * buf)
+{
+    for (int j = 0; j < nc; j += nr) {
+        int cols = MIN(nr, nc - j);
+        if (!transposed) {
+            for (int p = 0; p < kc; p++) {
+                const float * bp = b + p * ldb + j;
+                for (int q = 0; q < cols; q++)
+                    buf[q] = bp[q];
+                for (int q = cols; q < nr; q++)
+                    buf[q] = 0;
+                buf += nr;
+            }
+        }
+        else {
+            for (int p = 0; p < kc; p++) {
+                for (int q = 0; q < cols; q++)
+                    buf[q] = b[(j + q) * ldb + p];
+                for (int q = cols; q < nr; q++)
+                    buf[q] = 0;
+                buf += nr;
+            }
+        }
+    }
+}
+
+/* get an aligned address in a buffer */
+static float * AlignBuf(void * buf)
+{
+    size_t p = (size_t)buf;
+    return (float*)((p + GEMM_ALIGN - 1) / GEMM_ALIGN * GEMM_ALIGN);
+}
+
+/*
+single-precision matrix multiplication without BLAS (row-major)
+c = trans(a) * trans(b) * alpha + c * beta
+>> transposedA - indicates whether a is transposed
+>> transposedB - indicates whether b is transposed
+>> m - number of rows of c
+>> n - number of columns of c
+>> k - the inner dimension
+>> alpha - a coefficient
+>> a - matrix a (m * k, or k * m if it is transposed)
+>> lda - leading dimension of a (i.e., its row size)
+>> b - matrix b (k * n, or n * k if it is transposed)
+>> ldb - leading dimension of b
+>> beta - another coefficient
+>> c - where we put the result
+>> ldc - leading dimension of c
+*/
+void NativeSGEMM(bool transposedA, bool transposedB, int m, int n, int k,
+                 float alpha, const float * a, int lda, const float * b, int ldb,
+                 float beta, float * c, int ldc)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    /* c = c * beta */
+    if (beta == 0) {
+        for (int i = 0; i < m; i++)
+            memset(c + i * ldc, 0, sizeof(float) * n);
+    }
+    else if (beta != 1.0F) {
+        for (int i = 0; i < m; i++) {
+            float * ci = c + i * ldc;
+            for (int j = 0; j < n; j++)
+                ci[j] *= beta;
+        }
+    }
+
+    if (k <= 0 || alpha == 0)
+        return;
+
+    /* choose the kernel */
+    GEMMKernel kernel = GEMMKernelScalar;
+    int mr = 4;
+    int nr = 8;
+
+#ifdef X86_SIMD
+    SIMD_LEVEL level = GetSIMDLevel();
+    if (level >= SIMD_AVX512) {
+        kernel = GEMMKernelAVX512;
+        mr = 6;
+        nr = 32;
+    }
+    else if (level >= SIMD_AVX2) {
+        kernel = GEMMKernelAVX2;
+        mr = 6;
+        nr = 16;
+    }
+#endif
+
+    int mcMax = mr * GEMM_MC_TILE_NUM;
+    int kcMax = MIN(k, GEMM_KC);
+    int ncMax = MIN((n + nr - 1) / nr * nr, GEMM_NC);
+    int mcRound = MIN((m + mr - 1) / mr * mr, mcMax);
+
+    char * bufA = (char*)malloc(sizeof(float) * mcRound * kcMax + GEMM_ALIGN);
+    char * bufB = (char*)malloc(sizeof(float) * ncMax * kcMax + GEMM_ALIGN);
+    CheckNTErrors(bufA != NULL && bufB != NULL, "Cannot allocate the buffer!");
+
+    float * packedA = AlignBuf(bufA);
+    float * packedB = AlignBuf(bufB);
+
+    /* a tile for the margin of c */
+    float tile[GEMM_MAX_MR * GEMM_MAX_NR];
+
+    for (int jc = 0; jc < n; jc += GEMM_NC) {
+        int nc = MIN(GEMM_NC, n - jc);
+
+        for (int pc = 0; pc < k; pc += GEMM_KC) {
+            int kc = MIN(GEMM_KC, k - pc);
+            const float * bBlock = transposedB ? b + jc * ldb + pc : b + pc * ldb + jc;
+            PackB(transposedB, bBlock, ldb, kc, nc, nr, packedB);
+
+            for (int ic = 0; ic < m; ic += mcMax) {
+                int mc = MIN(mcMax, m - ic);
+                const float * aBlock = transposedA ? a + pc * lda + ic : a + ic * lda + pc;
+                PackA(transposedA, aBlock, lda, mc, kc, mr, packedA);
+
+                for (int jr = 0; jr < nc; jr += nr) {
+                    int cols = MIN(nr, nc - jr);
+                    const float * bPanel = packedB + jr * kc;
+
+                    for (int ir = 0; ir < mc; ir += mr) {
+                        int rows = MIN(mr, mc - ir);
+                        const float * aPanel = packedA + ir * kc;
+                        float * cTile = c + (ic + ir) * ldc + jc + jr;
+
+                        if (rows == mr && cols == nr)
+                            kernel(kc, aPanel, bPanel, cTile, ldc, alpha);
+                        else {
+                            memset(tile, 0, sizeof(float) * mr * nr);
+                            kernel(kc, aPanel, bPanel, tile, nr, alpha);
+                            for (int r = 0; r < rows; r++) {
+                                for (int q = 0; q < cols; q++)
+                                    cTile[r * ldc + q] += tile[r * nr + q];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    free(bufA);
+    free(bufB);
+}
+
+/*
+matrix multiplication for a block (x1,y1) - (x2,y2) of c with the native kernel
+NOTE: this is a instance of the TFunction type and would be used in XThread
+(see more information in XThread.h/cpp)
+>> args - arguments
+argument0: x1 - row index (upper-left corner)
+argument1: y1 - column index (upper-left corner)
+argument3: x2 - row index (bottom-right corner)
+argument4: y2 - column index (bottom-right corner)
+argument5: matrix a
+argument6: matrix b
+argument7: matrix c (c=a*b*\alpha + c*beta)
+argument8: alpha
+argument9: beta
+argument10: transposedA
+argument11: transposedB
+*/
+void _MatrixMul2DNativeBlock(TensorList * args)
+{
+    CheckNTErrors(args->count == 2, "invalid argument number!");
+    IntList * indexArgs = (IntList*)args->GetItem(0);
+    TensorList * matrixArgs = (TensorList*)args->GetItem(1);
+    CheckNTErrors(indexArgs->count == 4, "invalid argument number!");
+    CheckNTErrors(matrixArgs->count == 7, "invalid argument number!");
+
+    XTensor * a = matrixArgs->GetItem(0);
+    XTensor * b = matrixArgs->GetItem(1);
+    XTensor * c = matrixArgs->GetItem(2);
+    float alpha = *(float*)(matrixArgs->GetItem(3));
+    float beta = *(float*)(matrixArgs->GetItem(4));
+    bool transposedA = *(MATRIX_TRANS_TYPE*)(matrixArgs->GetItem(5)) == X_TRANS;
+    bool transposedB = *(MATRIX_TRANS_TYPE*)(matrixArgs->GetItem(6)) == X_TRANS;
+    int x1 = indexArgs->GetItem(0);
+    int y1 = indexArgs->GetItem(1);
+    int x2 = indexArgs->GetItem(2);
+    int y2 = indexArgs->GetItem(3);
+
+    int lda = a->dimSize[1];
+    int ldb = b->dimSize[1];
+    int ldc = c->dimSize[1];
+    int k = transposedA ? a->dimSize[0] : a->dimSize[1];
+
+    const float * ap = (float*)a->data + (transposedA ? x1 : x1 * lda);
+    const float * bp = (float*)b->data + (transposedB ? y1 * ldb : y1);
+    float * cp = (float*)c->data + x1 * ldc + y1;
+
+    NativeSGEMM(transposedA, transposedB, x2 - x1 + 1, y2 - y1 + 1, k,
+                alpha, ap, lda, bp, ldb, beta, cp, ldc);
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,46 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#ifndef __MATRIXMUL2DNATIVE_H__
+#define __MATRIXMUL2DNATIVE_H__
+
+#include "../../XTensor.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+single-precision matrix multiplication without BLAS (row-major)
+c = trans(a) * trans(b) * alpha + c * beta
+where c is an m * n matrix and k is the inner dimension
+*/
+void NativeSGEMM(bool transposedA, bool transposedB, int m, int n, int k,
+                 float alpha, const float * a, int lda, const float * b, int ldb,
+                 float beta, float * c, int ldc);
+
+/*
+matrix multiplication for a block (x1,y1) - (x2,y2) of c with the native kernel
+(an instance of the TFunction type, see XThread.h)
+*/
+void _MatrixMul2DNativeBlock(TensorList * args);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __MATRIXMUL2DNATIVE_H__
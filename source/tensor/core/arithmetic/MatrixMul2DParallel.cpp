@@ -22,6 +22,7 @@
 #include "../../XTensor.h"
 #include "MatrixMul2DParallel.h"
 #include "MatrixMul2DMultiTheading.h"
+#include "MatrixMul2DNative.h"
 #include "../utilities/XMatrixSegment.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
@@ -51,6 +52,18 @@ void _MatrixMul2DParallel(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
     int an = a->dimSize[0], am = a->dimSize[1];
     int bm = b->dimSize[1];
     int cn = c->dimSize[0], cm = c->dimSize[1];
+
+#ifndef DOUBELPRICSION
+    /* 
+    the packed and vectorized kernel handles all the cases. Each job 
+    works on a block of c and packs the pieces of a and b it needs.
+    */
+    int k = transposedA == X_TRANS ? an : am;
+    double opNum = (double)cn * cm * k;
+    RunParallel2D(parallelRunner, (void*)_MatrixMul2DNativeBlock, (int)MIN(opNum, (double)MAX_INT),
+                  cn, cm, 7,
+                  a, b, c, &alpha, &beta, &transposedA, &transposedB);
+#else
     int aColNum = am;
     int bColNum = bm;
 
@@ -126,6 +139,7 @@ void _MatrixMul2DParallel(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
             }
         }
     }
+#endif
 }
 
 } // namespace nts(NiuTrans.Tensor)
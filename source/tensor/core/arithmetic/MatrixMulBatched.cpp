@@ -22,10 +22,14 @@
 #include "../../XTensor.h"
 #include "../../XDevice.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../shape/IsSameShaped.h"
 #include "MatrixMulBatched.h"
 #include "XTensorBLAS.h"
 #include "MatrixMul2D.h"
+#include "MatrixMul2DNative.h"
+#include "../shape/View.h"
+#include "../../XUtility.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
 
@@ -50,6 +54,8 @@ void _MatrixMulBatched(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
                        const XTensor * b, MATRIX_TRANS_TYPE transposedB,
                        XTensor * c, DTYPE alpha, DTYPE beta, XPRunner * parallelRunner)
 {
+    XProfileOp profile(MATH_MATRIXMULBATCHED, a, b, c);
+
     CheckNTErrors((a && b && c), "Empty input tensors!");
     CheckNTErrors((a->dataType == b->dataType && a->dataType == c->dataType),
                   "Input tensors should have the same data type!");
@@ -94,6 +100,7 @@ void _MatrixMulBatchedGPU(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
     CheckNTErrors((a->order == b->order && a->order == c->order), 
                   "Input tensor and output tensor must have same order!");
     CheckNTErrors(a->devID >= 0 && b->devID >= 0 && c->devID >= 0, "The tensors must be on GPUs");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && c->IsContiguous(), "TODO!");
 
     int an = transposedA == X_TRANS ? a->dimSize[a->order - 1] : a->dimSize[a->order - 2];
     int am = transposedA == X_TRANS ? a->dimSize[a->order - 2] : a->dimSize[a->order - 1];
@@ -137,6 +144,102 @@ void _MatrixMulBatchedGPU(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
 #endif
 }
 
+/*
+get the leading dimension of the matrices in a (strided) tensor. A matrix whose
+columns are contiguous (rather than its rows) is regarded as a transposed matrix
+that is kept in the row-major order.
+>> t - the tensor
+>> transposed - the transposition flag (it is flipped if the columns are contiguous)
+<< return - the leading dimension (-1 if neither the rows nor the columns are contiguous)
+*/
+static int GetLeadingDim(const XTensor * t, MATRIX_TRANS_TYPE &transposed)
+{
+    int rowNum = t->dimSize[t->order - 2];
+    int colNum = t->dimSize[t->order - 1];
+    int rowStride = t->GetStride(t->order - 2);
+    int colStride = t->GetStride(t->order - 1);
+
+    if ((colStride == 1 || colNum == 1) && (rowNum == 1 || rowStride >= colNum))
+        return rowNum == 1 ? colNum : rowStride;
+
+    if ((rowStride == 1 || rowNum == 1) && (colNum == 1 || colStride >= rowNum)) {
+        transposed = transposed == X_TRANS ? X_NOTRANS : X_TRANS;
+        return colNum == 1 ? rowNum : colStride;
+    }
+
+    return -1;
+}
+
+/*
+matrix multiplication of the two tensors where some of them are views (see
+View.h). Each matrix is read (or written) in place with its leading dimension,
+e.g., the heads of a split view of a (B, L, H) tensor.
+>> a - tensor a
+>> transposedA - indicates whether the matrices in a are transposed
+>> b - tensor b
+>> transposedB - indicates whether teh matrices in b are transposed
+>> c - where we keep a*b
+>> alpha - a coefficient
+>> beta - another coefficient
+*/
+void _MatrixMulBatchedStridedCPU(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
+                                 const XTensor * b, MATRIX_TRANS_TYPE transposedB,
+                                 XTensor * c, DTYPE alpha, DTYPE beta)
+{
+    CheckNTErrors(a->dataType == DEFAULT_DTYPE, "TODO!");
+
+    /* the matrices that can not be read in place are copied */
+    XTensor aCopy;
+    XTensor bCopy;
+    int lda = GetLeadingDim(a, transposedA);
+    int ldb = GetLeadingDim(b, transposedB);
+    if (lda < 0) {
+        aCopy = Contiguous(*a);
+        a = &aCopy;
+        lda = GetLeadingDim(a, transposedA);
+    }
+    if (ldb < 0) {
+        bCopy = Contiguous(*b);
+        b = &bCopy;
+        ldb = GetLeadingDim(b, transposedB);
+    }
+
+    MATRIX_TRANS_TYPE transposedC = X_NOTRANS;
+    int ldc = GetLeadingDim(c, transposedC);
+    CheckNTErrors(ldc > 0 && transposedC == X_NOTRANS, "The rows of the output matrices must be contiguous!");
+
+    int cn = c->dimSize[c->order - 2];
+    int cm = c->dimSize[c->order - 1];
+    int am = transposedA == X_TRANS ? a->dimSize[a->order - 2] : a->dimSize[a->order - 1];
+
+    /* the matrices in a and b may be transposed (by the flipping of the flags),
+       so we need their sizes as kept in memory */
+    int aBlockSize = a->dimSize[a->order - 1] * a->dimSize[a->order - 2];
+    int bBlockSize = b->dimSize[b->order - 1] * b->dimSize[b->order - 2];
+    int cBlockSize = cn * cm;
+    int blockNum = cBlockSize > 0 ? c->unitNum / cBlockSize : 0;
+
+    DTYPE * ap = (DTYPE*)a->data;
+    DTYPE * bp = (DTYPE*)b->data;
+    DTYPE * cp = (DTYPE*)c->data;
+
+    ParallelFor(0, blockNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(cBlockSize * am, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            const DTYPE * ai = ap + a->GetStridedOffset(i * aBlockSize);
+            const DTYPE * bi = bp + b->GetStridedOffset(i * bBlockSize);
+            DTYPE * ci = cp + c->GetStridedOffset(i * cBlockSize);
+#ifdef USE_BLAS
+            GEMM(CblasRowMajor, transposedA == X_TRANS ? CblasTrans : CblasNoTrans,
+                 transposedB == X_TRANS ? CblasTrans : CblasNoTrans,
+                 cn, cm, am, alpha, ai, lda, bi, ldb, beta, ci, ldc);
+#else
+            NativeSGEMM(transposedA == X_TRANS, transposedB == X_TRANS, cn, cm, am,
+                        alpha, ai, lda, bi, ldb, beta, ci, ldc);
+#endif
+        }
+    });
+}
+
 /*
 matrix multiplication of the two tensors
 optimized for CPU
@@ -190,6 +293,12 @@ void _MatrixMulBatchedCPU(const XTensor * a, MATRIX_TRANS_TYPE transposedA,
         blockNum *= a->dimSize[i];
     }
 
+    /* views (see View.h) */
+    if (!a->IsContiguous() || !b->IsContiguous() || !c->IsContiguous()) {
+        _MatrixMulBatchedStridedCPU(a, transposedA, b, transposedB, c, alpha, beta);
+        return;
+    }
+
     int aDimSize[2] = {-a->dimSize[a->order - 2], a->dimSize[a->order - 1]};
     int bDimSize[2] = {-b->dimSize[b->order - 2], b->dimSize[b->order - 1]};
     int cDimSize[2] = {-c->dimSize[c->order - 2], c->dimSize[c->order - 1]};
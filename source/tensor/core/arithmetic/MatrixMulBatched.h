@@ -54,6 +54,13 @@ optimized for GPU
 void _MatrixMulBatchedCPU(const XTensor * a, MATRIX_TRANS_TYPE transposedA, const XTensor * b, MATRIX_TRANS_TYPE transposedB, 
                           XTensor * c, DTYPE alpha = (DTYPE)1.0, DTYPE beta = 0);
 
+/*
+matrix multiplication of the two tensors c = trans(a) * trans(b) * alpha + c * beta
+where the tensors can be views (see View.h) on CPUs
+*/
+void _MatrixMulBatchedStridedCPU(const XTensor * a, MATRIX_TRANS_TYPE transposedA, const XTensor * b, MATRIX_TRANS_TYPE transposedB,
+                                 XTensor * c, DTYPE alpha = (DTYPE)1.0, DTYPE beta = 0);
+
 /*
 matrix multiplication of the two tensors c = trans(a) * trans(b) * alpha + c * beta (for list inputs)
 optimized for GPU
@@ -0,0 +1,141 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+* Matrix multiplication with float16 weights. The weights take half of the
+* memory (and the memory bandwidth) of float32 weights. We convert a panel of
+* the weight matrix (a number of output channels) into float32 at a time,
+* which is small enough to stay in the cache, and multiply the input with it.
+*/
+
+#include <string.h>
+#include "../../XTensor.h"
+#include "../getandset/ConvertDataType.h"
+#include "MatrixMulFP16.h"
+#include "MatrixMul2DNative.h"
+#include "XTensorBLAS.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* number of float32 numbers in a converted panel of the weight matrix */
+#define FP16_PANEL_SIZE (1024 * 32)
+
+/*
+c = x * w + b (or x * trans(w) + b) where w is kept in float16 and the
+computation is in float32. The output channels are split into panels and
+each panel of w is converted into float32 right before it is used.
+>> x - the input, ... * k
+>> w - the weight in float16, k * n (or n * k if it is transposed)
+>> transposedW - indicates whether w is transposed
+>> b - the bias, n (NULL means no bias)
+>> c - the output, ... * n
+*/
+void _MatrixMulFP16(const XTensor * x, const XTensor * w, MATRIX_TRANS_TYPE transposedW,
+                    const XTensor * b, XTensor * c)
+{
+    CheckNTErrors(x->dataType == X_FLOAT && c->dataType == X_FLOAT, "TODO!");
+    CheckNTErrors(w->dataType == X_FLOAT16, "The weight must be in float16!");
+    CheckNTErrors(x->devID < 0 && w->devID < 0 && c->devID < 0,
+                  "Matrix multiplication with float16 weights is only supported on CPUs!");
+    CheckNTErrors(w->order == 2, "The weight must be a matrix!");
+
+    int k = transposedW == X_TRANS ? w->dimSize[1] : w->dimSize[0];
+    int n = transposedW == X_TRANS ? w->dimSize[0] : w->dimSize[1];
+
+    CheckNTErrors(x->dimSize[x->order - 1] == k, "Unmatched tensors in multiplication!");
+    CheckNTErrors(c->dimSize[c->order - 1] == n, "Wrong size of the result!");
+    CheckNTErrors(b == NULL || (b->unitNum == n && b->dataType == X_FLOAT), "Wrong size of the bias!");
+
+    int m = x->unitNum / k;
+
+    CheckNTErrors(c->unitNum == m * n, "Wrong size of the result!");
+
+    /* a panel has a multiple of 16 output channels */
+    int panel = MAX(16, FP16_PANEL_SIZE / MAX(k, 1) / 16 * 16);
+    int panelNum = (n + panel - 1) / panel;
+
+    const float * xd = (const float*)x->data;
+    const float16 * wd = (const float16*)w->data;
+    const float * bd = b != NULL ? (const float*)b->data : NULL;
+    float * cd = (float*)c->data;
+
+    ParallelFor(0, panelNum, 1, [&](int beg, int end) {
+        float * buf = new float[(long long)panel * k];
+
+        for (int p = beg; p < end; p++) {
+            int j0 = p * panel;
+            int nb = MIN(panel, n - j0);
+            float * cp = cd + j0;
+
+            /* the panel is nb * k if w is transposed, and k * nb otherwise */
+            if (transposedW == X_TRANS)
+                ConvertFloat16ToFloat(wd + (long long)j0 * k, buf, nb * k);
+            else {
+                for (int i = 0; i < k; i++)
+                    ConvertFloat16ToFloat(wd + (long long)i * n + j0, buf + (long long)i * nb, nb);
+            }
+
+            /* c = b and then c = x * w + c */
+            float beta = 0;
+            if (bd != NULL) {
+                for (int i = 0; i < m; i++)
+                    memcpy(cp + (long long)i * n, bd + j0, sizeof(float) * nb);
+                beta = 1.0F;
+            }
+
+            int ldb = transposedW == X_TRANS ? k : nb;
+
+#ifdef USE_BLAS
+            GEMM(CblasRowMajor, CblasNoTrans, transposedW == X_TRANS ? CblasTrans : CblasNoTrans,
+                 m, nb, k, 1.0F, xd, k, buf, ldb, beta, cp, n);
+#else
+            NativeSGEMM(false, transposedW == X_TRANS, m, nb, k,
+                        1.0F, xd, k, buf, ldb, beta, cp, n);
+#endif
+        }
+
+        delete[] buf;
+    });
+}
+
+/*
+c = x * w + b (or x * trans(w) + b) where w is kept in float16 (return an XTensor structure).
+This is for inference only and no gradient goes through it.
+>> x - the input, ... * k
+>> w - the weight in float16, k * n (or n * k if it is transposed)
+>> transposedW - indicates whether w is transposed
+>> b - the bias, n (NULL means no bias)
+<< return - the output, ... * n
+*/
+XTensor MatrixMulFP16(const XTensor &x, const XTensor &w, MATRIX_TRANS_TYPE transposedW, const XTensor * b)
+{
+    CheckNTErrors(x.order >= 2 && w.order == 2, "Wrong tensor orders!");
+
+    int dimSize[MAX_TENSOR_DIM_NUM];
+    memcpy(dimSize, x.dimSize, sizeof(int) * x.order);
+    dimSize[x.order - 1] = transposedW == X_TRANS ? w.dimSize[0] : w.dimSize[1];
+
+    XTensor c(x.order, dimSize, X_FLOAT, 1.0F, x.devID, x.mem);
+    c.SetTMPFlag();
+
+    _MatrixMulFP16(&x, &w, transposedW, b, &c);
+
+    return c;
+}
+
+} // namespace nts(NiuTrans.Tensor)
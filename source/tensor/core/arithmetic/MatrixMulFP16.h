@@ -0,0 +1,45 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#ifndef __MATRIXMULFP16_H__
+#define __MATRIXMULFP16_H__
+
+#include "../../XTensor.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+c = x * w + b (or x * trans(w) + b) where w is kept in float16 and the
+computation is in float32 (for inference on CPUs)
+*/
+void _MatrixMulFP16(const XTensor * x, const XTensor * w, MATRIX_TRANS_TYPE transposedW,
+                    const XTensor * b, XTensor * c);
+
+/*
+c = x * w + b (or x * trans(w) + b) where w is kept in float16 (return an XTensor structure).
+This is for inference only and no gradient goes through it.
+*/
+XTensor MatrixMulFP16(const XTensor &x, const XTensor &w, MATRIX_TRANS_TYPE transposedW,
+                      const XTensor * b = NULL);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __MATRIXMULFP16_H__
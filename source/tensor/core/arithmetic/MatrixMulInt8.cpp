@@ -0,0 +1,345 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+* Matrix multiplication with 8-bit weights. The weights are quantized once
+* (one scale for each output channel) and the input is quantized row by row
+* when we run the multiplication. The products are accumulated in int32 and
+* are then scaled back to floats (with the bias added).
+*/
+
+#include <math.h>
+#include <string.h>
+#include "../../XTensor.h"
+#include "../../XSIMD.h"
+#include "MatrixMulInt8.h"
+
+#ifdef X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* the largest value of the quantized numbers (we do not use -128) */
+#define INT8_RANGE 127.0F
+
+/*
+a block kernel computes the dot products of (up to) 4 rows of a and 4 rows of b
+>> k - length of the rows
+>> a - pointers to the rows of a
+>> b - pointers to the rows of b
+>> c - the 4 * 4 results
+*/
+typedef void (*Int8Kernel)(int k, const signed char ** a, const signed char ** b, int c[4][4]);
+
+/* plain C++ kernel */
+static void Int8KernelScalar(int k, const signed char ** a, const signed char ** b, int c[4][4])
+{
+    for (int r = 0; r < 4; r++) {
+        for (int j = 0; j < 4; j++) {
+            int sum = 0;
+            for (int p = 0; p < k; p++)
+                sum += (int)a[r][p] * (int)b[j][p];
+            c[r][j] = sum;
+        }
+    }
+}
+
+#ifdef X86_SIMD
+
+/* sum of the 8 int32 numbers in a ymm register */
+TARGET_AVX2
+static inline int HorizontalSumAVX2(__m256i v)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+#define INT8_LOAD16(p) _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(p)))
+
+#define INT8_ROW_MADD(r) \
+{ \
+    __m256i ar = INT8_LOAD16(a[r] + p); \
+    c##r##0 = _mm256_add_epi32(c##r##0, _mm256_madd_epi16(ar, b0)); \
+    c##r##1 = _mm256_add_epi32(c##r##1, _mm256_madd_epi16(ar, b1)); \
+    c##r##2 = _mm256_add_epi32(c##r##2, _mm256_madd_epi16(ar, b2)); \
+    c##r##3 = _mm256_add_epi32(c##r##3, _mm256_madd_epi16(ar, b3)); \
+}
+
+#define INT8_ROW_STORE(r) \
+{ \
+    c[r][0] = HorizontalSumAVX2(c##r##0); \
+    c[r][1] = HorizontalSumAVX2(c##r##1); \
+    c[r][2] = HorizontalSumAVX2(c##r##2); \
+    c[r][3] = HorizontalSumAVX2(c##r##3); \
+}
+
+/*
+AVX2 kernel. 16 numbers are sign-extended to int16 and then multiplied and
+added in pairs (vpmaddwd). This is exact because |a * b| <= 127 * 127.
+*/
+TARGET_AVX2
+static void Int8KernelAVX2(int k, const signed char ** a, const signed char ** b, int c[4][4])
+{
+    __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+    __m256i c02 = _mm256_setzero_si256(), c03 = _mm256_setzero_si256();
+    __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+    __m256i c12 = _mm256_setzero_si256(), c13 = _mm256_setzero_si256();
+    __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+    __m256i c22 = _mm256_setzero_si256(), c23 = _mm256_setzero_si256();
+    __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+    __m256i c32 = _mm256_setzero_si256(), c33 = _mm256_setzero_si256();
+
+    int p = 0;
+    for (; p + 16 <= k; p += 16) {
+        __m256i b0 = INT8_LOAD16(b[0] + p);
+        __m256i b1 = INT8_LOAD16(b[1] + p);
+        __m256i b2 = INT8_LOAD16(b[2] + p);
+        __m256i b3 = INT8_LOAD16(b[3] + p);
+        INT8_ROW_MADD(0);
+        INT8_ROW_MADD(1);
+        INT8_ROW_MADD(2);
+        INT8_ROW_MADD(3);
+    }
+
+    INT8_ROW_STORE(0);
+    INT8_ROW_STORE(1);
+    INT8_ROW_STORE(2);
+    INT8_ROW_STORE(3);
+
+    /* the remaining columns */
+    for (; p < k; p++) {
+        for (int r = 0; r < 4; r++) {
+            for (int j = 0; j < 4; j++)
+                c[r][j] += (int)a[r][p] * (int)b[j][p];
+        }
+    }
+}
+
+#endif
+
+/*
+int8 matrix multiplication c = a * trans(b) (row-major, accumulated in int32)
+>> m - number of rows of a (and c)
+>> n - number of rows of b (i.e., number of columns of c)
+>> k - number of columns of a and b
+>> a - matrix a
+>> lda - distance between two rows of a
+>> b - matrix b
+>> ldb - distance between two rows of b
+>> c - matrix c
+>> ldc - distance between two rows of c
+*/
+void Int8GEMM(int m, int n, int k, const signed char * a, int lda,
+              const signed char * b, int ldb, int * c, int ldc)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    Int8Kernel kernel = Int8KernelScalar;
+
+#ifdef X86_SIMD
+    if (GetSIMDLevel() >= SIMD_AVX2)
+        kernel = Int8KernelAVX2;
+#endif
+
+    int rowBlockNum = (m + 3) / 4;
+    int colBlockNum = (n + 3) / 4;
+
+    /* each job is a block of 4 rows and 4 columns */
+    int grain = MAX(1, PFOR_ELEMENT_GRAIN / MAX(16 * k, 1));
+    ParallelFor(0, rowBlockNum * colBlockNum, grain, [&](int beg, int end) {
+        int block[4][4];
+        const signed char * ar[4];
+        const signed char * br[4];
+
+        for (int id = beg; id < end; id++) {
+            int i = (id / colBlockNum) * 4;
+            int j = (id % colBlockNum) * 4;
+            int mr = MIN(4, m - i);
+            int nr = MIN(4, n - j);
+
+            /* at the margin we repeat the last row (and throw away the results) */
+            for (int r = 0; r < 4; r++) {
+                ar[r] = a + (long long)(i + MIN(r, mr - 1)) * lda;
+                br[r] = b + (long long)(j + MIN(r, nr - 1)) * ldb;
+            }
+
+            kernel(k, ar, br, block);
+
+            for (int r = 0; r < mr; r++)
+                memcpy(c + (long long)(i + r) * ldc + j, block[r], sizeof(int) * nr);
+        }
+    });
+}
+
+/*
+quantize a weight matrix into 8-bit integers (symmetric, one scale for each
+output channel)
+>> w - the weight matrix, k * n (or n * k if it is transposed)
+>> transposedW - indicates whether w is transposed
+>> wq - the quantized matrix (X_INT8), n * k
+>> scale - the scale of each output channel (X_FLOAT), n
+*/
+void _QuantizeInt8(const XTensor * w, MATRIX_TRANS_TYPE transposedW, XTensor * wq, XTensor * scale)
+{
+    CheckNTErrors(w->order == 2, "The weight must be a matrix!");
+    CheckNTErrors(w->dataType == X_FLOAT, "TODO!");
+    CheckNTErrors(wq->dataType == X_INT8 && scale->dataType == X_FLOAT, "Wrong data types!");
+    CheckNTErrors(w->devID < 0 && wq->devID < 0 && scale->devID < 0,
+                  "INT8 quantization is only supported on CPUs!");
+
+    int k = transposedW == X_TRANS ? w->dimSize[1] : w->dimSize[0];
+    int n = transposedW == X_TRANS ? w->dimSize[0] : w->dimSize[1];
+
+    CheckNTErrors(wq->order == 2 && wq->dimSize[0] == n && wq->dimSize[1] == k, "Wrong size of the result!");
+    CheckNTErrors(scale->unitNum == n, "Wrong size of the scale!");
+
+    const float * wd = (const float*)w->data;
+    signed char * qd = (signed char*)wq->data;
+    float * sd = (float*)scale->data;
+
+    /* element (p, j) of the k * n matrix */
+    int stepP = transposedW == X_TRANS ? 1 : n;
+    int stepJ = transposedW == X_TRANS ? k : 1;
+
+    ParallelFor(0, n, MAX(1, PFOR_ELEMENT_GRAIN / MAX(k, 1)), [&](int beg, int end) {
+        for (int j = beg; j < end; j++) {
+            float maxAbs = 0;
+            for (int p = 0; p < k; p++)
+                maxAbs = MAX(maxAbs, (float)fabs(wd[p * stepP + j * stepJ]));
+
+            float s = maxAbs / INT8_RANGE;
+            float inv = s > 0 ? 1.0F / s : 0;
+            for (int p = 0; p < k; p++)
+                qd[(long long)j * k + p] = (signed char)lrintf(wd[p * stepP + j * stepJ] * inv);
+
+            sd[j] = s;
+        }
+    });
+}
+
+/*
+c = x * w + b where w is quantized into 8-bit integers (see _QuantizeInt8).
+Each row of x is quantized with its own scale on the fly.
+>> x - the input, ... * k
+>> wq - the quantized weight, n * k
+>> scale - the scale of each output channel, n
+>> b - the bias, n (NULL means no bias)
+>> c - the output, ... * n
+*/
+void _MatrixMulInt8(const XTensor * x, const XTensor * wq, const XTensor * scale,
+                    const XTensor * b, XTensor * c)
+{
+    CheckNTErrors(x->dataType == X_FLOAT && c->dataType == X_FLOAT, "TODO!");
+    CheckNTErrors(wq->dataType == X_INT8 && scale->dataType == X_FLOAT, "Wrong data types!");
+    CheckNTErrors(x->devID < 0 && wq->devID < 0 && c->devID < 0,
+                  "INT8 matrix multiplication is only supported on CPUs!");
+    CheckNTErrors(wq->order == 2, "The weight must be a matrix!");
+
+    int n = wq->dimSize[0];
+    int k = wq->dimSize[1];
+
+    CheckNTErrors(x->dimSize[x->order - 1] == k, "Unmatched tensors in multiplication!");
+    CheckNTErrors(c->dimSize[c->order - 1] == n, "Wrong size of the result!");
+    CheckNTErrors(scale->unitNum == n, "Wrong size of the scale!");
+    CheckNTErrors(b == NULL || (b->unitNum == n && b->dataType == X_FLOAT), "Wrong size of the bias!");
+
+    int m = x->unitNum / k;
+
+    CheckNTErrors(c->unitNum == m * n, "Wrong size of the result!");
+
+    const float * xd = (const float*)x->data;
+    signed char * xq = new signed char[(long long)m * k];
+    float * xScale = new float[m];
+    int * acc = new int[(long long)m * n];
+
+    /* quantize the input row by row */
+    ParallelFor(0, m, MAX(1, PFOR_ELEMENT_GRAIN / MAX(k, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            const float * row = xd + (long long)i * k;
+            float maxAbs = 0;
+            for (int p = 0; p < k; p++)
+                maxAbs = MAX(maxAbs, (float)fabs(row[p]));
+
+            float s = maxAbs / INT8_RANGE;
+            float inv = s > 0 ? 1.0F / s : 0;
+            signed char * q = xq + (long long)i * k;
+            for (int p = 0; p < k; p++)
+                q[p] = (signed char)lrintf(row[p] * inv);
+
+            xScale[i] = s;
+        }
+    });
+
+    Int8GEMM(m, n, k, xq, k, (const signed char*)wq->data, k, acc, n);
+
+    /* scale the results back and add the bias */
+    const float * sd = (const float*)scale->data;
+    const float * bd = b != NULL ? (const float*)b->data : NULL;
+    float * cd = (float*)c->data;
+
+    ParallelFor(0, m, MAX(1, PFOR_ELEMENT_GRAIN / MAX(n, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            const int * ai = acc + (long long)i * n;
+            float * ci = cd + (long long)i * n;
+            float s = xScale[i];
+            if (bd != NULL) {
+                for (int j = 0; j < n; j++)
+                    ci[j] = (float)ai[j] * s * sd[j] + bd[j];
+            }
+            else {
+                for (int j = 0; j < n; j++)
+                    ci[j] = (float)ai[j] * s * sd[j];
+            }
+        }
+    });
+
+    delete[] xq;
+    delete[] xScale;
+    delete[] acc;
+}
+
+/*
+c = x * w + b where w is quantized into 8-bit integers (return an XTensor structure).
+This is for inference only and no gradient goes through it.
+>> x - the input, ... * k
+>> wq - the quantized weight, n * k
+>> scale - the scale of each output channel, n
+>> b - the bias, n (NULL means no bias)
+<< return - the output, ... * n
+*/
+XTensor MatrixMulInt8(const XTensor &x, const XTensor &wq, const XTensor &scale, const XTensor * b)
+{
+    CheckNTErrors(x.order >= 2 && wq.order == 2, "Wrong tensor orders!");
+
+    int dimSize[MAX_TENSOR_DIM_NUM];
+    memcpy(dimSize, x.dimSize, sizeof(int) * x.order);
+    dimSize[x.order - 1] = wq.dimSize[0];
+
+    XTensor c(x.order, dimSize, X_FLOAT, 1.0F, x.devID, x.mem);
+    c.SetTMPFlag();
+
+    _MatrixMulInt8(&x, &wq, &scale, b, &c);
+
+    return c;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,59 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#ifndef __MATRIXMULINT8_H__
+#define __MATRIXMULINT8_H__
+
+#include "../../XTensor.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+int8 matrix multiplication c = a * trans(b) (row-major, accumulated in int32)
+where a is an m * k matrix and b is an n * k matrix
+*/
+void Int8GEMM(int m, int n, int k, const signed char * a, int lda,
+              const signed char * b, int ldb, int * c, int ldc);
+
+/*
+quantize a weight matrix into 8-bit integers (symmetric, one scale for each
+output channel). The result wq is an n * k matrix and w = trans(wq) * scale,
+i.e., w[i][j] = wq[j][i] * scale[j] (or w[j][i] = wq[j][i] * scale[j] if w is
+transposed).
+*/
+void _QuantizeInt8(const XTensor * w, MATRIX_TRANS_TYPE transposedW, XTensor * wq, XTensor * scale);
+
+/*
+c = x * w + b where w is quantized into 8-bit integers (see _QuantizeInt8)
+and x is quantized row by row on the fly
+*/
+void _MatrixMulInt8(const XTensor * x, const XTensor * wq, const XTensor * scale,
+                    const XTensor * b, XTensor * c);
+
+/*
+c = x * w + b where w is quantized into 8-bit integers (return an XTensor structure).
+This is for inference only and no gradient goes through it.
+*/
+XTensor MatrixMulInt8(const XTensor &x, const XTensor &wq, const XTensor &scale, const XTensor * b = NULL);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __MATRIXMULINT8_H__
@@ -21,6 +21,7 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "../shape/IsSameShaped.h"
 #include "Sum.h"
@@ -45,10 +46,14 @@ where i is the index of the item
 */
 void _Multiply(const XTensor * a, const XTensor * b, XTensor * c, DTYPE alpha, int leadingDim)
 {
+    XProfileOp profile(MATH_MULTIPLY, a, b, c);
+
     CheckNTErrors((a->unitNum <= c->unitNum && b->unitNum <= c->unitNum),
                   "Unmatched tensors in multiplication!");
     CheckNTErrors((a->order == b->order && a->order == c->order), 
                   "Unmatched tensors!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && c->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     CheckDev(a->devID, b->devID);
 #ifdef USE_CUDA
@@ -90,12 +95,16 @@ void _Multiply(const XTensor * a, const XTensor * b, XTensor * c, DTYPE alpha, i
                 DTYPE * bp = (DTYPE*)b->data;
                 DTYPE * cp = (DTYPE*)c->data;
                 if (alpha == 0) {
-                    for (int i = 0; i < size; i++)
-                        cp[i] = ap[i] * bp[i];
+                    ParallelFor(0, size, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                        for (int i = beg; i < end; i++)
+                            cp[i] = ap[i] * bp[i];
+                    });
                 }
                 else {
-                    for (int i = 0; i < size; i++)
-                        cp[i] = ap[i] * bp[i] + alpha * cp[i];
+                    ParallelFor(0, size, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                        for (int i = beg; i < end; i++)
+                            cp[i] = ap[i] * bp[i] + alpha * cp[i];
+                    });
                 }
             }
             else {
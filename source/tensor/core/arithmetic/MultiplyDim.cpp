@@ -26,6 +26,7 @@
 #include "../shape/Unsqueeze.h"
 #include "../shape/IsSameShaped.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "../movement/CopyValues.h"
 
@@ -46,6 +47,8 @@ i.e., a is multiplied with b by broadcasting
 */
 void _MultiplyDim(const XTensor * a, const XTensor * b, XTensor * c, int n, DTYPE alpha) 
 {
+    XProfileOp profile(MATH_MULTIPLYDIM, a, b, c);
+
     n = MODX(n, a->order);
 
     CheckNTErrors(a && b && c, "Empty tensor input!");
@@ -55,6 +58,8 @@ void _MultiplyDim(const XTensor * a, const XTensor * b, XTensor * c, int n, DTYP
     CheckNTErrors(a->order == c->order, "The input tensors do not have the same order in multiplication!");
     CheckNTErrors(!a->isSparse && !b->isSparse && !c->isSparse, "Dense tensors are required!");
     CheckNTErrors(a->dimSize[n] == b->unitNum, "Wrong tensor size!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && c->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     CheckDev(a->devID, b->devID);
 
@@ -21,6 +21,7 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "../../XBLAS.h"
 #include "../movement/CopyValues.h"
@@ -42,6 +43,8 @@ tensor summation c = a + b * \beta
 */
 void _Sum(const XTensor * a, const XTensor * b, XTensor * c, DTYPE beta)
 {
+    XProfileOp profile(MATH_SUM, a, b, c);
+
     CheckNTErrors(a && b && c, "Empty tensor input!");
     CheckNTErrors(a->unitNum == b->unitNum && a->unitNum == c->unitNum,
                   "Unmatched tensors in addition!");
@@ -80,6 +83,36 @@ void _Sum(const XTensor * a, const XTensor * b, XTensor * c, DTYPE beta)
         if (!a->isSparse && !b->isSparse) {
             CheckNTErrors(!c->isSparse, "Illegal use of sparse tensor in addition!");
 
+            /* views (see View.h). We go over the rows (i.e., the last dimension)
+               and find where a row starts with the strides. */
+            if (!a->IsContiguous() || !b->IsContiguous() || !c->IsContiguous()) {
+                CheckNTErrors(a->dataType == DEFAULT_DTYPE, "TODO!");
+                CheckNTErrors(_IsSameShaped(a, b) && _IsSameShaped(a, c), "Unmatched tensors in addition!");
+
+                if (c->unitNum == 0)
+                    return;
+
+                int rowSize = c->order > 0 ? c->dimSize[c->order - 1] : 1;
+                int rowNum = c->unitNum / rowSize;
+                int aStep = a->order > 0 ? a->GetStride(a->order - 1) : 1;
+                int bStep = b->order > 0 ? b->GetStride(b->order - 1) : 1;
+                int cStep = c->order > 0 ? c->GetStride(c->order - 1) : 1;
+                DTYPE * ap = (DTYPE*)a->data;
+                DTYPE * bp = (DTYPE*)b->data;
+                DTYPE * cp = (DTYPE*)c->data;
+
+                ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(rowSize, 1)), [&](int beg, int end) {
+                    for (int i = beg; i < end; i++) {
+                        DTYPE * ar = ap + a->GetStridedOffset(i * rowSize);
+                        DTYPE * br = bp + b->GetStridedOffset(i * rowSize);
+                        DTYPE * cr = cp + c->GetStridedOffset(i * rowSize);
+                        for (int j = 0; j < rowSize; j++)
+                            cr[j * cStep] = ar[j * aStep] + br[j * bStep] * beta;
+                    }
+                });
+                return;
+            }
+
             if (a->dataType == DEFAULT_DTYPE &&
                 b->dataType == DEFAULT_DTYPE &&
                 c->dataType == DEFAULT_DTYPE)
@@ -116,27 +149,12 @@ void _Sum(const XTensor * a, const XTensor * b, XTensor * c, DTYPE beta)
                     }
                 }
 #else
-                /* unrolling */
+                /* split the elements among the threads */
                 int num = a->unitNum;
-                if (num % 4 == 0) {
-                    for (int i = 0; i < num; i += 4) {
-                        cp[i] = ap[i] + bp[i] * beta;
-                        cp[i + 1] = ap[i + 1] + bp[i + 1] * beta;
-                        cp[i + 2] = ap[i + 2] + bp[i + 2] * beta;
-                        cp[i + 3] = ap[i + 3] + bp[i + 3] * beta;
-                    }
-                }
-                else if (num % 2 == 0) {
-                    for (int i = 0; i < num; i += 2) {
-                        cp[i] = ap[i] + bp[i] * beta;
-                        cp[i + 1] = ap[i + 1] + bp[i + 1] * beta;
-                    }
-                }
-                else {
-                    for (int i = 0; i < num; i++) {
+                ParallelFor(0, num, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                    for (int i = beg; i < end; i++)
                         cp[i] = ap[i] + bp[i] * beta;
-                    }
-                }
+                });
 #endif
             }
             else if (a->dataType == X_INT &&
@@ -147,27 +165,12 @@ void _Sum(const XTensor * a, const XTensor * b, XTensor * c, DTYPE beta)
                 int * bp = (int*)b->data;
                 int * cp = (int*)c->data;
 
-                /* unrolling */
+                /* split the elements among the threads */
                 int num = a->unitNum;
-                if (num % 4 == 0) {
-                    for (int i = 0; i < num; i += 4) {
-                        cp[i] = ap[i] + bp[i] * beta;
-                        cp[i + 1] = ap[i + 1] + bp[i + 1] * beta;
-                        cp[i + 2] = ap[i + 2] + bp[i + 2] * beta;
-                        cp[i + 3] = ap[i + 3] + bp[i + 3] * beta;
-                    }
-                }
-                else if (num % 2 == 0) {
-                    for (int i = 0; i < num; i += 2) {
+                ParallelFor(0, num, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                    for (int i = beg; i < end; i++)
                         cp[i] = ap[i] + bp[i] * beta;
-                        cp[i + 1] = ap[i + 1] + bp[i + 1] * beta;
-                    }
-                }
-                else {
-                    for (int i = 0; i < num; i++) {
-                        cp[i] = ap[i] + bp[i] * beta;
-                    }
-                }
+                });
             }
             else {
                 // TODO!!
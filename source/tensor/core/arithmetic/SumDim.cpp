@@ -28,6 +28,7 @@
 #include "../shape/Unsqueeze.h"
 #include "../shape/IsSameShaped.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "../movement/CopyValues.h"
 
@@ -48,6 +49,8 @@ i.e., a is summed with b by broadcasting
 */
 void _SumDim(const XTensor * a, const XTensor * b, XTensor * c, int n, DTYPE beta)
 {
+    XProfileOp profile(MATH_SUMDIM, a, b, c);
+
     n = MODX(n, a->order);
 
     CheckNTErrors(a && b && c, "Empty tensor input!");
@@ -57,6 +60,8 @@ void _SumDim(const XTensor * a, const XTensor * b, XTensor * c, int n, DTYPE bet
     CheckNTErrors(a->order == c->order, "The input tensors do not have the same order in addition!");
     CheckNTErrors(!a->isSparse && !b->isSparse && !c->isSparse, "Dense tensors are required!");
     CheckNTErrors(a->dimSize[n] == b->unitNum, "Wrong tensor size!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && c->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     CheckDev(a->devID, b->devID);
 
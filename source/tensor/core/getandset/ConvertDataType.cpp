@@ -21,6 +21,8 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
+#include "../../XSIMDMath.h"
 #include "ConvertDataType.h"
 #include "ConvertDataType.cuh"
 #include "../movement/CopyValues.h"
@@ -28,6 +30,292 @@
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
 
+/*
+tables for the conversion between float16 and float32 without the hardware
+support (see "Fast Half Float Conversions" by Jeroen van der Zijp). A float16
+number h is converted by
+f = mantissa[offset[h >> 10] + (h & 0x3FF)] + exponent[h >> 10]
+and a float32 number f is converted by
+h = base[f >> 23] + ((mantissa(f) | implicit[f >> 23]) >> shift[f >> 23])
+with the rounding to the nearest even number (as the hardware does).
+*/
+struct Float16Tables
+{
+    unsigned int mantissa[2048];
+    unsigned int exponent[64];
+    unsigned short offset[64];
+    unsigned short base[512];
+    unsigned char shift[512];
+    unsigned int implicit[512];
+
+    Float16Tables()
+    {
+        /* float16 -> float32 */
+        mantissa[0] = 0;
+        for (int i = 1; i < 1024; i++) {
+            /* subnormal numbers are normalized */
+            unsigned int m = (unsigned int)i << 13;
+            unsigned int e = 0;
+            while (!(m & 0x00800000)) {
+                e -= 0x00800000;
+                m <<= 1;
+            }
+            m &= ~0x00800000;
+            e += 0x38800000;
+            mantissa[i] = m | e;
+        }
+        for (int i = 1024; i < 2048; i++)
+            mantissa[i] = 0x38000000 + ((unsigned int)(i - 1024) << 13);
+
+        exponent[0] = 0;
+        exponent[32] = 0x80000000;
+        for (int i = 1; i < 31; i++) {
+            exponent[i] = (unsigned int)i << 23;
+            exponent[i + 32] = 0x80000000 + ((unsigned int)i << 23);
+        }
+        exponent[31] = 0x47800000;
+        exponent[63] = 0xC7800000;
+
+        for (int i = 0; i < 64; i++)
+            offset[i] = (i == 0 || i == 32) ? 0 : 1024;
+
+        /* float32 -> float16 */
+        for (int i = 0; i < 256; i++) {
+            int e = i - 127;
+            unsigned short b;
+            unsigned char s;
+            unsigned int im = 0;
+            if (e < -25) {
+                /* too small (zero) */
+                b = 0;
+                s = 24;
+            }
+            else if (e < -14) {
+                /* subnormal numbers */
+                b = 0;
+                s = (unsigned char)(-e - 1);
+                im = 0x00800000;
+            }
+            else if (e <= 15) {
+                /* normal numbers */
+                b = (unsigned short)((e + 15) << 10);
+                s = 13;
+            }
+            else if (e < 128) {
+                /* too large (infinity) */
+                b = 0x7C00;
+                s = 24;
+            }
+            else {
+                /* infinity and NaN */
+                b = 0x7C00;
+                s = 13;
+            }
+            base[i] = b;
+            base[i | 0x100] = b | 0x8000;
+            shift[i] = shift[i | 0x100] = s;
+            implicit[i] = implicit[i | 0x100] = im;
+        }
+    }
+};
+
+/* get the tables (they are built once) */
+static const Float16Tables &GetFloat16Tables()
+{
+    static Float16Tables tables;
+    return tables;
+}
+
+/* the kernels of conversion for a segment of an array */
+typedef void (*F32ToF16Kernel)(const float * s, unsigned short * t, int n);
+typedef void (*F16ToF32Kernel)(const unsigned short * s, float * t, int n);
+
+/*
+float32 -> float16 with the tables
+>> s - the float32 numbers
+>> t - the float16 numbers
+>> n - number of the items
+*/
+static void F32ToF16KernelTable(const float * s, unsigned short * t, int n)
+{
+    const Float16Tables &tab = GetFloat16Tables();
+    const unsigned int * f = (const unsigned int*)s;
+
+    for (int i = 0; i < n; i++) {
+        unsigned int x = f[i];
+        unsigned int e = x >> 23;
+
+        /* NaN is quieted (as the hardware does) so that it stays NaN even if
+           the high bits of its mantissa are zero */
+        if ((x & 0x7FFFFFFF) > 0x7F800000) {
+            t[i] = (unsigned short)(((x >> 16) & 0x8000) | 0x7E00 | ((x >> 13) & 0x3FF));
+            continue;
+        }
+
+        unsigned int m = (x & 0x007FFFFF) | tab.implicit[e];
+        unsigned int sh = tab.shift[e];
+        unsigned int h = tab.base[e] + (m >> sh);
+        unsigned int rest = m & ((1U << sh) - 1);
+        unsigned int half = 1U << (sh - 1);
+
+        /* round to the nearest even number. It may carry into the exponent,
+           which is what we want */
+        if (rest > half || (rest == half && (h & 1)))
+            h++;
+
+        t[i] = (unsigned short)h;
+    }
+}
+
+/*
+float16 -> float32 with the tables
+>> s - the float16 numbers
+>> t - the float32 numbers
+>> n - number of the items
+*/
+static void F16ToF32KernelTable(const unsigned short * s, float * t, int n)
+{
+    const Float16Tables &tab = GetFloat16Tables();
+    unsigned int * f = (unsigned int*)t;
+
+    for (int i = 0; i < n; i++) {
+        unsigned int h = s[i];
+        f[i] = tab.mantissa[tab.offset[h >> 10] + (h & 0x3FF)] + tab.exponent[h >> 10];
+    }
+}
+
+#ifdef X86_SIMD
+
+/* float32 -> float16 (F16C, 8 items at a time) */
+TARGET_F16C
+static void F32ToF16KernelF16C(const float * s, unsigned short * t, int n)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(s + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)(t + i), h);
+    }
+
+    F32ToF16KernelTable(s + i, t + i, n - i);
+}
+
+/* float16 -> float32 (F16C, 8 items at a time) */
+TARGET_F16C
+static void F16ToF32KernelF16C(const unsigned short * s, float * t, int n)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(t + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(s + i))));
+
+    F16ToF32KernelTable(s + i, t + i, n - i);
+}
+
+/* float32 -> float16 (AVX-512, 16 items at a time) */
+TARGET_AVX512
+static void F32ToF16KernelAVX512(const float * s, unsigned short * t, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(s + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256((__m256i*)(t + i), h);
+    }
+
+    F32ToF16KernelTable(s + i, t + i, n - i);
+}
+
+/* float16 -> float32 (AVX-512, 16 items at a time) */
+TARGET_AVX512
+static void F16ToF32KernelAVX512(const unsigned short * s, float * t, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(t + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(s + i))));
+
+    F16ToF32KernelTable(s + i, t + i, n - i);
+}
+
+#endif
+
+/* choose the kernel of float32 -> float16 for this machine */
+static F32ToF16Kernel GetF32ToF16Kernel()
+{
+#ifdef X86_SIMD
+    if (GetSIMDLevel() >= SIMD_AVX512)
+        return F32ToF16KernelAVX512;
+    else if (IsF16CSupported())
+        return F32ToF16KernelF16C;
+#endif
+    return F32ToF16KernelTable;
+}
+
+/* choose the kernel of float16 -> float32 for this machine */
+static F16ToF32Kernel GetF16ToF32Kernel()
+{
+#ifdef X86_SIMD
+    if (GetSIMDLevel() >= SIMD_AVX512)
+        return F16ToF32KernelAVX512;
+    else if (IsF16CSupported())
+        return F16ToF32KernelF16C;
+#endif
+    return F16ToF32KernelTable;
+}
+
+/*
+convert float32 numbers to float16 numbers (rounded to the nearest even
+number). It runs in the calling thread, e.g., on a block of a matrix in
+another parallel job.
+>> s - the float32 numbers
+>> t - the float16 numbers
+>> size - number of the items
+*/
+void ConvertFloatToFloat16(const float * s, float16 * t, int size)
+{
+    GetF32ToF16Kernel()(s, (unsigned short*)t, size);
+}
+
+/*
+convert float16 numbers to float32 numbers. It runs in the calling thread.
+>> s - the float16 numbers
+>> t - the float32 numbers
+>> size - number of the items
+*/
+void ConvertFloat16ToFloat(const float16 * s, float * t, int size)
+{
+    GetF16ToF32Kernel()((const unsigned short*)s, t, size);
+}
+
+/*
+convert float32 numbers to float16 numbers with a number of threads
+>> s - the float32 numbers
+>> t - the float16 numbers
+>> size - number of the items
+*/
+static void ConvertFloatToFloat16Parallel(const float * s, float16 * t, int size)
+{
+    F32ToF16Kernel kernel = GetF32ToF16Kernel();
+    unsigned short * h = (unsigned short*)t;
+
+    ParallelFor(0, size, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+        kernel(s + beg, h + beg, end - beg);
+    });
+}
+
+/*
+convert float16 numbers to float32 numbers with a number of threads
+>> s - the float16 numbers
+>> t - the float32 numbers
+>> size - number of the items
+*/
+static void ConvertFloat16ToFloatParallel(const float16 * s, float * t, int size)
+{
+    F16ToF32Kernel kernel = GetF16ToF32Kernel();
+    const unsigned short * h = (const unsigned short*)s;
+
+    ParallelFor(0, size, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+        kernel(h + beg, t + beg, end - beg);
+    });
+}
+
 /* 
 data type conversion
 >> devID - device id
@@ -48,14 +336,10 @@ void ConvertDataType(int devID,
         return;
 
     if(typeS == X_FLOAT && typeT == X_FLOAT16){
-        for(int i = 0; i < size; i++){
-            ((float16*)t)[i] = float16(((float*)s)[i]);
-        }
+        ConvertFloatToFloat16Parallel((float*)s, (float16*)t, size);
     }
     else if(typeS == X_FLOAT16 && typeT == X_FLOAT){
-        for(int i = 0; i < size; i++){
-            ((float*)t)[i] = ((float16*)s)[i].Float();
-        }
+        ConvertFloat16ToFloatParallel((float16*)s, (float*)t, size);
     }
     else{
         ShowNTErrors("Unsupported data types for conversion!");
@@ -70,6 +354,11 @@ convert data type
 */
 void _ConvertDataType(const XTensor * input, XTensor * output)
 {
+    XProfileOp profile(GETANDSET_CONVERTDATATYPE, input, NULL, output);
+
+    CheckNTErrors(input->IsContiguous() && output->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
+
     if (input->dataType == output->dataType)
         return;
     
@@ -94,16 +383,10 @@ void _ConvertDataType(const XTensor * input, XTensor * output)
             outputData[i] = (float)inputData[i];
     }
     else if (input->dataType == X_FLOAT && output->dataType == X_FLOAT16) {
-        float* inputData = (float*)input->data;
-        float16* outputData = (float16*)output->data;
-        for (int i = 0; i < input->unitNum; i++)
-            outputData[i] = (float16)inputData[i];
+        ConvertFloatToFloat16Parallel((float*)input->data, (float16*)output->data, input->unitNum);
     }
     else if (input->dataType == X_FLOAT16 && output->dataType == X_FLOAT) {
-        float16* inputData = (float16*)input->data;
-        float* outputData = (float*)output->data;
-        for (int i = 0; i < input->unitNum; i++)
-            outputData[i] = inputData[i].Float();
+        ConvertFloat16ToFloatParallel((float16*)input->data, (float*)output->data, input->unitNum);
     }
     else
         ShowNTErrors("Unsupported data types for conversion!");
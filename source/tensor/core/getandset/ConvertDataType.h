@@ -24,6 +24,7 @@
 
 #include "../../XTensor.h"
 #include "../../XDataType.h"
+#include "../utilities/Float16.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
 
@@ -32,6 +33,12 @@ void ConvertDataType(int devID,
                      void * s, TENSOR_DATA_TYPE typeS, 
                      void * t, TENSOR_DATA_TYPE typeT, int size);
 
+/* convert float32 numbers to float16 numbers (in the calling thread) */
+void ConvertFloatToFloat16(const float * s, float16 * t, int size);
+
+/* convert float16 numbers to float32 numbers (in the calling thread) */
+void ConvertFloat16ToFloat(const float16 * s, float * t, int size);
+
 /* convert data type */
 void _ConvertDataType(const XTensor * input, XTensor * output);
 
@@ -0,0 +1,237 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ * Adam in one sweep over the memory. It replaces a chain of element-wise
+ * operations (ScaleAndShift, Sum, Multiply, Power, Div ...) that read and
+ * write the parameters and the moments many times.
+ */
+
+#include <math.h>
+#include "../../XTensor.h"
+#include "../../XSIMDMath.h"
+#include "../shape/IsSameShaped.h"
+#include "../movement/Gather.h"
+#include "../movement/CopyIndexed.h"
+#include "Adam.h"
+#include "Adam.cuh"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* the kernel for a segment of the parameters */
+typedef void (*AdamKernel)(float * p, const float * g, float * m, float * v, int n,
+                           float beta1, float beta2, float alpha, float delta, float keep);
+
+/*
+a step of the Adam update (scalar)
+>> p - the parameters
+>> g - the gradients
+>> m - the first moments
+>> v - the second moments
+>> n - number of the items
+>> beta1 - decay rate of the first moments
+>> beta2 - decay rate of the second moments
+>> alpha - step size (with the bias correction)
+>> delta - a small number for numerical stability
+>> keep - 1 - the weight decay
+*/
+static void AdamKernelScalar(float * p, const float * g, float * m, float * v, int n,
+                             float beta1, float beta2, float alpha, float delta, float keep)
+{
+    for (int i = 0; i < n; i++) {
+        float gi = g[i];
+        float mi = beta1 * m[i] + (1.0F - beta1) * gi;
+        float vi = beta2 * v[i] + (1.0F - beta2) * gi * gi;
+        m[i] = mi;
+        v[i] = vi;
+        p[i] = keep * p[i] - alpha * mi / (sqrtf(vi) + delta);
+    }
+}
+
+#ifdef X86_SIMD
+
+/* a step of the Adam update (AVX2) */
+TARGET_AVX2
+static void AdamKernelAVX2(float * p, const float * g, float * m, float * v, int n,
+                           float beta1, float beta2, float alpha, float delta, float keep)
+{
+    __m256 b1 = _mm256_set1_ps(beta1);
+    __m256 c1 = _mm256_set1_ps(1.0F - beta1);
+    __m256 b2 = _mm256_set1_ps(beta2);
+    __m256 c2 = _mm256_set1_ps(1.0F - beta2);
+    __m256 a = _mm256_set1_ps(alpha);
+    __m256 d = _mm256_set1_ps(delta);
+    __m256 k = _mm256_set1_ps(keep);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 gi = _mm256_loadu_ps(g + i);
+        __m256 mi = _mm256_fmadd_ps(b1, _mm256_loadu_ps(m + i), _mm256_mul_ps(c1, gi));
+        __m256 vi = _mm256_fmadd_ps(b2, _mm256_loadu_ps(v + i), _mm256_mul_ps(c2, _mm256_mul_ps(gi, gi)));
+        __m256 u = _mm256_div_ps(mi, _mm256_add_ps(_mm256_sqrt_ps(vi), d));
+        _mm256_storeu_ps(m + i, mi);
+        _mm256_storeu_ps(v + i, vi);
+        _mm256_storeu_ps(p + i, _mm256_fnmadd_ps(a, u, _mm256_mul_ps(k, _mm256_loadu_ps(p + i))));
+    }
+
+    AdamKernelScalar(p + i, g + i, m + i, v + i, n - i, beta1, beta2, alpha, delta, keep);
+}
+
+/* a step of the Adam update (AVX-512) */
+TARGET_AVX512
+static void AdamKernelAVX512(float * p, const float * g, float * m, float * v, int n,
+                             float beta1, float beta2, float alpha, float delta, float keep)
+{
+    __m512 b1 = _mm512_set1_ps(beta1);
+    __m512 c1 = _mm512_set1_ps(1.0F - beta1);
+    __m512 b2 = _mm512_set1_ps(beta2);
+    __m512 c2 = _mm512_set1_ps(1.0F - beta2);
+    __m512 a = _mm512_set1_ps(alpha);
+    __m512 d = _mm512_set1_ps(delta);
+    __m512 k = _mm512_set1_ps(keep);
+
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 gi = _mm512_loadu_ps(g + i);
+        __m512 mi = _mm512_fmadd_ps(b1, _mm512_loadu_ps(m + i), _mm512_mul_ps(c1, gi));
+        __m512 vi = _mm512_fmadd_ps(b2, _mm512_loadu_ps(v + i), _mm512_mul_ps(c2, _mm512_mul_ps(gi, gi)));
+        __m512 u = _mm512_div_ps(mi, _mm512_add_ps(_mm512_sqrt_ps(vi), d));
+        _mm512_storeu_ps(m + i, mi);
+        _mm512_storeu_ps(v + i, vi);
+        _mm512_storeu_ps(p + i, _mm512_fnmadd_ps(a, u, _mm512_mul_ps(k, _mm512_loadu_ps(p + i))));
+    }
+
+    AdamKernelScalar(p + i, g + i, m + i, v + i, n - i, beta1, beta2, alpha, delta, keep);
+}
+
+#endif
+
+/*
+a step of the Adam (or AdamW) update in a single sweep (do it on site)
+m = beta1 * m + (1 - beta1) * g
+v = beta2 * v + (1 - beta2) * g * g
+p = (1 - decay) * p - alpha * m / (sqrt(v) + delta)
+where alpha is the learning rate with the bias correction, i.e.,
+lr * sqrt(1 - beta2^t) / (1 - beta1^t), and decay is the (decoupled) weight
+decay of AdamW (decay = 0 for Adam)
+>> p - the parameters
+>> g - the gradients
+>> m - the first moments
+>> v - the second moments
+>> beta1 - decay rate of the first moments
+>> beta2 - decay rate of the second moments
+>> alpha - step size (with the bias correction)
+>> delta - a small number for numerical stability
+>> decay - the weight decay (scaled by the learning rate)
+*/
+void _Adam(XTensor * p, const XTensor * g, XTensor * m, XTensor * v,
+           DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE decay)
+{
+    CheckNTErrors(_IsSameShaped(p, g) && _IsSameShaped(p, m) && _IsSameShaped(p, v),
+                  "Input tensors should have the same shape!");
+    CheckNTErrors(p->devID == g->devID && p->devID == m->devID && p->devID == v->devID,
+                  "Input tensors should be on the same device!");
+    CheckNTErrors(p->dataType == X_FLOAT, "TODO!");
+
+#ifdef USE_CUDA
+    /* run it on GPUs */
+    if (p->devID >= 0) {
+        _CudaAdam(p, g, m, v, beta1, beta2, alpha, delta, decay);
+        return;
+    }
+#endif
+
+    AdamKernel kernel = AdamKernelScalar;
+
+#ifdef X86_SIMD
+    SIMD_LEVEL level = GetSIMDLevel();
+    if (level >= SIMD_AVX512)
+        kernel = AdamKernelAVX512;
+    else if (level >= SIMD_AVX2)
+        kernel = AdamKernelAVX2;
+#endif
+
+    float * pd = (float*)p->data;
+    const float * gd = (const float*)g->data;
+    float * md = (float*)m->data;
+    float * vd = (float*)v->data;
+    float keep = 1.0F - decay;
+
+    ParallelFor(0, p->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+        kernel(pd + beg, gd + beg, md + beg, vd + beg, end - beg, beta1, beta2, alpha, delta, keep);
+    });
+}
+
+/*
+a step of the Adam update with a row-sparse gradient (do it on site). The rows
+of p, m and v that appear in the gradient are gathered, updated in a single
+sweep and then copied back. So the cost depends on the number of the rows
+rather than the size of p.
+>> p - the parameter matrix
+>> g - the row-sparse gradient (it is coalesced here)
+>> m - the first moment
+>> v - the second moment
+>> beta1 - decay rate of the first moment
+>> beta2 - decay rate of the second moment
+>> alpha - the (bias-corrected) learning rate
+>> delta - the (bias-corrected) smoothing term
+>> decay - the (decoupled) weight decay
+*/
+void _AdamSparse(XTensor * p, XRowSparse * g, XTensor * m, XTensor * v,
+                 DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE decay)
+{
+    CheckNTErrors(_IsSameShaped(p, m) && _IsSameShaped(p, v),
+                  "Input tensors should have the same shape!");
+    CheckNTErrors(p->order == 2 && p->dimSize[0] == g->rowNum && p->dimSize[1] == g->colNum,
+                  "Unmatched gradient!");
+
+    g->Coalesce();
+
+    int num = g->count;
+    if (num == 0)
+        return;
+
+    XTensor index;
+    XTensor gRows;
+    XTensor pRows;
+    XTensor mRows;
+    XTensor vRows;
+    g->GetIndex(&index);
+    g->GetRows(&gRows);
+    InitTensor2DV2(&pRows, num, g->colNum, X_FLOAT, p->devID);
+    InitTensor2DV2(&mRows, num, g->colNum, X_FLOAT, p->devID);
+    InitTensor2DV2(&vRows, num, g->colNum, X_FLOAT, p->devID);
+
+    _Gather(p, &pRows, &index);
+    _Gather(m, &mRows, &index);
+    _Gather(v, &vRows, &index);
+
+    _Adam(&pRows, &gRows, &mRows, &vRows, beta1, beta2, alpha, delta, decay);
+
+    int * rowIndex = new int[num];
+    for (int i = 0; i < num; i++)
+        rowIndex[i] = i;
+
+    _CopyIndexed(&pRows, p, 0, rowIndex, num, g->index);
+    _CopyIndexed(&mRows, m, 0, rowIndex, num, g->index);
+    _CopyIndexed(&vRows, v, 0, rowIndex, num, g->index);
+
+    delete[] rowIndex;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,94 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "../../XDevice.h"
+#include "../../XTensor.h"
+#include "Adam.h"
+#include "Adam.cuh"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+#ifdef USE_CUDA
+
+/*
+a step of the Adam (or AdamW) update (CUDA Kernel)
+>> p - the parameters
+>> g - the gradients
+>> m - the first moments
+>> v - the second moments
+>> size - number of the items
+>> beta1 - decay rate of the first moments
+>> beta2 - decay rate of the second moments
+>> alpha - step size (with the bias correction)
+>> delta - a small number for numerical stability
+>> keep - 1 - the weight decay
+*/
+__global__
+void KernelAdam(DTYPE * p, DTYPE * g, DTYPE * m, DTYPE * v, int size,
+                DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE keep)
+{
+    int i = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (i < size) {
+        DTYPE gi = g[i];
+        DTYPE mi = beta1 * m[i] + (1.0F - beta1) * gi;
+        DTYPE vi = beta2 * v[i] + (1.0F - beta2) * gi * gi;
+        m[i] = mi;
+        v[i] = vi;
+        p[i] = keep * p[i] - alpha * mi / (sqrt(vi) + delta);
+    }
+}
+
+/*
+a step of the Adam (or AdamW) update in a single sweep
+>> p - the parameters
+>> g - the gradients
+>> m - the first moments
+>> v - the second moments
+>> beta1 - decay rate of the first moments
+>> beta2 - decay rate of the second moments
+>> alpha - step size (with the bias correction)
+>> delta - a small number for numerical stability
+>> decay - the weight decay (scaled by the learning rate)
+*/
+void _CudaAdam(XTensor * p, const XTensor * g, XTensor * m, XTensor * v,
+               DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE decay)
+{
+    int gridSize[3];
+    int blockSize[3];
+
+    GDevs.GetCudaThread(p->devID, p->unitNum, gridSize, blockSize);
+
+    dim3 blocks(gridSize[0]);
+    dim3 threads(blockSize[0]);
+
+    int devIDBackup;
+    ProtectCudaDev(p->devID, devIDBackup);
+
+    KernelAdam<<<blocks, threads>>>((DTYPE*)p->data, (DTYPE*)g->data, (DTYPE*)m->data, (DTYPE*)v->data,
+                                    p->unitNum, beta1, beta2, alpha, delta, 1.0F - decay);
+
+    BacktoCudaDev(p->devID, devIDBackup);
+}
+
+#endif // USE_CUDA
+
+} // namespace nts(NiuTrans.Tensor)
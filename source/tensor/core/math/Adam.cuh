@@ -0,0 +1,44 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __ADAM_CUH__
+#define __ADAM_CUH__
+
+#include "Adam.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+#ifdef USE_CUDA
+
+/* a step of the Adam (or AdamW) update (CUDA Kernel) */
+__global__
+void KernelAdam(DTYPE * p, DTYPE * g, DTYPE * m, DTYPE * v, int size,
+                DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE keep);
+
+/* a step of the Adam (or AdamW) update in a single sweep */
+void _CudaAdam(XTensor * p, const XTensor * g, XTensor * m, XTensor * v,
+               DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE decay);
+
+#endif // USE_CUDA
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __ADAM_CUH__
@@ -0,0 +1,50 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __ADAM_H__
+#define __ADAM_H__
+
+#include "../../XTensor.h"
+#include "../../XRowSparse.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+a step of the Adam (or AdamW) update in a single sweep (do it on site)
+m = beta1 * m + (1 - beta1) * g
+v = beta2 * v + (1 - beta2) * g * g
+p = (1 - decay) * p - alpha * m / (sqrt(v) + delta)
+*/
+void _Adam(XTensor * p, const XTensor * g, XTensor * m, XTensor * v,
+           DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE decay = 0);
+
+/*
+a step of the Adam update with a row-sparse gradient (do it on site). Only the
+rows in the gradient are updated ("lazy" Adam), i.e., the moments of the other
+rows are not decayed in this step. It is what we have if the gradients of all
+rows are non-zero
+*/
+void _AdamSparse(XTensor * p, XRowSparse * g, XTensor * m, XTensor * v,
+                 DTYPE beta1, DTYPE beta2, DTYPE alpha, DTYPE delta, DTYPE decay = 0);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __ADAM_H__
@@ -79,25 +79,33 @@ void _funcName(const XTensor * a, XTensor * b, T num)
         _cudaFuncName(a, b, num);                                                    \
         return;                                                                      \
     }                                                                                \
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous(),                            \
+                  "Strided views are not supported. Call Contiguous() first!");      \
     CheckNTErrors((_IsSameShaped(a, b)),                                             \
                   "Input tensors should have the same data type!");                  \
     if (a->dataType == X_INT) {                                                      \
         int * d = (int*)a->data;                                                     \
         int * db = (int*)b->data;                                                    \
-        for (int i = 0; i < a->unitNum; i++)                                         \
-            db[i] = (int)origFunc((int)d[i], (T)num);                                \
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {       \
+            for (int i = beg; i < end; i++)                                          \
+                db[i] = (int)origFunc((int)d[i], (T)num);                            \
+        });                                                                          \
     }                                                                                \
     else if (a->dataType == X_FLOAT) {                                               \
         float * d = (float*)a->data;                                                 \
         float * db = (float*)b->data;                                                \
-        for (int i = 0; i < a->unitNum; i++)                                         \
-            db[i] = (float)origFunc((float)d[i], (T)num);                            \
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {       \
+            for (int i = beg; i < end; i++)                                          \
+                db[i] = (float)origFunc((float)d[i], (T)num);                        \
+        });                                                                          \
     }                                                                                \
     else if (a->dataType == X_DOUBLE) {                                              \
         double * d = (double*)a->data;                                               \
         double * db = (double*)b->data;                                              \
-        for (int i = 0; i < a->unitNum; i++)                                         \
-            db[i] = (double)origFunc((double)d[i], (T)num);                          \
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {       \
+            for (int i = beg; i < end; i++)                                          \
+                db[i] = (double)origFunc((double)d[i], (T)num);                      \
+        });                                                                          \
     }                                                                                \
     else                                                                             \
         ShowNTErrors("TO DO!");                                                      \
@@ -114,25 +122,33 @@ void _funcName(const XTensor * a, XTensor * b, T num)
     if (a->devID >= 0) {                                                             \
         ShowNTErrors("No GPU devices support!")                                      \
     }                                                                                \
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous(),                            \
+                  "Strided views are not supported. Call Contiguous() first!");      \
     CheckNTErrors((_IsSameShaped(a, b)),                                             \
                   "Input tensors should have the same data type!");                  \
     if (a->dataType == X_INT) {                                                      \
         int * d = (int*)a->data;                                                     \
         int * db = (int*)b->data;                                                    \
-        for (int i = 0; i < a->unitNum; i++)                                         \
-            db[i] = (int)origFunc((int)d[i], (T)num);                                \
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {       \
+            for (int i = beg; i < end; i++)                                          \
+                db[i] = (int)origFunc((int)d[i], (T)num);                            \
+        });                                                                          \
     }                                                                                \
     else if (a->dataType == X_FLOAT) {                                               \
         float * d = (float*)a->data;                                                 \
         float * db = (float*)b->data;                                                \
-        for (int i = 0; i < a->unitNum; i++)                                         \
-            db[i] = (float)origFunc((float)d[i], (T)num);                            \
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {       \
+            for (int i = beg; i < end; i++)                                          \
+                db[i] = (float)origFunc((float)d[i], (T)num);                        \
+        });                                                                          \
     }                                                                                \
     else if (a->dataType == X_DOUBLE) {                                              \
         double * d = (double*)a->data;                                               \
         double * db = (double*)b->data;                                              \
-        for (int i = 0; i < a->unitNum; i++)                                         \
-            db[i] = (double)origFunc((double)d[i], (T)num);                          \
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {       \
+            for (int i = beg; i < end; i++)                                          \
+                db[i] = (double)origFunc((double)d[i], (T)num);                      \
+        });                                                                          \
     }                                                                                \
     else                                                                             \
         ShowNTErrors("TO DO!");                                                      \
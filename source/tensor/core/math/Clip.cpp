@@ -36,6 +36,9 @@ set every entry to its clip value
 */
 void _Clip(const XTensor * a, XTensor * b, DTYPE lower, DTYPE upper)
 {
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
+
 #ifdef USE_CUDA
     /* run it on GPUs */
     if (a->devID >= 0) {
@@ -49,26 +52,30 @@ void _Clip(const XTensor * a, XTensor * b, DTYPE lower, DTYPE upper)
     if (a->dataType == DEFAULT_DTYPE) {
         DTYPE* d = (DTYPE*)a->data;
         DTYPE* db = (DTYPE*)b->data;
-        for (int i = 0; i < a->unitNum; i++) {
-            if (d[i] > upper)
-                db[i] = upper;
-            else if (d[i] < lower)
-                db[i] = lower;
-            else
-                db[i] = d[i];
-        }
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+            for (int i = beg; i < end; i++) {
+                if (d[i] > upper)
+                    db[i] = upper;
+                else if (d[i] < lower)
+                    db[i] = lower;
+                else
+                    db[i] = d[i];
+            }
+        });
     }
     else if (a->dataType == X_INT) {
         int* d = (int*)a->data;
         int* db = (int*)b->data;
-        for (int i = 0; i < a->unitNum; i++) {
-            if (d[i] > upper)
-                db[i] = upper;
-            else if (d[i] < lower)
-                db[i] = lower;
-            else
-                db[i] = d[i];
-        }
+        ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+            for (int i = beg; i < end; i++) {
+                if (d[i] > upper)
+                    db[i] = upper;
+                else if (d[i] < lower)
+                    db[i] = lower;
+                else
+                    db[i] = d[i];
+            }
+        });
     }
     else
         ShowNTErrors("TODO!");
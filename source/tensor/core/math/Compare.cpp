@@ -53,8 +53,10 @@ void _funcName(const XTensor * a, XTensor * b, DTYPE number)
     }                                                                                \
     DTYPE * d = (DTYPE*)a->data;                                                     \
     DTYPE * db = (DTYPE*)b->data;                                                    \
-    for (int i = 0; i < a->unitNum; i++)                                             \
-        db[i] = (DTYPE)origFunc(d[i], number);                                       \
+    ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {           \
+        for (int i = beg; i < end; i++)                                              \
+            db[i] = (DTYPE)origFunc(d[i], number);                                   \
+    });                                                                              \
 }     
 #else
 #define _SIMPLE_COMPARE_FUNCTION(_funcName, origFunc)                                \
@@ -69,8 +71,10 @@ void _funcName(const XTensor * a, XTensor * b, DTYPE number)
     }                                                                                \
     DTYPE * d = (DTYPE*)a->data;                                                     \
     DTYPE * db = (DTYPE*)b->data;                                                    \
-    for (int i = 0; i < a->unitNum; i++)                                             \
-        db[i] = (DTYPE)origFunc(d[i], number);                                       \
+    ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {           \
+        for (int i = beg; i < end; i++)                                              \
+            db[i] = (DTYPE)origFunc(d[i], number);                                   \
+    });                                                                              \
 }     
 #endif
                                                                                      
@@ -144,8 +148,10 @@ void _funcName(const XTensor * a, const XTensor * b,  XTensor * c)
     DTYPE * da = (DTYPE*)a->data;                                                    \
     DTYPE * db = (DTYPE*)b->data;                                                    \
     DTYPE * dc = (DTYPE*)c->data;                                                    \
-    for (int i = 0; i < a->unitNum; i++)                                             \
-        dc[i] = (DTYPE)origFunc(da[i], db[i]);                                       \
+    ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {           \
+        for (int i = beg; i < end; i++)                                              \
+            dc[i] = (DTYPE)origFunc(da[i], db[i]);                                   \
+    });                                                                              \
 }     
 #else
 #define _SIMPLE_MAX_MIN_FUNCTION(_funcName, origFunc)                                \
@@ -163,8 +169,10 @@ void _funcName(const XTensor * a, const XTensor * b, XTensor *c)
     DTYPE * da = (DTYPE*)a->data;                                                    \
     DTYPE * db = (DTYPE*)b->data;                                                    \
     DTYPE * dc = (DTYPE*)c->data;                                                    \
-    for (int i = 0; i < a->unitNum; i++)                                             \
-        dc[i] = (DTYPE)origFunc(da[i], db[i]);                                       \
+    ParallelFor(0, a->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {           \
+        for (int i = beg; i < end; i++)                                              \
+            dc[i] = (DTYPE)origFunc(da[i], db[i]);                                   \
+    });                                                                              \
 }     
 #endif
                                                                                      
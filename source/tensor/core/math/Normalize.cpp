@@ -53,6 +53,8 @@ void _Normalize(const XTensor * input, XTensor * output, int dim,
     CheckNTErrors((input && output && mean && var && a && b), "Empty input tensors!");
     CheckNTErrors((dim >= 0 && dim < input->order), "Incorrect reduction dimension!");
     CheckNTErrors((input->order == mean->order + 1), "Incorrect reduction dimension!");
+    CheckNTErrors(input->IsContiguous() && output->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     int stride = 1;
     int strideNum = input->dimSize[dim];
@@ -21,6 +21,7 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "../shape/IsSameShaped.h"
 #include "../math/Binary.h"
@@ -41,6 +42,8 @@ b = a * scale + shift
 */
 void _ScaleAndShift(const XTensor * a, XTensor * b, DTYPE scale, DTYPE shift)
 {
+    XProfileOp profile(MATH_SCALEANDSHIFT, a, NULL, b);
+
 #ifdef USE_CUDA
     /* run it on GPUs */
     if(a->devID >= 0){
@@ -64,15 +67,37 @@ void _ScaleAndShift(const XTensor * a, XTensor * b, DTYPE scale, DTYPE shift)
                 fb += sizeof(int) + sizeof(DTYPE);
             }
         }
+        /* views (see View.h). We go over the rows (i.e., the last dimension)
+           and find where a row starts with the strides. */
+        else if (!a->IsContiguous() || !b->IsContiguous()) {
+            CheckNTErrors(_IsSameShaped(a, b), "Unmatched tensors!");
+
+            if (b->unitNum == 0)
+                return;
+
+            int rowSize = b->order > 0 ? b->dimSize[b->order - 1] : 1;
+            int rowNum = b->unitNum / rowSize;
+            int aStep = a->order > 0 ? a->GetStride(a->order - 1) : 1;
+            int bStep = b->order > 0 ? b->GetStride(b->order - 1) : 1;
+            DTYPE * va = (DTYPE*)a->data;
+            DTYPE * vb = (DTYPE*)b->data;
+            ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(rowSize, 1)), [&](int beg, int end) {
+                for (int i = beg; i < end; i++) {
+                    DTYPE * ar = va + a->GetStridedOffset(i * rowSize);
+                    DTYPE * br = vb + b->GetStridedOffset(i * rowSize);
+                    for (int j = 0; j < rowSize; j++)
+                        br[j * bStep] = (DTYPE)(ar[j * aStep] * scale + shift);
+                }
+            });
+        }
         /* dense tensor */
         else {
             DTYPE * va = (DTYPE*)a->data;
             DTYPE * vb = (DTYPE*)b->data;
-            for(int i = 0; i < b->unitNum; i++){
-                *vb = *va * scale + shift;
-                va++;
-                vb++;
-            }
+            ParallelFor(0, b->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                for(int i = beg; i < end; i++)
+                    vb[i] = (DTYPE)(va[i] * scale + shift);
+            });
         }
     }
     else if (a->dataType == X_INT) {
@@ -95,11 +120,10 @@ void _ScaleAndShift(const XTensor * a, XTensor * b, DTYPE scale, DTYPE shift)
         else {
             int * va = (int*)a->data;
             int * vb = (int*)b->data;
-            for(int i = 0; i < b->unitNum; i++){
-                *vb = *va * scale + shift;
-                va++;
-                vb++;
-            }
+            ParallelFor(0, b->unitNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                for(int i = beg; i < end; i++)
+                    vb[i] = (int)(va[i] * scale + shift);
+            });
         }
     }
     else
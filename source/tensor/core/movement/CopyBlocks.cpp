@@ -94,10 +94,13 @@ void _CopyBlocks(void * source, int unitSize, int blockSize, int * sourceBlocks,
         kernel calls would slow down the system. We prefer to use
         one kernel to do block copy in batch (kernel fusion). 
         */
-        for (int i = 0; i < blockNum; i++) {
-            XMemCopy((char*)target + targetBlocks[i] * blockSize, devID,
-                     (char*)source + sourceBlocks[i] * blockSize, devID, blockSize);
-        }
+        int grain = MAX(1, PFOR_ELEMENT_GRAIN * (int)sizeof(DTYPE) / blockSize);
+        ParallelFor(0, blockNum, grain, [&](int beg, int end) {
+            for (int i = beg; i < end; i++) {
+                XMemCopy((char*)target + targetBlocks[i] * blockSize, devID,
+                         (char*)source + sourceBlocks[i] * blockSize, devID, blockSize);
+            }
+        });
     }
 }
 
@@ -52,16 +52,21 @@ void _CopyBlocksOnSite(void * source, int unitSize, int blockSize, int blockNum,
         one kernel to do block copy in batch (kernel fusion). 
         */
         if(blockSize == sizeof(int)){
-            for (int i = 0, b = 0; i < blockNum; i++, b += blockSize) {
-                *(int*)((char*)target + targetBlocks[i] * blockSize) = 
-                *(int*)((char*)source + b);
-            }
+            ParallelFor(0, blockNum, PFOR_ELEMENT_GRAIN, [&](int beg, int end) {
+                for (int i = beg; i < end; i++) {
+                    *(int*)((char*)target + targetBlocks[i] * blockSize) = 
+                    *(int*)((char*)source + i * blockSize);
+                }
+            });
         }
         else{
-            for (int i = 0, b = 0; i < blockNum; i++, b += blockSize) {
-                XMemCopy((char*)target + targetBlocks[i] * blockSize, devID,
-                         (char*)source + b, devID, blockSize);
-            }
+            int grain = MAX(1, PFOR_ELEMENT_GRAIN * (int)sizeof(DTYPE) / blockSize);
+            ParallelFor(0, blockNum, grain, [&](int beg, int end) {
+                for (int i = beg; i < end; i++) {
+                    XMemCopy((char*)target + targetBlocks[i] * blockSize, devID,
+                             (char*)source + i * blockSize, devID, blockSize);
+                }
+            });
         }
     }
 }
@@ -20,10 +20,12 @@
 */
 
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XUtility.h"
 #include "CopyValues.h"
 #include "CopyValues.cuh"
 #include "../getandset/ConvertDataType.h"
+#include "../shape/View.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
 
@@ -36,6 +38,8 @@ copy s to t
 */
 void _CopyValues(const XTensor * s, XTensor * t, XStream * stream)
 {
+    XProfileOp profile(MOVEMENT_COPYVALUES, s, NULL, t);
+
     if(s->data == NULL && t->data == NULL)
         return;
 
@@ -45,6 +49,12 @@ void _CopyValues(const XTensor * s, XTensor * t, XStream * stream)
     CheckNTErrors(s->unitSize == t->unitSize, "Incompatible data types in value copy.");
     CheckNTErrors(s->unitNum == t->unitNum, "The data items are be the same.");
 
+    /* views (see View.h) */
+    if (!s->IsContiguous() || !t->IsContiguous()) {
+        _Contiguous(s, t);
+        return;
+    }
+
     if ((s->dataType == X_FLOAT16 && t->dataType == X_FLOAT) ||
         (s->dataType == X_FLOAT && t->dataType == X_FLOAT16)) {
         CheckNTErrors((s->devID < 0 && t->devID < 0) || s->devID == t->devID,
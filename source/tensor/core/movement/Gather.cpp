@@ -24,6 +24,7 @@
 #include "CopyIndexed.h"
 #include "../../XUtility.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../shape/Reshape.h"
 
 namespace nts{ // namespace nts(NiuTrans.Tensor)
@@ -40,11 +41,15 @@ we have 4 sub-tensors of size (3, 2)
 */
 void _Gather(const XTensor * s, XTensor * t, XTensor * srcIndex, int dim)
 {
+    XProfileOp profile(MOVEMENT_GATHER, s, srcIndex, t);
+
     CheckNTErrors((s && t), "Invalid tensors!");
     CheckNTErrors(s->devID == t->devID, "the data must be kept on the same device!");
     CheckNTErrors((t->unitSize == srcIndex->unitSize), "Unmatched tensors!");
     CheckNTErrors((srcIndex->dataType == X_INT), "The index tensor should be INT type!");
     CheckNTErrors((srcIndex->order == s->order), "index's order should be the same with source's");
+    CheckNTErrors(s->IsContiguous() && t->IsContiguous() && srcIndex->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 #ifdef USE_CUDA
     if (s->devID >= 0 && t->devID >= 0) {
         _CudaGather(s, t, srcIndex, dim);
@@ -68,18 +73,20 @@ void _Gather(const XTensor * s, XTensor * t, XTensor * srcIndex, int dim)
     DTYPE * sData = (DTYPE*)s->data;
     DTYPE * tData = (DTYPE*)t->data;
     int * sIndexData = (int*)srcIndex->data;
-    for (int blockIndex = 0; blockIndex < blockNum; ++blockIndex)
-    {
-        for (int i = 0; i < indexStrideNum; i++) {
-            for (int j = 0; j < stride; j++)
-            {
-                int sIndex = sIndexData[i * stride + blockIndex * indexStrideNum + j] * stride + blockIndex * srcStrideNum + j;
-                CheckNTErrors(sIndex < s->unitNum, "Wrong index!");
-                int tIndex = i * stride + blockIndex * tgtBlockSize + j;
-                tData[tIndex] = sData[sIndex];
+    ParallelFor(0, blockNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(tgtBlockSize, 1)), [&](int beg, int end) {
+        for (int blockIndex = beg; blockIndex < end; ++blockIndex)
+        {
+            for (int i = 0; i < indexStrideNum; i++) {
+                for (int j = 0; j < stride; j++)
+                {
+                    int sIndex = sIndexData[i * stride + blockIndex * indexStrideNum + j] * stride + blockIndex * srcStrideNum + j;
+                    CheckNTErrors(sIndex < s->unitNum, "Wrong index!");
+                    int tIndex = i * stride + blockIndex * tgtBlockSize + j;
+                    tData[tIndex] = sData[sIndex];
+                }
             }
         }
-    }
+    });
 }
 
 /*
@@ -91,9 +98,13 @@ gather indexed sub-tensors
 */
 void _Gather(const XTensor * s, XTensor * t, XTensor * srcIndex)
 {
+    XProfileOp profile(MOVEMENT_GATHER, s, srcIndex, t);
+
     CheckNTErrors((s && t), "Invalid tensors!");
     CheckNTErrors(s->devID == t->devID, "the data must be kept on the same device!");
     CheckNTErrors((s->unitSize == t->unitSize), "Unmatched tensors!");
+    CheckNTErrors(s->IsContiguous() && t->IsContiguous() && srcIndex->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     if (s->devID >= 0) {
 #ifdef USE_CUDA
@@ -109,16 +120,20 @@ void _Gather(const XTensor * s, XTensor * t, XTensor * srcIndex)
         stride = s->GetDim(-1);
         indexSize = srcIndex->unitNum;
 
-        DTYPE * sData = (DTYPE*)s->data;
-        DTYPE * tData = (DTYPE*)t->data;
+        /* we copy the rows as bytes, so it works for any data type (e.g.,
+           float16 weights) */
+        char * sData = (char*)s->data;
+        char * tData = (char*)t->data;
         int * sIndexData = (int*)srcIndex->data;
+        int rowSize = stride * s->unitSize;
 
-        for (int i = 0; i < indexSize; i++) {
-            int sIndex = sIndexData[i] * stride;
-            CheckNTErrors(sIndex < s->unitNum, "Wrong index!");
-            for (int j = 0; j < stride; j++)
-                tData[i * stride + j] = sData[sIndex + j];
-        }
+        ParallelFor(0, indexSize, MAX(1, PFOR_ELEMENT_GRAIN / MAX(stride, 1)), [&](int beg, int end) {
+            for (int i = beg; i < end; i++) {
+                int sIndex = sIndexData[i] * stride;
+                CheckNTErrors(sIndex < s->unitNum, "Wrong index!");
+                memcpy(tData + (long long)i * rowSize, sData + (long long)sIndex * s->unitSize, rowSize);
+            }
+        });
     }
 }
 
@@ -265,11 +265,15 @@ void _SpreadForGather(XTensor * source, XTensor * collection, XTensor * index)
     DTYPE * cData = (DTYPE*)collection->data;
     int * sIndexData = (int*)index->data;
 
-    for (int i = 0; i < indexSize; i++) {
-        int sIndex = sIndexData[i] * stride;
-        for (int j = 0; j < stride; j++)
-            sData[sIndex + j] += cData[i * stride + j];
-    }
+    /* the same row may appear several times in the index, so we split
+       the columns (rather than the rows) among the threads */
+    ParallelFor(0, stride, MAX(1, PFOR_ELEMENT_GRAIN / MAX(indexSize, 1)), [&](int beg, int end) {
+        for (int i = 0; i < indexSize; i++) {
+            int sIndex = sIndexData[i] * stride;
+            for (int j = beg; j < end; j++)
+                sData[sIndex + j] += cData[i * stride + j];
+        }
+    });
 }
 
 } // namespace nts(NiuTrans.Tensor)
\ No newline at end of file
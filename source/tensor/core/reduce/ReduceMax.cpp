@@ -35,7 +35,7 @@ get the max value of the items along a dimension of the tensor
 >> output - the output tensor
 >> dim - the dimension where the reduction is performed on
 */
-#define _REDUCE_CPU_FUNCTION(_funcCPUName, _vectorOp, _reduceOp)                                                    \
+#define _REDUCE_CPU_FUNCTION(_funcCPUName, _isMax)                                                                   \
 void _funcCPUName(const XTensor * input, XTensor * output, int dim)                                                 \
 {                                                                                                                   \
     CheckNTErrors((input->devID == output->devID || (input->devID < 0 && output->devID < 0)),                       \
@@ -44,6 +44,8 @@ void _funcCPUName(const XTensor * input, XTensor * output, int dim)
     CheckNTErrors((input->order == output->order + 1), "Incorrect tensor sizes!");                                  \
     CheckNTErrors((input->order > dim && dim >= 0), "Illegal dimension to reduce!");                                \
     CheckNTErrors((input->dataType == output->dataType), "Unmatched data types!");                                  \
+    CheckNTErrors(input->IsContiguous() && output->IsContiguous(),                                                  \
+                  "Strided views are not supported. Call Contiguous() first!");                                     \
                                                                                                                     \
     CheckNTErrors(dim < input->order, "Wrong dimension!");                                                          \
                                                                                                                     \
@@ -72,96 +74,34 @@ void _funcCPUName(const XTensor * input, XTensor * output, int dim)
     }                                                                                                               \
     blockSize = stride * strideNum;                                                                                 \
                                                                                                                     \
+    /* the kernel is chosen once according to the CPU */                                                            \
+    VectorMaxKernel kernel = GetVectorMaxKernel();                                                                  \
                                                                                                                     \
-    if(input->dimSize[input->order - 1] % (4 * 32 / sizeof(DTYPE)) == 0 && input->dimSize[input->order - 1] >= 32){ \
-        int vecBufLength =  32 / sizeof(DTYPE);                                                                     \
-                                                                                                                    \
-        if (dim == input->order - 1) {                                                                              \
-            /*data is contiguous in dim 0 */                                                                        \
-            for (int i = 0; i < blockNum; i++) {                                                                    \
-                DTYPE * ip = (DTYPE*)input->data + blockSize * i;                                                   \
-                DTYPE * op = (DTYPE*)output->data + i;                                                              \
-                VectorBuffer vecBuf[4];                                                                             \
-                for (int j = 0; j < 4; j++) {                                                                       \
-                    vecBuf[j] = VectorBuffer::loadu((DTYPE*)(ip)+j * vecBufLength);                                 \
-                }                                                                                                   \
-                for (int j = 1; j < strideNum / 32; j++) {                                                          \
-                    const DTYPE* ptr = (DTYPE*)(ip + j * 4 * vecBufLength);                                         \
-                    vecBuf[0] = vecBuf[0]._vectorOp(VectorBuffer::loadu(ptr + 0 * vecBufLength));                   \
-                    vecBuf[1] = vecBuf[1]._vectorOp(VectorBuffer::loadu(ptr + 1 * vecBufLength));                   \
-                    vecBuf[2] = vecBuf[2]._vectorOp(VectorBuffer::loadu(ptr + 2 * vecBufLength));                   \
-                    vecBuf[3] = vecBuf[3]._vectorOp(VectorBuffer::loadu(ptr + 3 * vecBufLength));                   \
-                }                                                                                                   \
-                vecBuf[0] = vecBuf[0]._vectorOp(vecBuf[1]);                                                         \
-                vecBuf[0] = vecBuf[0]._vectorOp(vecBuf[2]);                                                         \
-                vecBuf[0] = vecBuf[0]._vectorOp(vecBuf[3]);                                                         \
-                DTYPE maxN = vecBuf[0][0];                                                                          \
-                for (int k = 1; k < vecBufLength; k++) {                                                            \
-                    maxN = _reduceOp(maxN, vecBuf[0][k]);                                                           \
-                }                                                                                                   \
-                *op = maxN;                                                                                         \
-            }                                                                                                       \
-                                                                                                                    \
-        }                                                                                                           \
-        else {                                                                                                      \
-            /* data is separated */                                                                                 \
-            for(int i = 0; i < blockNum; i++){                                                                      \
-                for(int j = 0; j < stride / 32; j++){                                                               \
-                    DTYPE * ip = (DTYPE*)input->data + blockSize * i;                                               \
-                    DTYPE * op = (DTYPE*)output->data + stride * i;                                                 \
-                    VectorBuffer vecBuf[4];                                                                         \
-                    for(int k = 0; k < 4; k++){                                                                     \
-                        vecBuf[k] = VectorBuffer::loadu((DTYPE*)(ip) + (j * 4 + k) * 32 / sizeof(DTYPE));           \
-                                                                                                                    \
-                    }                                                                                               \
-                    for(int k = 1; k < strideNum; k++){                                                             \
-                        DTYPE * ptr = ip + k * stride + (j * 4) * vecBufLength;                                     \
-                        vecBuf[0] = vecBuf[0]._vectorOp(VectorBuffer::loadu(ptr + 0 * vecBufLength));               \
-                        vecBuf[1] = vecBuf[1]._vectorOp(VectorBuffer::loadu(ptr + 1 * vecBufLength));               \
-                        vecBuf[2] = vecBuf[2]._vectorOp(VectorBuffer::loadu(ptr + 2 * vecBufLength));               \
-                        vecBuf[3] = vecBuf[3]._vectorOp(VectorBuffer::loadu(ptr + 3 * vecBufLength));               \
-                    }                                                                                               \
-                    for(int k = 0; k < 4; k++){                                                                     \
-                        for(int l = 0; l < vecBufLength; l++)                                                       \
-                            *(op + j * 32 + 8 * k + l) = vecBuf[k][l];                                              \
-                    }                                                                                               \
-                }                                                                                                   \
-            }                                                                                                       \
-        }                                                                                                           \
-    }/* run vector buffer */                                                                                        \
-    else{                                                                                                           \
-        for(int k = 0; k < blockNum; k++){                                                                          \
+    ParallelFor(0, blockNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(blockSize, 1)), [&](int beg, int end) {                \
+        for (int k = beg; k < end; k++) {                                                                           \
             DTYPE * ip = (DTYPE*)input->data + blockSize * k;                                                       \
             DTYPE * op = (DTYPE*)output->data + stride * k;                                                         \
-            for(int i = 0; i < stride; i++){                                                                        \
-                DTYPE * ipe = ip + blockSize;                                                                       \
-                DTYPE tmpData = *(ip + i);                                                                          \
-                for(DTYPE * ipb = ip + i + stride; ipb < ipe; ipb += stride){                                       \
-                    DTYPE v = *ipb;                                                                                 \
-                    tmpData = _reduceOp(tmpData, v);                                                                \
-                }                                                                                                   \
-                *(op + i) = tmpData;                                                                                \
-            }                                                                                                       \
+            kernel(ip, op, strideNum, stride, _isMax);                                                              \
         }                                                                                                           \
-    }                                                                                                               \
+    });                                                                                                             \
 }
 
-_REDUCE_CPU_FUNCTION(reduceMaxCPU, maxData, MAX)
-_REDUCE_CPU_FUNCTION(reduceMinCPU, minData, MIN)
+_REDUCE_CPU_FUNCTION(reduceMaxCPU, true)
+_REDUCE_CPU_FUNCTION(reduceMinCPU, false)
 
 #ifdef USE_CUDA            
-#define _REDUCE_FUNCTION(_funcName, _cudaFuncName)                                                                   \
+#define _REDUCE_FUNCTION(_funcName, _cudaFuncName, reduceNameCPU)                                                    \
 void _funcName(const XTensor * input, XTensor * output, int dim)                                                     \
 {                                                                                                                    \
     if(input->devID >= 0){                                                                                           \
         _cudaFuncName(input, output, dim);                                                                           \
     }                                                                                                                \
     else{                                                                                                            \
-        reduceMaxCPU(input, output, dim);                                                                            \
+        reduceNameCPU(input, output, dim);                                                                           \
     }                                                                                                                \
 }
-_REDUCE_FUNCTION(_ReduceMax, _CudaReduceMax)
-_REDUCE_FUNCTION(_ReduceMin, _CudaReduceMin)
+_REDUCE_FUNCTION(_ReduceMax, _CudaReduceMax, reduceMaxCPU)
+_REDUCE_FUNCTION(_ReduceMin, _CudaReduceMin, reduceMinCPU)
 #else
 #define _REDUCE_FUNCTION(_funcName, reduceNameCPU)                                                                   \
 void _funcName(const XTensor * input, XTensor * output, int dim)                                                     \
@@ -21,6 +21,7 @@
 
 #include "../math/ScaleAndShift.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "ReduceSum.h"
 #include "ReduceMean.h"
 
@@ -37,6 +38,8 @@ For a 1-dimensional data array a, mean = (1/n) * sum_i input_i
 */
 void _ReduceMean(const XTensor * input, XTensor * output, int dim)
 {
+    XProfileOp profile(REDUCE_REDUCEMEAN, input, NULL, output);
+
     CheckNTErrors((input->order > dim), "Illegal dimension specified!");
 
     int num = input->dimSize[dim];
@@ -24,9 +24,9 @@
 #include "ReduceSum.cuh"
 #include "../shape/IsSameShaped.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XBLAS.h"
 #include "VectorBuffer.h"
-#include <iostream>
 
 namespace nts{ // namespace nts(NiuTrans.Tensor)
 
@@ -46,6 +46,8 @@ sum = \sum_i exp((a_i - shift)^power) if isExp == true
 */
 void _ReduceSum(const XTensor * input, XTensor * output, int dim, const XTensor * shift, DTYPE power, bool isExp)
 {
+    XProfileOp profile(REDUCE_REDUCESUM, input, shift, output);
+
     CheckNTErrors((input->devID == output->devID || (input->devID < 0 && output->devID < 0)), 
                   "This code must be run on the same device!");
     CheckNTErrors((input && output), "Empty input or output tensors!");
@@ -53,6 +55,8 @@ void _ReduceSum(const XTensor * input, XTensor * output, int dim, const XTensor
     CheckNTErrors((input->order > dim && dim >=0), "Illegal dimension to reduce!");
     CheckNTErrors((input->dataType == output->dataType), "Unmatched data types!");
     CheckNTErrors((shift == NULL || _IsSameShaped(output, shift)), "Incorrect shift tensor size!");
+    CheckNTErrors(input->IsContiguous() && output->IsContiguous() && (shift == NULL || shift->IsContiguous()),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     CheckNTErrors(dim < input->order, "Wrong dimension!");
 
@@ -85,187 +89,17 @@ void _ReduceSum(const XTensor * input, XTensor * output, int dim, const XTensor
         }
         blockSize = stride * strideNum;
 
-        if(input->dimSize[input->order - 1] % (4 * 32 / sizeof(DTYPE)) == 0 && input->dimSize[input->order - 1] >= 32){
-            int vecBufLength =  32 / sizeof(DTYPE);
-
-            if(dim == input->order - 1){
-                //data is contiguous in dim 0
-                for(int i = 0; i < blockNum; i++){
-                    // stride = 1
-                    DTYPE * ip = (DTYPE*)input->data + blockSize * i;
-                    DTYPE * op = (DTYPE*)output->data + i;
-                    DTYPE * sp = shift != NULL ? (DTYPE*)shift->data + i : NULL;
-                    DTYPE bias[32 / sizeof(DTYPE)] = {0};
-                    if(shift != NULL){
-                        for(int k = 0; k < 32 / sizeof(DTYPE); k++)
-                            bias[k] = *(sp);
-                    }
-                    VectorBuffer vecBuf[4];
-                    for(int j = 0; j < 4; j++){
-                        vecBuf[j] = VectorBuffer::loadu((DTYPE*)(ip) + j * vecBufLength, isExp, power, bias);
-                    }
-                    for(int j = 1; j < strideNum / 32; j++){
-                        const DTYPE* ptr = (DTYPE*)(ip + (j * 4) * vecBufLength);
-                        vecBuf[0] = vecBuf[0] + VectorBuffer::loadu(ptr + 0 * vecBufLength, isExp, power, bias);
-                        vecBuf[1] = vecBuf[1] + VectorBuffer::loadu(ptr + 1 * vecBufLength, isExp, power, bias);
-                        vecBuf[2] = vecBuf[2] + VectorBuffer::loadu(ptr + 2 * vecBufLength, isExp, power, bias);
-                        vecBuf[3] = vecBuf[3] + VectorBuffer::loadu(ptr + 3 * vecBufLength, isExp, power, bias);
-                    }
-                    vecBuf[0] = ((vecBuf[0] + vecBuf[1]) + (vecBuf[2] + vecBuf[3]));
-                    DTYPE sum = (DTYPE) 0.0;
-                    for(int k = 0; k < vecBufLength; k++){
-                        sum = sum + vecBuf[0][k];
-                    }
-                    *op = sum;
-                }
-
-            } else{
-                //data is separated
-                for(int i = 0; i < blockNum; i++){
-                    for(int j = 0; j < stride / 32; j++){
-                        DTYPE * ip = (DTYPE*)input->data + blockSize * i;
-                        DTYPE * op = (DTYPE*)output->data + stride * i;
-                        DTYPE * sp = shift != NULL ? (DTYPE*)shift->data + stride * i : NULL;
-                        DTYPE bias[4 * 32 / sizeof(DTYPE)] = {0};
-                        if(shift != NULL){
-                            for(int k = 0; k < 4 * 32 / sizeof(DTYPE); k++)
-                                bias[k] = *(sp + k);
-                        }
-                        VectorBuffer vecBuf[4];
-                        for(int k = 0; k < 4; k++){
-                            vecBuf[k] = VectorBuffer::loadu((DTYPE*)(ip) + (j * 4 + k) * 32 / sizeof(DTYPE), isExp, power, bias + k * 32 / sizeof(DTYPE));
-                        }
-                        for(int k = 1; k < strideNum; k++){
-                            DTYPE * ptr = ip + k * stride + (j * 4) * vecBufLength;
-                            vecBuf[0] = vecBuf[0] + VectorBuffer::loadu(ptr + 0 * vecBufLength, isExp, power, bias);
-                            vecBuf[1] = vecBuf[1] + VectorBuffer::loadu(ptr + 1 * vecBufLength, isExp, power, bias + 1 * vecBufLength);
-                            vecBuf[2] = vecBuf[2] + VectorBuffer::loadu(ptr + 2 * vecBufLength, isExp, power, bias + 2 * vecBufLength);
-                            vecBuf[3] = vecBuf[3] + VectorBuffer::loadu(ptr + 3 * vecBufLength, isExp, power, bias + 3 * vecBufLength);
-                        }
-                        for(int k = 0; k < 4; k++){
-                            for(int l = 0; l < vecBufLength; l++)
-                                *(op + j * 32 + 8 * k + l) = vecBuf[k][l];
-                        }
-                    }
-                }
-            }
-        }//run vector buffer
-        else{
+        /* the kernel is chosen once according to the CPU */
+        VectorSumKernel kernel = GetVectorSumKernel(power);
 
-            for(int k = 0; k < blockNum; k++){
+        ParallelFor(0, blockNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(blockSize, 1)), [&](int beg, int end) {
+            for (int k = beg; k < end; k++) {
                 DTYPE * ip = (DTYPE*)input->data + blockSize * k;
                 DTYPE * op = (DTYPE*)output->data + stride * k;
                 DTYPE * sp = shift != NULL ? (DTYPE*)shift->data + stride * k : NULL;
-                for(int i = 0; i < stride; i++){
-                    DTYPE sum = 0;
-                    DTYPE bias = shift != NULL ? *(sp + i) : 0;
-                    DTYPE * ipe = ip + blockSize;
-                    if(isExp){
-                        if(bias == 0){
-                            if(power == (DTYPE)1.0){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride)
-                                    sum += (DTYPE)exp(*ipb);
-                            }
-                            else if(power == (DTYPE)2.0){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb);
-                                    sum += (DTYPE)exp(value * value);
-                                }
-                            }
-                            else if(power == (DTYPE)0.5){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb);
-                                    sum += (DTYPE)exp(sqrt(value));
-                                }
-                            }
-                            else{
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb);
-                                    sum += (DTYPE)exp(pow(value, power));
-                                }
-                            }
-                        }
-                        else{
-                            if(power == (DTYPE)1.0){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride)
-                                    sum += (DTYPE)exp(*ipb - bias);
-                            }
-                            else if(power == (DTYPE)2.0){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb) - bias;
-                                    sum += (DTYPE)exp(value * value);
-                                }
-                            }
-                            else if(power == (DTYPE)0.5){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb) - bias;
-                                    sum += (DTYPE)exp(sqrt(value));
-                                }
-                            }
-                            else{
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb) - bias;
-                                    sum += (DTYPE)exp(pow(value, power));
-                                }
-                            }
-                        }
-                    }
-                    else{
-                        if(bias == 0){
-                            if(power == (DTYPE)1.0){
-                                    for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride)
-                                        sum += *ipb;
-                            }
-                            else if(power == (DTYPE)2.0){
-                                    for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                        DTYPE value = (*ipb);
-                                        sum += value * value;
-                                    }
-                            }
-                            else if(power == (DTYPE)0.5){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb);
-                                    sum += (DTYPE)sqrt(value);
-                                }
-                            }
-                            else{
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb);
-                                    sum += (DTYPE)pow(value, power);
-                                }
-                            }
-                        }
-                        else{
-                            if(power == (DTYPE)1.0){
-                                    for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride)
-                                        sum += *ipb;
-                                sum -= strideNum * bias;
-                            }
-                            else if(power == (DTYPE)2.0){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb) - bias;
-                                    sum += value * value;
-                                }
-                            }
-                            else if(power == (DTYPE)0.5){
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb) - bias;
-                                    sum += (DTYPE)sqrt(value);
-                                }
-                            }
-                            else{
-                                for(DTYPE * ipb = ip + i; ipb < ipe; ipb += stride){
-                                    DTYPE value = (*ipb) - bias;
-                                    sum += (DTYPE)pow(value, power);
-                                }
-                            }
-                        }
-                    }
-                    *(op + i) = sum;
-                }
+                kernel(ip, op, strideNum, stride, sp, power, isExp);
             }
-        }
-
+        });
     }
 }
 
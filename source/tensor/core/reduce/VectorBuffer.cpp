@@ -17,163 +17,630 @@
 
 /*
 * $Created by: ZHANG Yuhao (email: zhangyuhao@stu.neu.edu.cn) 2019-07-23
+* $Updated by: agent (email: agent@local) 2026-10-18
+* The kernels are vectorized with SSE4/AVX2/AVX-512 on x86 (chosen at
+* runtime) and with NEON on ARM (chosen at compile time). A block is
+* reduced in two ways. If stride == 1 (i.e., reduce along the last
+* dimension), a row is contiguous and we keep 4 registers of partial
+* results and merge them at the end. Otherwise the registers run across
+* the columns, and each of them is the result of its own columns.
 */
 
+#include <math.h>
 #include "VectorBuffer.h"
-#include "math.h"
+#include "../../XSIMDMath.h"
+
 namespace nts {
-/* data size for each buffer */
-int VectorBuffer::size()
+
+/* (x - shift)^power or exp((x - shift)^power) of an item */
+static inline DTYPE MapScalar(DTYPE v, DTYPE power, bool isExp)
+{
+    if (power == (DTYPE)2.0)
+        v = v * v;
+    else if (power == (DTYPE)0.5)
+        v = (DTYPE)sqrt(v);
+    else if (power != (DTYPE)1.0)
+        v = (DTYPE)pow(v, power);
+    return isExp ? (DTYPE)exp(v) : v;
+}
+
+/* sum over n items (with a stride) */
+static DTYPE SumScalar(const DTYPE * x, int n, int stride, DTYPE bias, DTYPE power, bool isExp)
+{
+    DTYPE sum = 0;
+    for (int i = 0; i < n; i++)
+        sum += MapScalar(x[i * stride] - bias, power, isExp);
+    return sum;
+}
+
+/* max (or min) over n items (with a stride) starting with m */
+static DTYPE MaxScalar(const DTYPE * x, int n, int stride, DTYPE m, bool isMax)
+{
+    for (int i = 0; i < n; i++) {
+        DTYPE v = x[i * stride];
+        m = isMax ? MAX(m, v) : MIN(m, v);
+    }
+    return m;
+}
+
+/* plain C++ kernels (for any power) */
+static void SumKernelScalar(const DTYPE * x, DTYPE * y, int strideNum, int stride,
+                            const DTYPE * shift, DTYPE power, bool isExp)
+{
+    for (int j = 0; j < stride; j++)
+        y[j] = SumScalar(x + j, strideNum, stride, shift != NULL ? shift[j] : 0, power, isExp);
+}
+
+static void MaxKernelScalar(const DTYPE * x, DTYPE * y, int strideNum, int stride, bool isMax)
+{
+    for (int j = 0; j < stride; j++)
+        y[j] = MaxScalar(x + j + stride, strideNum - 1, stride, x[j], isMax);
+}
+
+#if defined(X86_SIMD) && !defined(DOUBELPRICSION)
+
+/* SSE4 kernels. The vectorized kernels support power = 1, 2 and 0.5 only. */
+TARGET_SSE
+static inline __m128 MapSSE(__m128 v, __m128 bias, float power, bool isExp)
+{
+    v = _mm_sub_ps(v, bias);
+    if (power == 2.0F)
+        v = _mm_mul_ps(v, v);
+    else if (power == 0.5F)
+        v = _mm_sqrt_ps(v);
+    return isExp ? ExpSSE(v) : v;
+}
+
+TARGET_SSE
+static inline __m128 PickSSE(__m128 a, __m128 b, bool isMax)
+{
+    return isMax ? _mm_max_ps(a, b) : _mm_min_ps(a, b);
+}
+
+TARGET_SSE
+static void SumKernelSSE(const float * x, float * y, int strideNum, int stride,
+                         const float * shift, float power, bool isExp)
+{
+    if (stride == 1) {
+        float b = shift != NULL ? shift[0] : 0;
+        __m128 bias = _mm_set1_ps(b);
+        __m128 s0 = _mm_setzero_ps();
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 s3 = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 16 <= strideNum; i += 16) {
+            s0 = _mm_add_ps(s0, MapSSE(_mm_loadu_ps(x + i), bias, power, isExp));
+            s1 = _mm_add_ps(s1, MapSSE(_mm_loadu_ps(x + i + 4), bias, power, isExp));
+            s2 = _mm_add_ps(s2, MapSSE(_mm_loadu_ps(x + i + 8), bias, power, isExp));
+            s3 = _mm_add_ps(s3, MapSSE(_mm_loadu_ps(x + i + 12), bias, power, isExp));
+        }
+        for (; i + 4 <= strideNum; i += 4)
+            s0 = _mm_add_ps(s0, MapSSE(_mm_loadu_ps(x + i), bias, power, isExp));
+        s0 = _mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3));
+        y[0] = HorizontalSumSSE(s0) + SumScalar(x + i, strideNum - i, 1, b, power, isExp);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 16 <= stride; j += 16) {
+        __m128 b0 = shift != NULL ? _mm_loadu_ps(shift + j) : _mm_setzero_ps();
+        __m128 b1 = shift != NULL ? _mm_loadu_ps(shift + j + 4) : _mm_setzero_ps();
+        __m128 b2 = shift != NULL ? _mm_loadu_ps(shift + j + 8) : _mm_setzero_ps();
+        __m128 b3 = shift != NULL ? _mm_loadu_ps(shift + j + 12) : _mm_setzero_ps();
+        __m128 s0 = _mm_setzero_ps();
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 s3 = _mm_setzero_ps();
+        for (int i = 0; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            s0 = _mm_add_ps(s0, MapSSE(_mm_loadu_ps(p), b0, power, isExp));
+            s1 = _mm_add_ps(s1, MapSSE(_mm_loadu_ps(p + 4), b1, power, isExp));
+            s2 = _mm_add_ps(s2, MapSSE(_mm_loadu_ps(p + 8), b2, power, isExp));
+            s3 = _mm_add_ps(s3, MapSSE(_mm_loadu_ps(p + 12), b3, power, isExp));
+        }
+        _mm_storeu_ps(y + j, s0);
+        _mm_storeu_ps(y + j + 4, s1);
+        _mm_storeu_ps(y + j + 8, s2);
+        _mm_storeu_ps(y + j + 12, s3);
+    }
+    for (; j + 4 <= stride; j += 4) {
+        __m128 b0 = shift != NULL ? _mm_loadu_ps(shift + j) : _mm_setzero_ps();
+        __m128 s0 = _mm_setzero_ps();
+        for (int i = 0; i < strideNum; i++)
+            s0 = _mm_add_ps(s0, MapSSE(_mm_loadu_ps(x + i * stride + j), b0, power, isExp));
+        _mm_storeu_ps(y + j, s0);
+    }
+    for (; j < stride; j++)
+        y[j] = SumScalar(x + j, strideNum, stride, shift != NULL ? shift[j] : 0, power, isExp);
+}
+
+TARGET_SSE
+static void MaxKernelSSE(const float * x, float * y, int strideNum, int stride, bool isMax)
+{
+    if (stride == 1) {
+        __m128 m0 = _mm_set1_ps(x[0]);
+        __m128 m1 = m0;
+        __m128 m2 = m0;
+        __m128 m3 = m0;
+        int i = 0;
+        for (; i + 16 <= strideNum; i += 16) {
+            m0 = PickSSE(m0, _mm_loadu_ps(x + i), isMax);
+            m1 = PickSSE(m1, _mm_loadu_ps(x + i + 4), isMax);
+            m2 = PickSSE(m2, _mm_loadu_ps(x + i + 8), isMax);
+            m3 = PickSSE(m3, _mm_loadu_ps(x + i + 12), isMax);
+        }
+        for (; i + 4 <= strideNum; i += 4)
+            m0 = PickSSE(m0, _mm_loadu_ps(x + i), isMax);
+        m0 = PickSSE(PickSSE(m0, m1, isMax), PickSSE(m2, m3, isMax), isMax);
+        float m = isMax ? HorizontalMaxSSE(m0) : HorizontalMinSSE(m0);
+        y[0] = MaxScalar(x + i, strideNum - i, 1, m, isMax);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 16 <= stride; j += 16) {
+        __m128 m0 = _mm_loadu_ps(x + j);
+        __m128 m1 = _mm_loadu_ps(x + j + 4);
+        __m128 m2 = _mm_loadu_ps(x + j + 8);
+        __m128 m3 = _mm_loadu_ps(x + j + 12);
+        for (int i = 1; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            m0 = PickSSE(m0, _mm_loadu_ps(p), isMax);
+            m1 = PickSSE(m1, _mm_loadu_ps(p + 4), isMax);
+            m2 = PickSSE(m2, _mm_loadu_ps(p + 8), isMax);
+            m3 = PickSSE(m3, _mm_loadu_ps(p + 12), isMax);
+        }
+        _mm_storeu_ps(y + j, m0);
+        _mm_storeu_ps(y + j + 4, m1);
+        _mm_storeu_ps(y + j + 8, m2);
+        _mm_storeu_ps(y + j + 12, m3);
+    }
+    for (; j + 4 <= stride; j += 4) {
+        __m128 m0 = _mm_loadu_ps(x + j);
+        for (int i = 1; i < strideNum; i++)
+            m0 = PickSSE(m0, _mm_loadu_ps(x + i * stride + j), isMax);
+        _mm_storeu_ps(y + j, m0);
+    }
+    for (; j < stride; j++)
+        y[j] = MaxScalar(x + j + stride, strideNum - 1, stride, x[j], isMax);
+}
+
+/* AVX2 kernels (see the SSE4 kernels) */
+TARGET_AVX2
+static inline __m256 MapAVX2(__m256 v, __m256 bias, float power, bool isExp)
+{
+    v = _mm256_sub_ps(v, bias);
+    if (power == 2.0F)
+        v = _mm256_mul_ps(v, v);
+    else if (power == 0.5F)
+        v = _mm256_sqrt_ps(v);
+    return isExp ? ExpAVX2(v) : v;
+}
+
+TARGET_AVX2
+static inline __m256 PickAVX2(__m256 a, __m256 b, bool isMax)
+{
+    return isMax ? _mm256_max_ps(a, b) : _mm256_min_ps(a, b);
+}
+
+TARGET_AVX2
+static void SumKernelAVX2(const float * x, float * y, int strideNum, int stride,
+                          const float * shift, float power, bool isExp)
+{
+    if (stride == 1) {
+        float b = shift != NULL ? shift[0] : 0;
+        __m256 bias = _mm256_set1_ps(b);
+        __m256 s0 = _mm256_setzero_ps();
+        __m256 s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps();
+        __m256 s3 = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 32 <= strideNum; i += 32) {
+            s0 = _mm256_add_ps(s0, MapAVX2(_mm256_loadu_ps(x + i), bias, power, isExp));
+            s1 = _mm256_add_ps(s1, MapAVX2(_mm256_loadu_ps(x + i + 8), bias, power, isExp));
+            s2 = _mm256_add_ps(s2, MapAVX2(_mm256_loadu_ps(x + i + 16), bias, power, isExp));
+            s3 = _mm256_add_ps(s3, MapAVX2(_mm256_loadu_ps(x + i + 24), bias, power, isExp));
+        }
+        for (; i + 8 <= strideNum; i += 8)
+            s0 = _mm256_add_ps(s0, MapAVX2(_mm256_loadu_ps(x + i), bias, power, isExp));
+        s0 = _mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3));
+        y[0] = HorizontalSumAVX2(s0) + SumScalar(x + i, strideNum - i, 1, b, power, isExp);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 32 <= stride; j += 32) {
+        __m256 b0 = shift != NULL ? _mm256_loadu_ps(shift + j) : _mm256_setzero_ps();
+        __m256 b1 = shift != NULL ? _mm256_loadu_ps(shift + j + 8) : _mm256_setzero_ps();
+        __m256 b2 = shift != NULL ? _mm256_loadu_ps(shift + j + 16) : _mm256_setzero_ps();
+        __m256 b3 = shift != NULL ? _mm256_loadu_ps(shift + j + 24) : _mm256_setzero_ps();
+        __m256 s0 = _mm256_setzero_ps();
+        __m256 s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps();
+        __m256 s3 = _mm256_setzero_ps();
+        for (int i = 0; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            s0 = _mm256_add_ps(s0, MapAVX2(_mm256_loadu_ps(p), b0, power, isExp));
+            s1 = _mm256_add_ps(s1, MapAVX2(_mm256_loadu_ps(p + 8), b1, power, isExp));
+            s2 = _mm256_add_ps(s2, MapAVX2(_mm256_loadu_ps(p + 16), b2, power, isExp));
+            s3 = _mm256_add_ps(s3, MapAVX2(_mm256_loadu_ps(p + 24), b3, power, isExp));
+        }
+        _mm256_storeu_ps(y + j, s0);
+        _mm256_storeu_ps(y + j + 8, s1);
+        _mm256_storeu_ps(y + j + 16, s2);
+        _mm256_storeu_ps(y + j + 24, s3);
+    }
+    for (; j + 8 <= stride; j += 8) {
+        __m256 b0 = shift != NULL ? _mm256_loadu_ps(shift + j) : _mm256_setzero_ps();
+        __m256 s0 = _mm256_setzero_ps();
+        for (int i = 0; i < strideNum; i++)
+            s0 = _mm256_add_ps(s0, MapAVX2(_mm256_loadu_ps(x + i * stride + j), b0, power, isExp));
+        _mm256_storeu_ps(y + j, s0);
+    }
+    for (; j < stride; j++)
+        y[j] = SumScalar(x + j, strideNum, stride, shift != NULL ? shift[j] : 0, power, isExp);
+}
+
+TARGET_AVX2
+static void MaxKernelAVX2(const float * x, float * y, int strideNum, int stride, bool isMax)
+{
+    if (stride == 1) {
+        __m256 m0 = _mm256_set1_ps(x[0]);
+        __m256 m1 = m0;
+        __m256 m2 = m0;
+        __m256 m3 = m0;
+        int i = 0;
+        for (; i + 32 <= strideNum; i += 32) {
+            m0 = PickAVX2(m0, _mm256_loadu_ps(x + i), isMax);
+            m1 = PickAVX2(m1, _mm256_loadu_ps(x + i + 8), isMax);
+            m2 = PickAVX2(m2, _mm256_loadu_ps(x + i + 16), isMax);
+            m3 = PickAVX2(m3, _mm256_loadu_ps(x + i + 24), isMax);
+        }
+        for (; i + 8 <= strideNum; i += 8)
+            m0 = PickAVX2(m0, _mm256_loadu_ps(x + i), isMax);
+        m0 = PickAVX2(PickAVX2(m0, m1, isMax), PickAVX2(m2, m3, isMax), isMax);
+        float m = isMax ? HorizontalMaxAVX2(m0) : HorizontalMinAVX2(m0);
+        y[0] = MaxScalar(x + i, strideNum - i, 1, m, isMax);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 32 <= stride; j += 32) {
+        __m256 m0 = _mm256_loadu_ps(x + j);
+        __m256 m1 = _mm256_loadu_ps(x + j + 8);
+        __m256 m2 = _mm256_loadu_ps(x + j + 16);
+        __m256 m3 = _mm256_loadu_ps(x + j + 24);
+        for (int i = 1; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            m0 = PickAVX2(m0, _mm256_loadu_ps(p), isMax);
+            m1 = PickAVX2(m1, _mm256_loadu_ps(p + 8), isMax);
+            m2 = PickAVX2(m2, _mm256_loadu_ps(p + 16), isMax);
+            m3 = PickAVX2(m3, _mm256_loadu_ps(p + 24), isMax);
+        }
+        _mm256_storeu_ps(y + j, m0);
+        _mm256_storeu_ps(y + j + 8, m1);
+        _mm256_storeu_ps(y + j + 16, m2);
+        _mm256_storeu_ps(y + j + 24, m3);
+    }
+    for (; j + 8 <= stride; j += 8) {
+        __m256 m0 = _mm256_loadu_ps(x + j);
+        for (int i = 1; i < strideNum; i++)
+            m0 = PickAVX2(m0, _mm256_loadu_ps(x + i * stride + j), isMax);
+        _mm256_storeu_ps(y + j, m0);
+    }
+    for (; j < stride; j++)
+        y[j] = MaxScalar(x + j + stride, strideNum - 1, stride, x[j], isMax);
+}
+
+/* AVX-512 kernels (see the SSE4 kernels) */
+TARGET_AVX512
+static inline __m512 MapAVX512(__m512 v, __m512 bias, float power, bool isExp)
+{
+    v = _mm512_sub_ps(v, bias);
+    if (power == 2.0F)
+        v = _mm512_mul_ps(v, v);
+    else if (power == 0.5F)
+        v = _mm512_sqrt_ps(v);
+    return isExp ? ExpAVX512(v) : v;
+}
+
+TARGET_AVX512
+static inline __m512 PickAVX512(__m512 a, __m512 b, bool isMax)
+{
+    return isMax ? _mm512_max_ps(a, b) : _mm512_min_ps(a, b);
+}
+
+TARGET_AVX512
+static void SumKernelAVX512(const float * x, float * y, int strideNum, int stride,
+                            const float * shift, float power, bool isExp)
+{
+    if (stride == 1) {
+        float b = shift != NULL ? shift[0] : 0;
+        __m512 bias = _mm512_set1_ps(b);
+        __m512 s0 = _mm512_setzero_ps();
+        __m512 s1 = _mm512_setzero_ps();
+        __m512 s2 = _mm512_setzero_ps();
+        __m512 s3 = _mm512_setzero_ps();
+        int i = 0;
+        for (; i + 64 <= strideNum; i += 64) {
+            s0 = _mm512_add_ps(s0, MapAVX512(_mm512_loadu_ps(x + i), bias, power, isExp));
+            s1 = _mm512_add_ps(s1, MapAVX512(_mm512_loadu_ps(x + i + 16), bias, power, isExp));
+            s2 = _mm512_add_ps(s2, MapAVX512(_mm512_loadu_ps(x + i + 32), bias, power, isExp));
+            s3 = _mm512_add_ps(s3, MapAVX512(_mm512_loadu_ps(x + i + 48), bias, power, isExp));
+        }
+        for (; i + 16 <= strideNum; i += 16)
+            s0 = _mm512_add_ps(s0, MapAVX512(_mm512_loadu_ps(x + i), bias, power, isExp));
+        s0 = _mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3));
+        y[0] = _mm512_reduce_add_ps(s0) + SumScalar(x + i, strideNum - i, 1, b, power, isExp);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 64 <= stride; j += 64) {
+        __m512 b0 = shift != NULL ? _mm512_loadu_ps(shift + j) : _mm512_setzero_ps();
+        __m512 b1 = shift != NULL ? _mm512_loadu_ps(shift + j + 16) : _mm512_setzero_ps();
+        __m512 b2 = shift != NULL ? _mm512_loadu_ps(shift + j + 32) : _mm512_setzero_ps();
+        __m512 b3 = shift != NULL ? _mm512_loadu_ps(shift + j + 48) : _mm512_setzero_ps();
+        __m512 s0 = _mm512_setzero_ps();
+        __m512 s1 = _mm512_setzero_ps();
+        __m512 s2 = _mm512_setzero_ps();
+        __m512 s3 = _mm512_setzero_ps();
+        for (int i = 0; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            s0 = _mm512_add_ps(s0, MapAVX512(_mm512_loadu_ps(p), b0, power, isExp));
+            s1 = _mm512_add_ps(s1, MapAVX512(_mm512_loadu_ps(p + 16), b1, power, isExp));
+            s2 = _mm512_add_ps(s2, MapAVX512(_mm512_loadu_ps(p + 32), b2, power, isExp));
+            s3 = _mm512_add_ps(s3, MapAVX512(_mm512_loadu_ps(p + 48), b3, power, isExp));
+        }
+        _mm512_storeu_ps(y + j, s0);
+        _mm512_storeu_ps(y + j + 16, s1);
+        _mm512_storeu_ps(y + j + 32, s2);
+        _mm512_storeu_ps(y + j + 48, s3);
+    }
+    for (; j + 16 <= stride; j += 16) {
+        __m512 b0 = shift != NULL ? _mm512_loadu_ps(shift + j) : _mm512_setzero_ps();
+        __m512 s0 = _mm512_setzero_ps();
+        for (int i = 0; i < strideNum; i++)
+            s0 = _mm512_add_ps(s0, MapAVX512(_mm512_loadu_ps(x + i * stride + j), b0, power, isExp));
+        _mm512_storeu_ps(y + j, s0);
+    }
+    for (; j < stride; j++)
+        y[j] = SumScalar(x + j, strideNum, stride, shift != NULL ? shift[j] : 0, power, isExp);
+}
+
+TARGET_AVX512
+static void MaxKernelAVX512(const float * x, float * y, int strideNum, int stride, bool isMax)
+{
+    if (stride == 1) {
+        __m512 m0 = _mm512_set1_ps(x[0]);
+        __m512 m1 = m0;
+        __m512 m2 = m0;
+        __m512 m3 = m0;
+        int i = 0;
+        for (; i + 64 <= strideNum; i += 64) {
+            m0 = PickAVX512(m0, _mm512_loadu_ps(x + i), isMax);
+            m1 = PickAVX512(m1, _mm512_loadu_ps(x + i + 16), isMax);
+            m2 = PickAVX512(m2, _mm512_loadu_ps(x + i + 32), isMax);
+            m3 = PickAVX512(m3, _mm512_loadu_ps(x + i + 48), isMax);
+        }
+        for (; i + 16 <= strideNum; i += 16)
+            m0 = PickAVX512(m0, _mm512_loadu_ps(x + i), isMax);
+        m0 = PickAVX512(PickAVX512(m0, m1, isMax), PickAVX512(m2, m3, isMax), isMax);
+        float m = isMax ? _mm512_reduce_max_ps(m0) : _mm512_reduce_min_ps(m0);
+        y[0] = MaxScalar(x + i, strideNum - i, 1, m, isMax);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 64 <= stride; j += 64) {
+        __m512 m0 = _mm512_loadu_ps(x + j);
+        __m512 m1 = _mm512_loadu_ps(x + j + 16);
+        __m512 m2 = _mm512_loadu_ps(x + j + 32);
+        __m512 m3 = _mm512_loadu_ps(x + j + 48);
+        for (int i = 1; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            m0 = PickAVX512(m0, _mm512_loadu_ps(p), isMax);
+            m1 = PickAVX512(m1, _mm512_loadu_ps(p + 16), isMax);
+            m2 = PickAVX512(m2, _mm512_loadu_ps(p + 32), isMax);
+            m3 = PickAVX512(m3, _mm512_loadu_ps(p + 48), isMax);
+        }
+        _mm512_storeu_ps(y + j, m0);
+        _mm512_storeu_ps(y + j + 16, m1);
+        _mm512_storeu_ps(y + j + 32, m2);
+        _mm512_storeu_ps(y + j + 48, m3);
+    }
+    for (; j + 16 <= stride; j += 16) {
+        __m512 m0 = _mm512_loadu_ps(x + j);
+        for (int i = 1; i < strideNum; i++)
+            m0 = PickAVX512(m0, _mm512_loadu_ps(x + i * stride + j), isMax);
+        _mm512_storeu_ps(y + j, m0);
+    }
+    for (; j < stride; j++)
+        y[j] = MaxScalar(x + j + stride, strideNum - 1, stride, x[j], isMax);
+}
+
+#elif defined(ARM_SIMD) && !defined(DOUBELPRICSION)
+
+/* NEON kernels (see the SSE4 kernels). There is no vector sqrt on 32-bit
+   ARM, and the kernels support power = 0.5 on AArch64 only. */
+#ifdef __aarch64__
+#define NEON_SQRT
+#endif
+
+static inline float32x4_t MapNEON(float32x4_t v, float32x4_t bias, float power, bool isExp)
+{
+    v = vsubq_f32(v, bias);
+    if (power == 2.0F)
+        v = vmulq_f32(v, v);
+#ifdef NEON_SQRT
+    else if (power == 0.5F)
+        v = vsqrtq_f32(v);
+#endif
+    return isExp ? ExpNEON(v) : v;
+}
+
+static inline float32x4_t PickNEON(float32x4_t a, float32x4_t b, bool isMax)
 {
-    return 32 / sizeof(DTYPE);
+    return isMax ? vmaxq_f32(a, b) : vminq_f32(a, b);
+}
+
+static void SumKernelNEON(const float * x, float * y, int strideNum, int stride,
+                          const float * shift, float power, bool isExp)
+{
+    if (stride == 1) {
+        float b = shift != NULL ? shift[0] : 0;
+        float32x4_t bias = vdupq_n_f32(b);
+        float32x4_t s0 = vdupq_n_f32(0);
+        float32x4_t s1 = vdupq_n_f32(0);
+        float32x4_t s2 = vdupq_n_f32(0);
+        float32x4_t s3 = vdupq_n_f32(0);
+        int i = 0;
+        for (; i + 16 <= strideNum; i += 16) {
+            s0 = vaddq_f32(s0, MapNEON(vld1q_f32(x + i), bias, power, isExp));
+            s1 = vaddq_f32(s1, MapNEON(vld1q_f32(x + i + 4), bias, power, isExp));
+            s2 = vaddq_f32(s2, MapNEON(vld1q_f32(x + i + 8), bias, power, isExp));
+            s3 = vaddq_f32(s3, MapNEON(vld1q_f32(x + i + 12), bias, power, isExp));
+        }
+        for (; i + 4 <= strideNum; i += 4)
+            s0 = vaddq_f32(s0, MapNEON(vld1q_f32(x + i), bias, power, isExp));
+        s0 = vaddq_f32(vaddq_f32(s0, s1), vaddq_f32(s2, s3));
+        y[0] = HorizontalSumNEON(s0) + SumScalar(x + i, strideNum - i, 1, b, power, isExp);
+        return;
+    }
+
+    int j = 0;
+    for (; j + 16 <= stride; j += 16) {
+        float32x4_t b0 = shift != NULL ? vld1q_f32(shift + j) : vdupq_n_f32(0);
+        float32x4_t b1 = shift != NULL ? vld1q_f32(shift + j + 4) : vdupq_n_f32(0);
+        float32x4_t b2 = shift != NULL ? vld1q_f32(shift + j + 8) : vdupq_n_f32(0);
+        float32x4_t b3 = shift != NULL ? vld1q_f32(shift + j + 12) : vdupq_n_f32(0);
+        float32x4_t s0 = vdupq_n_f32(0);
+        float32x4_t s1 = vdupq_n_f32(0);
+        float32x4_t s2 = vdupq_n_f32(0);
+        float32x4_t s3 = vdupq_n_f32(0);
+        for (int i = 0; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            s0 = vaddq_f32(s0, MapNEON(vld1q_f32(p), b0, power, isExp));
+            s1 = vaddq_f32(s1, MapNEON(vld1q_f32(p + 4), b1, power, isExp));
+            s2 = vaddq_f32(s2, MapNEON(vld1q_f32(p + 8), b2, power, isExp));
+            s3 = vaddq_f32(s3, MapNEON(vld1q_f32(p + 12), b3, power, isExp));
+        }
+        vst1q_f32(y + j, s0);
+        vst1q_f32(y + j + 4, s1);
+        vst1q_f32(y + j + 8, s2);
+        vst1q_f32(y + j + 12, s3);
+    }
+    for (; j + 4 <= stride; j += 4) {
+        float32x4_t b0 = shift != NULL ? vld1q_f32(shift + j) : vdupq_n_f32(0);
+        float32x4_t s0 = vdupq_n_f32(0);
+        for (int i = 0; i < strideNum; i++)
+            s0 = vaddq_f32(s0, MapNEON(vld1q_f32(x + i * stride + j), b0, power, isExp));
+        vst1q_f32(y + j, s0);
+    }
+    for (; j < stride; j++)
+        y[j] = SumScalar(x + j, strideNum, stride, shift != NULL ? shift[j] : 0, power, isExp);
 }
 
-/* constructor */
-VectorBuffer::VectorBuffer() 
+static void MaxKernelNEON(const float * x, float * y, int strideNum, int stride, bool isMax)
 {
+    if (stride == 1) {
+        float32x4_t m0 = vdupq_n_f32(x[0]);
+        float32x4_t m1 = m0;
+        float32x4_t m2 = m0;
+        float32x4_t m3 = m0;
+        int i = 0;
+        for (; i + 16 <= strideNum; i += 16) {
+            m0 = PickNEON(m0, vld1q_f32(x + i), isMax);
+            m1 = PickNEON(m1, vld1q_f32(x + i + 4), isMax);
+            m2 = PickNEON(m2, vld1q_f32(x + i + 8), isMax);
+            m3 = PickNEON(m3, vld1q_f32(x + i + 12), isMax);
+        }
+        for (; i + 4 <= strideNum; i += 4)
+            m0 = PickNEON(m0, vld1q_f32(x + i), isMax);
+        m0 = PickNEON(PickNEON(m0, m1, isMax), PickNEON(m2, m3, isMax), isMax);
+        float m = isMax ? HorizontalMaxNEON(m0) : HorizontalMinNEON(m0);
+        y[0] = MaxScalar(x + i, strideNum - i, 1, m, isMax);
+        return;
+    }
 
+    int j = 0;
+    for (; j + 16 <= stride; j += 16) {
+        float32x4_t m0 = vld1q_f32(x + j);
+        float32x4_t m1 = vld1q_f32(x + j + 4);
+        float32x4_t m2 = vld1q_f32(x + j + 8);
+        float32x4_t m3 = vld1q_f32(x + j + 12);
+        for (int i = 1; i < strideNum; i++) {
+            const float * p = x + i * stride + j;
+            m0 = PickNEON(m0, vld1q_f32(p), isMax);
+            m1 = PickNEON(m1, vld1q_f32(p + 4), isMax);
+            m2 = PickNEON(m2, vld1q_f32(p + 8), isMax);
+            m3 = PickNEON(m3, vld1q_f32(p + 12), isMax);
+        }
+        vst1q_f32(y + j, m0);
+        vst1q_f32(y + j + 4, m1);
+        vst1q_f32(y + j + 8, m2);
+        vst1q_f32(y + j + 12, m3);
+    }
+    for (; j + 4 <= stride; j += 4) {
+        float32x4_t m0 = vld1q_f32(x + j);
+        for (int i = 1; i < strideNum; i++)
+            m0 = PickNEON(m0, vld1q_f32(x + i * stride + j), isMax);
+        vst1q_f32(y + j, m0);
+    }
+    for (; j < stride; j++)
+        y[j] = MaxScalar(x + j + stride, strideNum - 1, stride, x[j], isMax);
 }
 
+#endif
+
 /* 
-constructor
-initial values with val
+get the (fastest) sum kernel for the given power. The vectorized kernels
+support power = 1, 2 and 0.5, and the other powers go to the plain C++ kernel.
+>> power - we perform pow(item_i, power) on each item
+<< return - the kernel
 */
-VectorBuffer::VectorBuffer(DTYPE val)
-{
-    for (int i = 0; i != size(); i++) {
-        values[i] = val;
-    }
-}
-
-/* load data */
-VectorBuffer VectorBuffer::loadu(const DTYPE* ptr, bool isExp , DTYPE power , DTYPE* bias )
-{
-    int count = 32 / sizeof(DTYPE);
-    VectorBuffer vec;
-    if (isExp) {
-        if (bias == NULL) {
-            if (power == (DTYPE)1.0) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp(*(ptr + i));
-                }
-            }
-            else if (power == (DTYPE)2.0) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp((*(ptr + i)) * (*(ptr + i)));
-                }
-            }
-            else if (power == (DTYPE)0.5) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp(sqrt(*(ptr + i)));
-                }
-            }
-            else {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp(pow(*(ptr + i), power));
-                }
-            }
-        }/*is bias == NULL*/
-        else {
-            if (power == (DTYPE)1.0) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp(*(ptr + i) - bias[i]);
-                }
-            }
-            else if (power == (DTYPE)2.0) {
-                for (int i = 0; i != count; i++) {
-                    DTYPE value = *(ptr + i) - bias[i];
-                    vec.values[i] = (DTYPE)exp(value * value);
-                }
-            }
-            else if (power == (DTYPE)0.5) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp(sqrt(*(ptr + i) - bias[i]));
-                }
-            }
-            else {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)exp(pow(*(ptr + i) - bias[i], power));
-                }
-            }
-        }
-    }//isExp
-    else {
-        if (bias == NULL) {
-            if (power == (DTYPE)1.0) {
-                memcpy(vec.values, ptr, count * sizeof(DTYPE));
-            }
-            else if (power == (DTYPE)2.0) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (*(ptr + i)) * (*(ptr + i));
-                }
-            }
-            else if (power == (DTYPE)0.5) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)sqrt(*(ptr + i));
-                }
-            }
-            else {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)pow(*(ptr + i), power);
-                }
-            }
-        }// if bias == NULL
-        else {
-            if (power == (DTYPE)1.0) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = *(ptr + i) - bias[i];
-                }
-            }
-            else if (power == (DTYPE)2.0) {
-                for (int i = 0; i != count; i++) {
-                    DTYPE value = *(ptr + i) - bias[i];
-                    vec.values[i] = value * value;
-                }
-            }
-            else if (power == (DTYPE)0.5) {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)sqrt(*(ptr + i) - bias[i]);
-                }
-            }
-            else {
-                for (int i = 0; i != count; i++) {
-                    vec.values[i] = (DTYPE)pow(*(ptr + i) - bias[i], power);
-                }
-            }
-        }
-    }
-    return vec;
-}
-
-/* overloading [] */
-const DTYPE& VectorBuffer::operator[](int idx)const
-{
-    return values[idx];
-}
-
-/* overloading + */
-VectorBuffer VectorBuffer::operator+(const VectorBuffer &a)
-{
-    for (int i = 0; i != a.size(); i++) {
-        this->values[i] = a[i] + this->values[i];
-    }
-    return *this;
-}
-
-/* conculte the max of two buffer */
-VectorBuffer VectorBuffer::maxData(const VectorBuffer &a) {
-    for (int i = 0; i != a.size(); i++) {
-        this->values[i] = MAX(a[i], this->values[i]);
-    }
-    return *this;
-}
-
-/* conculte the max of two buffer */
-VectorBuffer VectorBuffer::minData(const VectorBuffer &a) {
-    for (int i = 0; i != a.size(); i++) {
-        this->values[i] = MIN(a[i], this->values[i]);
-    }
-    return *this;
-}
-
-}/* end of the nts (NiuTrans.Tensor) namespace */
\ No newline at end of file
+VectorSumKernel GetVectorSumKernel(DTYPE power)
+{
+#if defined(X86_SIMD) && !defined(DOUBELPRICSION)
+    if (power == 1.0F || power == 2.0F || power == 0.5F) {
+        SIMD_LEVEL level = GetSIMDLevel();
+        if (level >= SIMD_AVX512)
+            return SumKernelAVX512;
+        else if (level >= SIMD_AVX2)
+            return SumKernelAVX2;
+        else if (level >= SIMD_SSE)
+            return SumKernelSSE;
+    }
+#elif defined(ARM_SIMD) && !defined(DOUBELPRICSION)
+#ifdef NEON_SQRT
+    if (power == 1.0F || power == 2.0F || power == 0.5F) {
+#else
+    if (power == 1.0F || power == 2.0F) {
+#endif
+        if (GetSIMDLevel() >= SIMD_SSE)
+            return SumKernelNEON;
+    }
+#endif
+    return SumKernelScalar;
+}
+
+/* get the (fastest) max/min kernel */
+VectorMaxKernel GetVectorMaxKernel()
+{
+#if defined(X86_SIMD) && !defined(DOUBELPRICSION)
+    SIMD_LEVEL level = GetSIMDLevel();
+    if (level >= SIMD_AVX512)
+        return MaxKernelAVX512;
+    else if (level >= SIMD_AVX2)
+        return MaxKernelAVX2;
+    else if (level >= SIMD_SSE)
+        return MaxKernelSSE;
+#elif defined(ARM_SIMD) && !defined(DOUBELPRICSION)
+    if (GetSIMDLevel() >= SIMD_SSE)
+        return MaxKernelNEON;
+#endif
+    return MaxKernelScalar;
+}
+
+}
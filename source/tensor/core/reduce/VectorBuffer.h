@@ -17,38 +17,41 @@
 
 /*
 * $Created by: ZHANG Yuhao (email: zhangyuhao@stu.neu.edu.cn) 2019-07-23
+* $Updated by: agent (email: agent@local) 2026-10-18
+* The buffers are now real SIMD registers (SSE4, AVX2 or AVX-512) and the
+* kernel is chosen at runtime according to the CPU. On ARM they are NEON
+* registers.
 */
 
+#ifndef __VECTORBUFFER_H__
+#define __VECTORBUFFER_H__
+
 #include "../../XGlobal.h"
 
 namespace nts {
-class VectorBuffer {
-private:
-    /* buffer for concluter */
-    DTYPE values[32 / sizeof(DTYPE)] = { 0 };
-public:
-    /* data size for each buffer */
-    static int size();
-
-    /* constructor */
-    VectorBuffer();
 
-    /* constructor */
-    VectorBuffer(DTYPE val);
+/*
+the kernel that sums the items of a block along the rows, i.e., for a
+block x of strideNum * stride items (row-major),
+y_j = \sum_i (x_{i,j} - shift_j)^power if isExp == false
+y_j = \sum_i exp((x_{i,j} - shift_j)^power) if isExp == true
+*/
+typedef void (*VectorSumKernel)(const DTYPE * x, DTYPE * y, int strideNum, int stride,
+                                const DTYPE * shift, DTYPE power, bool isExp);
 
-    /* load data */
-    static VectorBuffer loadu(const DTYPE* ptr, bool isExp = false, DTYPE power = (DTYPE)1.0F, DTYPE* bias = NULL); 
+/* 
+the kernel that takes the max (or min) of the items of a block along the rows, i.e.,
+y_j = max_i x_{i,j} if isMax == true
+y_j = min_i x_{i,j} if isMax == false
+*/
+typedef void (*VectorMaxKernel)(const DTYPE * x, DTYPE * y, int strideNum, int stride, bool isMax);
 
-    /* overloading [] */
-    const DTYPE& operator[](int idx)const; 
+/* get the (fastest) sum kernel for the given power */
+VectorSumKernel GetVectorSumKernel(DTYPE power);
 
-    /* overloading + */
-    VectorBuffer operator+(const VectorBuffer &a); 
+/* get the (fastest) max/min kernel */
+VectorMaxKernel GetVectorMaxKernel();
 
-    /* conculte the max of two buffer */
-    VectorBuffer maxData(const VectorBuffer &a); 
+}
 
-    /* conculte the max of two buffer */
-    VectorBuffer minData(const VectorBuffer &a);
-};
-}
\ No newline at end of file
+#endif
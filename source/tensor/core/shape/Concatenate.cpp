@@ -21,6 +21,7 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../shape/IsSameShaped.h"
 #include "Concatenate.h"
 #include "Merge.h"
@@ -261,6 +262,8 @@ concatenate two tensors along a given dimension
 */
 void _Concatenate(const XTensor * smallA, const XTensor * smallB, XTensor * big, int dim)
 {
+    XProfileOp profile(SHAPE_CONCATENATE, smallA, smallB, big);
+
     TensorList smalls(2);
     smalls.Add((XTensor*)smallA);
     smalls.Add((XTensor*)smallB);
@@ -22,6 +22,7 @@
 #include "../../XTensor.h"
 #include "../../XUtility.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../shape/IsSameShaped.h"
 #include "Merge.h"
 #include "MakeMergeBlockIndex.h"
@@ -43,6 +44,11 @@ e.g., (N/3, M, 3) -> (N, M)
 */
 void _Merge(const XTensor * s, XTensor * t, int whereToMerge, int leadingDim)
 {
+    XProfileOp profile(SHAPE_MERGE, s, NULL, t);
+
+    CheckNTErrors(s->IsContiguous() && t->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
+
     if(leadingDim < 0)
         leadingDim = 0;
 
@@ -23,6 +23,7 @@
 #include "Split.h"
 #include "MakeSplitBlockIndex.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "../../XTensor.h"
 #include "../../XDevice.h"
 #include "../../XUtility.h"
@@ -40,9 +41,13 @@ transform a tensor by splitting it, e.g., (N, M) -> (N/3, M, 3)
 */
 void _Split(const XTensor * s, XTensor * t, int whereToSplit, int splitNum)
 {
+    XProfileOp profile(SHAPE_SPLIT, s, NULL, t);
+
     CheckNTErrors((s && t), "Invalid tensors!");
     CheckNTErrors((s->devID == t->devID || (s->devID < 0 && t->devID < 0)),
                   "the data must be kept on the same device!");
+    CheckNTErrors(s->IsContiguous() && t->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     CheckNTErrors((s->unitNum == t->unitNum && s->unitSize == t->unitSize), "Unmatched tensors!");
     CheckNTErrors((s->order == t->order - 1), "Unmatched tensors!");
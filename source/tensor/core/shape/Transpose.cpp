@@ -25,6 +25,7 @@
 #include "Merge.h"
 #include "../../XUtility.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
 
@@ -43,11 +44,15 @@ then the output will be a tensor of size z * y * x.
 */
 void _Transpose(const XTensor * a, XTensor * b, const int i, const int j)
 {
+    XProfileOp profile(SHAPE_TRANSPOSE, a, NULL, b);
+
     CheckNTErrors(a && b, "Empty tensors");
     CheckNTErrors(a->order == b->order, "Wrong tensor orders");
     CheckNTErrors(a->unitNum == b->unitNum && a->unitSize == b->unitSize, "Wrong tensor sizes");
     CheckNTErrors(a->order > i && i >= 0, "index of dimension is out of scope!");
     CheckNTErrors(a->order > j && j >= 0, "index of dimension is out of scope!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     for(int k = 0; k < a->order; k++){
         if(k == i){
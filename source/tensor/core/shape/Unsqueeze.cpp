@@ -21,6 +21,7 @@
 
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
 #include "Unsqueeze.h"
 #include "MergeBlockLists.h"
 #include "Unsqueeze.cuh"
@@ -38,9 +39,13 @@ insert a dimension by copying the blocks for x times
 */
 void _Unsqueeze(const XTensor * a, XTensor * b, int dim, int dSize)
 {
+    XProfileOp profile(SHAPE_UNSQUEEZE, a, NULL, b);
+
     CheckNTErrors((a && b), "Empty input tensors!");
     CheckNTErrors((a->order == b->order - 1), "Unmatched tensors!");
     CheckNTErrors((a->unitSize == b->unitSize), "Unmatched tensors!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     for (int i = 0; i < b->order; i++) {
         if (i < dim) {
@@ -0,0 +1,241 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "View.h"
+#include "Merge.h"
+#include "../../XUtility.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+make a view of a tensor
+>> s - the source tensor
+>> order - order of the view
+>> dimSize - size of each dimension of the view
+>> strides - stride (in units) of each dimension of the view
+>> offset - where the view starts (in units) in the data array of s
+<< return - the view
+*/
+XTensor MakeView(const XTensor &s, int order, const int * dimSize, const int * strides, int offset)
+{
+    CheckNTErrors(s.data != NULL, "Cannot make a view of an empty tensor!");
+    CheckNTErrors(!s.isSparse, "Cannot make a view of a sparse tensor!");
+    CheckNTErrors(order <= MAX_TENSOR_DIM_NUM, "Too many dimensions!");
+
+    XTensor t(order, s.devID, s.mem);
+    t.dataType = s.dataType;
+    t.unitSize = s.unitSize;
+    t.isDefaultDType = s.isDefaultDType;
+    t.unitNum = 1;
+    for (int i = 0; i < order; i++) {
+        t.dimSize[i] = dimSize[i];
+        t.strides[i] = strides[i];
+        t.unitNum *= dimSize[i];
+    }
+    t.data = (char*)s.data + (long long)offset * s.unitSize;
+    t.isShared = true;
+    t.isStrided = true;
+    t.isInit = true;
+    t.enableGrad = false;
+    t.SetTMPFlag();
+
+    return t;
+}
+
+/*
+split a tensor as Split() does, e.g., (M, N) -> (3, M, N/3), but the result
+is a view of the source tensor
+>> s - the source tensor
+>> whereToSplit - which dimension of the tensor is to split
+>> splitNum - how many splits
+<< return - the view, where the first dimension is the index of the splits
+*/
+XTensor SplitView(const XTensor &s, int whereToSplit, int splitNum)
+{
+    CheckNTErrors(whereToSplit >= 0 && whereToSplit < s.order, "Illegal dimension to split!");
+    CheckNTErrors(s.dimSize[whereToSplit] % splitNum == 0, "Incorrect split number!");
+    CheckNTErrors(s.order < MAX_TENSOR_DIM_NUM, "Too many dimensions!");
+
+    int dimSize[MAX_TENSOR_DIM_NUM];
+    int strides[MAX_TENSOR_DIM_NUM];
+
+    for (int i = 0; i < s.order; i++) {
+        dimSize[i + 1] = s.dimSize[i];
+        strides[i + 1] = s.GetStride(i);
+    }
+
+    dimSize[whereToSplit + 1] /= splitNum;
+    dimSize[0] = splitNum;
+    strides[0] = dimSize[whereToSplit + 1] * strides[whereToSplit + 1];
+
+    return MakeView(s, s.order + 1, dimSize, strides, 0);
+}
+
+/*
+merge a tensor as Merge() does, e.g., (3, M, N/3) -> (M, N). The result is a
+view if the two dimensions can be merged without moving the data (e.g., s is
+a result of SplitView()), and is a copy otherwise.
+>> s - the source tensor
+>> whereToMerge - the merging operation is along with which dimension
+>> leadingDim - the leading dimension of merging (see Merge())
+<< return - the merged tensor
+*/
+XTensor MergeView(const XTensor &s, int whereToMerge, int leadingDim)
+{
+    if (leadingDim < 0)
+        leadingDim = 0;
+
+    CheckNTErrors(leadingDim < whereToMerge && whereToMerge < s.order, "Invalid leading dimension!");
+
+    /* the leading dimension has to jump over the whole merged dimension */
+    if (s.GetStride(leadingDim) != s.dimSize[whereToMerge] * s.GetStride(whereToMerge)) {
+        XTensor c = Contiguous(s);
+        return Merge(c, whereToMerge, leadingDim);
+    }
+
+    int dimSize[MAX_TENSOR_DIM_NUM];
+    int strides[MAX_TENSOR_DIM_NUM];
+    int order = 0;
+
+    for (int i = 0; i < s.order; i++) {
+        if (i == leadingDim)
+            continue;
+        dimSize[order] = s.dimSize[i];
+        strides[order] = s.GetStride(i);
+        if (i == whereToMerge)
+            dimSize[order] *= s.dimSize[leadingDim];
+        order++;
+    }
+
+    return MakeView(s, order, dimSize, strides, 0);
+}
+
+/*
+transpose the dimensions i and j of a tensor as Transpose() does (return a view)
+>> a - the input tensor
+>> i - the transposed dimension
+>> j - the transposed dimension
+<< return - the view
+*/
+XTensor TransposeView(const XTensor &a, const int i, const int j)
+{
+    CheckNTErrors(i >= 0 && i < a.order && j >= 0 && j < a.order, "Illegal dimensions!");
+
+    int dimSize[MAX_TENSOR_DIM_NUM];
+    int strides[MAX_TENSOR_DIM_NUM];
+
+    for (int k = 0; k < a.order; k++) {
+        dimSize[k] = a.dimSize[k];
+        strides[k] = a.GetStride(k);
+    }
+
+    dimSize[i] = a.dimSize[j];
+    dimSize[j] = a.dimSize[i];
+    strides[i] = a.GetStride(j);
+    strides[j] = a.GetStride(i);
+
+    return MakeView(a, a.order, dimSize, strides, 0);
+}
+
+/*
+permute the dimensions of a tensor (return a view), i.e., dimension i of
+the result is dimension dimPermute[i] of the input
+>> a - the input tensor
+>> dimPermute - the permutation
+<< return - the view
+*/
+XTensor PermuteView(const XTensor &a, const int * dimPermute)
+{
+    int dimSize[MAX_TENSOR_DIM_NUM];
+    int strides[MAX_TENSOR_DIM_NUM];
+    bool used[MAX_TENSOR_DIM_NUM] = {false};
+
+    for (int i = 0; i < a.order; i++) {
+        int d = dimPermute[i];
+        CheckNTErrors(d >= 0 && d < a.order && !used[d], "Illegal permutation!");
+        used[d] = true;
+        dimSize[i] = a.dimSize[d];
+        strides[i] = a.GetStride(d);
+    }
+
+    return MakeView(a, a.order, dimSize, strides, 0);
+}
+
+/*
+copy the items of a (strided) tensor to another (strided) tensor of the same shape.
+We copy a row (i.e., the last dimension) at a time.
+>> s - the source tensor
+>> t - the target tensor
+*/
+void _Contiguous(const XTensor * s, XTensor * t)
+{
+    CheckNTErrors(s && t, "Empty input tensors!");
+    CheckNTErrors(s->unitNum == t->unitNum && s->unitSize == t->unitSize, "Unmatched tensors!");
+    CheckNTErrors(s->order == t->order, "Unmatched tensors!");
+    CheckNTErrors(!s->isSparse && !t->isSparse, "TODO!");
+
+    if (s->IsContiguous() && t->IsContiguous()) {
+        XMemCopy(t->data, t->devID, s->data, s->devID, s->unitNum * s->unitSize);
+        return;
+    }
+
+    CheckNTErrors(s->devID < 0 && t->devID < 0, "TODO!");
+
+    if (s->unitNum == 0)
+        return;
+
+    int rowSize = s->order > 0 ? s->dimSize[s->order - 1] : 1;
+    int rowNum = s->unitNum / rowSize;
+    int sStep = s->order > 0 ? s->GetStride(s->order - 1) : 1;
+    int tStep = t->order > 0 ? t->GetStride(t->order - 1) : 1;
+    int unitSize = s->unitSize;
+
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(rowSize, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            const char * sp = (char*)s->data + (long long)s->GetStridedOffset(i * rowSize) * unitSize;
+            char * tp = (char*)t->data + (long long)t->GetStridedOffset(i * rowSize) * unitSize;
+            if (sStep == 1 && tStep == 1)
+                memcpy(tp, sp, rowSize * unitSize);
+            else {
+                for (int j = 0; j < rowSize; j++)
+                    memcpy(tp + (long long)j * tStep * unitSize, sp + (long long)j * sStep * unitSize, unitSize);
+            }
+        }
+    });
+}
+
+/*
+make a contiguous copy of a (strided) tensor (return an XTensor structure)
+make a new tensor to keep the result and return it
+>> s - the source tensor
+<< return - the contiguous copy
+*/
+XTensor Contiguous(const XTensor &s)
+{
+    XTensor t(s.order, s.dimSize, s.dataType, 1.0F, s.devID, s.mem);
+    t.SetTMPFlag();
+
+    _Contiguous(&s, &t);
+
+    return t;
+}
+
+} // namespace nts(NiuTrans.Tensor)
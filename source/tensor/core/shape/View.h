@@ -0,0 +1,72 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Views of a tensor, i.e., tensors that share the data array of the source
+ * tensor and read it with their own strides (see XTensor::isStrided). Making
+ * a view costs nothing but a few integers. Note that
+ * 1) the source tensor must outlive its views.
+ * 2) a view is not linked to the network, so there is no back-propagation.
+ * 3) only a few functions take views, e.g., _CopyValues, _Sum, _ScaleAndShift
+ *    and _MatrixMulBatched on CPUs. The other functions stop with an error
+ *    on a strided view, so please make a contiguous copy with Contiguous()
+ *    first.
+ *
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __VIEW_H__
+#define __VIEW_H__
+
+#include "../../XTensor.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* 
+split a tensor as Split() does, e.g., (M, N) -> (3, M, N/3), but the result 
+is a view of the source tensor 
+*/
+XTensor SplitView(const XTensor &s, int whereToSplit, int splitNum);
+
+/* 
+merge a tensor as Merge() does, e.g., (3, M, N/3) -> (M, N). The result is a 
+view if the two dimensions can be merged without moving the data (e.g., s is
+a result of SplitView()), and is a copy otherwise.
+*/
+XTensor MergeView(const XTensor &s, int whereToMerge, int leadingDim = -1);
+
+/* transpose the dimensions i and j of a tensor as Transpose() does (return a view) */
+XTensor TransposeView(const XTensor &a, const int i, const int j);
+
+/* 
+permute the dimensions of a tensor (return a view), i.e., dimension i of 
+the result is dimension dimPermute[i] of the input 
+*/
+XTensor PermuteView(const XTensor &a, const int * dimPermute);
+
+/* copy the items of a (strided) tensor to another (strided) tensor of the same shape */
+void _Contiguous(const XTensor * s, XTensor * t);
+
+/* 
+make a contiguous copy of a (strided) tensor (return an XTensor structure)
+make a new tensor to keep the result and return it
+*/
+XTensor Contiguous(const XTensor &s);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __VIEW_H__
@@ -22,10 +22,16 @@
 #include <math.h>
 #include "../../XTensor.h"
 #include "../../XName.h"
+#include "../../XProfiler.h"
+#include "../../XSIMD.h"
 #include "TopK.h"
 #include "TopK.cuh"
 #include "Sort.h"
 
+#ifdef X86_SIMD
+#include <immintrin.h>
+#endif
+
 namespace nts { // namespace nts(NiuTrans.Tensor)
 
 /*
@@ -39,12 +45,16 @@ get the top-k items along a given dimension
 */
 void _TopK(const XTensor * a, XTensor * b, XTensor * index, int dim, int k, bool isSorted)
 {
+    XProfileOp profile(SORT_TOPK, a, NULL, b);
+
     dim = MODX(dim, a->order);
     
     CheckNTErrors(a->unitSize == b->unitSize, "Unmatched input tensors!");
     CheckNTErrors(a->order == b->order, "Unmatched input tensors!");
     CheckNTErrors(index == NULL || a->order == index->order, "Unmatched input tensors!");
     CheckNTErrors(index->dataType == X_INT, "Wrong data type!");
+    CheckNTErrors(a->IsContiguous() && b->IsContiguous() && index->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     for (int i = 0; i < a->order; i++) {
         if (i == dim) {
@@ -139,5 +149,176 @@ void TopK(XTensor &a, XTensor &b, XTensor &index, int dim, int k, bool isSorted)
     //XLink::AddParamToHeadInt(&index, k);
 }
 
+/* the kernel that keeps the top-k items of a row */
+typedef void (*TopKRowKernel)(const float * a, int n, int k, float * value, int * index);
+
+/*
+put an item into a sorted list (in descending order) of k items. The last
+item is dropped. An item goes after those of the same value, i.e., we
+prefer the item that comes first when there is a tie.
+>> value - values of the list
+>> index - indices of the list
+>> k - size of the list
+>> v - value of the new item
+>> id - index of the new item
+*/
+inline void InsertTopK(float * value, int * index, int k, float v, int id)
+{
+    int j = k - 1;
+    while (j > 0 && value[j - 1] < v) {
+        value[j] = value[j - 1];
+        index[j] = index[j - 1];
+        j--;
+    }
+    value[j] = v;
+    index[j] = id;
+}
+
+/*
+keep the top-k items of a row (scalar). The first k items are sorted
+as they are and then each of the rest items goes into the list only
+if it is larger than the k-th best item so far.
+>> a - the row
+>> n - number of the items in the row
+>> k - how many items we keep (k <= n)
+>> value - values of the top-k items (sorted)
+>> index - indices of the top-k items
+*/
+static void TopKRowScalar(const float * a, int n, int k, float * value, int * index)
+{
+    for (int i = 0; i < k; i++)
+        InsertTopK(value, index, i + 1, a[i], i);
+
+    for (int i = k; i < n; i++) {
+        if (a[i] > value[k - 1])
+            InsertTopK(value, index, k, a[i], i);
+    }
+}
+
+#ifdef X86_SIMD
+
+/* keep the top-k items of a row (AVX2). We compare 8 items with the k-th
+   best item at a time and go into the list only when some of them win. */
+TARGET_AVX2
+static void TopKRowAVX2(const float * a, int n, int k, float * value, int * index)
+{
+    for (int i = 0; i < k; i++)
+        InsertTopK(value, index, i + 1, a[i], i);
+
+    int i = k;
+    __m256 threshold = _mm256_set1_ps(value[k - 1]);
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a + i), threshold, _CMP_GT_OQ));
+        if (mask == 0)
+            continue;
+        for (int j = 0; mask != 0; j++, mask >>= 1) {
+            if ((mask & 1) && a[i + j] > value[k - 1])
+                InsertTopK(value, index, k, a[i + j], i + j);
+        }
+        threshold = _mm256_set1_ps(value[k - 1]);
+    }
+
+    for (; i < n; i++) {
+        if (a[i] > value[k - 1])
+            InsertTopK(value, index, k, a[i], i);
+    }
+}
+
+/* keep the top-k items of a row (AVX-512) */
+TARGET_AVX512
+static void TopKRowAVX512(const float * a, int n, int k, float * value, int * index)
+{
+    for (int i = 0; i < k; i++)
+        InsertTopK(value, index, i + 1, a[i], i);
+
+    int i = k;
+    __m512 threshold = _mm512_set1_ps(value[k - 1]);
+    for (; i + 16 <= n; i += 16) {
+        int mask = (int)_mm512_cmp_ps_mask(_mm512_loadu_ps(a + i), threshold, _CMP_GT_OQ);
+        if (mask == 0)
+            continue;
+        for (int j = 0; mask != 0; j++, mask >>= 1) {
+            if ((mask & 1) && a[i + j] > value[k - 1])
+                InsertTopK(value, index, k, a[i + j], i + j);
+        }
+        threshold = _mm512_set1_ps(value[k - 1]);
+    }
+
+    for (; i < n; i++) {
+        if (a[i] > value[k - 1])
+            InsertTopK(value, index, k, a[i], i);
+    }
+}
+
+#endif
+
+/*
+get the top-k items of each row (along the last dimension) where a row is
+a number of segments of "wordNum" items. This is the top-k used in beam search,
+i.e., a row is the scores of (beam size \times vocabulary size) candidates
+of a sentence. Rather than the offset in the row, we output the segment
+(i.e., the previous state in the beam) and the offset in the segment (i.e.,
+the word) of each item. It runs on CPUs only and the rows are processed
+in parallel.
+>> a - input tensor
+>> b - output tensor (top-k result in descending order)
+>> beamIndex - the segment where each of the top-k items comes from
+>> wordIndex - the offset in the segment of each of the top-k items
+>> k - how many items returned
+>> wordNum - size of a segment
+*/
+void _TopKBeam(const XTensor * a, XTensor * b, XTensor * beamIndex, XTensor * wordIndex,
+               int k, int wordNum)
+{
+    int last = a->order - 1;
+    int rowSize = a->dimSize[last];
+
+    CheckNTErrors(a->devID < 0 && b->devID < 0 && beamIndex->devID < 0 && wordIndex->devID < 0,
+                  "The top-k for beam search runs on CPUs only!");
+    CheckNTErrors(a->dataType == X_FLOAT && b->dataType == X_FLOAT, "TODO!");
+    CheckNTErrors(beamIndex->dataType == X_INT && wordIndex->dataType == X_INT, "Wrong data type!");
+    CheckNTErrors(a->order == b->order && a->order == beamIndex->order &&
+                  a->order == wordIndex->order, "Unmatched input tensors!");
+    CheckNTErrors(wordNum > 0 && rowSize % wordNum == 0, "Wrong segment size!");
+    CheckNTErrors(k > 0 && k <= rowSize, "A too large K");
+
+    for (int i = 0; i < a->order; i++) {
+        int size = i == last ? k : a->dimSize[i];
+        CheckNTErrors(b->dimSize[i] == size && beamIndex->dimSize[i] == size &&
+                      wordIndex->dimSize[i] == size, "Wrong size!");
+    }
+
+    TopKRowKernel kernel = TopKRowScalar;
+
+#ifdef X86_SIMD
+    SIMD_LEVEL level = GetSIMDLevel();
+    if (level >= SIMD_AVX512)
+        kernel = TopKRowAVX512;
+    else if (level >= SIMD_AVX2)
+        kernel = TopKRowAVX2;
+#endif
+
+    int rowNum = a->unitNum / rowSize;
+    const float * dataA = (const float*)a->data;
+    float * dataB = (float*)b->data;
+    int * beamData = (int*)beamIndex->data;
+    int * wordData = (int*)wordIndex->data;
+
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(rowSize, 1)), [&](int beg, int end) {
+        for (int r = beg; r < end; r++) {
+            float * value = dataB + (size_t)r * k;
+            int * beam = beamData + (size_t)r * k;
+            int * word = wordData + (size_t)r * k;
+
+            /* the offsets in the row go to "word" for the moment */
+            kernel(dataA + (size_t)r * rowSize, rowSize, k, value, word);
+
+            for (int i = 0; i < k; i++) {
+                beam[i] = word[i] / wordNum;
+                word[i] = word[i] % wordNum;
+            }
+        }
+    });
+}
 
 } // namespace nts(NiuTrans.Tensor)
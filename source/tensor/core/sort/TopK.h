@@ -32,6 +32,11 @@ void _TopK(const XTensor * a, XTensor * b, XTensor * index, int dim, int k, bool
 /* get the top-k items along a given dimension */
 void TopK(XTensor &a, XTensor &b, XTensor &index, int dim, int k, bool isSorted = false);
 
+/* get the top-k items of each row where a row is a number of segments of
+   "wordNum" items (e.g., beam \times vocabulary in beam search) */
+void _TopKBeam(const XTensor * a, XTensor * b, XTensor * beamIndex, XTensor * wordIndex,
+               int k, int wordNum);
+
 } // namespace nts(NiuTrans.Tensor)
 
 #endif // __TOPK_H__
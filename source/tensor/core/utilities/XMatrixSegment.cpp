@@ -43,9 +43,17 @@ void RunParallel2D(XPRunner * parallelRunner, void * job,
 
     int jobNum = 1;
 
-    if (parallelRunner != NULL && (parallelRunner->method == PRUNNER_SINGLE || parallelRunner->method == PRUNNER_MULTIPLE)) {
-        if (opNum >= parallelRunner->minimumOPNum * parallelRunner->threadNum)
-            jobNum = parallelRunner->GetJobNum(rowNum * colNum);
+    /* we use the global runner if no runner is specified */
+    std::shared_ptr<XPRunner> globalRunner;
+    if (parallelRunner == NULL) {
+        globalRunner = GetGlobalPRunner();
+        parallelRunner = globalRunner.get();
+    }
+
+    if (parallelRunner->method == PRUNNER_SINGLE || parallelRunner->method == PRUNNER_MULTIPLE) {
+        jobNum = parallelRunner->GetJobNum(opNum);
+        if ((double)jobNum > (double)rowNum * colNum)
+            jobNum = rowNum * colNum;
     }
 
     CheckNTErrors(jobNum != 0, "TODO!");
@@ -61,24 +69,25 @@ void RunParallel2D(XPRunner * parallelRunner, void * job,
     }
     va_end(ap);
 
-    /* prepare the neccesary argument list for parallel processing */
-    TensorList * jobs = new TensorList(jobNum);
-    TensorList * args = new TensorList(jobNum);
-
     int * indexList = new int[jobNum * 4 * 4];
 
     /* segment the matrix into blocks */
     int nblock = SegmentTensor2D(rowNum, colNum, jobNum, indexList);
 
+    /* prepare the neccesary argument list for parallel processing */
+    TensorList * jobs = new TensorList(nblock);
+    TensorList * args = new TensorList(nblock);
+
     /*
     assign jobs
     argument rules:
     1. block information
     2. other arguments
     */
-    for (int i = 0; i < jobNum; i++) {
+    for (int i = 0; i < nblock; i++) {
         IntList* indexArgs = new IntList(4);
         TensorList * blockArgs = new TensorList(argNum);
+        TensorList * jobArgs = new TensorList(2);
         int * blockIndex = indexList + i * 4;
 
         indexArgs->Add(blockIndex[0]);
@@ -89,18 +98,16 @@ void RunParallel2D(XPRunner * parallelRunner, void * job,
         for (int j = 0; j < argNum; j++)
             blockArgs->Add(jobArgList->GetItem(j));
 
-        args->Add((XTensor*)indexArgs);
-        args->Add((XTensor*)blockArgs);
+        jobArgs->Add((XTensor*)indexArgs);
+        jobArgs->Add((XTensor*)blockArgs);
 
+        args->Add((XTensor*)jobArgs);
         jobs->Add((XTensor*)job);
     }
 
-    args->count = jobNum * 2;
-    jobs->count = nblock;
-
     /* single job */
-    if (jobNum == 1)
-        ((TFunction)job)(args);
+    if (nblock == 1)
+        ((TFunction)job)((TensorList*)args->GetItem(0));
     /* multiple jobs */
     else
         parallelRunner->Run(jobs, args);
@@ -108,8 +115,10 @@ void RunParallel2D(XPRunner * parallelRunner, void * job,
     /* free the memory */
     delete[] indexList;
     for (int i = 0; i < args->count; i++) {
-        TensorList * blockArgs = (TensorList*)args->GetItem(i);
-        delete blockArgs;
+        TensorList * jobArgs = (TensorList*)args->GetItem(i);
+        delete (IntList*)jobArgs->GetItem(0);
+        delete (TensorList*)jobArgs->GetItem(1);
+        delete jobArgs;
     }
     delete args;
     delete jobs;
@@ -30,6 +30,7 @@
 #include "DropoutWithIndex.h"
 #include "HardTanH.h"
 #include "Identity.h"
+#include "LayerNorm.h"
 #include "LogSoftmax.h"
 #include "Loss.h"
 #include "Rectify.h"
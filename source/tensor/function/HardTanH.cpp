@@ -39,6 +39,8 @@ void _HardTanH(const XTensor * x, XTensor * y)
 {
     CheckNTErrors(_IsSameShaped(x, y), 
                  "The input tensor and output tensor must have the same shape!")
+    CheckNTErrors(x->IsContiguous() && y->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
 #ifdef USE_CUDA
     if(x->devID >= 0 || y->devID >= 0){
@@ -0,0 +1,263 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <math.h>
+#include "../XName.h"
+#include "../XProfiler.h"
+#include "../core/shape/IsSameShaped.h"
+#include "LayerNorm.h"
+#include "LayerNorm.cuh"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+/*
+compute the mean and 1/\sqrt{\sigma^2 + eps} of each row
+>> x - the input (rowNum * colNum)
+>> mean - the mean of each row
+>> rstd - the reciprocal of the standard deviation of each row
+>> rowNum - number of rows
+>> colNum - number of columns
+>> eps - a small number to avoid dividing by zero
+*/
+static void LayerNormStat(const DTYPE * x, DTYPE * mean, DTYPE * rstd, int rowNum, int colNum, DTYPE eps)
+{
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(colNum, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            const DTYPE * xp = x + (long long)i * colNum;
+
+            DTYPE sum = 0;
+            for (int j = 0; j < colNum; j++)
+                sum += xp[j];
+            DTYPE mu = sum / colNum;
+
+            DTYPE var = 0;
+            for (int j = 0; j < colNum; j++) {
+                DTYPE d = xp[j] - mu;
+                var += d * d;
+            }
+            var /= colNum;
+
+            mean[i] = mu;
+            rstd[i] = (DTYPE)(1.0 / sqrt(var + eps));
+        }
+    });
+}
+
+/*
+layer normalization over the last dimension
+y = (x - \mu) / \sqrt{\sigma^2 + eps} * w + b
+where \mu and \sigma^2 are the mean and the (biased) variance of x along
+the last dimension. Everything is done in one pass over each row.
+>> x - input tensor
+>> w - the scaling factor (the size of the last dimension)
+>> b - the bias (the size of the last dimension)
+>> y - output tensor
+>> eps - a small number to avoid dividing by zero
+*/
+void _LayerNorm(const XTensor * x, const XTensor * w, const XTensor * b, XTensor * y, DTYPE eps)
+{
+    XProfileOp profile(FUNC_LAYERNORM, x, w, y);
+
+    CheckNTErrors(_IsSameShaped(x, y),
+                  "The input tensor and output tensor must have the same shape!");
+    CheckNTErrors(w->unitNum == x->GetDim(-1) && b->unitNum == x->GetDim(-1),
+                  "The size of w and b must be the same as the last dimension of x!");
+    CheckNTErrors(x->dataType == DEFAULT_DTYPE && y->dataType == DEFAULT_DTYPE, "TODO!");
+    CheckNTErrors(x->devID == w->devID && x->devID == b->devID && x->devID == y->devID,
+                  "The tensors must be on the same device!");
+    CheckNTErrors(x->IsContiguous() && w->IsContiguous() && b->IsContiguous() && y->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
+
+    /* nothing to do for an empty input */
+    if (x->unitNum == 0)
+        return;
+
+#ifdef USE_CUDA
+    if (x->devID >= 0) {
+        _CudaLayerNorm(x, w, b, y, eps);
+        return;
+    }
+#endif
+
+    CheckNTErrors(x->devID < 0, "Please specify USE_CUDA and recompile the code!");
+
+    int colNum = x->GetDim(-1);
+    int rowNum = x->unitNum / colNum;
+
+    const DTYPE * xd = (DTYPE*)x->data;
+    const DTYPE * wd = (DTYPE*)w->data;
+    const DTYPE * bd = (DTYPE*)b->data;
+    DTYPE * yd = (DTYPE*)y->data;
+
+    DTYPE * mean = new DTYPE[rowNum];
+    DTYPE * rstd = new DTYPE[rowNum];
+
+    LayerNormStat(xd, mean, rstd, rowNum, colNum, eps);
+
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(colNum, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            const DTYPE * xp = xd + (long long)i * colNum;
+            DTYPE * yp = yd + (long long)i * colNum;
+            DTYPE mu = mean[i];
+            DTYPE r = rstd[i];
+            for (int j = 0; j < colNum; j++)
+                yp[j] = (xp[j] - mu) * r * wd[j] + bd[j];
+        }
+    });
+
+    delete[] mean;
+    delete[] rstd;
+}
+
+/*
+layer normalization over the last dimension (return an XTensor structure)
+make a new tensor to keep the result and return it
+>> x - input tensor
+>> w - the scaling factor
+>> b - the bias
+>> eps - a small number to avoid dividing by zero
+<< return - output tensor
+*/
+XTensor LayerNorm(const XTensor &x, const XTensor &w, const XTensor &b, DTYPE eps)
+{
+    XTensor y(&x);
+    y.SetTMPFlag();
+
+    /* call _LayerNorm function */
+    _LayerNorm(&x, &w, &b, &y, eps);
+
+    /* tensor connection */
+    if (x.enableGrad) {
+        XLink::MakeLink(&x, &w, &b, &y, FUNC_LAYERNORM);
+        XLink::AddParamToHead(&y, eps);
+    }
+
+    return y;
+}
+
+/*
+backward computation of layer normalization
+
+Let x' = (x - \mu) * r where r = 1/\sqrt{\sigma^2 + eps}, and g = dE/dy * w.
+Then
+
+    dE/dx_i = r * (g_i - mean(g) - x'_i * mean(g * x'))
+    dE/dw   = \sum_{rows} dE/dy * x'
+    dE/db   = \sum_{rows} dE/dy
+
+where mean(.) is taken over the last dimension. \mu and r are recomputed
+here so that the forward pass does not have to keep them.
+
+>> x - input of the function
+>> w - the scaling factor
+>> dedy - dE/dy
+>> dedx - dE/dx (accumulated, NULL means no need to compute it)
+>> dedw - dE/dw (accumulated, NULL means no need to compute it)
+>> dedb - dE/db (accumulated, NULL means no need to compute it)
+>> eps - a small number to avoid dividing by zero
+*/
+void _LayerNormBackward(const XTensor * x, const XTensor * w, const XTensor * dedy,
+                        XTensor * dedx, XTensor * dedw, XTensor * dedb, DTYPE eps)
+{
+    CheckNTErrors(_IsSameShaped(x, dedy), "Unmatched tensors!");
+    CheckNTErrors(dedx == NULL || _IsSameShaped(x, dedx), "Unmatched tensors!");
+    CheckNTErrors(x->dataType == DEFAULT_DTYPE, "TODO!");
+
+    /* nothing to do for an empty input */
+    if (x->unitNum == 0)
+        return;
+
+#ifdef USE_CUDA
+    if (x->devID >= 0) {
+        _CudaLayerNormBackward(x, w, dedy, dedx, dedw, dedb, eps);
+        return;
+    }
+#endif
+
+    CheckNTErrors(x->devID < 0, "Please specify USE_CUDA and recompile the code!");
+
+    int colNum = x->GetDim(-1);
+    int rowNum = x->unitNum / colNum;
+
+    const DTYPE * xd = (DTYPE*)x->data;
+    const DTYPE * wd = (DTYPE*)w->data;
+    const DTYPE * gd = (DTYPE*)dedy->data;
+
+    DTYPE * mean = new DTYPE[rowNum];
+    DTYPE * rstd = new DTYPE[rowNum];
+
+    LayerNormStat(xd, mean, rstd, rowNum, colNum, eps);
+
+    /* dE/dx (row by row) */
+    if (dedx != NULL) {
+        DTYPE * dxd = (DTYPE*)dedx->data;
+        ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(colNum, 1)), [&](int beg, int end) {
+            for (int i = beg; i < end; i++) {
+                const DTYPE * xp = xd + (long long)i * colNum;
+                const DTYPE * gp = gd + (long long)i * colNum;
+                DTYPE * dxp = dxd + (long long)i * colNum;
+                DTYPE mu = mean[i];
+                DTYPE r = rstd[i];
+
+                DTYPE sumG = 0;
+                DTYPE sumGX = 0;
+                for (int j = 0; j < colNum; j++) {
+                    DTYPE g = gp[j] * wd[j];
+                    sumG += g;
+                    sumGX += g * (xp[j] - mu) * r;
+                }
+                sumG /= colNum;
+                sumGX /= colNum;
+
+                for (int j = 0; j < colNum; j++) {
+                    DTYPE g = gp[j] * wd[j];
+                    dxp[j] += r * (g - sumG - (xp[j] - mu) * r * sumGX);
+                }
+            }
+        });
+    }
+
+    /* dE/dw and dE/db (column by column) */
+    if (dedw != NULL || dedb != NULL) {
+        DTYPE * dwd = dedw != NULL ? (DTYPE*)dedw->data : NULL;
+        DTYPE * dbd = dedb != NULL ? (DTYPE*)dedb->data : NULL;
+        ParallelFor(0, colNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(rowNum, 1)), [&](int beg, int end) {
+            for (int j = beg; j < end; j++) {
+                DTYPE sumW = 0;
+                DTYPE sumB = 0;
+                for (int i = 0; i < rowNum; i++) {
+                    DTYPE g = gd[(long long)i * colNum + j];
+                    sumW += g * (xd[(long long)i * colNum + j] - mean[i]) * rstd[i];
+                    sumB += g;
+                }
+                if (dwd != NULL)
+                    dwd[j] += sumW;
+                if (dbd != NULL)
+                    dbd[j] += sumB;
+            }
+        });
+    }
+
+    delete[] mean;
+    delete[] rstd;
+}
+
+} // namespace nts(NiuTrans.Tensor)
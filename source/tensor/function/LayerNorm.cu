@@ -0,0 +1,261 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "LayerNorm.cuh"
+#include "../XDevice.h"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+#ifdef USE_CUDA
+
+/* number of threads that work on a row */
+#define LAYERNORM_BLOCK_SIZE 256
+
+/*
+sum of a number over all threads of a block (every thread gets the result)
+>> v - the number of this thread
+>> buf - a shared buffer of LAYERNORM_BLOCK_SIZE numbers
+*/
+__device__
+DTYPE LayerNormBlockSum(DTYPE v, DTYPE * buf)
+{
+    int tid = threadIdx.x;
+    buf[tid] = v;
+    __syncthreads();
+
+    for (int s = blockDim.x / 2; s > 0; s >>= 1) {
+        if (tid < s)
+            buf[tid] += buf[tid + s];
+        __syncthreads();
+    }
+
+    DTYPE r = buf[0];
+    __syncthreads();
+
+    return r;
+}
+
+/*
+the mean and 1/\sqrt{\sigma^2 + eps} of a row (Cuda device function)
+>> xp - the row
+>> colNum - size of the row
+>> eps - a small number to avoid dividing by zero
+>> buf - a shared buffer
+>> mean - the mean
+>> rstd - the reciprocal of the standard deviation
+*/
+__device__
+void LayerNormRowStat(const DTYPE * xp, int colNum, DTYPE eps, DTYPE * buf, DTYPE &mean, DTYPE &rstd)
+{
+    DTYPE sum = 0;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x)
+        sum += xp[j];
+    mean = LayerNormBlockSum(sum, buf) / colNum;
+
+    DTYPE var = 0;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x) {
+        DTYPE d = xp[j] - mean;
+        var += d * d;
+    }
+    var = LayerNormBlockSum(var, buf) / colNum;
+
+    rstd = rsqrtf(var + eps);
+}
+
+/*
+layer normalization (Cuda kernel). Each block works on a row.
+>> x - the input
+>> w - the scaling factor
+>> b - the bias
+>> y - the output
+>> colNum - size of the last dimension
+>> eps - a small number to avoid dividing by zero
+*/
+__global__
+void KernelLayerNorm(const DTYPE * x, const DTYPE * w, const DTYPE * b, DTYPE * y, int colNum, DTYPE eps)
+{
+    __shared__ DTYPE buf[LAYERNORM_BLOCK_SIZE];
+
+    const DTYPE * xp = x + (long long)blockIdx.x * colNum;
+    DTYPE * yp = y + (long long)blockIdx.x * colNum;
+
+    DTYPE mean;
+    DTYPE rstd;
+    LayerNormRowStat(xp, colNum, eps, buf, mean, rstd);
+
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x)
+        yp[j] = (xp[j] - mean) * rstd * w[j] + b[j];
+}
+
+/*
+layer normalization over the last dimension (Cuda version)
+>> x - input tensor
+>> w - the scaling factor
+>> b - the bias
+>> y - output tensor
+>> eps - a small number to avoid dividing by zero
+*/
+void _CudaLayerNorm(const XTensor * x, const XTensor * w, const XTensor * b, XTensor * y, DTYPE eps)
+{
+    int colNum = x->GetDim(-1);
+    int rowNum = x->unitNum / colNum;
+
+    int devIDBackup;
+    ProtectCudaDev(x->devID, devIDBackup);
+
+    KernelLayerNorm<<<dim3(rowNum), dim3(LAYERNORM_BLOCK_SIZE)>>>
+                   ((DTYPE*)x->data, (DTYPE*)w->data, (DTYPE*)b->data, (DTYPE*)y->data, colNum, eps);
+
+    BacktoCudaDev(x->devID, devIDBackup);
+}
+
+/*
+dE/dx of layer normalization (Cuda kernel). Each block works on a row,
+and the mean and the standard deviation of the row are also kept for
+computing dE/dw.
+>> x - the input
+>> w - the scaling factor
+>> dedy - dE/dy
+>> dedx - dE/dx (NULL means no need to compute it)
+>> mean - the mean of each row
+>> rstd - the reciprocal of the standard deviation of each row
+>> colNum - size of the last dimension
+>> eps - a small number to avoid dividing by zero
+*/
+__global__
+void KernelLayerNormBackwardX(const DTYPE * x, const DTYPE * w, const DTYPE * dedy, DTYPE * dedx,
+                              DTYPE * mean, DTYPE * rstd, int colNum, DTYPE eps)
+{
+    __shared__ DTYPE buf[LAYERNORM_BLOCK_SIZE];
+
+    const DTYPE * xp = x + (long long)blockIdx.x * colNum;
+    const DTYPE * gp = dedy + (long long)blockIdx.x * colNum;
+
+    DTYPE mu;
+    DTYPE r;
+    LayerNormRowStat(xp, colNum, eps, buf, mu, r);
+
+    if (threadIdx.x == 0) {
+        mean[blockIdx.x] = mu;
+        rstd[blockIdx.x] = r;
+    }
+
+    if (dedx == NULL)
+        return;
+
+    DTYPE sumG = 0;
+    DTYPE sumGX = 0;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x) {
+        DTYPE g = gp[j] * w[j];
+        sumG += g;
+        sumGX += g * (xp[j] - mu) * r;
+    }
+    sumG = LayerNormBlockSum(sumG, buf) / colNum;
+    sumGX = LayerNormBlockSum(sumGX, buf) / colNum;
+
+    DTYPE * dxp = dedx + (long long)blockIdx.x * colNum;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x) {
+        DTYPE g = gp[j] * w[j];
+        dxp[j] += r * (g - sumG - (xp[j] - mu) * r * sumGX);
+    }
+}
+
+/*
+dE/dw and dE/db of layer normalization (Cuda kernel). Each thread works on a column.
+>> x - the input
+>> dedy - dE/dy
+>> dedw - dE/dw (NULL means no need to compute it)
+>> dedb - dE/db (NULL means no need to compute it)
+>> mean - the mean of each row
+>> rstd - the reciprocal of the standard deviation of each row
+>> rowNum - number of rows
+>> colNum - size of the last dimension
+*/
+__global__
+void KernelLayerNormBackwardWB(const DTYPE * x, const DTYPE * dedy, DTYPE * dedw, DTYPE * dedb,
+                               const DTYPE * mean, const DTYPE * rstd, int rowNum, int colNum)
+{
+    int j = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (j >= colNum)
+        return;
+
+    DTYPE sumW = 0;
+    DTYPE sumB = 0;
+    for (int i = 0; i < rowNum; i++) {
+        DTYPE g = dedy[(long long)i * colNum + j];
+        sumW += g * (x[(long long)i * colNum + j] - mean[i]) * rstd[i];
+        sumB += g;
+    }
+
+    if (dedw != NULL)
+        dedw[j] += sumW;
+    if (dedb != NULL)
+        dedb[j] += sumB;
+}
+
+/*
+backward computation of layer normalization (Cuda version)
+>> x - input of the function
+>> w - the scaling factor
+>> dedy - dE/dy
+>> dedx - dE/dx (accumulated, NULL means no need to compute it)
+>> dedw - dE/dw (accumulated, NULL means no need to compute it)
+>> dedb - dE/db (accumulated, NULL means no need to compute it)
+>> eps - a small number to avoid dividing by zero
+*/
+void _CudaLayerNormBackward(const XTensor * x, const XTensor * w, const XTensor * dedy,
+                            XTensor * dedx, XTensor * dedw, XTensor * dedb, DTYPE eps)
+{
+    int colNum = x->GetDim(-1);
+    int rowNum = x->unitNum / colNum;
+
+    int devIDBackup;
+    ProtectCudaDev(x->devID, devIDBackup);
+
+    XTensor * mean = NewTensorBufV2(1, &rowNum, X_FLOAT, 1.0F, x->devID, x->mem);
+    XTensor * rstd = NewTensorBufV2(1, &rowNum, X_FLOAT, 1.0F, x->devID, x->mem);
+
+    KernelLayerNormBackwardX<<<dim3(rowNum), dim3(LAYERNORM_BLOCK_SIZE)>>>
+                            ((DTYPE*)x->data, (DTYPE*)w->data, (DTYPE*)dedy->data,
+                             dedx != NULL ? (DTYPE*)dedx->data : NULL,
+                             (DTYPE*)mean->data, (DTYPE*)rstd->data, colNum, eps);
+
+    if (dedw != NULL || dedb != NULL) {
+        int gridSize[3], blockSize[3];
+        GDevs.GetCudaThread(x->devID, colNum, gridSize, blockSize);
+
+        KernelLayerNormBackwardWB<<<dim3(gridSize[0]), dim3(blockSize[0])>>>
+                                 ((DTYPE*)x->data, (DTYPE*)dedy->data,
+                                  dedw != NULL ? (DTYPE*)dedw->data : NULL,
+                                  dedb != NULL ? (DTYPE*)dedb->data : NULL,
+                                  (DTYPE*)mean->data, (DTYPE*)rstd->data, rowNum, colNum);
+    }
+
+    DelTensorBuf(rstd);
+    DelTensorBuf(mean);
+
+    BacktoCudaDev(x->devID, devIDBackup);
+}
+
+#endif // USE_CUDA
+
+} // namespace nts(NiuTrans.Tensor)
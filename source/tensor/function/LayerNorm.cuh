@@ -0,0 +1,42 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __LAYERNORM_CUH__
+#define __LAYERNORM_CUH__
+
+#include "../XTensor.h"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+#ifdef USE_CUDA
+
+/* layer normalization over the last dimension (Cuda version) */
+void _CudaLayerNorm(const XTensor * x, const XTensor * w, const XTensor * b, XTensor * y, DTYPE eps);
+
+/* de/dx, de/dw and de/db (Cuda version) */
+void _CudaLayerNormBackward(const XTensor * x, const XTensor * w, const XTensor * dedy,
+                            XTensor * dedx, XTensor * dedw, XTensor * dedb, DTYPE eps);
+
+#endif // USE_CUDA
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __LAYERNORM_CUH__
@@ -0,0 +1,47 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __LAYERNORM_H__
+#define __LAYERNORM_H__
+
+#include "../XTensor.h"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+/*
+layer normalization over the last dimension
+y = (x - \mu) / \sqrt{\sigma^2 + eps} * w + b
+*/
+void _LayerNorm(const XTensor * x, const XTensor * w, const XTensor * b, XTensor * y, DTYPE eps);
+
+/*
+layer normalization over the last dimension (return an XTensor structure)
+make a new tensor to keep the result and return it
+*/
+XTensor LayerNorm(const XTensor &x, const XTensor &w, const XTensor &b, DTYPE eps);
+
+/* de/dx, de/dw and de/db (the gradients are accumulated) */
+void _LayerNormBackward(const XTensor * x, const XTensor * w, const XTensor * dedy,
+                        XTensor * dedx, XTensor * dedw, XTensor * dedb, DTYPE eps);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __LAYERNORM_H__
@@ -22,7 +22,9 @@
 #include <math.h>
 #include "LogSoftmax.h"
 #include "LogSoftmax.cuh"
+#include "SoftmaxNative.h"
 #include "../XName.h"
+#include "../XProfiler.h"
 #include "../XUtility.h"
 #include "../core/reduce/ReduceSum.h"
 #include "../core/reduce/ReduceMax.h"
@@ -39,17 +41,35 @@ log scale softmax y = log(e^x / \sum_{i} e^{x_i})
 */
 void _LogSoftmax(const XTensor * x, XTensor * y, int leadDim)
 {
+    XProfileOp profile(FUNC_LOGSOFTMAX, x, NULL, y);
+
     CheckNTErrors(!x->isSparse && !y->isSparse, "TODO!");
     CheckNTErrors(x && y, "Empty input tensors!");
+    CheckNTErrors(x->IsContiguous() && y->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
     if(leadDim < 0)
         leadDim = x->order - 1;
 
+    /* nothing to do for an empty input (and we would divide by zero below) */
+    if(x->unitNum == 0)
+        return;
+
     if(y->dimSize[leadDim] == 1){
         y->SetZeroAll();
         return;
     }
 
+#ifndef DOUBELPRICSION
+    /* the fused kernel for the last dimension on CPUs */
+    if (x->devID < 0 && y->devID < 0 && leadDim == x->order - 1 &&
+        x->dataType == X_FLOAT && y->dataType == X_FLOAT) {
+        int n = x->dimSize[leadDim];
+        NativeSoftmax((float*)x->data, (float*)y->data, x->unitNum / n, n, true);
+        return;
+    }
+#endif
+
     if (!x->isSparse && !y->isSparse &&
         x->dataType == DEFAULT_DTYPE && y->dataType == DEFAULT_DTYPE)
     {
@@ -102,53 +122,63 @@ void _LogSoftmax(const XTensor * x, XTensor * y, int leadDim)
             }
         }
 
-        for (int k = 0; k < blockNum; k++) {
-            int m = stride;
-            int n = dimensionSize;
+        /* the blocks are independent and we split them among the threads */
+        if (x->devID < 0) {
+            ParallelFor(0, blockNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(blockSize, 1)), [&](int beg, int end) {
+                for (int k = beg; k < end; k++) {
+                    int m = stride;
+                    int n = dimensionSize;
+
+                    DTYPE * ip = (DTYPE*)x->data + k * blockSize;
+                    DTYPE * op = (DTYPE*)y->data + k * blockSize;
+                    DTYPE * mp = (DTYPE*)max->data + k * blockSize / dimensionSize;
+                    DTYPE * sp = (DTYPE*)sum->data + k * blockSize / dimensionSize;
+
+                    for (int j = 0; j < m; j++) {
+                        DTYPE sumValue = sp[j];
+                        if (sumValue == 0) {
+                            for (int i = 0; i < n; i++)
+                                op[i * m + j] = 0;
+                        }
+                        else {
+                            for (int i = 0; i < n; i++) {
+                                DTYPE r = (DTYPE)log(exp(ip[i * m + j] - mp[j]) / sp[j]);
+                                if (IsNAN(r))
+                                    r = LOGPROB_MIN;
+                                if (IsINF(r))
+                                    r = LOGPROB_MIN;
+
+                                op[i * m + j] = MAX(r, LOGPROB_MIN);
+                            }
+                        }
+                    }
+                }
+            });
+        }
 
+        /* on GPUs we run the blocks one by one */
+        for (int k = 0; k < blockNum && x->devID >= 0; k++) {
             DTYPE * ip = (DTYPE*)x->data + k * blockSize;
             DTYPE * op = (DTYPE*)y->data + k * blockSize;
             DTYPE * mp = (DTYPE*)max->data + k * blockSize / dimensionSize;
             DTYPE * sp = (DTYPE*)sum->data + k * blockSize / dimensionSize;
 
-            if (x->devID < 0) {
-                for (int j = 0; j < m; j++) {
-                    DTYPE sumValue = sp[j];
-                    if (sumValue == 0) {
-                        for (int i = 0; i < n; i++)
-                            op[i * m + j] = 0;
-                    }
-                    else {
-                        for (int i = 0; i < n; i++) {
-                            DTYPE r = (DTYPE)log(exp(ip[i * m + j] - mp[j]) / sp[j]);
-                            if (IsNAN(r))
-                                r = LOGPROB_MIN;
-                            if (IsINF(r))
-                                r = LOGPROB_MIN;
-
-                            op[i * m + j] = MAX(r, LOGPROB_MIN);
-                        }
-                    }
-                }
-            }
-            else {
-                blockx->data = ip;
-                blocky->data = op;
-                blockMax->data = mp;
-                blockSum->data = sp;
+            blockx->data = ip;
+            blocky->data = op;
+            blockMax->data = mp;
+            blockSum->data = sp;
 #ifdef USE_CUDA
-                if(leadDim == x->order - 1)
-                    _CudaLogSoftmaxSumMax(blockx, blocky, 1, blockSum, blockMax);
-                else
-                    _CudaLogSoftmaxSumMax(blockx, blocky, leadDim, blockSum, blockMax);
+            if(leadDim == x->order - 1)
+                _CudaLogSoftmaxSumMax(blockx, blocky, 1, blockSum, blockMax);
+            else
+                _CudaLogSoftmaxSumMax(blockx, blocky, leadDim, blockSum, blockMax);
 #else
-                ShowNTErrors("Please specify USE_CUDA and recompile the code!");
+            ShowNTErrors("Please specify USE_CUDA and recompile the code!");
 #endif
-                blockx->data = NULL;
-                blocky->data = NULL;
-                blockMax->data = NULL;
-                blockSum->data = NULL;
-            }
+            blockx->data = NULL;
+            blocky->data = NULL;
+            blockMax->data = NULL;
+            blockSum->data = NULL;
         }
 
         DelTensorBuf(max);
@@ -298,6 +328,9 @@ void _LogSoftmaxBackward(XTensor * gold, XTensor * y, XTensor * x,
     if(leadDim < 0)
         leadDim = y->order - 1;
 
+    if(y->unitNum == 0)
+        return;
+
 #ifdef USE_CUDA
     if (gold->devID >= 0) {
         _CudaLogSoftmaxBackward(gold, y, x, dedy, dedx, padding, leadDim, lossName);
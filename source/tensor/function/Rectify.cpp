@@ -20,6 +20,7 @@
  */
 
 #include "../XName.h"
+#include "../XProfiler.h"
 #include "../core/shape/IsSameShaped.h"
 #include "Rectify.h"
 #include "Rectify.cuh"
@@ -33,8 +34,12 @@ rectify function y = max(0, x)
 */
 void _Rectify(const XTensor * x, XTensor * y)
 {
+    XProfileOp profile(FUNC_RECTIFY, x, NULL, y);
+
     CheckNTErrors(_IsSameShaped(x, y), 
                  "The input tensor and output tensor must have the same shape!")
+    CheckNTErrors(x->IsContiguous() && y->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
 #ifdef USE_CUDA
     if(x->devID >= 0 || y->devID >= 0){
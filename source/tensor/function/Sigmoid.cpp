@@ -20,6 +20,7 @@
  */
 
 #include "../XName.h"
+#include "../XProfiler.h"
 #include "../core/shape/IsSameShaped.h"
 #include <math.h>
 #include "Sigmoid.h"
@@ -35,8 +36,12 @@ sigmoid function y = 1/(1+exp(-x))
 */
 void _Sigmoid(const XTensor * x, XTensor * y)
 {
+    XProfileOp profile(FUNC_SIGMOID, x, NULL, y);
+
     CheckNTErrors(_IsSameShaped(x, y), 
                  "The input tensor and output tensor must have the same shape!")
+    CheckNTErrors(x->IsContiguous() && y->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
 
 #ifdef USE_CUDA
     if(x->devID >= 0 || y->devID >= 0){
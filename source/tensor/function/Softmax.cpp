@@ -22,7 +22,9 @@
 #include <math.h>
 #include "Softmax.h"
 #include "Softmax.cuh"
+#include "SoftmaxNative.h"
 #include "../XName.h"
+#include "../XProfiler.h"
 #include "../XUtility.h"
 #include "../core/reduce/ReduceSum.h"
 #include "../core/reduce/ReduceMax.h"
@@ -38,9 +40,28 @@ softmax y = e^x / \sum_{i} e^{x_i}
 */
 void _Softmax(const XTensor * x, XTensor * y, int leadDim)
 {
+    XProfileOp profile(FUNC_SOFTMAX, x, NULL, y);
+
+    CheckNTErrors(x->IsContiguous() && y->IsContiguous(),
+                  "Strided views are not supported. Call Contiguous() first!");
+
     if(leadDim < 0)
         leadDim = x->order - 1;
 
+    /* nothing to do for an empty input (and we would divide by zero below) */
+    if(x->unitNum == 0)
+        return;
+
+#ifndef DOUBELPRICSION
+    /* the fused kernel for the last dimension on CPUs */
+    if(x->devID < 0 && y->devID < 0 && leadDim == x->order - 1 &&
+       !x->isSparse && !y->isSparse && x->dataType == X_FLOAT && y->dataType == X_FLOAT){
+        int n = x->dimSize[leadDim];
+        NativeSoftmax((float*)x->data, (float*)y->data, x->unitNum / n, n, false);
+        return;
+    }
+#endif
+
     if(!x->isSparse && !y->isSparse && x->dataType == y->dataType){
         int * dimSize = new int[x->order - 1];
         for(int i = 0; i < x->order; i++){
@@ -80,35 +101,37 @@ void _Softmax(const XTensor * x, XTensor * y, int leadDim)
             blockSize = stride * dimensionSize;
             blockNum = y->unitNum / blockSize;
 
-            for(int k = 0; k < blockNum; k++){
-                int m = stride;
-                int n = dimensionSize;
-                int blockOffset = k * blockSize;
-                int blockOffsetMax = k * blockSize / dimensionSize;
-
-                DTYPE * ip = (DTYPE*)x->data + blockOffset;
-                DTYPE * op = (DTYPE*)y->data + blockOffset;
-                DTYPE * mp = (DTYPE*)max->data + blockOffsetMax;
-                DTYPE * sp = (DTYPE*)sum->data + blockOffsetMax;
-
-                for(int j = 0; j < m; j++){
-                    DTYPE sumValue = sp[j];
-                    if(sumValue == 0){
-                        for(int i = 0; i < n; i++)
-                            op[i * m + j] = 0;
-                    }
-                    else{
-                        for(int i = 0; i < n; i++){
-                            DTYPE r = (DTYPE)exp(ip[i * m + j] - mp[j])/sp[j];
-                            if (r > (DTYPE)1.0F)
-                                r = (DTYPE)1.0F;
-                            else if (r < 0)
-                                r = 0;
-                            op[i * m + j] = r;
+            ParallelFor(0, blockNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(blockSize, 1)), [&](int beg, int end) {
+                for (int k = beg; k < end; k++) {
+                    int m = stride;
+                    int n = dimensionSize;
+                    int blockOffset = k * blockSize;
+                    int blockOffsetMax = k * blockSize / dimensionSize;
+
+                    DTYPE * ip = (DTYPE*)x->data + blockOffset;
+                    DTYPE * op = (DTYPE*)y->data + blockOffset;
+                    DTYPE * mp = (DTYPE*)max->data + blockOffsetMax;
+                    DTYPE * sp = (DTYPE*)sum->data + blockOffsetMax;
+
+                    for(int j = 0; j < m; j++){
+                        DTYPE sumValue = sp[j];
+                        if(sumValue == 0){
+                            for(int i = 0; i < n; i++)
+                                op[i * m + j] = 0;
+                        }
+                        else{
+                            for(int i = 0; i < n; i++){
+                                DTYPE r = (DTYPE)exp(ip[i * m + j] - mp[j])/sp[j];
+                                if (r > (DTYPE)1.0F)
+                                    r = (DTYPE)1.0F;
+                                else if (r < 0)
+                                    r = 0;
+                                op[i * m + j] = r;
+                            }
                         }
                     }
                 }
-            }
+            });
         }
 
         DelTensorBuf(sum);
@@ -206,6 +229,9 @@ void _SoftmaxBackward(XTensor * gold, XTensor * y, XTensor * x,
     if(leadDim < 0)
         leadDim = y->order - 1;
 
+    if(y->unitNum == 0)
+        return;
+
 #ifdef USE_CUDA
     if(y->devID >= 0){
         _CudaSoftmaxBackward(gold, y, x, dedy, dedx, padding, leadDim, lossName);
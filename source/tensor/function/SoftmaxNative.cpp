@@ -0,0 +1,252 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ * Fused softmax kernels for the last dimension. For each row we keep a
+ * running max m and a running sum s = \sum_{i} e^{x_i - m}. When m grows,
+ * s is rescaled by e^{m_old - m_new}. So the max and the sum come from a
+ * single sweep, and the output comes from a second sweep. exp() is
+ * approximated by a polynomial (Cephes) in the vectorized kernels.
+ */
+
+#include <math.h>
+#include <float.h>
+#include "../XTensor.h"
+#include "../XSIMDMath.h"
+#include "../XUtility.h"
+#include "SoftmaxNative.h"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+/* the kernel for a row */
+typedef void (*SoftmaxKernel)(const float * x, float * y, int n, bool isLog);
+
+/*
+update the running max and sum with the remaining elements of a row
+>> x - the elements
+>> n - number of the elements
+>> m - the running max
+>> s - the running sum
+*/
+static void OnlineSoftmaxStat(const float * x, int n, float &m, float &s)
+{
+    for (int i = 0; i < n; i++) {
+        float v = x[i];
+        if (v > m) {
+            s = s * expf(m - v) + 1.0F;
+            m = v;
+        }
+        else
+            s += expf(v - m);
+    }
+}
+
+/*
+generate the output with the max and the sum of the row
+>> x - the input
+>> y - the output
+>> n - number of the elements
+>> m - max of the row
+>> s - sum of the row
+>> isLog - indicates whether we generate log-probabilities
+*/
+static void SoftmaxOutput(const float * x, float * y, int n, float m, float s, bool isLog)
+{
+    if (isLog) {
+        float c = m + logf(s);
+        for (int i = 0; i < n; i++) {
+            float r = x[i] - c;
+            if (IsNAN(r) || IsINF(r))
+                r = LOGPROB_MIN;
+            y[i] = MAX(r, LOGPROB_MIN);
+        }
+    }
+    else {
+        float inv = 1.0F / s;
+        for (int i = 0; i < n; i++) {
+            float r = expf(x[i] - m) * inv;
+            y[i] = MIN(MAX(r, 0.0F), 1.0F);
+        }
+    }
+}
+
+/* plain C++ kernel */
+static void SoftmaxKernelScalar(const float * x, float * y, int n, bool isLog)
+{
+    float m = -FLT_MAX;
+    float s = 0;
+
+    OnlineSoftmaxStat(x, n, m, s);
+    SoftmaxOutput(x, y, n, m, s, isLog);
+}
+
+#ifdef X86_SIMD
+
+/*
+AVX2 kernel. Each lane keeps its own max and sum. We take 32 numbers at a
+time so that the sum is rescaled once for every 4 vectors.
+*/
+TARGET_AVX2
+static void SoftmaxKernelAVX2(const float * x, float * y, int n, bool isLog)
+{
+    __m256 vm = _mm256_set1_ps(-FLT_MAX);
+    __m256 vs = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256 v0 = _mm256_loadu_ps(x + i);
+        __m256 v1 = _mm256_loadu_ps(x + i + 8);
+        __m256 v2 = _mm256_loadu_ps(x + i + 16);
+        __m256 v3 = _mm256_loadu_ps(x + i + 24);
+        __m256 nm = _mm256_max_ps(_mm256_max_ps(v0, v1), _mm256_max_ps(v2, v3));
+        nm = _mm256_max_ps(nm, vm);
+
+        vs = _mm256_mul_ps(vs, ExpAVX2(_mm256_sub_ps(vm, nm)));
+        vs = _mm256_add_ps(vs, ExpAVX2(_mm256_sub_ps(v0, nm)));
+        vs = _mm256_add_ps(vs, ExpAVX2(_mm256_sub_ps(v1, nm)));
+        vs = _mm256_add_ps(vs, ExpAVX2(_mm256_sub_ps(v2, nm)));
+        vs = _mm256_add_ps(vs, ExpAVX2(_mm256_sub_ps(v3, nm)));
+        vm = nm;
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(x + i);
+        __m256 nm = _mm256_max_ps(vm, v);
+        vs = _mm256_mul_ps(vs, ExpAVX2(_mm256_sub_ps(vm, nm)));
+        vs = _mm256_add_ps(vs, ExpAVX2(_mm256_sub_ps(v, nm)));
+        vm = nm;
+    }
+
+    /* merge the lanes */
+    float m = HorizontalMaxAVX2(vm);
+    float s = HorizontalSumAVX2(_mm256_mul_ps(vs, ExpAVX2(_mm256_sub_ps(vm, _mm256_set1_ps(m)))));
+
+    OnlineSoftmaxStat(x + i, n - i, m, s);
+
+    /* the output */
+    int j = 0;
+    if (isLog) {
+        __m256 c = _mm256_set1_ps(m + logf(s));
+        __m256 minv = _mm256_set1_ps(LOGPROB_MIN);
+        for (; j + 8 <= n; j += 8) {
+            /* NaN goes to LOGPROB_MIN because vmaxps returns the second operand */
+            __m256 r = _mm256_sub_ps(_mm256_loadu_ps(x + j), c);
+            _mm256_storeu_ps(y + j, _mm256_max_ps(r, minv));
+        }
+    }
+    else {
+        __m256 vmax = _mm256_set1_ps(m);
+        __m256 inv = _mm256_set1_ps(1.0F / s);
+        __m256 one = _mm256_set1_ps(1.0F);
+        for (; j + 8 <= n; j += 8) {
+            __m256 r = _mm256_mul_ps(ExpAVX2(_mm256_sub_ps(_mm256_loadu_ps(x + j), vmax)), inv);
+            _mm256_storeu_ps(y + j, _mm256_min_ps(r, one));
+        }
+    }
+
+    SoftmaxOutput(x + j, y + j, n - j, m, s, isLog);
+}
+
+/* AVX-512 kernel (see SoftmaxKernelAVX2) */
+TARGET_AVX512
+static void SoftmaxKernelAVX512(const float * x, float * y, int n, bool isLog)
+{
+    __m512 vm = _mm512_set1_ps(-FLT_MAX);
+    __m512 vs = _mm512_setzero_ps();
+
+    int i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512 v0 = _mm512_loadu_ps(x + i);
+        __m512 v1 = _mm512_loadu_ps(x + i + 16);
+        __m512 v2 = _mm512_loadu_ps(x + i + 32);
+        __m512 v3 = _mm512_loadu_ps(x + i + 48);
+        __m512 nm = _mm512_max_ps(_mm512_max_ps(v0, v1), _mm512_max_ps(v2, v3));
+        nm = _mm512_max_ps(nm, vm);
+
+        vs = _mm512_mul_ps(vs, ExpAVX512(_mm512_sub_ps(vm, nm)));
+        vs = _mm512_add_ps(vs, ExpAVX512(_mm512_sub_ps(v0, nm)));
+        vs = _mm512_add_ps(vs, ExpAVX512(_mm512_sub_ps(v1, nm)));
+        vs = _mm512_add_ps(vs, ExpAVX512(_mm512_sub_ps(v2, nm)));
+        vs = _mm512_add_ps(vs, ExpAVX512(_mm512_sub_ps(v3, nm)));
+        vm = nm;
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(x + i);
+        __m512 nm = _mm512_max_ps(vm, v);
+        vs = _mm512_mul_ps(vs, ExpAVX512(_mm512_sub_ps(vm, nm)));
+        vs = _mm512_add_ps(vs, ExpAVX512(_mm512_sub_ps(v, nm)));
+        vm = nm;
+    }
+
+    /* merge the lanes */
+    float m = _mm512_reduce_max_ps(vm);
+    float s = _mm512_reduce_add_ps(_mm512_mul_ps(vs, ExpAVX512(_mm512_sub_ps(vm, _mm512_set1_ps(m)))));
+
+    OnlineSoftmaxStat(x + i, n - i, m, s);
+
+    /* the output */
+    int j = 0;
+    if (isLog) {
+        __m512 c = _mm512_set1_ps(m + logf(s));
+        __m512 minv = _mm512_set1_ps(LOGPROB_MIN);
+        for (; j + 16 <= n; j += 16) {
+            __m512 r = _mm512_sub_ps(_mm512_loadu_ps(x + j), c);
+            _mm512_storeu_ps(y + j, _mm512_max_ps(r, minv));
+        }
+    }
+    else {
+        __m512 vmax = _mm512_set1_ps(m);
+        __m512 inv = _mm512_set1_ps(1.0F / s);
+        __m512 one = _mm512_set1_ps(1.0F);
+        for (; j + 16 <= n; j += 16) {
+            __m512 r = _mm512_mul_ps(ExpAVX512(_mm512_sub_ps(_mm512_loadu_ps(x + j), vmax)), inv);
+            _mm512_storeu_ps(y + j, _mm512_min_ps(r, one));
+        }
+    }
+
+    SoftmaxOutput(x + j, y + j, n - j, m, s, isLog);
+}
+
+#endif
+
+/*
+softmax (or log-softmax) over each row of a row-major matrix on CPUs
+>> x - the input matrix
+>> y - the output matrix (it can be the same as x)
+>> rowNum - number of rows
+>> colNum - number of columns
+>> isLog - indicates whether we generate log-probabilities
+*/
+void NativeSoftmax(const float * x, float * y, int rowNum, int colNum, bool isLog)
+{
+    SoftmaxKernel kernel = SoftmaxKernelScalar;
+
+#ifdef X86_SIMD
+    SIMD_LEVEL level = GetSIMDLevel();
+    if (level >= SIMD_AVX512)
+        kernel = SoftmaxKernelAVX512;
+    else if (level >= SIMD_AVX2)
+        kernel = SoftmaxKernelAVX2;
+#endif
+
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(colNum, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++)
+            kernel(x + (long long)i * colNum, y + (long long)i * colNum, colNum, isLog);
+    });
+}
+
+} // namespace nts(NiuTrans.Tensor)
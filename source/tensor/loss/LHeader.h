@@ -25,5 +25,6 @@
 #define __LHEADER_H__
 
 #include "CrossEntropy.h"
+#include "SoftmaxCrossEntropy.h"
 
 #endif // __LHEADER_H__
\ No newline at end of file
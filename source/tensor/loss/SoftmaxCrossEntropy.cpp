@@ -0,0 +1,245 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University. 
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ * Softmax and cross entropy in one operation. The gold standard is given
+ * by label indices, so neither the one-hot (or label-smoothed) distribution
+ * nor the output of softmax is ever stored. For a row x with the gold label
+ * y and the target distribution t, we have
+ *
+ *   loss   = c * T - \sum_{k} t_k * x_k,  where c = max + log(\sum_{k} e^{x_k - max})
+ *   dE/dx  = T * softmax(x) - t
+ *
+ * where T = \sum_{k} t_k, t_y = 1 - smoothing and t_k = smoothing / V (k != y).
+ */
+
+#include <math.h>
+#include <float.h>
+#include "../XName.h"
+#include "../XTensor.h"
+#include "SoftmaxCrossEntropy.h"
+#include "SoftmaxCrossEntropy.cuh"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+/*
+the max and the log of the sum of e^{x - max} of a row
+>> x - the row
+>> n - size of the row
+>> m - the max
+<< return - m + log(\sum_{k} e^{x_k - m})
+*/
+static float LogSumExpRow(const float * x, int n, float &m)
+{
+    m = -FLT_MAX;
+    for (int k = 0; k < n; k++)
+        m = x[k] > m ? x[k] : m;
+
+    float s = 0;
+    for (int k = 0; k < n; k++)
+        s += expf(x[k] - m);
+
+    return m + logf(s);
+}
+
+/* check the arguments */
+static void CheckSoftmaxCrossEntropyArgs(const XTensor * x, const XTensor * label, const XTensor * padding)
+{
+    CheckNTErrors(x->dataType == X_FLOAT, "TODO!");
+    CheckNTErrors(label->dataType == X_INT, "The labels must be in X_INT!");
+    CheckNTErrors(x->order == label->order + 1, "Unmatched tensors!");
+    for (int i = 0; i < label->order; i++)
+        CheckNTErrors(x->GetDim(i) == label->GetDim(i), "Unmatched tensors!");
+    CheckNTErrors(padding == NULL || padding->unitNum == label->unitNum, "Wrong padding tensor!");
+    CheckNTErrors(padding == NULL || padding->dataType == X_FLOAT, "TODO!");
+}
+
+/*
+softmax + cross entropy with the (label-smoothed) gold standard given by
+indices. The softmax is over the last dimension of x.
+loss = -\sum_{k} t_k * log(softmax(x)_k) * padding
+>> x - the input (scores before the softmax)
+>> label - index of the gold label at each position
+>> padding - padding of the positions (NULL means no padding)
+>> loss - the loss at each position
+>> smoothing - the factor of label smoothing
+*/
+void _SoftmaxCrossEntropyWithIndex(const XTensor * x, const XTensor * label,
+                                   const XTensor * padding, XTensor * loss,
+                                   DTYPE smoothing)
+{
+    CheckSoftmaxCrossEntropyArgs(x, label, padding);
+    CheckNTErrors(loss->unitNum == label->unitNum, "Wrong loss tensor!");
+
+#ifdef USE_CUDA
+    if (x->devID >= 0) {
+        _CudaSoftmaxCrossEntropyWithIndex(x, label, padding, loss, smoothing);
+        return;
+    }
+#endif
+
+    int colNum = x->GetDim(-1);
+    int rowNum = label->unitNum;
+    float low = smoothing / colNum;
+    float high = 1.0F - smoothing;
+    float total = high + low * (colNum - 1);
+
+    const float * xd = (const float*)x->data;
+    const int * ld = (const int*)label->data;
+    const float * pd = padding != NULL ? (const float*)padding->data : NULL;
+    float * lossd = (float*)loss->data;
+
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(colNum, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            float p = pd != NULL ? pd[i] : 1.0F;
+            if (p == 0) {
+                lossd[i] = 0;
+                continue;
+            }
+
+            const float * xp = xd + (long long)i * colNum;
+            int y = ld[i];
+            CheckNTErrors(y >= 0 && y < colNum, "Illegal label!");
+
+            float m;
+            float c = LogSumExpRow(xp, colNum, m);
+
+            float sum = 0;
+            if (low != 0) {
+                for (int k = 0; k < colNum; k++)
+                    sum += xp[k];
+            }
+
+            float tx = (high - low) * xp[y] + low * sum;
+            lossd[i] = (c * total - tx) * p;
+        }
+    });
+}
+
+/*
+softmax + cross entropy with index labels (return an XTensor structure)
+make a new tensor to keep the result and return it
+>> x - the input (scores before the softmax)
+>> label - index of the gold label at each position
+>> smoothing - the factor of label smoothing
+<< return - the loss at each position
+*/
+XTensor SoftmaxCrossEntropyWithIndex(const XTensor & x, const XTensor & label,
+                                     DTYPE smoothing)
+{
+    XTensor loss(label.order, label.dimSize, x.dataType, 1.0F, x.devID, x.mem);
+    loss.SetTMPFlag();
+
+    /* call _SoftmaxCrossEntropyWithIndex function */
+    _SoftmaxCrossEntropyWithIndex(&x, &label, NULL, &loss, smoothing);
+
+    /* tensor connection */
+    if (x.enableGrad) {
+        XLink::MakeLink(&x, &label, &loss, LOSS_SOFTMAXCROSSENTROPY);
+        XLink::AddParamToHead(&loss, smoothing);
+    }
+
+    return loss;
+}
+
+/*
+softmax + cross entropy with index labels and padding (return an XTensor structure)
+make a new tensor to keep the result and return it
+>> x - the input (scores before the softmax)
+>> label - index of the gold label at each position
+>> padding - padding of the positions
+>> smoothing - the factor of label smoothing
+<< return - the loss at each position
+*/
+XTensor SoftmaxCrossEntropyWithIndex(const XTensor & x, const XTensor & label,
+                                     const XTensor & padding, DTYPE smoothing)
+{
+    XTensor loss(label.order, label.dimSize, x.dataType, 1.0F, x.devID, x.mem);
+    loss.SetTMPFlag();
+
+    /* call _SoftmaxCrossEntropyWithIndex function */
+    _SoftmaxCrossEntropyWithIndex(&x, &label, &padding, &loss, smoothing);
+
+    /* tensor connection */
+    if (x.enableGrad) {
+        XLink::MakeLink(&x, &label, &padding, &loss, LOSS_SOFTMAXCROSSENTROPY);
+        XLink::AddParamToHead(&loss, smoothing);
+    }
+
+    return loss;
+}
+
+/*
+backward computation of softmax + cross entropy. We assume dE/dloss = 1 for
+every position (as in _CrossEntropyBackward) and add
+dE/dx = (T * softmax(x) - t) * padding
+to dedx. No temporary tensor is used.
+>> x - the input (scores before the softmax)
+>> label - index of the gold label at each position
+>> padding - padding of the positions (NULL means no padding)
+>> dedx - dE/dx
+>> smoothing - the factor of label smoothing
+*/
+void _SoftmaxCrossEntropyWithIndexBackward(const XTensor * x, const XTensor * label,
+                                           const XTensor * padding, XTensor * dedx,
+                                           DTYPE smoothing)
+{
+    CheckSoftmaxCrossEntropyArgs(x, label, padding);
+    CheckNTErrors(dedx->unitNum == x->unitNum && dedx->dataType == x->dataType,
+                  "Wrong gradient tensor!");
+
+#ifdef USE_CUDA
+    if (x->devID >= 0) {
+        _CudaSoftmaxCrossEntropyWithIndexBackward(x, label, padding, dedx, smoothing);
+        return;
+    }
+#endif
+
+    int colNum = x->GetDim(-1);
+    int rowNum = label->unitNum;
+    float low = smoothing / colNum;
+    float high = 1.0F - smoothing;
+    float total = high + low * (colNum - 1);
+
+    const float * xd = (const float*)x->data;
+    const int * ld = (const int*)label->data;
+    const float * pd = padding != NULL ? (const float*)padding->data : NULL;
+    float * gd = (float*)dedx->data;
+
+    ParallelFor(0, rowNum, MAX(1, PFOR_ELEMENT_GRAIN / MAX(colNum, 1)), [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            float p = pd != NULL ? pd[i] : 1.0F;
+            if (p == 0)
+                continue;
+
+            const float * xp = xd + (long long)i * colNum;
+            float * gp = gd + (long long)i * colNum;
+            int y = ld[i];
+
+            float m;
+            float c = LogSumExpRow(xp, colNum, m);
+            float scale = total * p;
+
+            for (int k = 0; k < colNum; k++)
+                gp[k] += scale * expf(xp[k] - c) - low * p;
+            gp[y] -= (high - low) * p;
+        }
+    });
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,205 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University. 
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "../XDevice.h"
+#include "SoftmaxCrossEntropy.cuh"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+#ifdef USE_CUDA
+
+/* number of threads that work on a row */
+#define SOFTMAXCE_BLOCK_SIZE 256
+
+/*
+max (or sum) of a number over all threads of a block (every thread gets the result)
+>> v - the number of this thread
+>> buf - a shared buffer of SOFTMAXCE_BLOCK_SIZE numbers
+>> isMax - indicates whether we compute the max (or the sum)
+*/
+__device__
+DTYPE SoftmaxCEBlockReduce(DTYPE v, DTYPE * buf, bool isMax)
+{
+    int tid = threadIdx.x;
+    buf[tid] = v;
+    __syncthreads();
+
+    for (int s = blockDim.x / 2; s > 0; s >>= 1) {
+        if (tid < s)
+            buf[tid] = isMax ? max(buf[tid], buf[tid + s]) : buf[tid] + buf[tid + s];
+        __syncthreads();
+    }
+
+    DTYPE r = buf[0];
+    __syncthreads();
+
+    return r;
+}
+
+/*
+m + log(\sum_{k} e^{x_k - m}) of a row where m is the max (Cuda device function)
+>> xp - the row
+>> colNum - size of the row
+>> buf - a shared buffer
+*/
+__device__
+DTYPE SoftmaxCELogSumExp(const DTYPE * xp, int colNum, DTYPE * buf)
+{
+    DTYPE m = -3.402823466e+38F;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x)
+        m = max(m, xp[j]);
+    m = SoftmaxCEBlockReduce(m, buf, true);
+
+    DTYPE s = 0;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x)
+        s += exp(xp[j] - m);
+    s = SoftmaxCEBlockReduce(s, buf, false);
+
+    return m + log(s);
+}
+
+/*
+softmax + cross entropy with index labels (Cuda kernel). Each block works on a row.
+>> x - the input
+>> label - the gold labels
+>> padding - the padding (NULL means no padding)
+>> loss - the loss
+>> colNum - size of the last dimension
+>> low - the target probability of the labels that are not gold
+>> high - the target probability of the gold label
+>> total - sum of the target distribution
+*/
+__global__
+void KernelSoftmaxCrossEntropyWithIndex(const DTYPE * x, const int * label, const DTYPE * padding,
+                                        DTYPE * loss, int colNum, DTYPE low, DTYPE high, DTYPE total)
+{
+    __shared__ DTYPE buf[SOFTMAXCE_BLOCK_SIZE];
+
+    int i = blockIdx.x;
+    DTYPE p = padding != NULL ? padding[i] : 1.0F;
+
+    if (p == 0) {
+        if (threadIdx.x == 0)
+            loss[i] = 0;
+        return;
+    }
+
+    const DTYPE * xp = x + (long long)i * colNum;
+    DTYPE c = SoftmaxCELogSumExp(xp, colNum, buf);
+
+    DTYPE sum = 0;
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x)
+        sum += xp[j];
+    sum = SoftmaxCEBlockReduce(sum, buf, false);
+
+    if (threadIdx.x == 0)
+        loss[i] = (c * total - (high - low) * xp[label[i]] - low * sum) * p;
+}
+
+/*
+backward computation of softmax + cross entropy (Cuda kernel). Each block works on a row.
+>> x - the input
+>> label - the gold labels
+>> padding - the padding (NULL means no padding)
+>> dedx - dE/dx (accumulated)
+>> colNum - size of the last dimension
+>> low - the target probability of the labels that are not gold
+>> high - the target probability of the gold label
+>> total - sum of the target distribution
+*/
+__global__
+void KernelSoftmaxCrossEntropyWithIndexBackward(const DTYPE * x, const int * label, const DTYPE * padding,
+                                                DTYPE * dedx, int colNum, DTYPE low, DTYPE high, DTYPE total)
+{
+    __shared__ DTYPE buf[SOFTMAXCE_BLOCK_SIZE];
+
+    int i = blockIdx.x;
+    DTYPE p = padding != NULL ? padding[i] : 1.0F;
+
+    if (p == 0)
+        return;
+
+    const DTYPE * xp = x + (long long)i * colNum;
+    DTYPE * gp = dedx + (long long)i * colNum;
+    DTYPE c = SoftmaxCELogSumExp(xp, colNum, buf);
+    int y = label[i];
+
+    for (int j = threadIdx.x; j < colNum; j += blockDim.x)
+        gp[j] += (total * exp(xp[j] - c) - (j == y ? high : low)) * p;
+}
+
+/*
+softmax + cross entropy with index labels (Cuda version)
+>> x - the input (scores before the softmax)
+>> label - index of the gold label at each position
+>> padding - padding of the positions (NULL means no padding)
+>> loss - the loss at each position
+>> smoothing - the factor of label smoothing
+*/
+void _CudaSoftmaxCrossEntropyWithIndex(const XTensor * x, const XTensor * label,
+                                       const XTensor * padding, XTensor * loss,
+                                       DTYPE smoothing)
+{
+    int colNum = x->GetDim(-1);
+    int rowNum = label->unitNum;
+    DTYPE low = smoothing / colNum;
+    DTYPE high = 1.0F - smoothing;
+
+    int devIDBackup;
+    ProtectCudaDev(x->devID, devIDBackup);
+
+    KernelSoftmaxCrossEntropyWithIndex<<<dim3(rowNum), dim3(SOFTMAXCE_BLOCK_SIZE)>>>
+        ((DTYPE*)x->data, (int*)label->data, padding != NULL ? (DTYPE*)padding->data : NULL,
+         (DTYPE*)loss->data, colNum, low, high, high + low * (colNum - 1));
+
+    BacktoCudaDev(x->devID, devIDBackup);
+}
+
+/*
+backward computation of softmax + cross entropy (Cuda version)
+>> x - the input (scores before the softmax)
+>> label - index of the gold label at each position
+>> padding - padding of the positions (NULL means no padding)
+>> dedx - dE/dx
+>> smoothing - the factor of label smoothing
+*/
+void _CudaSoftmaxCrossEntropyWithIndexBackward(const XTensor * x, const XTensor * label,
+                                               const XTensor * padding, XTensor * dedx,
+                                               DTYPE smoothing)
+{
+    int colNum = x->GetDim(-1);
+    int rowNum = label->unitNum;
+    DTYPE low = smoothing / colNum;
+    DTYPE high = 1.0F - smoothing;
+
+    int devIDBackup;
+    ProtectCudaDev(x->devID, devIDBackup);
+
+    KernelSoftmaxCrossEntropyWithIndexBackward<<<dim3(rowNum), dim3(SOFTMAXCE_BLOCK_SIZE)>>>
+        ((DTYPE*)x->data, (int*)label->data, padding != NULL ? (DTYPE*)padding->data : NULL,
+         (DTYPE*)dedx->data, colNum, low, high, high + low * (colNum - 1));
+
+    BacktoCudaDev(x->devID, devIDBackup);
+}
+
+#endif // USE_CUDA
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,53 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University. 
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __SOFTMAXCROSSENTROPY_H__
+#define __SOFTMAXCROSSENTROPY_H__
+
+#include "../XTensor.h"
+
+namespace nts{ // namespace nts(NiuTrans.Tensor)
+
+/*
+softmax + cross entropy with the (label-smoothed) gold standard given by
+indices. The target distribution is 1 - smoothing for the gold label and
+smoothing / vocabulary-size for the other labels (as in IndexToOnehot).
+*/
+void _SoftmaxCrossEntropyWithIndex(const XTensor * x, const XTensor * label,
+                                   const XTensor * padding, XTensor * loss,
+                                   DTYPE smoothing = 0);
+
+/* softmax + cross entropy with index labels (return an XTensor structure) */
+XTensor SoftmaxCrossEntropyWithIndex(const XTensor & x, const XTensor & label,
+                                     DTYPE smoothing = 0);
+
+/* softmax + cross entropy with index labels and padding (return an XTensor structure) */
+XTensor SoftmaxCrossEntropyWithIndex(const XTensor & x, const XTensor & label,
+                                     const XTensor & padding, DTYPE smoothing = 0);
+
+/* backward computation of softmax + cross entropy (dE/dx is accumulated) */
+void _SoftmaxCrossEntropyWithIndexBackward(const XTensor * x, const XTensor * label,
+                                           const XTensor * padding, XTensor * dedx,
+                                           DTYPE smoothing = 0);
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __SOFTMAXCROSSENTROPY_H__
@@ -0,0 +1,200 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include <math.h>
+#include "../XSIMD.h"
+#include "../core/utilities/CheckData.h"
+#include "TAdam.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+run a few steps of Adam (or AdamW) on random data and compare the result
+with a reference implementation in double precision
+>> n - number of the parameters
+>> decay - the weight decay
+>> level - the SIMD level we use
+*/
+static bool CheckAdam(int n, DTYPE decay, SIMD_LEVEL level)
+{
+    int stepNum = 3;
+    DTYPE beta1 = 0.9F;
+    DTYPE beta2 = 0.98F;
+    DTYPE lr = 0.01F;
+    DTYPE delta = 1e-9F;
+
+    /* create tensors */
+    XTensor * p = NewTensor1DV2(n);
+    XTensor * g = NewTensor1DV2(n);
+    XTensor * m = NewTensor1DV2(n);
+    XTensor * v = NewTensor1DV2(n);
+
+    /* initialize variables */
+    p->SetDataRand(-1.0F, 1.0F);
+    m->SetZeroAll();
+    v->SetZeroAll();
+
+    double * pd = new double[n];
+    double * md = new double[n];
+    double * vd = new double[n];
+    for (int i = 0; i < n; i++) {
+        pd[i] = ((DTYPE*)p->data)[i];
+        md[i] = 0;
+        vd[i] = 0;
+    }
+
+    SetMaxSIMDLevel(level);
+
+    double beta1T = 1.0;
+    double beta2T = 1.0;
+    for (int t = 0; t < stepNum; t++) {
+        g->SetDataRand(-0.5F, 0.5F);
+
+        beta1T *= beta1;
+        beta2T *= beta2;
+        double alpha = lr * sqrt(1 - beta2T) / (1 - beta1T);
+        double d = delta * sqrt(1 - beta2T);
+
+        /* the answer */
+        for (int i = 0; i < n; i++) {
+            double gi = ((DTYPE*)g->data)[i];
+            md[i] = beta1 * md[i] + (1 - beta1) * gi;
+            vd[i] = beta2 * vd[i] + (1 - beta2) * gi * gi;
+            pd[i] = (1 - lr * decay) * pd[i] - alpha * md[i] / (sqrt(vd[i]) + d);
+        }
+
+        /* call Adam function */
+        _Adam(p, g, m, v, beta1, beta2, (DTYPE)alpha, (DTYPE)d, lr * decay);
+    }
+
+    SetMaxSIMDLevel(SIMD_AVX512);
+
+    DTYPE * answerP = new DTYPE[n];
+    DTYPE * answerM = new DTYPE[n];
+    DTYPE * answerV = new DTYPE[n];
+    for (int i = 0; i < n; i++) {
+        answerP[i] = (DTYPE)pd[i];
+        answerM[i] = (DTYPE)md[i];
+        answerV[i] = (DTYPE)vd[i];
+    }
+
+    /* check results */
+    bool cpuTest = _CheckData(p, answerP, n, 1e-4F) &&
+                   _CheckData(m, answerM, n, 1e-5F) &&
+                   _CheckData(v, answerV, n, 1e-5F);
+
+    /* destroy variables */
+    delete p;
+    delete g;
+    delete m;
+    delete v;
+    delete[] pd;
+    delete[] md;
+    delete[] vd;
+    delete[] answerP;
+    delete[] answerM;
+    delete[] answerV;
+
+    return cpuTest;
+}
+
+/*
+case 1: test Adam function.
+m = beta1 * m + (1 - beta1) * g
+v = beta2 * v + (1 - beta2) * g * g
+p = p - alpha * m / (sqrt(v) + delta)
+In this case, p=(1037) and we run three steps with the scalar and
+vectorized kernels.
+*/
+bool TestAdam1()
+{
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+    bool cpuTest = true;
+
+    for (int l = 0; l < 3; l++)
+        cpuTest = CheckAdam(1037, 0, levels[l]) && cpuTest;
+
+    return cpuTest;
+}
+
+/*
+case 2: test Adam function with the (decoupled) weight decay, i.e., AdamW.
+p = (1 - decay) * p - alpha * m / (sqrt(v) + delta)
+In this case, p=(531).
+*/
+bool TestAdam2()
+{
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+    bool cpuTest = true;
+
+    for (int l = 0; l < 3; l++)
+        cpuTest = CheckAdam(531, 0.1F, levels[l]) && cpuTest;
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+    TODO!!
+*/
+
+/* test for Adam Function */
+bool TestAdam()
+{
+    XPRINT(0, stdout, "[TEST Adam] a fused step of the Adam update \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestAdam1();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestAdam2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
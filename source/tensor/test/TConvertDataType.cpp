@@ -19,8 +19,11 @@
  * $Created by: Xu Chen (email: hello_master1954@163.com) 2018-07-12
  */
 
+#include <math.h>
+#include <string.h>
 #include "../core/arithmetic/MatrixMul.h"
 #include "../core/utilities/CheckData.h"
+#include "../XSIMD.h"
 #include "TConvertDataType.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
@@ -291,6 +294,136 @@ bool TestConvertDataType3()
 #endif // USE_CUDA
 }
 
+/*
+case 4: test the conversion between float32 and float16 on CPUs.
+In this case, we convert numbers whose float16 forms are known (with the
+rounding to the nearest even number, subnormal numbers and infinity), and
+a (1000) array and all the 65536 float16 numbers with every SIMD level.
+The results must be exactly the same as those of the plain kernel.
+*/
+bool TestConvertDataType4()
+{
+    float data[14] = {1.0F, -2.0F, 0.1F, 65504.0F, 65520.0F, 1e9F,
+                      5.9604645e-8F, 2.9802322e-8F, 4.4703484e-8F, 6.1035156e-5F,
+                      1.0F + 1.0F / 2048, 1.0F + 3.0F / 2048, -0.0F, 0.0F};
+    unsigned short answer[14] = {0x3C00, 0xC000, 0x2E66, 0x7BFF, 0x7C00, 0x7C00,
+                                 0x0001, 0x0000, 0x0001, 0x0400,
+                                 0x3C00, 0x3C02, 0x8000, 0x0000};
+
+    int n = 1000;
+    float * s = new float[n];
+    float * f = new float[65536];
+    float * f0 = new float[65536];
+    unsigned short * h = new unsigned short[65536];
+    unsigned short * t = new unsigned short[n];
+    unsigned short * t0 = new unsigned short[n];
+
+    for (int i = 0; i < n; i++)
+        s[i] = (float)sin(i * 0.37) * (float)pow(2.0, i % 40 - 25);
+    for (int i = 0; i < 65536; i++)
+        h[i] = (unsigned short)i;
+
+    bool cpuTest = true;
+
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+
+    for (int l = 0; l < 3; l++) {
+        SetMaxSIMDLevel(levels[l]);
+
+        /* the known numbers */
+        unsigned short r[14];
+        ConvertFloatToFloat16(data, (float16*)r, 14);
+        for (int i = 0; i < 14; i++) {
+            if (r[i] != answer[i])
+                cpuTest = false;
+        }
+
+        /* float32 -> float16 */
+        ConvertFloatToFloat16(s, (float16*)t, n);
+        if (l == 0)
+            memcpy(t0, t, sizeof(unsigned short) * n);
+        else if (memcmp(t, t0, sizeof(unsigned short) * n) != 0)
+            cpuTest = false;
+
+        /* float16 -> float32 (NaN may be quieted by the hardware) */
+        ConvertFloat16ToFloat((float16*)h, f, 65536);
+        if (l == 0)
+            memcpy(f0, f, sizeof(float) * 65536);
+        for (int i = 0; i < 65536; i++) {
+            bool isNaN = (h[i] & 0x7C00) == 0x7C00 && (h[i] & 0x3FF) != 0;
+            if (isNaN ? !(f[i] != f[i]) : memcmp(f + i, f0 + i, sizeof(float)) != 0)
+                cpuTest = false;
+        }
+    }
+
+    SetMaxSIMDLevel(SIMD_AVX512);
+
+    /* the numbers go back to themselves */
+    for (int i = 0; i < 65536; i++) {
+        bool isNaN = (h[i] & 0x7C00) == 0x7C00 && (h[i] & 0x3FF) != 0;
+        unsigned short back;
+        ConvertFloatToFloat16(f0 + i, (float16*)&back, 1);
+        if (!isNaN && back != h[i])
+            cpuTest = false;
+    }
+
+    /* destroy variables */
+    delete[] s;
+    delete[] f;
+    delete[] f0;
+    delete[] h;
+    delete[] t;
+    delete[] t0;
+
+    return cpuTest;
+}
+
+/*
+case 5: test ConvertDataType function on a large tensor.
+In this case, a (100, 500) tensor is converted to float16 and back to float32
+with a number of threads. The relative error is at most 2^-11.
+*/
+bool TestConvertDataType5()
+{
+    /* a tensor of size (100, 500) */
+    int order = 2;
+    int dimSize[2] = {100, 500};
+    int unitNum = dimSize[0] * dimSize[1];
+
+    /* create tensors */
+    XTensor * a = NewTensorV2(order, dimSize, X_FLOAT, 1.0F, -1);
+    XTensor * b = NewTensorV2(order, dimSize, X_FLOAT16, 1.0F, -1);
+    XTensor * c = NewTensorV2(order, dimSize, X_FLOAT, 1.0F, -1);
+    XTensor bUser;
+    XTensor cUser;
+
+    /* initialize variables */
+    a->SetDataRand(-4.0F, 4.0F);
+
+    /* call ConvertDataType function */
+    _ConvertDataType(a, b);
+    _ConvertDataType(b, c);
+    bUser = ConvertDataType(*a, X_FLOAT16);
+    cUser = ConvertDataType(bUser, X_FLOAT);
+
+    /* check results */
+    bool cpuTest = true;
+    float * ad = (float*)a->data;
+    float * cd = (float*)c->data;
+    for (int i = 0; i < unitNum; i++) {
+        if (fabs(cd[i] - ad[i]) > fabs(ad[i]) / 2048 + 1e-7F)
+            cpuTest = false;
+    }
+    cpuTest = cpuTest && _CheckData(&cUser, c->data, unitNum, 0);
+
+    /* destroy variables */
+    delete a;
+    delete b;
+    delete c;
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
 TODO!!
@@ -332,6 +465,26 @@ bool TestConvertDataType()
     else
         XPRINT(0, stdout, ">> case 3 passed!\n");
 
+    /* case 4 test */
+    caseFlag = TestConvertDataType4();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 4 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 4 passed!\n");
+
+    /* case 5 test */
+    caseFlag = TestConvertDataType5();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 5 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 5 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
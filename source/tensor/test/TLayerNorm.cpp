@@ -0,0 +1,321 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include <math.h>
+#include "../core/utilities/CheckData.h"
+#include "TLayerNorm.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* layer normalization of a row in double precision */
+static void LayerNormRef(const double * x, const double * w, const double * b, double * y, int n, double eps)
+{
+    double mean = 0;
+    for (int j = 0; j < n; j++)
+        mean += x[j];
+    mean /= n;
+
+    double var = 0;
+    for (int j = 0; j < n; j++)
+        var += (x[j] - mean) * (x[j] - mean);
+    var /= n;
+
+    for (int j = 0; j < n; j++)
+        y[j] = (x[j] - mean) / sqrt(var + eps) * w[j] + b[j];
+}
+
+/* E = \sum_{i,j} g_{ij} * y_{ij} where y is the output of layer normalization */
+static double LayerNormLossRef(const double * x, const double * w, const double * b, const double * g,
+                               int m, int n, double eps)
+{
+    double * y = new double[n];
+    double e = 0;
+    for (int i = 0; i < m; i++) {
+        LayerNormRef(x + i * n, w, b, y, n, eps);
+        for (int j = 0; j < n; j++)
+            e += g[i * n + j] * y[j];
+    }
+    delete[] y;
+    return e;
+}
+
+/*
+case 1: test LayerNorm function.
+y = (x - \mu) / \sqrt{\sigma^2 + eps} * w + b
+In this case, x=(2, 3, 37), w=(37), b=(37) -> y=(2, 3, 37).
+*/
+bool TestLayerNorm1()
+{
+    int m = 6;
+    int n = 37;
+    int dimSize[3] = {2, 3, n};
+    DTYPE eps = 1e-5F;
+
+    /* create tensors */
+    XTensor * x = NewTensorV2(3, dimSize);
+    XTensor * w = NewTensor1DV2(n);
+    XTensor * b = NewTensor1DV2(n);
+    XTensor * y = NewTensorV2(3, dimSize);
+    XTensor yUser;
+
+    /* initialize variables */
+    x->SetDataRand(-2.0F, 3.0F);
+    w->SetDataRand(0.5F, 1.5F);
+    b->SetDataRand(-1.0F, 1.0F);
+
+    /* the answer */
+    double * xd = new double[m * n];
+    double * wd = new double[n];
+    double * bd = new double[n];
+    double * yd = new double[m * n];
+    for (int i = 0; i < m * n; i++)
+        xd[i] = ((DTYPE*)x->data)[i];
+    for (int j = 0; j < n; j++) {
+        wd[j] = w->Get1D(j);
+        bd[j] = b->Get1D(j);
+    }
+
+    DTYPE * answer = new DTYPE[m * n];
+    for (int i = 0; i < m; i++)
+        LayerNormRef(xd + i * n, wd, bd, yd + i * n, n, eps);
+    for (int i = 0; i < m * n; i++)
+        answer[i] = (DTYPE)yd[i];
+
+    /* call LayerNorm function */
+    _LayerNorm(x, w, b, y, eps);
+    yUser = LayerNorm(*x, *w, *b, eps);
+
+    /* check results */
+    bool cpuTest = _CheckData(y, answer, m * n, 1e-4F) &&
+                   _CheckData(&yUser, answer, m * n, 1e-4F);
+
+    /* destroy variables */
+    delete x;
+    delete w;
+    delete b;
+    delete y;
+    delete[] xd;
+    delete[] wd;
+    delete[] bd;
+    delete[] yd;
+    delete[] answer;
+
+    return cpuTest;
+}
+
+/*
+case 2: test LayerNormBackward function.
+We compute dE/dx, dE/dw and dE/db for E = \sum g * y and compare
+them with the numerical gradients (central differences in double precision).
+In this case, x=(4, 13), w=(13), b=(13).
+*/
+bool TestLayerNorm2()
+{
+    int m = 4;
+    int n = 13;
+    DTYPE eps = 1e-5F;
+
+    /* create tensors */
+    XTensor * x = NewTensor2DV2(m, n);
+    XTensor * w = NewTensor1DV2(n);
+    XTensor * g = NewTensor2DV2(m, n);
+    XTensor * dedx = NewTensor2DV2(m, n);
+    XTensor * dedw = NewTensor1DV2(n);
+    XTensor * dedb = NewTensor1DV2(n);
+
+    /* initialize variables */
+    x->SetDataRand(-2.0F, 3.0F);
+    w->SetDataRand(0.5F, 1.5F);
+    g->SetDataRand(-1.0F, 1.0F);
+    dedx->SetZeroAll();
+    dedw->SetZeroAll();
+    dedb->SetZeroAll();
+
+    double * xd = new double[m * n];
+    double * wd = new double[n];
+    double * bd = new double[n];
+    double * gd = new double[m * n];
+    for (int i = 0; i < m * n; i++) {
+        xd[i] = ((DTYPE*)x->data)[i];
+        gd[i] = ((DTYPE*)g->data)[i];
+    }
+    for (int j = 0; j < n; j++) {
+        wd[j] = w->Get1D(j);
+        bd[j] = 0;
+    }
+
+    /* the answer */
+    double h = 1e-4;
+    DTYPE * answerX = new DTYPE[m * n];
+    DTYPE * answerW = new DTYPE[n];
+    DTYPE * answerB = new DTYPE[n];
+
+    for (int i = 0; i < m * n; i++) {
+        double v = xd[i];
+        xd[i] = v + h;
+        double e1 = LayerNormLossRef(xd, wd, bd, gd, m, n, eps);
+        xd[i] = v - h;
+        double e2 = LayerNormLossRef(xd, wd, bd, gd, m, n, eps);
+        xd[i] = v;
+        answerX[i] = (DTYPE)((e1 - e2) / (2 * h));
+    }
+
+    for (int j = 0; j < n; j++) {
+        double v = wd[j];
+        wd[j] = v + h;
+        double e1 = LayerNormLossRef(xd, wd, bd, gd, m, n, eps);
+        wd[j] = v - h;
+        double e2 = LayerNormLossRef(xd, wd, bd, gd, m, n, eps);
+        wd[j] = v;
+        answerW[j] = (DTYPE)((e1 - e2) / (2 * h));
+
+        v = bd[j];
+        bd[j] = v + h;
+        e1 = LayerNormLossRef(xd, wd, bd, gd, m, n, eps);
+        bd[j] = v - h;
+        e2 = LayerNormLossRef(xd, wd, bd, gd, m, n, eps);
+        bd[j] = v;
+        answerB[j] = (DTYPE)((e1 - e2) / (2 * h));
+    }
+
+    /* call LayerNormBackward function */
+    _LayerNormBackward(x, w, g, dedx, dedw, dedb, eps);
+
+    /* check results */
+    bool cpuTest = _CheckData(dedx, answerX, m * n, 1e-3F) &&
+                   _CheckData(dedw, answerW, n, 1e-3F) &&
+                   _CheckData(dedb, answerB, n, 1e-3F);
+
+    /* destroy variables */
+    delete x;
+    delete w;
+    delete g;
+    delete dedx;
+    delete dedw;
+    delete dedb;
+    delete[] xd;
+    delete[] wd;
+    delete[] bd;
+    delete[] gd;
+    delete[] answerX;
+    delete[] answerW;
+    delete[] answerB;
+
+    return cpuTest;
+}
+
+/*
+case 3: test LayerNorm function and its backward computation on an empty input.
+In this case, x=(4, 0), w=(0), b=(0) -> y=(4, 0).
+*/
+bool TestLayerNorm3()
+{
+    int n = 0;
+    int dimSize[2] = {4, n};
+    DTYPE eps = 1e-5F;
+
+    /* create tensors */
+    XTensor * x = NewTensorV2(2, dimSize);
+    XTensor * w = NewTensor1DV2(n);
+    XTensor * b = NewTensor1DV2(n);
+    XTensor * y = NewTensorV2(2, dimSize);
+    XTensor * dedy = NewTensorV2(2, dimSize);
+    XTensor * dedx = NewTensorV2(2, dimSize);
+    XTensor * dedw = NewTensor1DV2(n);
+    XTensor * dedb = NewTensor1DV2(n);
+
+    /* call LayerNorm function and its backward computation
+       (nothing is computed, and nothing is divided by zero) */
+    _LayerNorm(x, w, b, y, eps);
+    _LayerNormBackward(x, w, dedy, dedx, dedw, dedb, eps);
+
+    /* check results */
+    bool cpuTest = y->unitNum == 0 && dedx->unitNum == 0;
+
+    /* destroy variables */
+    delete x;
+    delete w;
+    delete b;
+    delete y;
+    delete dedy;
+    delete dedx;
+    delete dedw;
+    delete dedb;
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+    TODO!!
+*/
+
+/* test for LayerNorm Function */
+bool TestLayerNorm()
+{
+    XPRINT(0, stdout, "[TEST LayerNorm] layer normalization and its backward computation \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestLayerNorm1();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestLayerNorm2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* case 3 test */
+    caseFlag = TestLayerNorm3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -21,6 +21,7 @@
 
 #include "../XUtility.h"
 #include "../core/utilities/CheckData.h"
+#include "../XSIMD.h"
 #include "TLogSoftmax.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
@@ -315,6 +316,102 @@ bool TestLogSoftmax3()
 #endif // USE_CUDA
 }
 
+/*
+case 4: test LogSoftmax function with the fused kernels.
+LogSoftmax function: y = log(e^x / \sum_{i} e^{x_i})
+In this case, x=(4, 1003) and the rows are longer than the vector blocks
+(with a remainder). The values of the first row are large so that a naive
+implementation would overflow. We check every SIMD level against the answer
+computed in double precision.
+*/
+bool TestLogSoftmax4()
+{
+    int m0 = 4;
+    int n = 1003;
+
+    /* create tensors */
+    XTensor * x = NewTensor2DV2(m0, n);
+    XTensor * y = NewTensor2DV2(m0, n);
+
+    /* initialize variables */
+    x->SetDataRand(-10.0F, 10.0F);
+    for (int j = 0; j < n; j++)
+        x->Set2D(x->Get2D(0, j) + 500.0F, 0, j);
+
+    /* the answer */
+    DTYPE * answer = new DTYPE[m0 * n];
+    for (int i = 0; i < m0; i++) {
+        double m = x->Get2D(i, 0);
+        for (int j = 1; j < n; j++)
+            m = MAX(m, (double)x->Get2D(i, j));
+        double s = 0;
+        for (int j = 0; j < n; j++)
+            s += exp(x->Get2D(i, j) - m);
+        for (int j = 0; j < n; j++) {
+            double v = x->Get2D(i, j);
+                double r = v - m - log(s);
+                answer[i * n + j] = (DTYPE)(r > LOGPROB_MIN ? r : LOGPROB_MIN);
+        }
+    }
+
+    bool cpuTest = true;
+
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+
+    for (int l = 0; l < 3; l++) {
+        SetMaxSIMDLevel(levels[l]);
+        y->SetZeroAll();
+
+        /* call LogSoftmax function */
+        _LogSoftmax(x, y, 1);
+
+        /* check results */
+        cpuTest = _CheckData(y, answer, m0 * n, 1e-5F) && cpuTest;
+    }
+
+    SetMaxSIMDLevel(SIMD_AVX512);
+
+    /* destroy variables */
+    delete x;
+    delete y;
+    delete[] answer;
+
+    return cpuTest;
+}
+
+/*
+case 5: test LogSoftmax function and its backward computation on an empty input.
+In this case, x=(4, 0) -> y=(4, 0) and LossName=CROSSENTROPY.
+*/
+bool TestLogSoftmax5()
+{
+    int dimSize[2] = {4, 0};
+
+    /* create tensors */
+    XTensor * x = NewTensorV2(2, dimSize);
+    XTensor * y = NewTensorV2(2, dimSize);
+    XTensor * g = NewTensorV2(2, dimSize);
+    XTensor * dedy = NewTensorV2(2, dimSize);
+    XTensor * dedx = NewTensorV2(2, dimSize);
+
+    /* call LogSoftmax function and its backward computation
+       (nothing is computed, and nothing is divided by zero) */
+    _LogSoftmax(x, y, 1);
+    _LogSoftmaxBackward(g, y, x, dedy, dedx, NULL, 1, CROSSENTROPY);
+
+    /* check results */
+    bool cpuTest = y->unitNum == 0 && dedx->unitNum == 0;
+
+    /* destroy variables */
+    delete x;
+    delete y;
+    delete g;
+    delete dedy;
+    delete dedx;
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
     TODO!!
@@ -356,6 +453,26 @@ bool TestLogSoftmax()
     else
         XPRINT(0, stdout, ">> case 3 passed!\n");
 
+    /* case 4 test */
+    caseFlag = TestLogSoftmax4();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 4 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 4 passed!\n");
+
+    /* case 5 test */
+    caseFlag = TestLogSoftmax5();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 5 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 5 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
@@ -20,6 +20,7 @@
 */
 
 #include "../core/utilities/CheckData.h"
+#include "../XSIMD.h"
 #include "TMatrixMul2DParallel.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
@@ -175,6 +176,77 @@ bool TestMatrixMul2DParallel2()
     return cpuTest;
 }
 
+/* 
+case 3: matrix multiplication (for 2d tensors) with the native kernels.
+In this case, the matrices are larger than a register tile and the
+inner dimension is larger than a cache block. We check all the transposed
+cases with alpha and beta for every SIMD level against a naive loop.
+*/
+bool TestMatrixMul2DParallel3()
+{
+    int n = 67;
+    int m = 53;
+    int k = 300;
+    DTYPE alpha = 0.5F;
+    DTYPE beta = 2.0F;
+
+    bool cpuTest = true;
+
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+
+    for (int t = 0; t < 4; t++) {
+        MATRIX_TRANS_TYPE transA = (t & 1) ? X_TRANS : X_NOTRANS;
+        MATRIX_TRANS_TYPE transB = (t & 2) ? X_TRANS : X_NOTRANS;
+
+        /* create tensors */
+        XTensor * a = transA == X_TRANS ? NewTensor2DV2(k, n) : NewTensor2DV2(n, k);
+        XTensor * b = transB == X_TRANS ? NewTensor2DV2(m, k) : NewTensor2DV2(k, m);
+        XTensor * c0 = NewTensor2DV2(n, m);
+        XTensor * c = NewTensor2DV2(n, m);
+
+        /* initialize variables */
+        a->SetDataRand(-1.0F, 1.0F);
+        b->SetDataRand(-1.0F, 1.0F);
+        c0->SetDataRand(-1.0F, 1.0F);
+
+        /* the answer */
+        DTYPE * answer = new DTYPE[n * m];
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                double r = 0;
+                for (int p = 0; p < k; p++) {
+                    DTYPE va = transA == X_TRANS ? a->Get2D(p, i) : a->Get2D(i, p);
+                    DTYPE vb = transB == X_TRANS ? b->Get2D(j, p) : b->Get2D(p, j);
+                    r += va * vb;
+                }
+                answer[i * m + j] = (DTYPE)(r * alpha + c0->Get2D(i, j) * beta);
+            }
+        }
+
+        for (int l = 0; l < 3; l++) {
+            SetMaxSIMDLevel(levels[l]);
+            c->SetData(c0->data, n * m);
+
+            /* call MatrixMul2DParallel function */
+            _MatrixMul2DParallel(a, transA, b, transB, c, alpha, beta);
+
+            /* check results */
+            cpuTest = _CheckData(c, answer, n * m, 1e-3F) && cpuTest;
+        }
+
+        SetMaxSIMDLevel(SIMD_AVX512);
+
+        /* destroy variables */
+        delete a;
+        delete b;
+        delete c0;
+        delete c;
+        delete[] answer;
+    }
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
     TODO!!
@@ -205,6 +277,15 @@ bool TestMatrixMul2DParallel()
     else
         XPRINT(0, stdout, ">> case 2 passed!\n");
 
+    /* case 3 test */
+    caseFlag = TestMatrixMul2DParallel3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
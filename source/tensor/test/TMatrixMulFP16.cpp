@@ -0,0 +1,138 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include "../core/getandset/ConvertDataType.h"
+#include "../core/utilities/CheckData.h"
+#include "TMatrixMulFP16.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+case 1: matrix multiplication with float16 weights c = x * w + b.
+In this case, x=(2, 3, 600), w=(600, 100) or its transposed form, b=(100)
+-> c=(2, 3, 100). The weight is converted in a few panels (the last one is
+not full). We compare the results with those of the float multiplication
+with the same (rounded) weights.
+*/
+bool TestMatrixMulFP161()
+{
+    int m = 6;
+    int n = 100;
+    int k = 600;
+
+    int xDimSize[3] = {2, 3, k};
+    int cDimSize[3] = {2, 3, n};
+
+    bool cpuTest = true;
+
+    for (int t = 0; t < 2; t++) {
+        MATRIX_TRANS_TYPE transW = t == 0 ? X_NOTRANS : X_TRANS;
+
+        /* create tensors */
+        XTensor * x = NewTensorV2(3, xDimSize);
+        XTensor * w = transW == X_TRANS ? NewTensor2DV2(n, k) : NewTensor2DV2(k, n);
+        XTensor * wh = transW == X_TRANS ? NewTensor2DV2(n, k, X_FLOAT16) : NewTensor2DV2(k, n, X_FLOAT16);
+        XTensor * b = NewTensor1DV2(n);
+        XTensor * c = NewTensorV2(3, cDimSize);
+        XTensor cUser;
+
+        /* initialize variables */
+        x->SetDataRand(-1.0F, 1.0F);
+        w->SetDataRand(-1.0F, 1.0F);
+        b->SetDataRand(-1.0F, 1.0F);
+
+        /* the weight in float16 (and the rounded weight in float32) */
+        _ConvertDataType(w, wh);
+        _ConvertDataType(wh, w);
+
+        /* the answer (with the bias only if w is not transposed) */
+        DTYPE * answer = new DTYPE[m * n];
+        DTYPE * xd = (DTYPE*)x->data;
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < n; j++) {
+                double r = transW == X_TRANS ? 0 : b->Get1D(j);
+                for (int p = 0; p < k; p++) {
+                    DTYPE vw = transW == X_TRANS ? w->Get2D(j, p) : w->Get2D(p, j);
+                    r += xd[i * k + p] * vw;
+                }
+                answer[i * n + j] = (DTYPE)r;
+            }
+        }
+
+        /* call MatrixMulFP16 function */
+        const XTensor * bias = transW == X_TRANS ? NULL : b;
+        _MatrixMulFP16(x, wh, transW, bias, c);
+        cUser = MatrixMulFP16(*x, *wh, transW, bias);
+
+        /* check results */
+        cpuTest = _CheckData(c, answer, m * n, 1e-3F) &&
+                  _CheckData(&cUser, answer, m * n, 1e-3F) && cpuTest;
+
+        /* destroy variables */
+        delete x;
+        delete w;
+        delete wh;
+        delete b;
+        delete c;
+        delete[] answer;
+    }
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+    TODO!!
+*/
+
+/* test for MatrixMulFP16 Function */
+bool TestMatrixMulFP16()
+{
+    XPRINT(0, stdout, "[TEST MatrixMulFP16] matrix multiplication with float16 weights \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestMatrixMulFP161();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,207 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include "../core/utilities/CheckData.h"
+#include "../XSIMD.h"
+#include "TMatrixMulInt8.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+case 1: int8 matrix multiplication c = a * trans(b) with int32 results.
+In this case, a=(7, 37), b=(9, 37) -> c=(7, 9). The sizes are not
+multiples of the block size so that we check the margins. The results
+must be exactly the same as those of a naive loop for every SIMD level.
+*/
+bool TestMatrixMulInt81()
+{
+    int m = 7;
+    int n = 9;
+    int k = 37;
+
+    signed char * a = new signed char[m * k];
+    signed char * b = new signed char[n * k];
+    int * c = new int[m * n];
+    int * answer = new int[m * n];
+
+    /* initialize variables */
+    for (int i = 0; i < m * k; i++)
+        a[i] = (signed char)((i * 37 + 11) % 255 - 127);
+    for (int i = 0; i < n * k; i++)
+        b[i] = (signed char)((i * 53 + 7) % 255 - 127);
+
+    /* the answer */
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            int r = 0;
+            for (int p = 0; p < k; p++)
+                r += (int)a[i * k + p] * (int)b[j * k + p];
+            answer[i * n + j] = r;
+        }
+    }
+
+    bool cpuTest = true;
+
+    SIMD_LEVEL levels[2] = {SIMD_SCALAR, SIMD_AVX2};
+
+    for (int l = 0; l < 2; l++) {
+        SetMaxSIMDLevel(levels[l]);
+        memset(c, 0, sizeof(int) * m * n);
+
+        /* call Int8GEMM function */
+        Int8GEMM(m, n, k, a, k, b, k, c, n);
+
+        /* check results */
+        for (int i = 0; i < m * n; i++) {
+            if (c[i] != answer[i])
+                cpuTest = false;
+        }
+    }
+
+    SetMaxSIMDLevel(SIMD_AVX512);
+
+    /* destroy variables */
+    delete[] a;
+    delete[] b;
+    delete[] c;
+    delete[] answer;
+
+    return cpuTest;
+}
+
+/*
+case 2: matrix multiplication with quantized weights c = x * w + b.
+In this case, x=(2, 5, 64), w=(64, 30) or its transposed form, b=(30)
+-> c=(2, 5, 30). We compare the results with those of the float
+multiplication (with a tolerance for the quantization errors).
+*/
+bool TestMatrixMulInt82()
+{
+    int m = 10;
+    int n = 30;
+    int k = 64;
+
+    int xDimSize[3] = {2, 5, k};
+    int cDimSize[3] = {2, 5, n};
+    int qDimSize[2] = {n, k};
+
+    bool cpuTest = true;
+
+    for (int t = 0; t < 2; t++) {
+        MATRIX_TRANS_TYPE transW = t == 0 ? X_NOTRANS : X_TRANS;
+
+        /* create tensors */
+        XTensor * x = NewTensorV2(3, xDimSize);
+        XTensor * w = transW == X_TRANS ? NewTensor2DV2(n, k) : NewTensor2DV2(k, n);
+        XTensor * b = NewTensor1DV2(n);
+        XTensor * wq = NewTensorV2(2, qDimSize, X_INT8);
+        XTensor * scale = NewTensor1DV2(n);
+        XTensor * c = NewTensorV2(3, cDimSize);
+        XTensor cUser;
+
+        /* initialize variables */
+        x->SetDataRand(-1.0F, 1.0F);
+        w->SetDataRand(-1.0F, 1.0F);
+        b->SetDataRand(-1.0F, 1.0F);
+
+        /* the answer */
+        DTYPE * answer = new DTYPE[m * n];
+        DTYPE * xd = (DTYPE*)x->data;
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < n; j++) {
+                double r = b->Get1D(j);
+                for (int p = 0; p < k; p++) {
+                    DTYPE vw = transW == X_TRANS ? w->Get2D(j, p) : w->Get2D(p, j);
+                    r += xd[i * k + p] * vw;
+                }
+                answer[i * n + j] = (DTYPE)r;
+            }
+        }
+
+        /* call QuantizeInt8 and MatrixMulInt8 functions */
+        _QuantizeInt8(w, transW, wq, scale);
+        _MatrixMulInt8(x, wq, scale, b, c);
+        cUser = MatrixMulInt8(*x, *wq, *scale, b);
+
+        /* check results */
+        cpuTest = _CheckData(c, answer, m * n, 0.1F) &&
+                  _CheckData(&cUser, answer, m * n, 0.1F) && cpuTest;
+
+        /* destroy variables */
+        delete x;
+        delete w;
+        delete b;
+        delete wq;
+        delete scale;
+        delete c;
+        delete[] answer;
+    }
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+    TODO!!
+*/
+
+/* test for MatrixMulInt8 Function */
+bool TestMatrixMulInt8()
+{
+    XPRINT(0, stdout, "[TEST MatrixMulInt8] matrix multiplication with 8-bit weights \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestMatrixMulInt81();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestMatrixMulInt82();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -19,6 +19,7 @@
 * $Created by: Xu Chen (email: hello_master1954@163.com) 2018-06-30
 */
 
+#include "../XSIMD.h"
 #include "../core/utilities/CheckData.h"
 #include "TReduceMax.h"
 
@@ -231,6 +232,73 @@ bool TestReduceMax2()
 #endif // USE_CUDA
 }
 
+/*
+case 3: test ReduceMax and ReduceMin with the vectorized kernels.
+In this case, (3, 37, 45) -> (3, 45), dim = 1 and (3, 37, 45) -> (3, 37), dim = 2.
+The sizes are not a multiple of the vector length, and we compare the results
+of all SIMD levels with the max (min) values found here.
+*/
+bool TestReduceMax3()
+{
+    int dimSize[3] = {3, 37, 45};
+    SIMD_LEVEL levels[4] = {SIMD_SCALAR, SIMD_SSE, SIMD_AVX2, SIMD_AVX512};
+
+    XTensor * s = NewTensorV2(3, dimSize);
+    s->SetDataRand(-1.0F, 1.0F);
+    DTYPE * sData = (DTYPE*)s->data;
+
+    bool cpuTest = true;
+
+    for (int dim = 1; dim < 3; dim++) {
+        int tDimSize[2] = {dimSize[0], dimSize[3 - dim]};
+        int stride = dim == 1 ? dimSize[2] : 1;
+        int strideNum = dimSize[dim];
+        int blockSize = strideNum * stride;
+        int blockNum = dim == 1 ? dimSize[0] : dimSize[0] * dimSize[1];
+
+        XTensor * t = NewTensorV2(2, tDimSize);
+        DTYPE * maxAnswer = new DTYPE[t->unitNum];
+        DTYPE * minAnswer = new DTYPE[t->unitNum];
+
+        for (int k = 0; k < blockNum; k++) {
+            for (int j = 0; j < stride; j++) {
+                DTYPE * ip = sData + k * blockSize + j;
+                DTYPE maxV = ip[0];
+                DTYPE minV = ip[0];
+                for (int i = 1; i < strideNum; i++) {
+                    maxV = MAX(maxV, ip[i * stride]);
+                    minV = MIN(minV, ip[i * stride]);
+                }
+                maxAnswer[k * stride + j] = maxV;
+                minAnswer[k * stride + j] = minV;
+            }
+        }
+
+        for (int l = 0; l < 4; l++) {
+            SetMaxSIMDLevel(levels[l]);
+
+            t->SetZeroAll();
+            _ReduceMax(s, t, dim);
+            cpuTest = _CheckData(t, maxAnswer, t->unitNum) && cpuTest;
+
+            t->SetZeroAll();
+            _ReduceMin(s, t, dim);
+            cpuTest = _CheckData(t, minAnswer, t->unitNum) && cpuTest;
+        }
+
+        SetMaxSIMDLevel(SIMD_AVX512);
+
+        delete t;
+        delete[] maxAnswer;
+        delete[] minAnswer;
+    }
+
+    /* destroy variables */
+    delete s;
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
 TODO!!
@@ -260,6 +328,15 @@ bool TestReduceMax()
     else
         XPRINT(0, stdout, ">> case 2 passed!\n");
 
+    /* case 3 test */
+    caseFlag = TestReduceMax3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
@@ -19,6 +19,8 @@
  * $Created by: LI Yinqiao (email: li.yin.qiao.2012@hotmail.com) 2018-04-30
  */
 
+#include <math.h>
+#include "../XSIMD.h"
 #include "../core/getandset/SetData.h"
 #include "../core/utilities/CheckData.h"
 #include "TReduceSum.h"
@@ -707,6 +709,79 @@ bool TestReduceSum7()
 #endif // USE_CUDA
 }
 
+/*
+case 8: test ReduceSum function with the vectorized kernels.
+In this case, (3, 37, 45) -> (3, 45), dim = 1 and (3, 37, 45) -> (3, 37), dim = 2,
+with a shift, power = 1, 2 and 0.5, and with or without exp(). The sizes are
+not a multiple of the vector length, and we compare the results of all SIMD
+levels with the sums computed here.
+*/
+bool TestReduceSum8()
+{
+    int dimSize[3] = {3, 37, 45};
+    DTYPE powers[3] = {1.0F, 2.0F, 0.5F};
+    SIMD_LEVEL levels[4] = {SIMD_SCALAR, SIMD_SSE, SIMD_AVX2, SIMD_AVX512};
+
+    XTensor * s = NewTensorV2(3, dimSize);
+    s->SetDataRand(0.5F, 1.5F);
+    DTYPE * sData = (DTYPE*)s->data;
+
+    bool cpuTest = true;
+
+    for (int dim = 1; dim < 3; dim++) {
+        int tDimSize[2] = {dimSize[0], dimSize[3 - dim]};
+        int stride = dim == 1 ? dimSize[2] : 1;
+        int strideNum = dimSize[dim];
+        int blockSize = strideNum * stride;
+        int blockNum = dim == 1 ? dimSize[0] : dimSize[0] * dimSize[1];
+
+        XTensor * shift = NewTensorV2(2, tDimSize);
+        XTensor * t = NewTensorV2(2, tDimSize);
+        shift->SetDataRand(-0.5F, 0.5F);
+        DTYPE * shiftData = (DTYPE*)shift->data;
+        DTYPE * answer = new DTYPE[t->unitNum];
+
+        for (int p = 0; p < 3; p++) {
+            for (int e = 0; e < 2; e++) {
+                bool isExp = e == 1;
+                for (int k = 0; k < blockNum; k++) {
+                    for (int j = 0; j < stride; j++) {
+                        double sum = 0;
+                        for (int i = 0; i < strideNum; i++) {
+                            double v = pow(sData[k * blockSize + i * stride + j] - shiftData[k * stride + j], powers[p]);
+                            sum += isExp ? exp(v) : v;
+                        }
+                        answer[k * stride + j] = (DTYPE)sum;
+                    }
+                }
+
+                for (int l = 0; l < 4; l++) {
+                    SetMaxSIMDLevel(levels[l]);
+                    t->SetZeroAll();
+                    _ReduceSum(s, t, dim, shift, powers[p], isExp);
+
+                    for (int i = 0; i < t->unitNum; i++) {
+                        DTYPE v = ((DTYPE*)t->data)[i];
+                        if (fabs(v - answer[i]) > 1e-4F * MAX(1.0F, fabs(answer[i])))
+                            cpuTest = false;
+                    }
+                }
+            }
+        }
+
+        SetMaxSIMDLevel(SIMD_AVX512);
+
+        delete shift;
+        delete t;
+        delete[] answer;
+    }
+
+    /* destroy variables */
+    delete s;
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
 TODO!!
@@ -781,6 +856,15 @@ bool TestReduceSum()
     else
         XPRINT(0, stdout, ">> case 7 passed!\n");
 
+    /* case 8 test */
+    caseFlag = TestReduceSum8();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 8 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 8 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
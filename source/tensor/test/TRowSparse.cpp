@@ -0,0 +1,205 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include <string.h>
+#include "../core/CHeader.h"
+#include "../core/utilities/CheckData.h"
+#include "TRowSparse.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+case 1: add rows to a row-sparse matrix, coalesce them and apply them to a
+dense matrix.
+In this case, the matrix is (10, 6) and we add 3 + 4 rows of indices
+[3, 1, 3] and [[7, 0], [3, 1]] (as in the backward computation of Gather).
+*/
+bool TestRowSparse1()
+{
+    int rowNum = 10;
+    int colNum = 6;
+    int index1[3] = {3, 1, 3};
+    int index2[4] = {7, 0, 3, 1};
+
+    XTensor i1;
+    XTensor i2;
+    XTensor r1;
+    XTensor r2;
+    InitTensor1D(&i1, 3, X_INT);
+    InitTensor2D(&i2, 2, 2, X_INT);
+    InitTensor2D(&r1, 3, colNum);
+    InitTensor3D(&r2, 2, 2, colNum);
+    i1.SetData(index1, 3);
+    i2.SetData(index2, 4);
+    r1.SetDataRand(-1.0F, 1.0F);
+    r2.SetDataRand(-1.0F, 1.0F);
+
+    XTensor t;
+    InitTensor2D(&t, rowNum, colNum);
+    t.SetDataRand(-1.0F, 1.0F);
+
+    /* the answers */
+    DTYPE * dense = new DTYPE[rowNum * colNum];
+    DTYPE * answer = new DTYPE[rowNum * colNum];
+    memset(dense, 0, sizeof(DTYPE) * rowNum * colNum);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < colNum; j++)
+            dense[index1[i] * colNum + j] += ((DTYPE*)r1.data)[i * colNum + j];
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < colNum; j++)
+            dense[index2[i] * colNum + j] += ((DTYPE*)r2.data)[i * colNum + j];
+    for (int i = 0; i < rowNum * colNum; i++)
+        answer[i] = ((DTYPE*)t.data)[i] - 0.5F * dense[i];
+
+    XRowSparse g(rowNum, colNum, -1);
+    g.Add(&i1, &r1);
+    g.Add(&i2, &r2);
+
+    bool cpuTest = g.count == 7;
+
+    XTensor d;
+    InitTensor2D(&d, rowNum, colNum);
+    g.ToDense(&d);
+    cpuTest = cpuTest && _CheckData(&d, dense, rowNum * colNum, 1e-5F);
+
+    /* each row appears only once after coalescing */
+    g.Coalesce();
+    cpuTest = cpuTest && g.count == 4;
+    cpuTest = cpuTest && g.index[0] == 3 && g.index[1] == 1 && g.index[2] == 7 && g.index[3] == 0;
+    g.ToDense(&d);
+    cpuTest = cpuTest && _CheckData(&d, dense, rowNum * colNum, 1e-5F);
+
+    /* t = t - 0.5 * g */
+    g.ApplyTo(&t, -0.5F);
+    cpuTest = cpuTest && _CheckData(&t, answer, rowNum * colNum, 1e-5F);
+
+    /* the buffer is reused */
+    g.Clear();
+    g.Add(&i1, &r1);
+    cpuTest = cpuTest && g.count == 3 && g.capacity >= 7;
+
+    delete[] dense;
+    delete[] answer;
+
+    return cpuTest;
+}
+
+/*
+case 2: a step of Adam with a row-sparse gradient.
+In this case, the matrix is (8, 5) and the gradient has rows [2, 5, 2]. The
+moments are zero at the beginning, so the result is the same as that of
+Adam with the dense gradient.
+*/
+bool TestRowSparse2()
+{
+    int rowNum = 8;
+    int colNum = 5;
+    int index[3] = {2, 5, 2};
+
+    XTensor i;
+    XTensor r;
+    InitTensor1D(&i, 3, X_INT);
+    InitTensor2D(&r, 3, colNum);
+    i.SetData(index, 3);
+    r.SetDataRand(-1.0F, 1.0F);
+
+    XTensor p;
+    XTensor m;
+    XTensor v;
+    XTensor pAnswer;
+    XTensor mAnswer;
+    XTensor vAnswer;
+    XTensor gAnswer;
+    InitTensor2D(&p, rowNum, colNum);
+    InitTensor2D(&m, rowNum, colNum);
+    InitTensor2D(&v, rowNum, colNum);
+    InitTensor2D(&pAnswer, rowNum, colNum);
+    InitTensor2D(&mAnswer, rowNum, colNum);
+    InitTensor2D(&vAnswer, rowNum, colNum);
+    InitTensor2D(&gAnswer, rowNum, colNum);
+    p.SetDataRand(-1.0F, 1.0F);
+    m.SetZeroAll();
+    v.SetZeroAll();
+    _CopyValues(&p, &pAnswer);
+    mAnswer.SetZeroAll();
+    vAnswer.SetZeroAll();
+
+    XRowSparse g(rowNum, colNum, -1);
+    g.Add(&i, &r);
+    g.ToDense(&gAnswer);
+
+    _Adam(&pAnswer, &gAnswer, &mAnswer, &vAnswer, 0.9F, 0.98F, 0.01F, 1e-9F);
+    _AdamSparse(&p, &g, &m, &v, 0.9F, 0.98F, 0.01F, 1e-9F);
+
+    bool cpuTest = _CheckData(&p, pAnswer.data, p.unitNum, 1e-5F) &&
+                   _CheckData(&m, mAnswer.data, m.unitNum, 1e-5F) &&
+                   _CheckData(&v, vAnswer.data, v.unitNum, 1e-5F);
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for row-sparse matrices */
+bool TestRowSparse()
+{
+    XPRINT(0, stdout, "[TEST RowSparse] row-sparse matrices (e.g., gradients of embeddings)\n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestRowSparse1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestRowSparse2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -22,6 +22,7 @@
 #include "../XTensor.h"
 #include "../XUtility.h"
 #include "../core/utilities/CheckData.h"
+#include "../XSIMD.h"
 #include "TSoftmax.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
@@ -210,6 +211,101 @@ bool TestSoftmax2()
 #endif // USE_CUDA
 }
 
+/*
+case 3: test Softmax function with the fused kernels.
+Softmax function: y = e^x / \sum_{i} e^{x_i}
+In this case, x=(4, 1003) and the rows are longer than the vector blocks
+(with a remainder). The values of the first row are large so that a naive
+implementation would overflow. We check every SIMD level against the answer
+computed in double precision.
+*/
+bool TestSoftmax3()
+{
+    int m0 = 4;
+    int n = 1003;
+
+    /* create tensors */
+    XTensor * x = NewTensor2DV2(m0, n);
+    XTensor * y = NewTensor2DV2(m0, n);
+
+    /* initialize variables */
+    x->SetDataRand(-10.0F, 10.0F);
+    for (int j = 0; j < n; j++)
+        x->Set2D(x->Get2D(0, j) + 500.0F, 0, j);
+
+    /* the answer */
+    DTYPE * answer = new DTYPE[m0 * n];
+    for (int i = 0; i < m0; i++) {
+        double m = x->Get2D(i, 0);
+        for (int j = 1; j < n; j++)
+            m = MAX(m, (double)x->Get2D(i, j));
+        double s = 0;
+        for (int j = 0; j < n; j++)
+            s += exp(x->Get2D(i, j) - m);
+        for (int j = 0; j < n; j++) {
+            double v = x->Get2D(i, j);
+                answer[i * n + j] = (DTYPE)(exp(v - m) / s);
+        }
+    }
+
+    bool cpuTest = true;
+
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+
+    for (int l = 0; l < 3; l++) {
+        SetMaxSIMDLevel(levels[l]);
+        y->SetZeroAll();
+
+        /* call Softmax function */
+        _Softmax(x, y, 1);
+
+        /* check results */
+        cpuTest = _CheckData(y, answer, m0 * n, 1e-5F) && cpuTest;
+    }
+
+    SetMaxSIMDLevel(SIMD_AVX512);
+
+    /* destroy variables */
+    delete x;
+    delete y;
+    delete[] answer;
+
+    return cpuTest;
+}
+
+/*
+case 4: test Softmax function and its backward computation on an empty input.
+In this case, x=(4, 0) -> y=(4, 0) and LossName=CROSSENTROPY.
+*/
+bool TestSoftmax4()
+{
+    int dimSize[2] = {4, 0};
+
+    /* create tensors */
+    XTensor * x = NewTensorV2(2, dimSize);
+    XTensor * y = NewTensorV2(2, dimSize);
+    XTensor * g = NewTensorV2(2, dimSize);
+    XTensor * dedy = NewTensorV2(2, dimSize);
+    XTensor * dedx = NewTensorV2(2, dimSize);
+
+    /* call Softmax function and its backward computation
+       (nothing is computed, and nothing is divided by zero) */
+    _Softmax(x, y, 1);
+    _SoftmaxBackward(g, y, x, dedy, dedx, NULL, 1, CROSSENTROPY);
+
+    /* check results */
+    bool cpuTest = y->unitNum == 0 && dedx->unitNum == 0;
+
+    /* destroy variables */
+    delete x;
+    delete y;
+    delete g;
+    delete dedy;
+    delete dedx;
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
     TODO!!
@@ -241,6 +337,26 @@ bool TestSoftmax()
     else
         XPRINT(0, stdout, ">> case 2 passed!\n");
 
+    /* case 3 test */
+    caseFlag = TestSoftmax3();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
+    /* case 4 test */
+    caseFlag = TestSoftmax4();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 4 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 4 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
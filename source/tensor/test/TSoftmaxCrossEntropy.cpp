@@ -0,0 +1,206 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include <math.h>
+#include "../core/utilities/CheckData.h"
+#include "TSoftmaxCrossEntropy.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* -\sum_{k} t_k * log(softmax(x)_k) of a row in double precision */
+static double SoftmaxCrossEntropyRef(const double * x, int n, int y, double smoothing)
+{
+    double m = x[0];
+    for (int k = 1; k < n; k++)
+        m = x[k] > m ? x[k] : m;
+
+    double s = 0;
+    for (int k = 0; k < n; k++)
+        s += exp(x[k] - m);
+
+    double loss = 0;
+    for (int k = 0; k < n; k++) {
+        double t = k == y ? 1.0 - smoothing : smoothing / n;
+        loss -= t * (x[k] - m - log(s));
+    }
+
+    return loss;
+}
+
+/*
+case 1: test SoftmaxCrossEntropyWithIndex function.
+loss = -\sum_{k} t_k * log(softmax(x)_k) * padding
+where t is the label-smoothed distribution of the gold label.
+In this case, x=(2, 3, 41), label=(2, 3), padding=(2, 3) -> loss=(2, 3).
+*/
+bool TestSoftmaxCrossEntropy1()
+{
+    int m = 6;
+    int n = 41;
+    int dimSize[3] = {2, 3, n};
+    DTYPE smoothing = 0.1F;
+    int labels[6] = {0, 7, 40, 13, 2, 21};
+    DTYPE paddings[6] = {1.0F, 1.0F, 1.0F, 1.0F, 0.0F, 1.0F};
+
+    /* create tensors */
+    XTensor * x = NewTensorV2(3, dimSize);
+    XTensor * label = NewTensorV2(2, dimSize, X_INT);
+    XTensor * padding = NewTensorV2(2, dimSize);
+    XTensor * loss = NewTensorV2(2, dimSize);
+    XTensor lossUser;
+
+    /* initialize variables */
+    x->SetDataRand(-5.0F, 5.0F);
+    label->SetData(labels, m);
+    padding->SetData(paddings, m);
+
+    /* the answer */
+    double * xd = new double[n];
+    DTYPE answer[6];
+    for (int i = 0; i < m; i++) {
+        for (int k = 0; k < n; k++)
+            xd[k] = ((DTYPE*)x->data)[i * n + k];
+        answer[i] = (DTYPE)(SoftmaxCrossEntropyRef(xd, n, labels[i], smoothing) * paddings[i]);
+    }
+
+    /* call SoftmaxCrossEntropyWithIndex function */
+    _SoftmaxCrossEntropyWithIndex(x, label, padding, loss, smoothing);
+    lossUser = SoftmaxCrossEntropyWithIndex(*x, *label, *padding, smoothing);
+
+    /* check results */
+    bool cpuTest = _CheckData(loss, answer, m, 1e-4F) &&
+                   _CheckData(&lossUser, answer, m, 1e-4F);
+
+    /* destroy variables */
+    delete x;
+    delete label;
+    delete padding;
+    delete loss;
+    delete[] xd;
+
+    return cpuTest;
+}
+
+/*
+case 2: test SoftmaxCrossEntropyWithIndexBackward function.
+We compute dE/dx for E = \sum loss and compare it with the numerical
+gradient (central differences in double precision). The gradient is
+accumulated, so we start with dE/dx = 1.
+In this case, x=(3, 17) and label=(3).
+*/
+bool TestSoftmaxCrossEntropy2()
+{
+    int m = 3;
+    int n = 17;
+    DTYPE smoothing = 0.2F;
+    int labels[3] = {16, 0, 5};
+
+    /* create tensors */
+    XTensor * x = NewTensor2DV2(m, n);
+    XTensor * label = NewTensor1DV2(m, X_INT);
+    XTensor * dedx = NewTensor2DV2(m, n);
+
+    /* initialize variables */
+    x->SetDataRand(-3.0F, 3.0F);
+    label->SetData(labels, m);
+    dedx->SetDataFixed(1.0F);
+
+    /* the answer */
+    double * xd = new double[n];
+    DTYPE * answer = new DTYPE[m * n];
+    double h = 1e-4;
+    for (int i = 0; i < m; i++) {
+        for (int k = 0; k < n; k++)
+            xd[k] = ((DTYPE*)x->data)[i * n + k];
+        for (int k = 0; k < n; k++) {
+            double v = xd[k];
+            xd[k] = v + h;
+            double e1 = SoftmaxCrossEntropyRef(xd, n, labels[i], smoothing);
+            xd[k] = v - h;
+            double e2 = SoftmaxCrossEntropyRef(xd, n, labels[i], smoothing);
+            xd[k] = v;
+            answer[i * n + k] = (DTYPE)(1.0 + (e1 - e2) / (2 * h));
+        }
+    }
+
+    /* call SoftmaxCrossEntropyWithIndexBackward function */
+    _SoftmaxCrossEntropyWithIndexBackward(x, label, NULL, dedx, smoothing);
+
+    /* check results */
+    bool cpuTest = _CheckData(dedx, answer, m * n, 1e-4F);
+
+    /* destroy variables */
+    delete x;
+    delete label;
+    delete dedx;
+    delete[] xd;
+    delete[] answer;
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+    TODO!!
+*/
+
+/* test for SoftmaxCrossEntropyWithIndex Function */
+bool TestSoftmaxCrossEntropy()
+{
+    XPRINT(0, stdout, "[TEST SoftmaxCrossEntropy] softmax + cross entropy with index labels \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestSoftmaxCrossEntropy1();
+
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestSoftmaxCrossEntropy2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
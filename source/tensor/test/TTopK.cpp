@@ -19,6 +19,7 @@
 * $Created by: Xu Chen (email: hello_master1954@163.com) 2018-06-27
 */
 
+#include "../XSIMD.h"
 #include "TTopK.h"
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
@@ -488,6 +489,66 @@ bool TestTopK2()
 #endif // USE_CUDA
 }
 
+/*
+case 3: get the top-k items of each row for beam search, i.e., the row is
+(beam size \times vocabulary size) items and we get the beam and the word
+of each top-k item. In this case, (3, 2 * 37) -> (3, 4), k = 4.
+We compare the result with that of _TopK with and without SIMD.
+*/
+bool TestTopK3()
+{
+    int rowNum = 3;
+    int beamSize = 2;
+    int wordNum = 37;
+    int k = 4;
+
+    XTensor * s = NewTensor2DV2(rowNum, beamSize * wordNum, X_FLOAT);
+    XTensor * t = NewTensor2DV2(rowNum, k, X_FLOAT);
+    XTensor * index = NewTensor2DV2(rowNum, k, X_INT);
+    XTensor * tBeam = NewTensor2DV2(rowNum, k, X_FLOAT);
+    XTensor * beam = NewTensor2DV2(rowNum, k, X_INT);
+    XTensor * word = NewTensor2DV2(rowNum, k, X_INT);
+
+    /* random scores with a few large ones at the end of the rows */
+    s->SetDataRand(-10.0F, 0.0F);
+    for (int i = 0; i < rowNum; i++)
+        s->Set2D(1.0F + i, i, beamSize * wordNum - 1 - i);
+
+    _TopK(s, t, index, 1, k);
+
+    bool cpuTest = true;
+
+    SIMD_LEVEL levels[3] = {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512};
+
+    for (int l = 0; l < 3; l++) {
+        SetMaxSIMDLevel(levels[l]);
+
+        tBeam->SetZeroAll();
+        beam->SetZeroAll();
+        word->SetZeroAll();
+
+        _TopKBeam(s, tBeam, beam, word, k, wordNum);
+
+        for (int i = 0; i < t->unitNum; i++) {
+            int offset = ((int*)beam->data)[i] * wordNum + ((int*)word->data)[i];
+            if (((float*)tBeam->data)[i] != ((float*)t->data)[i] || offset != ((int*)index->data)[i])
+                cpuTest = false;
+        }
+    }
+
+    SetMaxSIMDLevel(SIMD_AVX512);
+
+    /* destroy variables */
+    delete s;
+    delete t;
+    delete index;
+    delete tBeam;
+    delete beam;
+    delete word;
+
+    return cpuTest;
+}
+
 /* other cases */
 /*
 TODO!!
@@ -517,6 +578,15 @@ bool TestTopK()
     else
         XPRINT(0, stdout, ">> case 2 passed!\n");
 
+    /* case 3 test */
+    caseFlag = TestTopK3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
     /* other cases test */
     /*
     TODO!!
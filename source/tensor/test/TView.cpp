@@ -0,0 +1,310 @@
+/* NiuTrans.Tensor - an open-source tensor library
+* Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+* $Created by: agent (email: agent@local) 2026-10-18
+*/
+
+#include "../core/CHeader.h"
+#include "../core/utilities/CheckData.h"
+#include "../function/FHeader.h"
+#include "TView.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+check whether a (strided) tensor has the same values as a contiguous one
+>> t - the tensor to check
+>> answer - the contiguous tensor
+*/
+bool CheckView(const XTensor &t, const XTensor &answer)
+{
+    if (!_IsSameShaped(&t, &answer))
+        return false;
+
+    XTensor c = Contiguous(t);
+
+    return _CheckData(&c, answer.data, answer.unitNum, 1e-4F);
+}
+
+/*
+case 1: split, merge, transpose and permute a tensor with views.
+In this case, (2, 3, 6) -> (3, 2, 3, 2) (split the last dimension),
+(3, 2, 3, 2) -> (2, 3, 6) (merge), (2, 3, 6) -> (2, 6, 3) (transpose) and
+(2, 3, 6) -> (6, 2, 3) (permute). We compare the results with Split,
+Merge and Transpose.
+*/
+bool TestView1()
+{
+    XTensor s;
+    InitTensor3D(&s, 2, 3, 6);
+    s.SetDataRand(-1.0F, 1.0F);
+
+    bool cpuTest = true;
+
+    /* split and merge */
+    XTensor split = SplitView(s, 2, 3);
+    cpuTest = cpuTest && !split.IsContiguous() && split.data == s.data;
+    cpuTest = cpuTest && CheckView(split, Split(s, 2, 3));
+
+    XTensor merged = MergeView(split, 3, 0);
+    cpuTest = cpuTest && merged.IsContiguous() && merged.data == s.data;
+    cpuTest = cpuTest && CheckView(merged, s);
+
+    /* merging a transposed tensor has to copy the data */
+    XTensor splitT = TransposeView(split, 2, 3);
+    XTensor mergedT = MergeView(splitT, 3, 0);
+    cpuTest = cpuTest && mergedT.IsContiguous() && mergedT.data != s.data;
+    XTensor splitAnswer;
+    XTensor splitTAnswer;
+    InitTensor4D(&splitAnswer, 3, 2, 3, 2);
+    InitTensor4D(&splitTAnswer, 3, 2, 2, 3);
+    _Split(&s, &splitAnswer, 2, 3);
+    _Transpose(&splitAnswer, &splitTAnswer, 2, 3);
+    cpuTest = cpuTest && CheckView(mergedT, Merge(splitTAnswer, 3, 0));
+
+    /* transpose */
+    XTensor trans = TransposeView(s, 1, 2);
+    cpuTest = cpuTest && CheckView(trans, Transpose(s, 1, 2));
+
+    /* permute */
+    int dimPermute[3] = {2, 0, 1};
+    XTensor perm = PermuteView(s, dimPermute);
+    XTensor permAnswer;
+    InitTensor3D(&permAnswer, 6, 2, 3);
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < 2; j++)
+            for (int k = 0; k < 3; k++)
+                permAnswer.Set3D(s.Get3D(j, k, i), i, j, k);
+    cpuTest = cpuTest && CheckView(perm, permAnswer);
+    cpuTest = cpuTest && perm.Get3D(4, 1, 2) == s.Get3D(1, 2, 4);
+
+    return cpuTest;
+}
+
+/*
+case 2: element-wise operations and copies on views.
+In this case, a and b are (2, 3, 6) tensors and we compute
+Split(a) + Split(b) * 2, Split(a) * 3 + 1 and a copy of Split(a)
+with views.
+*/
+bool TestView2()
+{
+    XTensor a;
+    XTensor b;
+    InitTensor3D(&a, 2, 3, 6);
+    InitTensor3D(&b, 2, 3, 6);
+    a.SetDataRand(-1.0F, 1.0F);
+    b.SetDataRand(-1.0F, 1.0F);
+
+    XTensor aSplit;
+    XTensor bSplit;
+    InitTensor4D(&aSplit, 3, 2, 3, 2);
+    InitTensor4D(&bSplit, 3, 2, 3, 2);
+    _Split(&a, &aSplit, 2, 3);
+    _Split(&b, &bSplit, 2, 3);
+    XTensor aView = SplitView(a, 2, 3);
+    XTensor bView = SplitView(b, 2, 3);
+
+    bool cpuTest = true;
+
+    /* sum */
+    XTensor c;
+    InitTensor(&c, &aSplit);
+    _Sum(&aView, &bView, &c, 2.0F);
+    cpuTest = cpuTest && CheckView(c, Sum(aSplit, bSplit, 2.0F));
+
+    /* sum into a view */
+    XTensor d;
+    InitTensor3D(&d, 2, 3, 6);
+    XTensor dView = SplitView(d, 2, 3);
+    _Sum(&aView, &bView, &dView, 2.0F);
+    cpuTest = cpuTest && CheckView(d, Sum(a, b, 2.0F));
+
+    /* scale and shift */
+    _ScaleAndShift(&aView, &c, 3.0F, 1.0F);
+    cpuTest = cpuTest && CheckView(c, ScaleAndShift(aSplit, 3.0F, 1.0F));
+
+    /* copy */
+    XTensor e;
+    InitTensor(&e, &aSplit);
+    _CopyValues(&aView, &e);
+    cpuTest = cpuTest && CheckView(e, aSplit);
+
+    return cpuTest;
+}
+
+/*
+case 3: batched matrix multiplication on views (as in multi-head attention).
+In this case, q is (2, 5, 8), k is (2, 7, 8) and we have 2 heads, i.e.,
+(2, 2, 5, 4) * (2, 2, 7, 4)^T -> (2, 2, 5, 7). The heads are views of q and
+k, or transposed views of k. The output is written into a split view of a
+(2, 5, 14) tensor.
+*/
+bool TestView3()
+{
+    XTensor q;
+    XTensor k;
+    InitTensor3D(&q, 2, 5, 8);
+    InitTensor3D(&k, 2, 7, 8);
+    q.SetDataRand(-1.0F, 1.0F);
+    k.SetDataRand(-1.0F, 1.0F);
+
+    XTensor qSplit;
+    XTensor kSplit;
+    XTensor answer;
+    InitTensor4D(&qSplit, 2, 2, 5, 4);
+    InitTensor4D(&kSplit, 2, 2, 7, 4);
+    InitTensor4D(&answer, 2, 2, 5, 7);
+    _Split(&q, &qSplit, 2, 2);
+    _Split(&k, &kSplit, 2, 2);
+    _MatrixMulBatched(&qSplit, X_NOTRANS, &kSplit, X_TRANS, &answer);
+
+    XTensor qView = SplitView(q, 2, 2);
+    XTensor kView = SplitView(k, 2, 2);
+    XTensor kViewT = TransposeView(kView, 2, 3);
+
+    bool cpuTest = true;
+
+    /* the heads are read in place */
+    cpuTest = cpuTest && CheckView(MatrixMulBatched(qView, X_NOTRANS, kView, X_TRANS), answer);
+
+    /* the transposed heads are read as transposed matrices */
+    cpuTest = cpuTest && CheckView(MatrixMulBatched(qView, X_NOTRANS, kViewT, X_NOTRANS), answer);
+
+    /* the heads are written in place */
+    XTensor merged;
+    InitTensor3D(&merged, 2, 5, 14);
+    XTensor mergedView = SplitView(merged, 2, 2);
+    _MatrixMulBatched(&qView, X_NOTRANS, &kView, X_TRANS, &mergedView);
+    cpuTest = cpuTest && CheckView(merged, Merge(answer, 3, 0));
+
+    return cpuTest;
+}
+
+/*
+case 4: views in the functions that do not read the strides (e.g., Softmax,
+Sigmoid and ReduceMax). Such a function stops with an error on a strided
+view, so we make a contiguous copy with Contiguous() first. A view that
+keeps the items in the row-major order (e.g., MergeView() of a split view)
+is contiguous and is taken as it is.
+In this case, s is a (2, 3, 6) tensor and its view is (3, 2, 3, 2).
+*/
+bool TestView4()
+{
+    XTensor s;
+    InitTensor3D(&s, 2, 3, 6);
+    s.SetDataRand(-1.0F, 1.0F);
+
+    XTensor sSplit;
+    InitTensor4D(&sSplit, 3, 2, 3, 2);
+    _Split(&s, &sSplit, 2, 3);
+
+    XTensor split = SplitView(s, 2, 3);
+    XTensor merged = MergeView(split, 3, 0);
+
+    bool cpuTest = true;
+
+    /* the split view would be rejected */
+    cpuTest = cpuTest && !split.IsContiguous();
+
+    /* softmax and max over a contiguous copy of the view */
+    XTensor splitCopy;
+    XTensor y;
+    XTensor m;
+    splitCopy = Contiguous(split);
+    InitTensor(&y, &sSplit);
+    InitTensor3D(&m, 3, 2, 3);
+    _Softmax(&splitCopy, &y, 3);
+    _ReduceMax(&splitCopy, &m, 3);
+    cpuTest = cpuTest && CheckView(y, Softmax(sSplit, 3));
+    cpuTest = cpuTest && CheckView(m, ReduceMax(sSplit, 3));
+
+    /* the merged view shares the data with s and is contiguous */
+    XTensor z;
+    InitTensor(&z, &s);
+    cpuTest = cpuTest && merged.IsContiguous() && merged.data == s.data;
+    _Sigmoid(&merged, &z);
+    cpuTest = cpuTest && CheckView(z, Sigmoid(s));
+
+    return cpuTest;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the views of tensors */
+bool TestView()
+{
+    XPRINT(0, stdout, "[TEST View] split, merge, transpose and permute tensors without copying the data\n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestView1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestView2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* case 3 test */
+    caseFlag = TestView3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
+    /* case 4 test */
+    caseFlag = TestView4();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 4 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 4 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
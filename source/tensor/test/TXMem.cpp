@@ -19,8 +19,11 @@
  * $Created by: XIAO Tong (xiaotong@mail.neu.edu.cn) 2018-6-24
  */
 
+#include <thread>
+#include <vector>
 #include "../XGlobal.h"
 #include "../XUtility.h"
+#include "../XMemSlab.h"
 #include "TXMem.h"
 
 namespace nts{ // namespace nts(NiuTrans.Tensor)
@@ -162,6 +165,182 @@ bool TestXMemCase1()
     return ok;
 }
 
+/* 
+case 2: test the slab mode of the memory pool. We allocate and free pieces
+of random sizes (and a piece that is bigger than a slab), and check the
+data and the statistics.
+*/
+bool TestXMemCase2()
+{
+    bool ok = true;
+    int caseNum = 1000;
+    int testNum = caseNum * 20;
+    int maxSize = 20000;
+    int devID = -1;
+
+    XMem mem;
+    mem.Initialize(devID, SLAB_FREE, MILLION, 1, 1024);
+
+    srand(907);
+
+    int ** p = new int*[caseNum];
+    int * size = new int[caseNum];
+    int * buf = new int[maxSize];
+
+    for (int i = 0; i < caseNum; i++) {
+        p[i] = NULL;
+        size[i] = rand() % maxSize + 1;
+    }
+
+    for (int i = 0; i < testNum; i++) {
+        int j = rand() % caseNum;
+
+        if (p[j] == NULL) {
+            p[j] = (int*)mem.Alloc(devID, size[j] * sizeof(int));
+            for (int k = 0; k < size[j]; k++)
+                buf[k] = j;
+            XMemCopy(p[j], devID, buf, -1, sizeof(int) * size[j]);
+        }
+        else {
+            XMemCopy(buf, -1, p[j], devID, sizeof(int) * size[j]);
+            for (int k = 0; k < size[j]; k++) {
+                if (buf[k] != j)
+                    ok = false;
+            }
+            mem.Release(devID, p[j], size[j] * sizeof(int));
+            p[j] = NULL;
+        }
+    }
+
+    for (int i = 0; i < caseNum; i++) {
+        if (p[i] != NULL)
+            mem.Release(devID, p[i], size[i] * sizeof(int));
+    }
+
+    /* every piece is in the pool again */
+    ok = ok && mem.slab->requestedSize == 0 && mem.slab->usedSize == 0;
+    ok = ok && mem.slab->peakRequestedSize > 0;
+    ok = ok && mem.slab->peakRequestedSize <= mem.slab->peakUsedSize;
+    ok = ok && mem.slab->peakUsedSize <= mem.GetUsedSize();
+
+    /* a piece that is bigger than a slab is not rounded up, and it goes
+       back to the device when it is released */
+    MTYPE reserved = mem.GetUsedSize();
+    MTYPE bigSize = 3 * MILLION + 7;
+    char * big = (char*)mem.Alloc(devID, bigSize);
+    ok = ok && big != NULL && mem.slab->largeNum == 1;
+    ok = ok && mem.GetUsedSize() == reserved + bigSize && mem.slab->usedSize == bigSize;
+    if (big != NULL)
+        memset(big, 1, bigSize);
+    mem.Release(devID, big, bigSize);
+    ok = ok && mem.slab->largeNum == 0 && mem.GetUsedSize() == reserved;
+    ok = ok && mem.slab->requestedSize == 0 && mem.slab->usedSize == 0;
+
+    /* the buffer works in the same way as that of the other modes */
+    void * b1 = mem.AllocBuf(devID, 100);
+    void * b2 = mem.AllocBuf(devID, 100);
+    mem.ReleaseBuf(devID, 100);
+    void * b3 = mem.AllocBuf(devID, 100);
+    ok = ok && b1 != b2 && b2 == b3;
+
+    mem.Clear();
+    ok = ok && mem.GetUsedSize() == 0;
+
+    delete[] p;
+    delete[] size;
+    delete[] buf;
+
+    return ok;
+}
+
+/* 
+case 3: test the slab mode of the memory pool with a number of threads.
+The threads allocate and free pieces at the same time, and then each of
+them frees the pieces allocated by another thread.
+*/
+bool TestXMemCase3()
+{
+    const int threadNum = 4;
+    int caseNum = 200;
+    int testNum = caseNum * 20;
+    int maxSize = 5000;
+    int devID = -1;
+
+    XMem mem;
+    mem.Initialize(devID, SLAB_FREE, MILLION, 1, 1024);
+
+    int ** p = new int*[threadNum * caseNum];
+    int * size = new int[threadNum * caseNum];
+    bool oks[threadNum];
+
+    srand(907);
+    for (int i = 0; i < threadNum * caseNum; i++) {
+        p[i] = NULL;
+        size[i] = rand() % maxSize + 1;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            int ** myP = p + t * caseNum;
+            int * mySize = size + t * caseNum;
+            unsigned int seed = t + 1;
+            oks[t] = true;
+
+            for (int i = 0; i < testNum; i++) {
+                seed = seed * 1103515245 + 12345;
+                int j = (seed >> 16) % caseNum;
+
+                if (myP[j] == NULL) {
+                    myP[j] = (int*)mem.Alloc(devID, mySize[j] * sizeof(int));
+                    for (int k = 0; k < mySize[j]; k++)
+                        myP[j][k] = t * caseNum + j;
+                }
+                else {
+                    for (int k = 0; k < mySize[j]; k++) {
+                        if (myP[j][k] != t * caseNum + j)
+                            oks[t] = false;
+                    }
+                    mem.Release(devID, myP[j], mySize[j] * sizeof(int));
+                    myP[j] = NULL;
+                }
+            }
+        }));
+    }
+
+    for (int t = 0; t < threadNum; t++)
+        threads[t].join();
+    threads.clear();
+
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            int other = (t + 1) % threadNum;
+            for (int j = 0; j < caseNum; j++) {
+                int id = other * caseNum + j;
+                if (p[id] == NULL)
+                    continue;
+                for (int k = 0; k < size[id]; k++) {
+                    if (p[id][k] != id)
+                        oks[t] = false;
+                }
+                mem.Release(devID, p[id], size[id] * sizeof(int));
+            }
+        }));
+    }
+
+    for (int t = 0; t < threadNum; t++)
+        threads[t].join();
+
+    bool ok = mem.slab->requestedSize == 0 && mem.slab->usedSize == 0;
+    for (int t = 0; t < threadNum; t++)
+        ok = ok && oks[t];
+
+    delete[] p;
+    delete[] size;
+
+    return ok;
+}
+
 /* test for memory pool class */
 bool TestXMem()
 {
@@ -180,6 +359,24 @@ bool TestXMem()
     else
         XPRINT(0, stdout, ">> case 1 passed!\n");
 
+    /* case 2 test */
+    caseFlag = TestXMemCase2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* case 3 test */
+    caseFlag = TestXMemCase3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
     if (returnFlag) {
         XPRINT(0, stdout, ">> All Passed!\n");
     }
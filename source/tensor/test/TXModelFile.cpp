@@ -0,0 +1,194 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../XUtility.h"
+#include "../core/utilities/CheckData.h"
+#include "TXModelFile.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* the model file we write in the test */
+#define TEST_MODEL_FILE "xmodelfile.test.tmp"
+
+/* a file that is not a model */
+#define TEST_TEXT_FILE "xmodelfile.text.tmp"
+
+/*
+case 1: dump a few tensors (of different data types and shapes) and an
+odd number of meta integers, and then map the file. The names, the shapes,
+the meta info and the data are the same as what we dump, the index is
+aligned for its 64-bit fields, and Load() lets a tensor on the CPU point to
+the mapped data.
+*/
+bool TestXModelFile1()
+{
+    bool ok = true;
+    int meta[3] = {7, -1, 12345};
+    int ids[5] = {4, 0, 3, 9, 1};
+
+    XTensor w;
+    XTensor idx;
+    XTensor emb;
+    InitTensor2D(&w, 2, 3);
+    InitTensor1D(&idx, 5, X_INT);
+    InitTensor3D(&emb, 4, 1, 6);
+    w.SetDataRand(-1.0F, 1.0F);
+    idx.SetData(ids, 5);
+    emb.SetDataRand(-1.0F, 1.0F);
+    w.SetName("w");
+    idx.SetName("ids");
+    emb.SetName("emb");
+
+    TensorList tensors(3);
+    tensors.Add(&w);
+    tensors.Add(&idx);
+    tensors.Add(&emb);
+
+    XModelFile::Dump(TEST_MODEL_FILE, meta, 3, &tensors);
+
+    ok = ok && XModelFile::IsModelFile(TEST_MODEL_FILE);
+
+    XModelFile file;
+    file.Open(TEST_MODEL_FILE);
+
+    ok = ok && file.header.tensorNum == 3 && file.header.metaNum == 3;
+    ok = ok && file.header.indexOffset % sizeof(long long) == 0;
+    ok = ok && file.meta[0] == 7 && file.meta[1] == -1 && file.meta[2] == 12345;
+
+    for (int i = 0; i < tensors.count && ok; i++) {
+        XTensor * t = tensors.GetItem(i);
+        const XModelFileEntry * entry = file.Find(t->name);
+
+        ok = ok && entry != NULL;
+        if (!ok)
+            break;
+
+        ok = ok && entry->dataType == t->dataType && entry->order == t->order;
+        for (int j = 0; j < t->order; j++)
+            ok = ok && entry->dimSize[j] == t->dimSize[j];
+        ok = ok && entry->size == (long long)t->unitNum * t->unitSize;
+        ok = ok && entry->offset % MODEL_FILE_ALIGNMENT == 0;
+        ok = ok && memcmp(file.GetData(entry), t->data, (size_t)entry->size) == 0;
+    }
+
+    ok = ok && file.Find("nothing") == NULL;
+
+    /* load the tensors with the same names and shapes */
+    XTensor w2;
+    XTensor idx2;
+    InitTensor2D(&w2, 2, 3);
+    InitTensor1D(&idx2, 5, X_INT);
+    w2.SetName("w");
+    idx2.SetName("ids");
+
+    if (ok) {
+        file.Load(&w2);
+        file.Load(&idx2);
+
+        ok = ok && w2.data == file.GetData(file.Find("w"));
+        ok = ok && _CheckData(&w2, w.data, w.unitNum, 1e-6F);
+        ok = ok && _CheckData(&idx2, ids, 5);
+    }
+
+    /* the tensors do not point to the file after we close it */
+    w2.data = NULL;
+    idx2.data = NULL;
+
+    file.Close();
+    remove(TEST_MODEL_FILE);
+
+    return ok;
+}
+
+/*
+case 2: a file that is not in the format (a text file, a file shorter than
+the magic number and a file that does not exist) is not taken as a model.
+*/
+bool TestXModelFile2()
+{
+    bool ok = true;
+
+    FILE * file = fopen(TEST_TEXT_FILE, "wb");
+    CheckNTErrors(file, "Cannot create the test file!");
+    fprintf(file, "NTMODE is not a model file\n");
+    fclose(file);
+    ok = ok && !XModelFile::IsModelFile(TEST_TEXT_FILE);
+
+    file = fopen(TEST_TEXT_FILE, "wb");
+    CheckNTErrors(file, "Cannot create the test file!");
+    fprintf(file, "NTMOD");
+    fclose(file);
+    ok = ok && !XModelFile::IsModelFile(TEST_TEXT_FILE);
+
+    remove(TEST_TEXT_FILE);
+    ok = ok && !XModelFile::IsModelFile(TEST_TEXT_FILE);
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the model file (XModelFile) */
+bool TestXModelFile()
+{
+    XPRINT(0, stdout, "[TEST XModelFile] dump and map a model file \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestXModelFile1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestXModelFile2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,34 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#ifndef __TXMODELFILE_H__
+#define __TXMODELFILE_H__
+
+#include "../XModelFile.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* test for the model file (XModelFile) */
+bool TestXModelFile();
+
+} // namespace nts(NiuTrans.Tensor)
+
+#endif // __TXMODELFILE_H__
@@ -0,0 +1,391 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include "../XUtility.h"
+#include "../core/CHeader.h"
+#include "../loss/SoftmaxCrossEntropy.h"
+#include "../XDevice.h"
+#include "../XRowSparse.h"
+#include "../../network/XCheckpoint.h"
+#include "TXNet.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* a small network: y = softmax((sigmoid(x * w1) . (x * w1)) * w2) with a cross-entropy loss */
+struct TestNetModel
+{
+    XTensor x;
+    XTensor w1;
+    XTensor w2;
+    XTensor label;
+};
+
+/*
+initialize the inputs and the parameters of the test network
+>> model - the model
+>> rowNum - number of rows of the input
+>> inNum - size of the input
+>> hiddenNum - size of the hidden layer
+>> outNum - size of the output
+*/
+static void InitTestNet(TestNetModel &model, int rowNum, int inNum, int hiddenNum, int outNum)
+{
+    InitTensor2D(&model.x, rowNum, inNum);
+    InitTensor2D(&model.w1, inNum, hiddenNum);
+    InitTensor2D(&model.w2, hiddenNum, outNum);
+    InitTensor1D(&model.label, rowNum, X_INT);
+
+    model.x.SetDataRand(-1.0F, 1.0F);
+    model.w1.SetDataRand(-1.0F, 1.0F);
+    model.w2.SetDataRand(-1.0F, 1.0F);
+    for (int i = 0; i < rowNum; i++)
+        model.label.Set1DInt((i * 7) % outNum, i);
+
+    model.w1.SetVarFlag();
+    model.w2.SetVarFlag();
+}
+
+/*
+case 1: release the activations in back-propagation.
+The gradients of the parameters are the same with and without
+XNet::SetDataReleaseFlag(), and the values and the gradients of the
+intermediate nodes are freed if the flag is set.
+*/
+bool TestXNet1()
+{
+    bool ok = true;
+    TestNetModel model;
+    InitTestNet(model, 6, 5, 8, 4);
+
+    XTensor * dw1[2];
+    XTensor * dw2[2];
+
+    for (int r = 0; r < 2; r++) {
+        bool isReleased = r == 1;
+
+        XTensor a;
+        XTensor h;
+        XTensor h2;
+        XTensor y;
+        XTensor loss;
+
+        a = MatrixMul(model.x, model.w1);
+        h = Sigmoid(a);
+        h2 = Multiply(h, a);
+        y = MatrixMul(h2, model.w2);
+        loss = SoftmaxCrossEntropyWithIndex(y, model.label);
+
+        XNet net;
+        net.SetGradEfficientFlag(false);
+        net.SetDataReleaseFlag(isReleased);
+        net.Backward(loss);
+
+        dw1[r] = NewTensor(model.w1.grad);
+        dw2[r] = NewTensor(model.w2.grad);
+        _CopyValues(model.w1.grad, dw1[r]);
+        _CopyValues(model.w2.grad, dw2[r]);
+
+        if (isReleased) {
+            ok = ok && a.data == NULL && h.data == NULL && h2.data == NULL && y.data == NULL;
+            ok = ok && a.grad == NULL && h.grad == NULL && h2.grad == NULL && y.grad == NULL;
+            ok = ok && model.w1.data != NULL && model.x.data != NULL && loss.data != NULL;
+        }
+        else {
+            ok = ok && h.data != NULL && h2.grad != NULL;
+        }
+
+        model.w1.grad->SetZeroAll();
+        model.w2.grad->SetZeroAll();
+    }
+
+    ok = ok && _CheckData(dw1[0], dw1[1]->data, dw1[0]->unitNum, 1e-6F);
+    ok = ok && _CheckData(dw2[0], dw2[1]->data, dw2[0]->unitNum, 1e-6F);
+
+    for (int r = 0; r < 2; r++) {
+        delete dw1[r];
+        delete dw2[r];
+    }
+
+    return ok;
+}
+
+/*
+the sub-network of the checkpoint region in case 2:
+y = dropout(sigmoid(a)) . a
+>> inputs - the inputs of the region (a)
+>> model - no use
+>> id - no use
+<< return - the output of the region
+*/
+static XTensor MakeTestRegion(TensorList &inputs, void * model, int id)
+{
+    XTensor * a = inputs.GetItem(0);
+    XTensor h;
+
+    h = Dropout(Sigmoid(*a), 0.5F);
+
+    return Multiply(h, *a);
+}
+
+/*
+case 2: gradient checkpointing with dropout.
+The gradients of the parameters are the same whether the region is
+re-computed in back-propagation (Checkpoint()) or not. The dropout masks
+are generated again in the re-computation, and the other uses of rand()
+between the forward and the backward computation do not change them.
+*/
+bool TestXNet2()
+{
+    bool ok = true;
+    TestNetModel model;
+    InitTestNet(model, 6, 5, 8, 4);
+
+    XTensor * dw1[2];
+    XTensor * dw2[2];
+
+    for (int r = 0; r < 2; r++) {
+        bool isCheckpointed = r == 1;
+
+        XTensor a;
+        XTensor h;
+        XTensor y;
+        XTensor loss;
+
+        a = MatrixMul(model.x, model.w1);
+
+        TensorList inputs(1);
+        inputs.Add(&a);
+
+        srand(907);
+
+        if (isCheckpointed)
+            h = Checkpoint(MakeTestRegion, inputs, NULL, 0);
+        else {
+            /* the same seed as in Checkpoint() */
+            GDevs.SetSeed(rand());
+            h = MakeTestRegion(inputs, NULL, 0);
+        }
+
+        y = MatrixMul(h, model.w2);
+        loss = SoftmaxCrossEntropyWithIndex(y, model.label);
+
+        /* someone else draws random numbers before back-propagation */
+        for (int i = 0; i < 10; i++)
+            rand();
+
+        XNet net;
+        net.Backward(loss);
+
+        dw1[r] = NewTensor(model.w1.grad);
+        dw2[r] = NewTensor(model.w2.grad);
+        _CopyValues(model.w1.grad, dw1[r]);
+        _CopyValues(model.w2.grad, dw2[r]);
+
+        model.w1.grad->SetZeroAll();
+        model.w2.grad->SetZeroAll();
+    }
+
+    ok = ok && _CheckData(dw1[0], dw1[1]->data, dw1[0]->unitNum, 1e-6F);
+    ok = ok && _CheckData(dw2[0], dw2[1]->data, dw2[0]->unitNum, 1e-6F);
+
+    /* the masks really drop something, i.e., the gradient of w1 differs
+       from the one without dropout */
+    XTensor a;
+    XTensor h;
+    XTensor y;
+    XTensor loss;
+
+    a = MatrixMul(model.x, model.w1);
+    h = Multiply(Sigmoid(a), a);
+    y = MatrixMul(h, model.w2);
+    loss = SoftmaxCrossEntropyWithIndex(y, model.label);
+
+    XNet net;
+    net.Backward(loss);
+
+    ok = ok && !_CheckData(dw1[0], model.w1.grad->data, dw1[0]->unitNum, 1e-6F);
+
+    for (int r = 0; r < 2; r++) {
+        delete dw1[r];
+        delete dw2[r];
+    }
+
+    return ok;
+}
+
+/*
+case 3: row-sparse gradients of a matrix that we access by Gather.
+The gradient of the matrix is the same whether it is kept as the rows
+that are looked up (SetSparseGradFlag()) or as a dense matrix, also if a
+row is looked up several times. And the sparse weight decay
+(XRowSparse::ScaleRowsOf()) scales the rows that are looked up only.
+*/
+bool TestXNet3()
+{
+    bool ok = true;
+    int vSize = 10;
+    int rowNum = 6;
+    int eSize = 5;
+
+    TestNetModel model;
+    InitTestNet(model, rowNum, eSize, 8, 4);
+
+    XTensor emb;
+    InitTensor2D(&emb, vSize, eSize);
+    emb.SetDataRand(-1.0F, 1.0F);
+    emb.SetVarFlag();
+
+    /* row 3 and row 7 are looked up twice */
+    int ids[6] = {3, 7, 0, 3, 9, 7};
+    XTensor index;
+    InitTensor1D(&index, rowNum, X_INT);
+    index.SetData(ids, rowNum);
+
+    XTensor * dEmb[2];
+    XTensor * dw1[2];
+
+    for (int r = 0; r < 2; r++) {
+        bool isSparse = r == 1;
+
+        emb.SetSparseGradFlag(isSparse);
+
+        XTensor x;
+        XTensor a;
+        XTensor h;
+        XTensor y;
+        XTensor loss;
+
+        x = Gather(emb, index);
+        a = MatrixMul(x, model.w1);
+        h = Sigmoid(a);
+        y = MatrixMul(h, model.w2);
+        loss = SoftmaxCrossEntropyWithIndex(y, model.label);
+
+        XNet net;
+        net.Backward(loss);
+
+        dEmb[r] = NewTensor(&emb);
+        dw1[r] = NewTensor(model.w1.grad);
+        _CopyValues(model.w1.grad, dw1[r]);
+
+        if (isSparse) {
+            ok = ok && emb.sparseGrad != NULL;
+            if (ok) {
+                emb.sparseGrad->ToDense(dEmb[r]);
+
+                /* a row for each word after coalescing */
+                emb.sparseGrad->Coalesce();
+                ok = ok && emb.sparseGrad->count == 4;
+            }
+        }
+        else {
+            ok = ok && emb.grad != NULL;
+            if (ok)
+                _CopyValues(emb.grad, dEmb[r]);
+        }
+
+        model.w1.grad->SetZeroAll();
+        model.w2.grad->SetZeroAll();
+    }
+
+    ok = ok && _CheckData(dEmb[0], dEmb[1]->data, dEmb[0]->unitNum, 1e-6F);
+    ok = ok && _CheckData(dw1[0], dw1[1]->data, dw1[0]->unitNum, 1e-6F);
+
+    /* the weight decay with the sparse gradient */
+    if (ok) {
+        XTensor decayed;
+        InitTensor2D(&decayed, vSize, eSize);
+        _CopyValues(&emb, &decayed);
+        emb.sparseGrad->ScaleRowsOf(&decayed, 0.5F);
+
+        DTYPE * e = (DTYPE*)emb.data;
+        DTYPE * d = (DTYPE*)decayed.data;
+        for (int i = 0; i < vSize; i++) {
+            bool isLooked = i == 0 || i == 3 || i == 7 || i == 9;
+            DTYPE scale = isLooked ? 0.5F : 1.0F;
+            for (int j = 0; j < eSize; j++)
+                ok = ok && fabs(d[i * eSize + j] - scale * e[i * eSize + j]) < 1e-6F;
+        }
+    }
+
+    for (int r = 0; r < 2; r++) {
+        delete dEmb[r];
+        delete dw1[r];
+    }
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for back-propagation over networks */
+bool TestXNet()
+{
+    XPRINT(0, stdout, "[TEST XNet] back-propagation over networks \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestXNet1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestXNet2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* case 3 test */
+    caseFlag = TestXNet3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
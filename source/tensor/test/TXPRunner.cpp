@@ -0,0 +1,292 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "../XGlobal.h"
+#include "TXPRunner.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/*
+run a job over [begin, begin + num) and check that every item is processed
+exactly once, and that only the last chunk is smaller than the grain
+>> runner - the runner (NULL means the global ParallelFor)
+>> begin - the first item
+>> num - number of items
+>> grain - the minimum number of items of a chunk
+>> count - a buffer of num counters
+<< return - whether it works
+*/
+static bool RunAndCheck(XPRunner * runner, int begin, int num, int grain, std::atomic<int> * count)
+{
+    std::atomic<int> smallChunkNum(0);
+
+    for (int i = 0; i < num; i++)
+        count[i] = 0;
+
+    PFORFunction function = [&](int beg, int end) {
+        if (end - beg < grain)
+            smallChunkNum++;
+        for (int i = beg; i < end; i++)
+            count[i - begin]++;
+    };
+
+    if (runner != NULL)
+        runner->ParallelFor(begin, begin + num, grain, function);
+    else
+        ParallelFor(begin, begin + num, grain, function);
+
+    bool ok = smallChunkNum <= 1;
+    for (int i = 0; i < num; i++)
+        ok = ok && count[i] == 1;
+
+    return ok;
+}
+
+/*
+case 1: every item is processed exactly once for various grain sizes
+(from one item per chunk to a single chunk) and ranges that do not start
+at 0, with a pool of 4 threads and with the global runner.
+*/
+bool TestXPRunner1()
+{
+    bool ok = true;
+    int num = 10007;
+    int grains[7] = {1, 3, 100, 1000, 4096, 10007, 20000};
+    std::atomic<int> * count = new std::atomic<int>[num];
+
+    XPRunner runner;
+    runner.Init(4);
+
+    for (int g = 0; g < 7; g++) {
+        ok = ok && RunAndCheck(&runner, 0, num, grains[g], count);
+        ok = ok && RunAndCheck(&runner, 17, num, grains[g], count);
+        ok = ok && RunAndCheck(NULL, 5, num, grains[g], count);
+    }
+
+    /* empty and single-item ranges */
+    ok = ok && RunAndCheck(&runner, 3, 0, 1, count);
+    ok = ok && RunAndCheck(&runner, 3, 1, 1, count);
+
+    delete[] count;
+
+    return ok;
+}
+
+/*
+case 2: nested calls. A ParallelFor in a job of another ParallelFor runs
+in the current thread as a single call over the whole range, and every
+item is still processed exactly once.
+*/
+bool TestXPRunner2()
+{
+    bool ok = true;
+    int rowNum = 64;
+    int colNum = 300;
+    std::atomic<int> * count = new std::atomic<int>[rowNum * colNum];
+    std::atomic<int> * callNum = new std::atomic<int>[rowNum];
+    std::atomic<int> wrongThreadNum(0);
+
+    for (int i = 0; i < rowNum * colNum; i++)
+        count[i] = 0;
+    for (int i = 0; i < rowNum; i++)
+        callNum[i] = 0;
+
+    XPRunner runner;
+    runner.Init(4);
+
+    runner.ParallelFor(0, rowNum, 1, [&](int beg, int end) {
+        for (int i = beg; i < end; i++) {
+            std::thread::id outerThread = std::this_thread::get_id();
+            runner.ParallelFor(0, colNum, 1, [&](int b, int e) {
+                callNum[i]++;
+                if (std::this_thread::get_id() != outerThread)
+                    wrongThreadNum++;
+                for (int j = b; j < e; j++)
+                    count[i * colNum + j]++;
+            });
+        }
+    });
+
+    ok = ok && wrongThreadNum == 0;
+    for (int i = 0; i < rowNum; i++)
+        ok = ok && callNum[i] == 1;
+    for (int i = 0; i < rowNum * colNum; i++)
+        ok = ok && count[i] == 1;
+
+    delete[] count;
+    delete[] callNum;
+
+    return ok;
+}
+
+/*
+case 3: a number of threads share a runner. Only one of them can use the
+pool at a time and the others run their jobs in their own threads, but
+every job processes all of its items exactly once.
+*/
+bool TestXPRunner3()
+{
+    int threadNum = 3;
+    int num = 5000;
+    std::atomic<int> wrongNum(0);
+
+    XPRunner runner;
+    runner.Init(4);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t] {
+            std::atomic<int> * count = new std::atomic<int>[num];
+            for (int k = 0; k < 50; k++) {
+                if (!RunAndCheck(&runner, t, num, 16 + t, count))
+                    wrongNum++;
+            }
+            delete[] count;
+        }));
+    }
+
+    for (int t = 0; t < threadNum; t++)
+        threads[t].join();
+
+    return wrongNum == 0;
+}
+
+/*
+case 4: SetThreadNum switches the global runner to a new pool. A job that
+holds the old runner can still use it, and the old runner is freed when
+it is no longer held. The jobs that run while the number of threads
+changes process their items exactly once.
+*/
+bool TestXPRunner4()
+{
+    bool ok = true;
+    int num = 3000;
+    int oldThreadNum = GetThreadNum();
+    std::atomic<int> * count = new std::atomic<int>[num];
+
+    SetThreadNum(3);
+    ok = ok && GetThreadNum() == 3 && GetGlobalPRunner()->threadNum == 3;
+
+    std::shared_ptr<XPRunner> held = GetGlobalPRunner();
+    std::weak_ptr<XPRunner> old = held;
+
+    SetThreadNum(2);
+    ok = ok && GetThreadNum() == 2 && GetGlobalPRunner()->threadNum == 2;
+    ok = ok && held->threadNum == 3 && RunAndCheck(held.get(), 0, num, 10, count);
+    ok = ok && !old.expired();
+
+    held.reset();
+    ok = ok && old.expired();
+
+    /* change the number of threads while another thread runs jobs */
+    std::atomic<bool> toStop(false);
+    std::atomic<int> wrongNum(0);
+    std::thread worker([&] {
+        std::atomic<int> * myCount = new std::atomic<int>[num];
+        while (!toStop) {
+            if (!RunAndCheck(NULL, 0, num, 10, myCount))
+                wrongNum++;
+        }
+        delete[] myCount;
+    });
+
+    for (int k = 0; k < 20; k++)
+        SetThreadNum(k % 4 + 1);
+
+    toStop = true;
+    worker.join();
+    ok = ok && wrongNum == 0;
+
+    SetThreadNum(oldThreadNum);
+    ok = ok && GetThreadNum() == oldThreadNum;
+
+    delete[] count;
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the parallel runner (ParallelFor) */
+bool TestXPRunner()
+{
+    XPRINT(0, stdout, "[TEST XPRunner] run jobs in parallel with the thread pool \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestXPRunner1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestXPRunner2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* case 3 test */
+    caseFlag = TestXPRunner3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
+    /* case 4 test */
+    caseFlag = TestXPRunner4();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 4 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 4 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
@@ -0,0 +1,330 @@
+/* NiuTrans.Tensor - an open-source tensor library
+ * Copyright (C) 2017, Natural Language Processing Lab, Northeastern University.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * $Created by: agent (email: agent@local) 2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../XGlobal.h"
+#include "TXShuffler.h"
+
+namespace nts { // namespace nts(NiuTrans.Tensor)
+
+/* the file we shuffle in the test */
+#define TEST_SHUFFLE_FILE "xshuffler.test.tmp"
+
+/*
+write a file of lines "0", "1", ..., "lineNum-1"
+>> fn - the file name
+>> lineNum - number of lines
+>> lastNewLine - indicates whether the last line ends with '\n'
+*/
+static void WriteShuffleFile(const char * fn, int lineNum, bool lastNewLine)
+{
+    FILE * file = fopen(fn, "wb");
+    CheckNTErrors(file, "Cannot create the test file!");
+
+    for (int i = 0; i < lineNum; i++) {
+        if (i < lineNum - 1 || lastNewLine)
+            fprintf(file, "%d\n", i);
+        else
+            fprintf(file, "%d", i);
+    }
+
+    fclose(file);
+}
+
+/*
+go over an epoch and record the order of the lines
+>> shuffler - the shuffler
+>> epoch - the epoch id
+>> order - the line ids we get (its size is lineNum + 1)
+>> lineNum - number of lines in the file
+<< return - number of lines we get (-1 if a line is illegal)
+*/
+static int ReadShuffleEpoch(XShuffler &shuffler, int epoch, int * order, int lineNum)
+{
+    char line[64];
+    int num = 0;
+
+    shuffler.Start(epoch);
+
+    while (shuffler.GetLine(line, 64) != NULL) {
+        char * end = NULL;
+        int id = (int)strtol(line, &end, 10);
+        if (end == line || *end != '\n' || id < 0 || id >= lineNum || num >= lineNum + 1)
+            return -1;
+        order[num++] = id;
+    }
+
+    return num;
+}
+
+/*
+case 1: each epoch is a permutation of the lines, i.e., every line
+appears exactly once. The last line of the file has no '\n'.
+*/
+bool TestXShuffler1()
+{
+    bool ok = true;
+    int lineNum = 2500;
+    int * order = new int[lineNum + 1];
+    int * count = new int[lineNum];
+
+    WriteShuffleFile(TEST_SHUFFLE_FILE, lineNum, false);
+
+    XShuffler shuffler;
+    shuffler.Init(TEST_SHUFFLE_FILE, 7, 100, 4);
+
+    for (int epoch = 0; epoch < 3 && ok; epoch++) {
+        int num = ReadShuffleEpoch(shuffler, epoch, order, lineNum);
+        if (num != lineNum) {
+            ok = false;
+            break;
+        }
+
+        for (int i = 0; i < lineNum; i++)
+            count[i] = 0;
+        for (int i = 0; i < num; i++)
+            count[order[i]]++;
+        for (int i = 0; i < lineNum; i++)
+            ok = ok && count[i] == 1;
+
+        /* the order is really shuffled */
+        int inPlace = 0;
+        for (int i = 0; i < num; i++)
+            inPlace += order[i] == i ? 1 : 0;
+        ok = ok && inPlace < lineNum / 2;
+    }
+
+    shuffler.Close();
+    remove(TEST_SHUFFLE_FILE);
+
+    delete[] order;
+    delete[] count;
+
+    return ok;
+}
+
+/*
+case 2: the order only depends on the seed and the epoch. The same seed
+and epoch give the same order (also after other epochs and with another
+shuffler), and a different epoch or seed gives a different order.
+*/
+bool TestXShuffler2()
+{
+    bool ok = true;
+    int lineNum = 1000;
+    int * order1 = new int[lineNum + 1];
+    int * order2 = new int[lineNum + 1];
+    int * order3 = new int[lineNum + 1];
+    int * order4 = new int[lineNum + 1];
+    int * order5 = new int[lineNum + 1];
+
+    WriteShuffleFile(TEST_SHUFFLE_FILE, lineNum, true);
+
+    XShuffler shuffler1;
+    XShuffler shuffler2;
+    XShuffler shuffler3;
+    shuffler1.Init(TEST_SHUFFLE_FILE, 11, 50, 3);
+    shuffler2.Init(TEST_SHUFFLE_FILE, 11, 50, 3);
+    shuffler3.Init(TEST_SHUFFLE_FILE, 12, 50, 3);
+
+    ok = ok && ReadShuffleEpoch(shuffler1, 2, order1, lineNum) == lineNum;
+    ok = ok && ReadShuffleEpoch(shuffler1, 3, order3, lineNum) == lineNum;
+    ok = ok && ReadShuffleEpoch(shuffler1, 2, order4, lineNum) == lineNum;
+    ok = ok && ReadShuffleEpoch(shuffler2, 2, order2, lineNum) == lineNum;
+    ok = ok && ReadShuffleEpoch(shuffler3, 2, order5, lineNum) == lineNum;
+
+    if (ok) {
+        int diffEpoch = 0;
+        int diffSeed = 0;
+        for (int i = 0; i < lineNum; i++) {
+            ok = ok && order1[i] == order2[i] && order1[i] == order4[i];
+            diffEpoch += order1[i] != order3[i] ? 1 : 0;
+            diffSeed += order1[i] != order5[i] ? 1 : 0;
+        }
+        ok = ok && diffEpoch > 0 && diffSeed > 0;
+    }
+
+    shuffler1.Close();
+    shuffler2.Close();
+    shuffler3.Close();
+    remove(TEST_SHUFFLE_FILE);
+
+    delete[] order1;
+    delete[] order2;
+    delete[] order3;
+    delete[] order4;
+    delete[] order5;
+
+    return ok;
+}
+
+/*
+case 3: shard and epoch boundaries. The shard size does not divide the
+number of lines, so the last shard is short. The lines are loaded in groups
+of bufShardNum whole shards, i.e., the first shardSize * bufShardNum lines
+of an epoch are from exactly bufShardNum shards and cover them. After the
+end of an epoch nothing is returned until the next epoch starts. A file of
+a single line and an empty file work as well.
+*/
+bool TestXShuffler3()
+{
+    bool ok = true;
+    int lineNum = 1003;
+    int shardSize = 7;
+    int bufShardNum = 5;
+    int shardNum = (lineNum + shardSize - 1) / shardSize;
+    int * order = new int[lineNum + 1];
+    int * shardCount = new int[shardNum];
+    char line[64];
+
+    WriteShuffleFile(TEST_SHUFFLE_FILE, lineNum, true);
+
+    XShuffler shuffler;
+    shuffler.Init(TEST_SHUFFLE_FILE, 3, shardSize, bufShardNum);
+
+    for (int epoch = 0; epoch < 2 && ok; epoch++) {
+        int num = ReadShuffleEpoch(shuffler, epoch, order, lineNum);
+        ok = ok && num == lineNum;
+
+        /* the end of the epoch */
+        ok = ok && shuffler.GetLine(line, 64) == NULL;
+        ok = ok && shuffler.GetLine(line, 64) == NULL;
+
+        if (!ok)
+            break;
+
+        /* go over the groups of shards. A group might have fewer lines
+           if it has the last (short) shard. */
+        int pos = 0;
+        while (pos < num && ok) {
+            for (int s = 0; s < shardNum; s++)
+                shardCount[s] = 0;
+
+            int groupShards = 0;
+            int groupLines = 0;
+
+            /* the lines of the group are from the shards that we count below */
+            int end = pos;
+            int shards = 0;
+            while (end < num && shards <= bufShardNum) {
+                int s = order[end] / shardSize;
+                if (shardCount[s] == 0)
+                    shards++;
+                if (shards > bufShardNum)
+                    break;
+                shardCount[s]++;
+                end++;
+            }
+
+            for (int s = 0; s < shardNum; s++) {
+                if (shardCount[s] == 0)
+                    continue;
+                int size = s < shardNum - 1 ? shardSize : lineNum - s * shardSize;
+                ok = ok && shardCount[s] == size;
+                groupShards++;
+                groupLines += shardCount[s];
+            }
+
+            ok = ok && (groupShards == bufShardNum || end == num);
+            ok = ok && groupLines == end - pos;
+
+            pos = end;
+        }
+    }
+
+    shuffler.Close();
+
+    /* a file of a single line without '\n' */
+    WriteShuffleFile(TEST_SHUFFLE_FILE, 1, false);
+    shuffler.Init(TEST_SHUFFLE_FILE, 3, shardSize, bufShardNum);
+    ok = ok && ReadShuffleEpoch(shuffler, 0, order, 1) == 1 && order[0] == 0;
+    shuffler.Close();
+
+    /* an empty file */
+    WriteShuffleFile(TEST_SHUFFLE_FILE, 0, false);
+    shuffler.Init(TEST_SHUFFLE_FILE, 3, shardSize, bufShardNum);
+    ok = ok && ReadShuffleEpoch(shuffler, 0, order, 1) == 0;
+    shuffler.Close();
+
+    remove(TEST_SHUFFLE_FILE);
+
+    delete[] order;
+    delete[] shardCount;
+
+    return ok;
+}
+
+/* other cases */
+/*
+TODO!!
+*/
+
+/* test for the streaming shuffler */
+bool TestXShuffler()
+{
+    XPRINT(0, stdout, "[TEST XShuffler] shuffle the lines of a file by shards \n");
+    bool returnFlag = true, caseFlag = true;
+
+    /* case 1 test */
+    caseFlag = TestXShuffler1();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 1 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 1 passed!\n");
+
+    /* case 2 test */
+    caseFlag = TestXShuffler2();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 2 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 2 passed!\n");
+
+    /* case 3 test */
+    caseFlag = TestXShuffler3();
+    if (!caseFlag) {
+        returnFlag = false;
+        XPRINT(0, stdout, ">> case 3 failed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> case 3 passed!\n");
+
+    /* other cases test */
+    /*
+    TODO!!
+    */
+
+    if (returnFlag) {
+        XPRINT(0, stdout, ">> All Passed!\n");
+    }
+    else
+        XPRINT(0, stdout, ">> Failed!\n");
+
+    XPRINT(0, stdout, "\n");
+
+    return returnFlag;
+}
+
+} // namespace nts(NiuTrans.Tensor)
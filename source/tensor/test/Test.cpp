@@ -30,6 +30,7 @@ bool Test()
     XPRINT(0, stdout, "Testing the XTensor utilites ... \n\n");
     
     wrong = !TestAbsolute() || wrong;
+    wrong = !TestAdam() || wrong;
     wrong = !TestClip() || wrong;
     wrong = !TestCompare() || wrong;
     wrong = !TestConcatenate() || wrong;
@@ -47,6 +48,8 @@ bool Test()
     wrong = !TestMatrixMul2D() || wrong;
     wrong = !TestMatrixMul2DParallel() || wrong;
     wrong = !TestMatrixMulBatched() || wrong;
+    wrong = !TestMatrixMulInt8() || wrong;
+    wrong = !TestMatrixMulFP16() || wrong;
     wrong = !TestMerge() || wrong;
     wrong = !TestMultiply() || wrong;
     wrong = !TestMultiplyDim() || wrong;
@@ -60,6 +63,7 @@ bool Test()
     wrong = !TestReduceSumSquared() || wrong;
     wrong = !TestReduceVariance() || wrong;
     wrong = !TestRound() || wrong;
+    wrong = !TestRowSparse() || wrong;
     wrong = !TestScaleAndShift() || wrong;
     wrong = !TestSelect() || wrong;
     wrong = !TestSetAscendingOrder() || wrong;
@@ -76,17 +80,25 @@ bool Test()
     wrong = !TestTranspose() || wrong;
     wrong = !TestTopK() || wrong;
     wrong = !TestUnsqueeze() || wrong;
+    wrong = !TestView() || wrong;
     wrong = !TestXMem() || wrong;
+    wrong = !TestXModelFile() || wrong;
+    wrong = !TestXNet() || wrong;
+    wrong = !TestXPRunner() || wrong;
+    wrong = !TestXShuffler() || wrong;
     
     wrong = !TestCrossEntropy() || wrong;
     wrong = !TestDropout() || wrong;
     wrong = !TestHardTanH() || wrong;
     wrong = !TestIdentity() || wrong;
+    wrong = !TestLayerNorm() || wrong;
     wrong = !TestLogSoftmax() || wrong;
     wrong = !TestLoss() || wrong;
     wrong = !TestRectify() || wrong;
     wrong = !TestSigmoid() || wrong;
     wrong = !TestSoftmax() || wrong;
+    wrong = !TestSoftmaxCrossEntropy() || wrong;
+
 
     /* other test */
     /*
@@ -23,6 +23,7 @@
 #define __TEST_H__
 
 #include "TAbsolute.h"
+#include "TAdam.h"
 #include "TClip.h"
 #include "TCompare.h"
 #include "TConcatenate.h"
@@ -40,6 +41,8 @@
 #include "TMatrixMul2D.h"
 #include "TMatrixMul2DParallel.h"
 #include "TMatrixMulBatched.h"
+#include "TMatrixMulInt8.h"
+#include "TMatrixMulFP16.h"
 #include "TMerge.h"
 #include "TMultiply.h"
 #include "TMultiplyDim.h"
@@ -53,6 +56,7 @@
 #include "TReduceSumSquared.h"
 #include "TReduceVariance.h"
 #include "TRound.h"
+#include "TRowSparse.h"
 #include "TScaleAndShift.h"
 #include "TSelect.h"
 #include "TSetAscendingOrder.h"
@@ -69,17 +73,25 @@
 #include "TTranspose.h"
 #include "TTopK.h"
 #include "TUnsqueeze.h"
+#include "TView.h"
 #include "TXMem.h"
+#include "TXModelFile.h"
+#include "TXNet.h"
+#include "TXPRunner.h"
+#include "TXShuffler.h"
 
 #include "TCrossEntropy.h"
 #include "TDropout.h"
 #include "THardTanH.h"
 #include "TIdentity.h"
+#include "TLayerNorm.h"
 #include "TLogSoftmax.h"
 #include "TLoss.h"
 #include "TRectify.h"
 #include "TSigmoid.h"
 #include "TSoftmax.h"
+#include "TSoftmaxCrossEntropy.h"
+
 
 namespace nts { // namespace nts(NiuTrans.Tensor)
 